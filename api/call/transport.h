@@ -35,6 +35,9 @@ struct PacketOptions {
   bool batchable = false;
   // Whether this packet is the last of a batch.
   bool last_packet_in_batch = false;
+  // Whether this packet should be sent with ECN ECT(1), see
+  // rtc::PacketOptions::ecn_1.
+  bool send_as_ect1 = false;
 };
 
 class Transport {
@@ -74,6 +74,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -694,6 +695,12 @@ class RTC_EXPORT PeerConnectionInterface : public webrtc::RefCountInterface {
     // The burst interval of the pacer, see TaskQueuePacedSender constructor.
     std::optional<TimeDelta> pacer_burst_interval;
 
+    // Decodes the video receive streams of the call on a pool with one thread
+    // per core, shared by all peer connections of the factory that enable it,
+    // instead of on one thread per stream. Only applies when the call is
+    // created, not on SetConfiguration().
+    bool enable_decode_thread_pool = false;
+
     //
     // Don't forget to update operator== if adding something.
     //
@@ -963,6 +970,17 @@ class RTC_EXPORT PeerConnectionInterface : public webrtc::RefCountInterface {
   virtual void GetStats(
       rtc::scoped_refptr<RtpReceiverInterface> selector,
       rtc::scoped_refptr<RTCStatsCollectorCallback> callback) = 0;
+  // Non-standard getStats() for polling a few stats at a high rate. Only stats
+  // whose type is in `stats_types`, e.g. RTCInboundRtpStreamStats::kType and
+  // RTCIceCandidatePairStats::kType, are gathered, and stats they reference by
+  // ID are left out unless their type is selected too.
+  // The default implementation delivers the full report, for implementations
+  // that predate this method.
+  virtual void GetSelectedStats(
+      const std::set<std::string>& stats_types,
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+    GetStats(callback.get());
+  }
   // Clear cached stats in the RTCStatsCollector.
   virtual void ClearStatsCache() {}
 
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -125,6 +126,11 @@ class MockPeerConnectionInterface : public webrtc::PeerConnectionInterface {
               (rtc::scoped_refptr<RtpReceiverInterface>,
                rtc::scoped_refptr<RTCStatsCollectorCallback>),
               (override));
+  MOCK_METHOD(void,
+              GetSelectedStats,
+              (const std::set<std::string>&,
+               rtc::scoped_refptr<RTCStatsCollectorCallback>),
+              (override));
   MOCK_METHOD(void, ClearStatsCache, (), (override));
   MOCK_METHOD(rtc::scoped_refptr<SctpTransportInterface>,
               GetSctpTransport,
@@ -24,6 +24,7 @@
 #include "api/video/encoded_image.h"
 #include "api/video/video_frame_type.h"
 #include "api/video/video_timing.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/rtp_rtcp/source/frame_object.h"
 #include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
@@ -101,6 +102,7 @@ class RtpVideoFrameAssembler::Impl {
   SeqNumUnwrapper<uint16_t> rtp_sequence_number_unwrapper_;
   SeqNumUnwrapper<uint16_t> frame_id_unwrapper_;
   std::optional<int64_t> video_structure_frame_id_;
+  EncodedImageBufferPool frame_buffer_pool_;
   std::unique_ptr<VideoRtpDepacketizer> depacketizer_;
   video_coding::PacketBuffer packet_buffer_;
   RtpFrameReferenceFinder reference_finder_;
@@ -109,7 +111,11 @@ class RtpVideoFrameAssembler::Impl {
 RtpVideoFrameAssembler::Impl::Impl(
     std::unique_ptr<VideoRtpDepacketizer> depacketizer)
     : depacketizer_(std::move(depacketizer)),
-      packet_buffer_(/*start_buffer_size=*/2048, /*max_buffer_size=*/2048) {}
+      packet_buffer_(/*start_buffer_size=*/2048, /*max_buffer_size=*/2048) {
+  if (depacketizer_) {
+    depacketizer_->SetFrameBufferPool(&frame_buffer_pool_);
+  }
+}
 
 RtpVideoFrameAssembler::FrameVector RtpVideoFrameAssembler::Impl::InsertPacket(
     const RtpPacketReceived& rtp_packet) {
@@ -139,10 +145,11 @@ RtpVideoFrameAssembler::FrameVector RtpVideoFrameAssembler::Impl::InsertPacket(
 
   parsed_payload->video_header.is_last_packet_in_frame |= rtp_packet.Marker();
 
-  auto packet = std::make_unique<video_coding::PacketBuffer::Packet>(
-      rtp_packet,
-      rtp_sequence_number_unwrapper_.Unwrap(rtp_packet.SequenceNumber()),
-      parsed_payload->video_header);
+  std::unique_ptr<video_coding::PacketBuffer::Packet> packet =
+      packet_buffer_.CreatePacket(
+          rtp_packet,
+          rtp_sequence_number_unwrapper_.Unwrap(rtp_packet.SequenceNumber()),
+          parsed_payload->video_header);
   packet->video_payload = std::move(parsed_payload->video_payload);
 
   ClearOldData(rtp_packet.SequenceNumber());
@@ -201,6 +208,7 @@ RtpVideoFrameAssembler::Impl::AssembleFrames(
           std::move(bitstream)));
     }
   }
+  packet_buffer_.ReturnPackets(std::move(insert_result.packets));
 
   return result;
 }
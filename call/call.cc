@@ -95,6 +95,7 @@
 #include "video/call_stats2.h"
 #include "video/config/video_encoder_config.h"
 #include "video/decode_synchronizer.h"
+#include "video/decode_thread_pool.h"
 #include "video/send_delay_stats.h"
 #include "video/stats_counter.h"
 #include "video/video_receive_stream2.h"
@@ -405,6 +406,7 @@ class Call final : public webrtc::Call,
   RTC_NO_UNIQUE_ADDRESS SequenceChecker send_transport_sequence_checker_;
 
   const int num_cpu_cores_;
+  DecodeThreadPool* const decode_thread_pool_;
   const std::unique_ptr<CallStats> call_stats_;
   const std::unique_ptr<BitrateAllocator> bitrate_allocator_;
   const CallConfig config_ RTC_GUARDED_BY(worker_thread_);
@@ -719,6 +721,7 @@ Call::Call(CallConfig config,
                                                      worker_thread_)
               : nullptr),
       num_cpu_cores_(CpuInfo::DetectNumberOfCores()),
+      decode_thread_pool_(config.decode_thread_pool),
       call_stats_(new CallStats(&env_.clock(), worker_thread_)),
       bitrate_allocator_(new BitrateAllocator(
           this,
@@ -1069,7 +1072,8 @@ webrtc::VideoReceiveStreamInterface* Call::CreateVideoReceiveStream(
       env_, this, num_cpu_cores_, transport_send_->packet_router(),
       std::move(configuration), call_stats_.get(),
       std::make_unique<VCMTiming>(&env_.clock(), trials()),
-      &nack_periodic_processor_, decode_sync_.get());
+      &nack_periodic_processor_, decode_sync_.get(),
+      decode_thread_pool_);
   // TODO(bugs.webrtc.org/11993): Set this up asynchronously on the network
   // thread.
   receive_stream->RegisterWithTransport(&video_receiver_controller_);
@@ -30,6 +30,7 @@
 namespace webrtc {
 
 class AudioProcessing;
+class DecodeThreadPool;
 
 struct CallConfig {
   // If `network_task_queue` is set to nullptr, Call will assume that network
@@ -90,6 +91,11 @@ struct CallConfig {
   // Enables send packet batching from the egress RTP sender.
   bool enable_send_packet_batching = false;
 
+  // If set, the video receive streams of this call are decoded on this pool,
+  // which may be shared with other calls, instead of on one thread per
+  // stream. Must outlive the call.
+  DecodeThreadPool* decode_thread_pool = nullptr;
+
   // Logging
   std::string logging_folder;
 };
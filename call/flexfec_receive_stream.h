@@ -53,6 +53,10 @@ class FlexfecReceiveStream : public RtpPacketSinkInterface,
     // protection.
     std::vector<uint32_t> protected_media_ssrcs;
 
+    // Receive the Reed-Solomon FEC scheme (ReedSolomonFecReceiver) instead of
+    // FlexFEC, see RtpConfig::Flexfec::reed_solomon.
+    bool reed_solomon = false;
+
     // What RTCP mode to use in the reports.
     RtcpMode rtcp_mode = RtcpMode::kCompound;
 
@@ -22,6 +22,7 @@
 #include "call/flexfec_receive_stream.h"
 #include "call/rtp_stream_receiver_controller_interface.h"
 #include "modules/rtp_rtcp/include/flexfec_receiver.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_receiver.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -41,6 +42,8 @@ std::string FlexfecReceiveStream::Config::ToString() const {
     ss << protected_media_ssrcs[i] << ", ";
   if (!protected_media_ssrcs.empty())
     ss << protected_media_ssrcs[i];
+  if (reed_solomon)
+    ss << ", reed_solomon";
   ss << "}";
   return ss.str();
 }
@@ -61,15 +64,12 @@ bool FlexfecReceiveStream::Config::IsCompleteAndEnabled() const {
 namespace {
 
 // TODO(brandtr): Update this function when we support multistream protection.
-std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
-    Clock* clock,
-    const FlexfecReceiveStream::Config& config,
-    RecoveredPacketReceiver* recovered_packet_receiver) {
+bool ShouldCreateReceiver(const FlexfecReceiveStream::Config& config) {
   if (config.payload_type < 0) {
     RTC_LOG(LS_WARNING)
         << "Invalid FlexFEC payload type given. "
            "This FlexfecReceiveStream will therefore be useless.";
-    return nullptr;
+    return false;
   }
   RTC_DCHECK_GE(config.payload_type, 0);
   RTC_DCHECK_LE(config.payload_type, 127);
@@ -77,13 +77,13 @@ std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
     RTC_LOG(LS_WARNING)
         << "Invalid FlexFEC SSRC given. "
            "This FlexfecReceiveStream will therefore be useless.";
-    return nullptr;
+    return false;
   }
   if (config.protected_media_ssrcs.empty()) {
     RTC_LOG(LS_WARNING)
         << "No protected media SSRC supplied. "
            "This FlexfecReceiveStream will therefore be useless.";
-    return nullptr;
+    return false;
   }
 
   if (config.protected_media_ssrcs.size() > 1) {
@@ -92,14 +92,36 @@ std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
            "media streams, but our implementation currently only "
            "supports protecting a single media stream. "
            "To avoid confusion, disabling FlexFEC completely.";
-    return nullptr;
+    return false;
   }
   RTC_DCHECK_EQ(1U, config.protected_media_ssrcs.size());
+  return true;
+}
+
+std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
+    Clock* clock,
+    const FlexfecReceiveStream::Config& config,
+    RecoveredPacketReceiver* recovered_packet_receiver) {
+  if (config.reed_solomon || !ShouldCreateReceiver(config)) {
+    return nullptr;
+  }
   return std::unique_ptr<FlexfecReceiver>(new FlexfecReceiver(
       clock, config.rtp.remote_ssrc, config.protected_media_ssrcs[0],
       recovered_packet_receiver));
 }
 
+std::unique_ptr<ReedSolomonFecReceiver> MaybeCreateReedSolomonFecReceiver(
+    Clock* clock,
+    const FlexfecReceiveStream::Config& config,
+    RecoveredPacketReceiver* recovered_packet_receiver) {
+  if (!config.reed_solomon || !ShouldCreateReceiver(config)) {
+    return nullptr;
+  }
+  return std::make_unique<ReedSolomonFecReceiver>(
+      clock, config.rtp.remote_ssrc, config.protected_media_ssrcs[0],
+      recovered_packet_receiver);
+}
+
 }  // namespace
 
 FlexfecReceiveStreamImpl::FlexfecReceiveStreamImpl(
@@ -112,6 +134,10 @@ FlexfecReceiveStreamImpl::FlexfecReceiveStreamImpl(
       receiver_(MaybeCreateFlexfecReceiver(&env.clock(),
                                            config,
                                            recovered_packet_receiver)),
+      reed_solomon_receiver_(
+          MaybeCreateReedSolomonFecReceiver(&env.clock(),
+                                            config,
+                                            recovered_packet_receiver)),
       rtp_receive_statistics_(ReceiveStatistics::Create(&env.clock())),
       rtp_rtcp_(env,
                 {.audio = false,
@@ -138,7 +164,7 @@ void FlexfecReceiveStreamImpl::RegisterWithTransport(
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   RTC_DCHECK(!rtp_stream_receiver_);
 
-  if (!receiver_)
+  if (!receiver_ && !reed_solomon_receiver_)
     return;
 
   // TODO(nisse): OnRtpPacket in this class delegates all real work to
@@ -156,10 +182,13 @@ void FlexfecReceiveStreamImpl::UnregisterFromTransport() {
 
 void FlexfecReceiveStreamImpl::OnRtpPacket(const RtpPacketReceived& packet) {
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
-  if (!receiver_)
+  if (receiver_) {
+    receiver_->OnRtpPacket(packet);
+  } else if (reed_solomon_receiver_) {
+    reed_solomon_receiver_->OnRtpPacket(packet);
+  } else {
     return;
-
-  receiver_->OnRtpPacket(packet);
+  }
 
   // Do not report media packets in the RTCP RRs generated by `rtp_rtcp_`.
   if (packet.Ssrc() == remote_ssrc()) {
@@ -154,7 +154,10 @@ std::string RtpConfig::ToString() const {
     if (i != flexfec.protected_media_ssrcs.size() - 1)
       ss << ", ";
   }
-  ss << "]}";
+  ss << "]";
+  if (flexfec.reed_solomon)
+    ss << ", reed_solomon";
+  ss << "}";
 
   ss << ", rtx: " << rtx.ToString();
   ss << ", c_name: " << c_name;
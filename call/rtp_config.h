@@ -163,6 +163,11 @@ struct RtpConfig {
     // TODO(brandtr): Update comment above when we support
     // multistream protection.
     std::vector<uint32_t> protected_media_ssrcs;
+
+    // Send the Reed-Solomon FEC scheme (ReedSolomonFecSender) on the FlexFEC
+    // SSRC and payload type instead of FlexFEC. It is not negotiated in SDP,
+    // so the receiving FlexfecReceiveStream must be configured to match.
+    bool reed_solomon = false;
   } flexfec;
 
   // Settings for RTP retransmission payload format, see RFC 4588 for
@@ -31,6 +31,7 @@
 #include "api/task_queue/task_queue_base.h"
 #include "api/transport/bandwidth_estimation_settings.h"
 #include "api/transport/bitrate_settings.h"
+#include "api/transport/ecn_marking.h"
 #include "api/transport/goog_cc_factory.h"
 #include "api/transport/network_control.h"
 #include "api/transport/network_types.h"
@@ -123,6 +124,8 @@ RtpTransportControllerSend::RtpTransportControllerSend(
           "WebRTC-AddPacingToCongestionWindowPushback")),
       reset_bwe_on_adapter_id_change_(
           env_.field_trials().IsEnabled("WebRTC-Bwe-ResetOnAdapterIdChange")),
+      send_rtp_packets_as_ect1_(
+          env_.field_trials().IsEnabled("WebRTC-Bwe-L4s")),
       relay_bandwidth_cap_("relay_cap", DataRate::PlusInfinity()),
       transport_overhead_bytes_per_packet_(0),
       network_available_(false),
@@ -408,6 +411,8 @@ void RtpTransportControllerSend::OnNetworkRouteChanged(
     if (reset_feedback_on_route_change_) {
       transport_feedback_adapter_.SetNetworkRoute(network_route);
     }
+    // The new path may preserve ECN marks even if the old one did not.
+    ect1_marking_failed_ = false;
     if (controller_) {
       PostUpdates(controller_->OnNetworkRouteChange(msg));
     } else {
@@ -670,6 +675,7 @@ void RtpTransportControllerSend::OnCongestionControlFeedback(
       transport_feedback_adapter_.ProcessCongestionControlFeedback(
           feedback, receive_time);
   if (feedback_msg) {
+    UpdateEct1Marking(*feedback_msg);
     if (controller_)
       PostUpdates(controller_->OnTransportPacketsFeedback(*feedback_msg));
 
@@ -678,6 +684,33 @@ void RtpTransportControllerSend::OnCongestionControlFeedback(
   }
 }
 
+void RtpTransportControllerSend::UpdateEct1Marking(
+    const TransportPacketsFeedback& feedback) {
+  if (!send_rtp_packets_as_ect1_ || ect1_marking_failed_) {
+    return;
+  }
+  if (ect1_marking_start_.IsPlusInfinity()) {
+    // The remote end sends RFC 8888 feedback and thus reports ECN marks.
+    RTC_LOG(LS_INFO) << "Start sending RTP packets as ECT(1).";
+    ect1_marking_start_ = feedback.feedback_time;
+    packet_router_.SetSendRtpPacketsAsEct1(true);
+    return;
+  }
+  for (const PacketResult& packet : feedback.packet_feedbacks) {
+    if (packet.IsReceived() &&
+        packet.sent_packet.send_time > ect1_marking_start_ &&
+        (packet.ecn == EcnMarking::kNotEct ||
+         packet.ecn == EcnMarking::kEct0)) {
+      RTC_LOG(LS_WARNING) << "ECT(1) marks are not preserved on the path, "
+                             "stop sending RTP packets as ECT(1).";
+      ect1_marking_failed_ = true;
+      ect1_marking_start_ = Timestamp::PlusInfinity();
+      packet_router_.SetSendRtpPacketsAsEct1(false);
+      return;
+    }
+  }
+}
+
 void RtpTransportControllerSend::OnRemoteNetworkEstimate(
     NetworkStateEstimate estimate) {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
@@ -170,6 +170,10 @@ class RtpTransportControllerSend final
   void UpdateCongestedState() RTC_RUN_ON(sequence_checker_);
   std::optional<bool> GetCongestedStateUpdate() const
       RTC_RUN_ON(sequence_checker_);
+  // Starts marking RTP packets as ECT(1) once RFC 8888 feedback is received
+  // and stops if the feedback shows that the marks do not reach the receiver.
+  void UpdateEct1Marking(const TransportPacketsFeedback& feedback)
+      RTC_RUN_ON(sequence_checker_);
 
   // Called by packet router just before packet is sent to the RTP modules.
   void NotifyBweOfPacedSentPacket(const RtpPacketToSend& packet,
@@ -229,6 +233,13 @@ class RtpTransportControllerSend final
   const bool reset_feedback_on_route_change_;
   const bool add_pacing_to_cwin_;
   const bool reset_bwe_on_adapter_id_change_;
+  const bool send_rtp_packets_as_ect1_;
+  // Send time from which RTP packets are marked as ECT(1), PlusInfinity if
+  // packets are not marked.
+  Timestamp ect1_marking_start_ RTC_GUARDED_BY(sequence_checker_) =
+      Timestamp::PlusInfinity();
+  // Set if the path or the receiver does not preserve ECT(1) marks.
+  bool ect1_marking_failed_ RTC_GUARDED_BY(sequence_checker_) = false;
 
   FieldTrialParameter<DataRate> relay_bandwidth_cap_;
 
@@ -55,6 +55,7 @@
 #include "modules/include/module_fec_types.h"
 #include "modules/pacing/packet_router.h"
 #include "modules/rtp_rtcp/include/flexfec_sender.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_impl2.h"
 #include "modules/rtp_rtcp/source/rtp_sender.h"
@@ -203,6 +204,12 @@ std::unique_ptr<VideoFecGenerator> MaybeCreateFecGenerator(
     }
 
     RTC_DCHECK_EQ(1U, rtp.flexfec.protected_media_ssrcs.size());
+    if (rtp.flexfec.reed_solomon) {
+      return std::make_unique<ReedSolomonFecSender>(
+          env, rtp.flexfec.payload_type, rtp.flexfec.ssrc,
+          rtp.flexfec.protected_media_ssrcs[0], rtp.mid, rtp.extensions,
+          RTPSender::FecExtensionSizes(), rtp_state);
+    }
     return std::make_unique<FlexfecSender>(
         env, rtp.flexfec.payload_type, rtp.flexfec.ssrc,
         rtp.flexfec.protected_media_ssrcs[0], rtp.mid, rtp.extensions,
@@ -308,9 +315,13 @@ std::vector<RtpStreamSender> CreateRtpStreamSenders(
         !video_config.field_trials->IsDisabled(
             "WebRTC-Video-EnableRetransmitAllLayers");
 
+    // Reed-Solomon FEC is sent on the FlexFEC stream, so it takes priority
+    // over RED+ULPFEC the same way.
     const bool using_flexfec =
         fec_generator &&
-        fec_generator->GetFecType() == VideoFecGenerator::FecType::kFlexFec;
+        (fec_generator->GetFecType() == VideoFecGenerator::FecType::kFlexFec ||
+         fec_generator->GetFecType() ==
+             VideoFecGenerator::FecType::kReedSolomon);
     const bool should_disable_red_and_ulpfec = ShouldDisableRedAndUlpfec(
         using_flexfec, rtp_config, env.field_trials());
     if (!should_disable_red_and_ulpfec &&
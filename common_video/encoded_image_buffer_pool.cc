@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+namespace {
+bool HasOneRef(const rtc::scoped_refptr<EncodedImageBuffer>& buffer) {
+  // Cast to RefCountedObject is safe because this function is only called on
+  // buffers created by the pool with make_ref_counted.
+  return static_cast<RefCountedObject<EncodedImageBuffer>*>(buffer.get())
+      ->HasOneRef();
+}
+}  // namespace
+
+EncodedImageBufferPool::EncodedImageBufferPool()
+    : EncodedImageBufferPool(kDefaultMaxNumberOfBuffers) {}
+
+EncodedImageBufferPool::EncodedImageBufferPool(size_t max_number_of_buffers)
+    : max_number_of_buffers_(max_number_of_buffers) {}
+
+EncodedImageBufferPool::~EncodedImageBufferPool() = default;
+
+void EncodedImageBufferPool::Release() {
+  buffers_.clear();
+}
+
+rtc::scoped_refptr<EncodedImageBuffer> EncodedImageBufferPool::CreateBuffer(
+    size_t size) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  for (const rtc::scoped_refptr<EncodedImageBuffer>& buffer : buffers_) {
+    // If the ref count is 1, the list holds the only reference and it is safe
+    // to reuse the buffer. Resizing keeps the capacity of the buffer, so this
+    // only allocates if the frame is larger than any frame it held before.
+    if (HasOneRef(buffer)) {
+      buffer->Realloc(size);
+      return buffer;
+    }
+  }
+
+  if (buffers_.size() >= max_number_of_buffers_) {
+    return EncodedImageBuffer::Create(size);
+  }
+  rtc::scoped_refptr<EncodedImageBuffer> buffer =
+      make_ref_counted<EncodedImageBuffer>(size);
+  buffers_.push_back(buffer);
+  return buffer;
+}
+
+}  // namespace webrtc
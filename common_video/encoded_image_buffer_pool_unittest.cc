@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(EncodedImageBufferPoolTest, ReusesReleasedBuffer) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(1000);
+  EXPECT_EQ(buffer->size(), 1000u);
+  const uint8_t* data = buffer->data();
+  buffer = nullptr;
+
+  // A smaller frame fits in the capacity of the released buffer.
+  buffer = pool.CreateBuffer(500);
+  EXPECT_EQ(buffer->size(), 500u);
+  EXPECT_EQ(buffer->data(), data);
+  EXPECT_EQ(pool.size(), 1u);
+}
+
+TEST(EncodedImageBufferPoolTest, DoesNotReuseBufferInUse) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer1 = pool.CreateBuffer(100);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer2 = pool.CreateBuffer(100);
+  EXPECT_NE(buffer1.get(), buffer2.get());
+  EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(EncodedImageBufferPoolTest, GrowsReusedBuffer) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBuffer> buffer = pool.CreateBuffer(10);
+  memset(buffer->data(), 0xAB, buffer->size());
+  EncodedImageBuffer* raw_buffer = buffer.get();
+  buffer = nullptr;
+
+  buffer = pool.CreateBuffer(100'000);
+  EXPECT_EQ(buffer.get(), raw_buffer);
+  ASSERT_EQ(buffer->size(), 100'000u);
+  // All of the new size is writable.
+  memset(buffer->data(), 0, buffer->size());
+}
+
+TEST(EncodedImageBufferPoolTest, AllocatesOutsidePoolWhenFull) {
+  EncodedImageBufferPool pool(/*max_number_of_buffers=*/1);
+  rtc::scoped_refptr<EncodedImageBuffer> pooled = pool.CreateBuffer(100);
+  rtc::scoped_refptr<EncodedImageBuffer> not_pooled = pool.CreateBuffer(100);
+  ASSERT_TRUE(not_pooled);
+  EXPECT_NE(pooled.get(), not_pooled.get());
+  EXPECT_EQ(pool.size(), 1u);
+
+  // The buffer outside of the pool is never handed out again.
+  EncodedImageBuffer* raw_not_pooled = not_pooled.get();
+  not_pooled = nullptr;
+  pooled = nullptr;
+  EXPECT_NE(pool.CreateBuffer(100).get(), raw_not_pooled);
+}
+
+TEST(EncodedImageBufferPoolTest, BufferValidAfterPoolDestruction) {
+  rtc::scoped_refptr<EncodedImageBuffer> buffer;
+  {
+    EncodedImageBufferPool pool;
+    buffer = pool.CreateBuffer(100);
+  }
+  EXPECT_EQ(buffer->size(), 100u);
+  memset(buffer->data(), 0, buffer->size());
+}
+
+}  // namespace webrtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+#define COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include <list>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "rtc_base/race_checker.h"
+
+namespace webrtc {
+
+// Buffer pool for encoded frames on the receive path, so that assembling a
+// frame from its RTP payloads does not allocate once the pool is warm. The
+// pool keeps a reference to every buffer it creates; a buffer is reused when
+// the pool holds the only reference, i.e. when the frame has been decoded or
+// dropped. Reused buffers keep their capacity, so after a few key frames the
+// pool serves frames of any size without reallocating.
+class EncodedImageBufferPool {
+ public:
+  static constexpr size_t kDefaultMaxNumberOfBuffers = 64;
+
+  EncodedImageBufferPool();
+  explicit EncodedImageBufferPool(size_t max_number_of_buffers);
+  ~EncodedImageBufferPool();
+
+  // Returns a buffer of `size` bytes with unspecified content. If all
+  // `max_number_of_buffers` pooled buffers are in use, e.g. because many
+  // frames are waiting in the jitter buffer, a buffer that is not pooled is
+  // returned.
+  rtc::scoped_refptr<EncodedImageBuffer> CreateBuffer(size_t size);
+
+  // Number of buffers owned by the pool, in use or not.
+  size_t size() const { return buffers_.size(); }
+
+  // Drops the pool's references. Buffers that are in use stay valid.
+  void Release();
+
+ private:
+  rtc::RaceChecker race_checker_;
+  std::list<rtc::scoped_refptr<EncodedImageBuffer>> buffers_;
+  const size_t max_number_of_buffers_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
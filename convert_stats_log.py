@@ -0,0 +1,114 @@
+import os
+import struct
+import sys
+
+# Converts the binary stats log written by the peerconnection client with
+# --stats_log_format=binary (stats.bin) back into the per_frame_stats.csv and
+# average_stats.csv files that analyze_log.py and simple_analysis.py read.
+#
+# Layout (little-endian), see examples/peerconnection/client/stats_log_writer.h:
+#   file   := b"WRTCSTAT" | uint32 version | record*
+#   record := uint32 payload_size | uint8 type | payload[payload_size - 1]
+
+MAGIC = b"WRTCSTAT"
+SUPPORTED_VERSION = 1
+
+RECORD_PER_FRAME = 1
+RECORD_AVERAGE = 2
+
+PER_FRAME_HEADER = ("timestamp_ms,rtp_timestamp,encoding_ms,network_ms,decoding_ms,"
+                    "rendering_ms,e2e_ms,inter_frame_ms,intra_construction_ms\n")
+PER_FRAME_FORMAT = struct.Struct("<qIqqqqqqq")
+
+# Rolling latency percentiles follow the decoder name, one double per metric
+# and quantile; see LatencyMetric in stats_log_writer.h. Older logs end at the
+# name and get empty percentile columns.
+LATENCY_METRICS = ("encoding", "network", "decoding", "rendering", "e2e")
+LATENCY_QUANTILES = ("p0.1", "p1", "p5", "p50", "p95", "p99", "p99.9")
+LATENCY_COLUMNS = [f"{metric}_ms_{quantile}" for metric in LATENCY_METRICS
+                   for quantile in LATENCY_QUANTILES]
+LATENCY_FORMAT = struct.Struct("<" + "d" * len(LATENCY_COLUMNS))
+
+AVERAGE_HEADER = ("timestamp_ms,frames_decoded,frames_dropped,frames_received,"
+                  "framerate,jitter_buffer_delay_ms,video_width,video_height,"
+                  "total_decode_time_ms,total_bytes_received,bitrates,"
+                  "overall_avg_bitrates,decoder_implementation," +
+                  ",".join(LATENCY_COLUMNS) + "\n")
+AVERAGE_FORMAT = struct.Struct("<qdddddqqdqdd")
+
+
+def format_number(value):
+    # Match the "%g" formatting the CSV writer uses.
+    if isinstance(value, float):
+        return "%g" % value
+    return str(value)
+
+
+def read_records(data):
+    if data[:len(MAGIC)] != MAGIC:
+        raise ValueError("Not a stats log file (bad magic)")
+    offset = len(MAGIC)
+    (version,) = struct.unpack_from("<I", data, offset)
+    if version > SUPPORTED_VERSION:
+        raise ValueError(f"Unsupported stats log version {version}")
+    offset += 4
+
+    while offset + 4 <= len(data):
+        (payload_size,) = struct.unpack_from("<I", data, offset)
+        offset += 4
+        if payload_size == 0 or offset + payload_size > len(data):
+            print(f"Warning: truncated record at offset {offset - 4}, stopping.")
+            return
+        record_type = data[offset]
+        yield record_type, data[offset + 1:offset + payload_size]
+        offset += payload_size
+
+
+def convert(input_path, output_dir):
+    with open(input_path, "rb") as f:
+        data = f.read()
+
+    per_frame_path = os.path.join(output_dir, "per_frame_stats.csv")
+    average_path = os.path.join(output_dir, "average_stats.csv")
+    per_frame_rows = 0
+    average_rows = 0
+    with open(per_frame_path, "w") as per_frame, open(average_path, "w") as average:
+        per_frame.write(PER_FRAME_HEADER)
+        average.write(AVERAGE_HEADER)
+        for record_type, payload in read_records(data):
+            if record_type == RECORD_PER_FRAME:
+                fields = PER_FRAME_FORMAT.unpack_from(payload)
+                per_frame.write(",".join(str(v) for v in fields) + "\n")
+                per_frame_rows += 1
+            elif record_type == RECORD_AVERAGE:
+                fields = AVERAGE_FORMAT.unpack_from(payload)
+                offset = AVERAGE_FORMAT.size
+                name_length = payload[offset]
+                name = payload[offset + 1:offset + 1 + name_length].decode(
+                    "utf-8", errors="replace")
+                offset += 1 + name_length
+                if len(payload) >= offset + LATENCY_FORMAT.size:
+                    latency = ",".join(
+                        format_number(v)
+                        for v in LATENCY_FORMAT.unpack_from(payload, offset))
+                else:
+                    latency = "," * (len(LATENCY_COLUMNS) - 1)
+                average.write(",".join(format_number(v) for v in fields) +
+                              "," + name + "," + latency + "\n")
+                average_rows += 1
+            # Unknown record types are skipped; newer writers may add more.
+
+    print(f"Wrote {per_frame_rows} rows to {per_frame_path}")
+    print(f"Wrote {average_rows} rows to {average_path}")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("Usage: python convert_stats_log.py <stats.bin> [output_dir]")
+        print("Example: python convert_stats_log.py webrtc_logs/<run>/receiver/stats.bin")
+        sys.exit(1)
+
+    input_path = sys.argv[1]
+    output_dir = sys.argv[2] if len(sys.argv) > 2 else os.path.dirname(
+        os.path.abspath(input_path))
+    convert(input_path, output_dir)
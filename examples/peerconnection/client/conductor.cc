@@ -51,6 +51,7 @@
 #include "api/video_codecs/video_encoder_factory_template_open_h264_adapter.h"
 #include "api/video/video_timing.h"
 #include "examples/peerconnection/client/defaults.h"
+#include "examples/peerconnection/client/frame_timing_sinks.h"
 #include "examples/peerconnection/client/main_wnd.h"
 #include "examples/peerconnection/client/peer_connection_client.h"
 #include "json/reader.h"
@@ -66,7 +67,6 @@
 #include "test/frame_generator_capturer.h"
 #include "test/platform_video_capturer.h"
 #include "test/test_video_capturer.h"
-#include "test/testsupport/y4m_frame_generator.h"
 
 #include <stdlib.h>  // C-style header instead of <cstdlib>
 #include <ctime>
@@ -149,18 +149,6 @@ class CapturerTrackSource : public webrtc::VideoTrackSource {
 
 }  // namespace
 
-// y4m reader
-class Y4mVideoSource : public webrtc::VideoTrackSource {
- public:
-  explicit Y4mVideoSource(std::unique_ptr<webrtc::test::FrameGeneratorCapturer> capturer)
-      : VideoTrackSource(/*remote=*/false), capturer_(std::move(capturer)) {}  // Changed Y4mVideoTrackSource to VideoTrackSource
- protected:
-  rtc::VideoSourceInterface<webrtc::VideoFrame>* source() override {
-    return capturer_.get();
-  }
- private:
-  std::unique_ptr<webrtc::test::FrameGeneratorCapturer> capturer_;
-};
 
 
 
@@ -217,7 +205,7 @@ private:
 };
 */
 
-bool Conductor::curl_initialized_ = false;
+int Conductor::curl_users_ = 0;
 
 Conductor::Conductor(PeerConnectionClient* client, MainWindow* main_wnd, bool headless)
     : peer_id_(-1), loopback_(false), client_(client), main_wnd_(main_wnd), curl_(nullptr), headless_(headless), 
@@ -238,6 +226,22 @@ bool Conductor::connection_active() const {
   return peer_connection_ != nullptr;
 }
 
+bool Conductor::media_connected() const {
+  return peer_connection_ &&
+         peer_connection_->peer_connection_state() ==
+             webrtc::PeerConnectionInterface::PeerConnectionState::kConnected;
+}
+
+void Conductor::SetSharedMedia(
+    rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory,
+    rtc::scoped_refptr<FileVideoSource> video_source,
+    webrtc::TaskQueueFactory* task_queue_factory) {
+  shared_peer_connection_factory_ = std::move(factory);
+  file_video_source_ = std::move(video_source);
+  shared_video_source_ = file_video_source_ != nullptr;
+  task_queue_factory_ = task_queue_factory;
+}
+
 void Conductor::Close() {
   client_->SignOut();
   DeletePeerConnection();
@@ -253,17 +257,19 @@ size_t Conductor::WriteCallback(void* contents, size_t size, size_t nmemb, void*
 
 // In Conductor.cpp add the initialization code:
 bool Conductor::InitializeCurl() {
-    if (!curl_initialized_) {
-        curl_global_init(CURL_GLOBAL_ALL);
-        curl_initialized_ = true;
-    }
-
     if (!curl_) {
+        if (curl_users_ == 0) {
+            curl_global_init(CURL_GLOBAL_ALL);
+        }
         curl_ = curl_easy_init();
         if (!curl_) {
             RTC_LOG(LS_ERROR) << "Failed to initialize CURL";
+            if (curl_users_ == 0) {
+                curl_global_cleanup();
+            }
             return false;
         }
+        ++curl_users_;
     }
     
     return true;
@@ -274,11 +280,9 @@ void Conductor::CleanupCurl() {
     if (curl_) {
         curl_easy_cleanup(curl_);
         curl_ = nullptr;
-    }
-    
-    if (curl_initialized_) {
-        curl_global_cleanup();
-        curl_initialized_ = false;
+        if (--curl_users_ == 0) {
+            curl_global_cleanup();
+        }
     }
 }
 
@@ -287,6 +291,17 @@ bool Conductor::InitializePeerConnection() {
   RTC_DCHECK(!peer_connection_factory_);
   RTC_DCHECK(!peer_connection_);
 
+  if (shared_peer_connection_factory_) {
+    peer_connection_factory_ = shared_peer_connection_factory_;
+    if (!CreatePeerConnection()) {
+      main_wnd_->MessageBox("Error", "CreatePeerConnection failed", true);
+      DeletePeerConnection();
+      return false;
+    }
+    AddTracks();
+    return true;
+  }
+
   if (!signaling_thread_.get()) {
     signaling_thread_ = rtc::Thread::CreateWithSocketServer();
     signaling_thread_->Start();
@@ -422,6 +437,10 @@ bool Conductor::CreatePeerConnection() {
   config.continual_gathering_policy = 
       webrtc::PeerConnectionInterface::GATHER_CONTINUALLY;
 
+  config.media_config.video.enable_send_packet_batching =
+      send_packet_batching_;
+  config.enable_decode_thread_pool = decode_thread_pool_;
+
   // Logging
   config.logging_folder = log_dir_; 
 
@@ -435,10 +454,8 @@ bool Conductor::CreatePeerConnection() {
 
 
   // Set port range in configuration
-  const int kMinPort = 50000;  // Minimum port
-  const int kMaxPort = 50005;  // Maximum port
-  config.port_allocator_config.min_port = kMinPort;
-  config.port_allocator_config.max_port = kMaxPort;
+  config.port_allocator_config.min_port = min_port_;
+  config.port_allocator_config.max_port = max_port_;
 
 
   webrtc::PeerConnectionDependencies pc_dependencies(this);
@@ -453,7 +470,27 @@ bool Conductor::CreatePeerConnection() {
 
 
 void Conductor::DeletePeerConnection() {
-  stats_collector_->Stop();
+  if (stats_collector_) {
+    stats_collector_->Stop();
+  }
+  if (frame_timing_recorder_) {
+    ReleaseDecodedFrameTimingSink(frame_timing_recorder_.get());
+    frame_timing_recorder_->Stop();
+  }
+  if (sent_frame_timing_recorder_) {
+    ReleaseSentFrameTimingSink(sent_frame_timing_recorder_.get());
+    sent_frame_timing_recorder_->Stop();
+  }
+  if (file_video_source_ && !shared_video_source_) {
+    FrameScheduler::Stats pacing = file_video_source_->GetPacingStats();
+    RTC_LOG(LS_INFO) << "Y4M pacing: delivered " << pacing.frames_delivered
+                     << ", skipped " << pacing.frames_skipped << ", late "
+                     << pacing.frames_late << ", max lateness "
+                     << pacing.max_lateness.ms() << " ms";
+  }
+  if (!shared_video_source_) {
+    file_video_source_ = nullptr;
+  }
   
   main_wnd_->StopLocalRenderer();
   main_wnd_->StopRemoteRenderer();
@@ -844,7 +881,8 @@ void Conductor::StartLogin(const std::string& server, int port) {
     res = curl_easy_perform(curl_);
     if(res != CURLE_OK) {
       RTC_LOG(LS_ERROR) << "curl_easy_perform() failed: " << curl_easy_strerror(res);
-      curl_easy_cleanup(curl_);
+      curl_slist_free_all(headers);
+      CleanupCurl();
       return;
     }
     curl_slist_free_all(headers);
@@ -1053,47 +1091,29 @@ void Conductor::AddTracks() {
   }
 
   // Try Y4M first if path is provided
-  if (!y4m_path_.empty()) {
-    RTC_LOG(LS_INFO) << "Attempting to use Y4M file from path: " << y4m_path_;
-    
-    std::unique_ptr<webrtc::test::Y4mFrameGenerator> frame_generator(
-        new webrtc::test::Y4mFrameGenerator(
-            y4m_path_,
-            webrtc::test::Y4mFrameGenerator::RepeatMode::kLoop
-        ));
-
-    if (frame_generator) {
-      auto resolution = frame_generator->GetResolution();
-      const int kTargetFps = frame_generator->fps().value_or(30);
-      
-      auto video_capturer = std::make_unique<webrtc::test::FrameGeneratorCapturer>(
-          webrtc::Clock::GetRealTimeClock(),
-          std::move(frame_generator),
-          kTargetFps,
-          *task_queue_factory_
-      );
-
-      if (video_capturer) {
-        video_capturer->Start();
-        rtc::scoped_refptr<Y4mVideoSource> video_source = 
-            rtc::make_ref_counted<Y4mVideoSource>(std::move(video_capturer));
-            
-        rtc::scoped_refptr<webrtc::VideoTrackInterface> video_track =
-            peer_connection_factory_->CreateVideoTrack(kVideoLabel, video_source.get());
-
-        if (!headless_) {
-          main_wnd_->StartLocalRenderer(video_track.get());
-        }
+  if (shared_video_source_ || !y4m_path_.empty()) {
+    if (!shared_video_source_) {
+      RTC_LOG(LS_INFO) << "Attempting to use Y4M file from path: " << y4m_path_;
+      file_video_source_ = FileVideoSource::Create(
+          y4m_path_, /*target_fps=*/0, *task_queue_factory_, frame_pacing_,
+          y4m_read_mode_);
+    }
 
-        auto result_or_error = peer_connection_->AddTrack(video_track, {kStreamId});
-        if (result_or_error.ok()) {
-          use_camera = false;  // Successfully using Y4M
-          RTC_LOG(LS_INFO) << "Successfully initialized Y4M video source";
-        } else {
-          RTC_LOG(LS_WARNING) << "Failed to add Y4M track to peer connection. Falling back to camera.";
-        }
+    if (file_video_source_) {
+      rtc::scoped_refptr<webrtc::VideoTrackInterface> video_track =
+          peer_connection_factory_->CreateVideoTrack(kVideoLabel,
+                                                     file_video_source_.get());
+
+      if (!headless_) {
+        main_wnd_->StartLocalRenderer(video_track.get());
+      }
+
+      auto result_or_error = peer_connection_->AddTrack(video_track, {kStreamId});
+      if (result_or_error.ok()) {
+        use_camera = false;  // Successfully using Y4M
+        RTC_LOG(LS_INFO) << "Successfully initialized Y4M video source";
       } else {
-        RTC_LOG(LS_WARNING) << "Failed to create Y4M video capturer. Falling back to camera.";
+        RTC_LOG(LS_WARNING) << "Failed to add Y4M track to peer connection. Falling back to camera.";
       }
 
       // Configure RTP encoding parameters for high quality
@@ -1125,7 +1145,8 @@ void Conductor::AddTracks() {
             codec.parameters["level-asymmetry-allowed"] = "1";
             // For 4K support
             codec.parameters["max-mbps"] = "972000";
-            codec.parameters["max-fs"] = std::to_string((resolution.width * resolution.height) / 256);
+            codec.parameters["max-fs"] = std::to_string(
+                (file_video_source_->width() * file_video_source_->height()) / 256);
 
             RTC_LOG(LS_INFO) << "Configured H264 parameters:";
             for (const auto& param : codec.parameters) {
@@ -1161,7 +1182,7 @@ void Conductor::AddTracks() {
         }
       }
     } else {
-      RTC_LOG(LS_WARNING) << "Failed to create Y4M frame generator. Falling back to camera.";
+      RTC_LOG(LS_WARNING) << "Failed to open Y4M file. Falling back to camera.";
     }
   }
 
@@ -1189,6 +1210,8 @@ void Conductor::AddTracks() {
       RTC_LOG(LS_ERROR) << "OpenVideoCaptureDevice failed";
     }
   }
+  StartSentFrameTiming();
+
   //main_wnd_->SwitchToStreamingUI();
   // juheon added: turn on streaming UI when not in headless mode
   if(headless_){
@@ -1431,10 +1454,60 @@ void Conductor::GetReceiverVideoStats() {
 
     // Start collection if not already running
     if (!stats_collector_->IsRunning()) {
-        if (stats_collector_->Start(log_dir_, peer_connection_)) {
+        stats_collector_->set_write_per_frame(per_frame_stats_);
+        stats_collector_->set_stats_interval_ms(stats_interval_ms_);
+        if (stats_collector_->Start(log_dir_, peer_connection_,
+                                    stats_log_format_)) {
             RTC_LOG(LS_INFO) << "Started stats collection to " << log_dir_;
         } else {
             RTC_LOG(LS_ERROR) << "Failed to start stats collection";
         }
     }
-}
\ No newline at end of file
+
+    // Per-frame timing is pushed from the decoder rather than polled, so it
+    // covers every frame instead of one sample per stats interval.
+    if (!record_frame_timing_) {
+        return;
+    }
+    if (!frame_timing_recorder_) {
+        frame_timing_recorder_ = std::make_unique<FrameTimingRecorder>();
+        // The latency percentiles are computed over every decoded frame.
+        // The recorder is stopped, or destroyed, before the collector.
+        frame_timing_recorder_->set_frame_callback(
+            [collector = stats_collector_.get()](
+                const webrtc::TimingFrameInfo& timing) {
+                collector->AddFrameTiming(timing);
+            });
+    }
+    if (!frame_timing_recorder_->IsRunning()) {
+        if (!frame_timing_recorder_->Start(log_dir_)) {
+            RTC_LOG(LS_ERROR) << "Failed to start frame timing recorder";
+        } else if (!ClaimDecodedFrameTimingSink(
+                       frame_timing_recorder_.get())) {
+            RTC_LOG(LS_WARNING) << "Decoded frame timing sink is owned by "
+                                   "another connection, not recording "
+                                   "per-frame timing";
+            frame_timing_recorder_->Stop();
+            record_frame_timing_ = false;
+        }
+    }
+}
+
+// Pairs with the receiver's frame_timing.csv through join_frame_timing.py.
+void Conductor::StartSentFrameTiming() {
+  if (log_dir_.empty() || !record_frame_timing_) {
+    return;
+  }
+  if (!sent_frame_timing_recorder_) {
+    sent_frame_timing_recorder_ = std::make_unique<SentFrameTimingRecorder>();
+  }
+  if (!sent_frame_timing_recorder_->IsRunning()) {
+    if (!sent_frame_timing_recorder_->Start(log_dir_)) {
+      RTC_LOG(LS_ERROR) << "Failed to start sent frame timing recorder";
+    } else if (!ClaimSentFrameTimingSink(sent_frame_timing_recorder_.get())) {
+      RTC_LOG(LS_WARNING) << "Sent frame timing sink is owned by another "
+                             "connection, not recording per-frame timing";
+      sent_frame_timing_recorder_->Stop();
+    }
+  }
+}
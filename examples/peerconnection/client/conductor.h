@@ -29,7 +29,11 @@
 #include "examples/peerconnection/client/peer_connection_client.h"
 #include "rtc_base/thread.h"
 
+#include "examples/peerconnection/client/file_video_source.h"
+#include "examples/peerconnection/client/frame_scheduler.h"
+#include "examples/peerconnection/client/frame_timing_recorder.h"
 #include "examples/peerconnection/client/rtc_stats_collector.h"
+#include "examples/peerconnection/client/sent_frame_timing_recorder.h"
 #include "examples/peerconnection/client/websocket_client.h"
 #include <curl/curl.h>
 #include "json/value.h"
@@ -88,6 +92,48 @@ class Conductor : public webrtc::PeerConnectionObserver,
 
   void SetLogDirectory(const std::string& log_dir) { log_dir_ = log_dir; }
 
+  void SetStatsLogFormat(StatsLogFormat format) { stats_log_format_ = format; }
+
+  // See RTCStatsCollector::set_write_per_frame().
+  void SetPerFrameStats(bool enabled) { per_frame_stats_ = enabled; }
+
+  // See RTCStatsCollector::set_stats_interval_ms().
+  void SetStatsIntervalMs(int interval_ms) { stats_interval_ms_ = interval_ms; }
+
+  // Records the decoded and sent timing of every frame, see
+  // frame_timing_sinks.h. The sinks are process wide, so this must be
+  // disabled when several conductors run in one process.
+  void SetRecordFrameTiming(bool enabled) { record_frame_timing_ = enabled; }
+
+  void SetFramePacing(FrameScheduler::Mode mode) { frame_pacing_ = mode; }
+
+  // Sends the video packets of each pacer burst with one sendmmsg() or UDP
+  // GSO call, see MediaConfig::Video::enable_send_packet_batching.
+  void SetSendPacketBatching(bool enabled) { send_packet_batching_ = enabled; }
+
+  // Decodes all received video streams on one shared thread pool, see
+  // RTCConfiguration::enable_decode_thread_pool.
+  void SetDecodeThreadPool(bool enabled) { decode_thread_pool_ = enabled; }
+
+  void SetY4mReadMode(FileVideoSource::ReadMode mode) { y4m_read_mode_ = mode; }
+
+  // Used by the load generator: connect through `factory` and send
+  // `video_source` instead of creating a factory and source for this
+  // conductor alone. Must be called before Start().
+  void SetSharedMedia(
+      rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory,
+      rtc::scoped_refptr<FileVideoSource> video_source,
+      webrtc::TaskQueueFactory* task_queue_factory);
+
+  // Local UDP port range for ICE candidates; 0, 0 leaves it unrestricted.
+  void SetPortRange(int min_port, int max_port) {
+    min_port_ = min_port;
+    max_port_ = max_port;
+  }
+
+  // True once the peer connection has reached the connected state.
+  bool media_connected() const;
+
  protected:
   ~Conductor();
   bool InitializePeerConnection();
@@ -190,7 +236,9 @@ class Conductor : public webrtc::PeerConnectionObserver,
 
   std::string post_url_; // For HTTP POST when initiator
 
-  static bool curl_initialized_;
+  // Number of conductors that currently hold a curl handle. curl global
+  // state is set up for the first one and torn down with the last one.
+  static int curl_users_;
   CURL* curl_ = nullptr;
   static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp);
   bool InitializeCurl();
@@ -202,14 +250,35 @@ class Conductor : public webrtc::PeerConnectionObserver,
   bool is_sender_ = true;
   std::string y4m_path_;
   std::string log_dir_;
+  StatsLogFormat stats_log_format_ = StatsLogFormat::kCsv;
+  bool per_frame_stats_ = true;
+  bool record_frame_timing_ = true;
+  int stats_interval_ms_ = 200;
+  FrameScheduler::Mode frame_pacing_ = FrameScheduler::Mode::kPaced;
+  bool send_packet_batching_ = false;
+  bool decode_thread_pool_ = false;
+  FileVideoSource::ReadMode y4m_read_mode_ =
+      FileVideoSource::ReadMode::kFromDisk;
+  rtc::scoped_refptr<FileVideoSource> file_video_source_;
+  rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface>
+      shared_peer_connection_factory_;
+  bool shared_video_source_ = false;
+  int min_port_ = 50000;
+  int max_port_ = 50005;
 
   // juheon added
   bool headless_ = false;
 
   void StopStats ();
   void GetReceiverVideoStats();
+  void StartSentFrameTiming();
 
   std::unique_ptr<RTCStatsCollector> stats_collector_;
+  // Kept alive until the conductor is destroyed, since decode callbacks may
+  // still be in flight right after the sink has been unregistered.
+  std::unique_ptr<FrameTimingRecorder> frame_timing_recorder_;
+  // The send side counterpart, kept alive for the same reason.
+  std::unique_ptr<SentFrameTimingRecorder> sent_frame_timing_recorder_;
 
   using StatsCallback = std::function<void(StatsType type, const std::string& message)>;
   using RateCallback = std::function<void(double bitrate_bps, double framerate_fps)>;
@@ -0,0 +1,517 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/emulated_call.h"
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/create_peerconnection_factory.h"
+#include "api/jsep.h"
+#include "api/make_ref_counted.h"
+#include "api/media_stream_interface.h"
+#include "api/peer_connection_interface.h"
+#include "api/rtp_transceiver_interface.h"
+#include "api/set_local_description_observer_interface.h"
+#include "api/set_remote_description_observer_interface.h"
+#include "api/test/create_network_emulation_manager.h"
+#include "api/test/create_time_controller.h"
+#include "api/test/time_controller.h"
+#include "api/video_codecs/builtin_video_decoder_factory.h"
+#include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "examples/peerconnection/client/defaults.h"
+#include "examples/peerconnection/client/frame_timing_recorder.h"
+#include "examples/peerconnection/client/frame_timing_sinks.h"
+#include "examples/peerconnection/client/sent_frame_timing_recorder.h"
+#include "examples/peerconnection/client/rtc_stats_collector.h"
+#include "modules/audio_device/include/test_audio_device.h"
+#include "p2p/base/port_allocator.h"
+#include "p2p/client/basic_port_allocator.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/thread.h"
+#include "test/network/schedulable_network_behavior.h"
+
+namespace {
+
+// Fixed seeds so that loss and jitter hit the same packets on every run.
+constexpr uint64_t kForwardLinkSeed = 1;
+constexpr uint64_t kReverseLinkSeed = 2;
+
+class LocalDescriptionObserver
+    : public webrtc::SetLocalDescriptionObserverInterface {
+ public:
+  explicit LocalDescriptionObserver(std::string peer) : peer_(std::move(peer)) {}
+
+  void OnSetLocalDescriptionComplete(webrtc::RTCError error) override {
+    if (!error.ok()) {
+      RTC_LOG(LS_ERROR) << peer_ << ": SetLocalDescription failed: "
+                        << error.message();
+    }
+  }
+
+ private:
+  const std::string peer_;
+};
+
+class RemoteDescriptionObserver
+    : public webrtc::SetRemoteDescriptionObserverInterface {
+ public:
+  RemoteDescriptionObserver(std::string peer, std::function<void()> on_success)
+      : peer_(std::move(peer)), on_success_(std::move(on_success)) {}
+
+  void OnSetRemoteDescriptionComplete(webrtc::RTCError error) override {
+    if (!error.ok()) {
+      RTC_LOG(LS_ERROR) << peer_ << ": SetRemoteDescription failed: "
+                        << error.message();
+      return;
+    }
+    if (on_success_) {
+      on_success_();
+    }
+  }
+
+ private:
+  const std::string peer_;
+  const std::function<void()> on_success_;
+};
+
+std::unique_ptr<webrtc::SessionDescriptionInterface> CopyDescription(
+    const webrtc::SessionDescriptionInterface& description) {
+  std::string sdp;
+  description.ToString(&sdp);
+  return webrtc::CreateSessionDescription(description.GetType(), sdp);
+}
+
+webrtc::EmulatedNetworkNode* CreateLinkNode(
+    webrtc::NetworkEmulationManager& network,
+    const std::string& trace_path,
+    uint64_t random_seed) {
+  if (trace_path.empty()) {
+    return network.CreateUnconstrainedEmulatedNode();
+  }
+  webrtc::network_behaviour::NetworkConfigSchedule schedule;
+  if (!ReadLinkTrace(trace_path, &schedule)) {
+    return nullptr;
+  }
+  RTC_LOG(LS_INFO) << "Link trace " << trace_path << ": "
+                   << schedule.item_size() << " entries";
+  return network.CreateEmulatedNode(
+      std::make_unique<webrtc::SchedulableNetworkBehavior>(
+          std::move(schedule), random_seed,
+          *network.time_controller()->GetClock()));
+}
+
+}  // namespace
+
+bool ReadLinkTrace(const std::string& path,
+                   webrtc::network_behaviour::NetworkConfigSchedule* schedule) {
+  std::ifstream file(path);
+  if (!file) {
+    RTC_LOG(LS_ERROR) << "Failed to open link trace " << path;
+    return false;
+  }
+
+  schedule->Clear();
+  int64_t last_time_ms = -1;
+  std::string line;
+  for (int line_number = 1; std::getline(file, line); ++line_number) {
+    std::istringstream fields(line);
+    std::string first;
+    if (!(fields >> first) || first[0] == '#') {
+      continue;
+    }
+
+    if (first == "repeat") {
+      int64_t repeat_ms = 0;
+      if (!(fields >> repeat_ms) || repeat_ms <= 0) {
+        RTC_LOG(LS_ERROR) << path << ":" << line_number
+                          << ": expected 'repeat <ms>'";
+        return false;
+      }
+      schedule->set_repeat_schedule_after_last_ms(repeat_ms);
+      continue;
+    }
+
+    int64_t time_ms = 0;
+    int64_t capacity_kbps = 0;
+    int64_t delay_ms = 0;
+    if (!absl::SimpleAtoi(first, &time_ms) ||
+        !(fields >> capacity_kbps >> delay_ms) || time_ms <= last_time_ms ||
+        capacity_kbps < 0 || delay_ms < 0) {
+      RTC_LOG(LS_ERROR) << path << ":" << line_number
+                        << ": expected '<time_ms> <capacity_kbps> <delay_ms> "
+                           "[<loss_percent> [<queue_packets>]]' in "
+                           "increasing time order";
+      return false;
+    }
+    last_time_ms = time_ms;
+
+    webrtc::network_behaviour::NetworkConfigScheduleItem* item =
+        schedule->add_item();
+    item->set_time_since_first_sent_packet_ms(time_ms);
+    item->set_link_capacity_kbps(capacity_kbps);
+    item->set_queue_delay_ms(delay_ms);
+    int64_t loss_percent = 0;
+    if (fields >> loss_percent) {
+      item->set_loss_percent(loss_percent);
+      int64_t queue_packets = 0;
+      if (fields >> queue_packets) {
+        item->set_queue_length_packets(queue_packets);
+      }
+    }
+  }
+
+  if (schedule->item().empty()) {
+    RTC_LOG(LS_ERROR) << "Link trace " << path << " has no entries";
+    return false;
+  }
+  return true;
+}
+
+// One side of the call: its own factory and worker thread on the emulated
+// network, sharing the time controller's main thread for signaling.
+class EmulatedCall::Peer : public webrtc::PeerConnectionObserver {
+ public:
+  Peer(std::string name,
+       webrtc::TimeController& time_controller,
+       webrtc::EmulatedNetworkManagerInterface& network)
+      : name_(std::move(name)),
+        time_controller_(time_controller),
+        network_(network) {}
+
+  ~Peer() override {
+    RTC_DCHECK(!peer_connection_);
+  }
+
+  bool Initialize() {
+    worker_thread_ = time_controller_.CreateThread(name_ + "_worker");
+
+    webrtc::PeerConnectionFactoryDependencies deps;
+    deps.network_thread = network_.network_thread();
+    deps.worker_thread = worker_thread_.get();
+    deps.signaling_thread = time_controller_.GetMainThread();
+    deps.task_queue_factory = time_controller_.CreateTaskQueueFactory();
+    // No audio is sent, but the engine still wants a device; the test one
+    // neither touches the sound card nor depends on wall clock time.
+    deps.adm = webrtc::TestAudioDeviceModule::Create(
+        deps.task_queue_factory.get(), /*capturer=*/nullptr,
+        /*renderer=*/nullptr);
+    deps.audio_encoder_factory = webrtc::CreateBuiltinAudioEncoderFactory();
+    deps.audio_decoder_factory = webrtc::CreateBuiltinAudioDecoderFactory();
+    deps.video_encoder_factory = webrtc::CreateBuiltinVideoEncoderFactory();
+    deps.video_decoder_factory = webrtc::CreateBuiltinVideoDecoderFactory();
+    webrtc::EnableMediaWithDefaultsAndTimeController(time_controller_, deps);
+    factory_ = webrtc::CreateModularPeerConnectionFactory(std::move(deps));
+    if (!factory_) {
+      RTC_LOG(LS_ERROR) << name_ << ": failed to create factory";
+      return false;
+    }
+
+    webrtc::PeerConnectionInterface::RTCConfiguration config;
+    config.sdp_semantics = webrtc::SdpSemantics::kUnifiedPlan;
+    config.bundle_policy =
+        webrtc::PeerConnectionInterface::kBundlePolicyMaxBundle;
+    config.rtcp_mux_policy =
+        webrtc::PeerConnectionInterface::kRtcpMuxPolicyRequire;
+
+    webrtc::PeerConnectionDependencies pc_deps(this);
+    pc_deps.allocator = std::make_unique<cricket::BasicPortAllocator>(
+        network_.network_manager(), network_.packet_socket_factory());
+    pc_deps.allocator->set_flags(pc_deps.allocator->flags() |
+                                 cricket::PORTALLOCATOR_DISABLE_TCP);
+    auto result =
+        factory_->CreatePeerConnectionOrError(config, std::move(pc_deps));
+    if (!result.ok()) {
+      RTC_LOG(LS_ERROR) << name_ << ": failed to create PeerConnection: "
+                        << result.error().message();
+      return false;
+    }
+    peer_connection_ = result.MoveValue();
+    return true;
+  }
+
+  void Close() {
+    if (stats_collector_) {
+      stats_collector_->Stop();
+    }
+    if (frame_timing_recorder_) {
+      ReleaseDecodedFrameTimingSink(frame_timing_recorder_.get());
+      frame_timing_recorder_->Stop();
+    }
+    if (sent_frame_timing_recorder_) {
+      ReleaseSentFrameTimingSink(sent_frame_timing_recorder_.get());
+      sent_frame_timing_recorder_->Stop();
+    }
+    if (peer_connection_) {
+      peer_connection_->Close();
+    }
+    stats_collector_ = nullptr;
+    peer_connection_ = nullptr;
+    factory_ = nullptr;
+    worker_thread_ = nullptr;
+  }
+
+  webrtc::PeerConnectionInterface* pc() { return peer_connection_.get(); }
+  webrtc::PeerConnectionFactoryInterface* factory() { return factory_.get(); }
+  const std::string& name() const { return name_; }
+
+  // Starts receiver stats logging into `log_dir` once a video track arrives.
+  void LogReceiveStats(const std::string& log_dir,
+                       StatsLogFormat format,
+                       bool per_frame,
+                       int interval_ms) {
+    stats_log_dir_ = log_dir;
+    stats_log_format_ = format;
+    per_frame_stats_ = per_frame;
+    stats_interval_ms_ = interval_ms;
+  }
+
+  // Records the send timing of every video frame into `log_dir`.
+  void LogSentFrameTiming(const std::string& log_dir) {
+    sent_frame_timing_recorder_ = std::make_unique<SentFrameTimingRecorder>();
+    if (!sent_frame_timing_recorder_->Start(log_dir)) {
+      RTC_LOG(LS_ERROR) << name_ << ": failed to start sent frame timing "
+                        << "recorder";
+    } else if (!ClaimSentFrameTimingSink(sent_frame_timing_recorder_.get())) {
+      RTC_LOG(LS_WARNING) << name_ << ": sent frame timing sink is in use";
+      sent_frame_timing_recorder_->Stop();
+    }
+  }
+
+  // Called once ICE gathering is complete, so the local description carries
+  // every candidate and no trickling is needed.
+  void set_on_gathering_done(std::function<void()> callback) {
+    on_gathering_done_ = std::move(callback);
+  }
+
+  // PeerConnectionObserver implementation.
+  void OnSignalingChange(
+      webrtc::PeerConnectionInterface::SignalingState new_state) override {}
+  void OnDataChannel(
+      rtc::scoped_refptr<webrtc::DataChannelInterface> channel) override {}
+  void OnIceCandidate(const webrtc::IceCandidateInterface* candidate) override {
+  }
+  void OnIceGatheringChange(
+      webrtc::PeerConnectionInterface::IceGatheringState new_state) override {
+    if (new_state ==
+            webrtc::PeerConnectionInterface::kIceGatheringComplete &&
+        on_gathering_done_) {
+      on_gathering_done_();
+    }
+  }
+  void OnConnectionChange(
+      webrtc::PeerConnectionInterface::PeerConnectionState new_state) override {
+    RTC_LOG(LS_INFO) << name_ << ": connection state "
+                     << webrtc::PeerConnectionInterface::AsString(new_state);
+  }
+  void OnTrack(rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver)
+      override {
+    if (stats_log_dir_.empty() ||
+        transceiver->media_type() != cricket::MEDIA_TYPE_VIDEO ||
+        stats_collector_) {
+      return;
+    }
+    // Polled on the signaling thread; see RTCStatsCollector::Start().
+    stats_collector_ = std::make_unique<RTCStatsCollector>();
+    stats_collector_->set_write_per_frame(per_frame_stats_);
+    stats_collector_->set_stats_interval_ms(stats_interval_ms_);
+    if (!stats_collector_->Start(stats_log_dir_, peer_connection_,
+                                 stats_log_format_,
+                                 time_controller_.GetMainThread())) {
+      RTC_LOG(LS_ERROR) << name_ << ": failed to start stats collection";
+    }
+    frame_timing_recorder_ = std::make_unique<FrameTimingRecorder>();
+    frame_timing_recorder_->set_frame_callback(
+        [collector = stats_collector_.get()](
+            const webrtc::TimingFrameInfo& timing) {
+          collector->AddFrameTiming(timing);
+        });
+    if (!frame_timing_recorder_->Start(stats_log_dir_)) {
+      RTC_LOG(LS_ERROR) << name_ << ": failed to start frame timing recorder";
+    } else if (!ClaimDecodedFrameTimingSink(frame_timing_recorder_.get())) {
+      RTC_LOG(LS_WARNING) << name_ << ": decoded frame timing sink is in use";
+      frame_timing_recorder_->Stop();
+    }
+  }
+
+ private:
+  const std::string name_;
+  webrtc::TimeController& time_controller_;
+  webrtc::EmulatedNetworkManagerInterface& network_;
+  std::unique_ptr<rtc::Thread> worker_thread_;
+  rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory_;
+  rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection_;
+  std::function<void()> on_gathering_done_;
+
+  std::string stats_log_dir_;
+  StatsLogFormat stats_log_format_ = StatsLogFormat::kCsv;
+  bool per_frame_stats_ = true;
+  int stats_interval_ms_ = 200;
+  std::unique_ptr<RTCStatsCollector> stats_collector_;
+  // Outlives the sink registration for the same reason as in Conductor.
+  std::unique_ptr<FrameTimingRecorder> frame_timing_recorder_;
+  std::unique_ptr<SentFrameTimingRecorder> sent_frame_timing_recorder_;
+};
+
+EmulatedCall::EmulatedCall(const Config& config) : config_(config) {}
+
+EmulatedCall::~EmulatedCall() {
+  Shutdown();
+}
+
+bool EmulatedCall::Run() {
+  webrtc::NetworkEmulationManagerConfig network_config;
+  network_config.time_mode = config_.time_mode;
+  // Without this the DTLS handshake sizes vary between runs and shift when
+  // the first media packets hit a constrained link.
+  network_config.fake_dtls_handshake_sizes =
+      config_.time_mode == webrtc::TimeMode::kSimulated;
+  network_ = webrtc::CreateNetworkEmulationManager(network_config);
+  if (!CreateNetwork()) {
+    Shutdown();
+    return false;
+  }
+
+  webrtc::TimeController& time_controller = *network_->time_controller();
+  sender_ = std::make_unique<Peer>("sender", time_controller, *sender_network_);
+  receiver_ =
+      std::make_unique<Peer>("receiver", time_controller, *receiver_network_);
+  if (!sender_->Initialize() || !receiver_->Initialize()) {
+    Shutdown();
+    return false;
+  }
+
+  FrameScheduler::Mode pacing = config_.pacing;
+  if (config_.time_mode == webrtc::TimeMode::kSimulated &&
+      pacing == FrameScheduler::Mode::kBurst) {
+    // Burst ticks are posted without delay, so simulated time would never
+    // move forward.
+    RTC_LOG(LS_WARNING) << "Burst pacing needs real time; using paced";
+    pacing = FrameScheduler::Mode::kPaced;
+  }
+  video_source_ = FileVideoSource::Create(
+      config_.y4m_path, /*target_fps=*/0,
+      *time_controller.GetTaskQueueFactory(), pacing, config_.read_mode);
+  if (!video_source_) {
+    Shutdown();
+    return false;
+  }
+
+  std::string receiver_log_dir = config_.log_dir + "/receiver";
+  std::filesystem::create_directories(receiver_log_dir);
+  receiver_->LogReceiveStats(receiver_log_dir, config_.stats_log_format,
+                             config_.per_frame_stats,
+                             config_.stats_interval_ms);
+  std::string sender_log_dir = config_.log_dir + "/sender";
+  std::filesystem::create_directories(sender_log_dir);
+  sender_->LogSentFrameTiming(sender_log_dir);
+
+  Connect();
+  RTC_LOG(LS_INFO) << "Running emulated call for " << config_.duration.seconds()
+                   << " s in "
+                   << (config_.time_mode == webrtc::TimeMode::kSimulated
+                           ? "simulated"
+                           : "real")
+                   << " time";
+  time_controller.AdvanceTime(config_.duration);
+
+  FrameScheduler::Stats pacing_stats = video_source_->GetPacingStats();
+  RTC_LOG(LS_INFO) << "Emulated call done: delivered "
+                   << pacing_stats.frames_delivered << " frames, skipped "
+                   << pacing_stats.frames_skipped;
+  Shutdown();
+  return true;
+}
+
+bool EmulatedCall::CreateNetwork() {
+  webrtc::EmulatedNetworkNode* forward_link =
+      CreateLinkNode(*network_, config_.trace_path, kForwardLinkSeed);
+  webrtc::EmulatedNetworkNode* reverse_link = CreateLinkNode(
+      *network_,
+      config_.reverse_trace_path.empty() ? config_.trace_path
+                                         : config_.reverse_trace_path,
+      kReverseLinkSeed);
+  if (!forward_link || !reverse_link) {
+    return false;
+  }
+
+  webrtc::EmulatedEndpoint* sender_endpoint =
+      network_->CreateEndpoint(webrtc::EmulatedEndpointConfig());
+  webrtc::EmulatedEndpoint* receiver_endpoint =
+      network_->CreateEndpoint(webrtc::EmulatedEndpointConfig());
+  network_->CreateRoute(sender_endpoint, {forward_link}, receiver_endpoint);
+  network_->CreateRoute(receiver_endpoint, {reverse_link}, sender_endpoint);
+  sender_network_ =
+      network_->CreateEmulatedNetworkManagerInterface({sender_endpoint});
+  receiver_network_ =
+      network_->CreateEmulatedNetworkManagerInterface({receiver_endpoint});
+  return true;
+}
+
+void EmulatedCall::Connect() {
+  rtc::scoped_refptr<webrtc::VideoTrackInterface> video_track =
+      sender_->factory()->CreateVideoTrack(video_source_, kVideoLabel);
+  webrtc::RtpTransceiverInit init;
+  init.direction = webrtc::RtpTransceiverDirection::kSendOnly;
+  init.stream_ids.push_back(kStreamId);
+  auto transceiver = sender_->pc()->AddTransceiver(video_track, init);
+  if (!transceiver.ok()) {
+    RTC_LOG(LS_ERROR) << "Failed to add video track: "
+                      << transceiver.error().message();
+    return;
+  }
+
+  // Offer and answer are only handed over once ICE gathering is complete,
+  // which is immediate on the emulated network, so each description already
+  // lists every candidate.
+  sender_->set_on_gathering_done([this] {
+    receiver_->pc()->SetRemoteDescription(
+        CopyDescription(*sender_->pc()->local_description()),
+        rtc::make_ref_counted<RemoteDescriptionObserver>(
+            receiver_->name(), [this] {
+              receiver_->pc()->SetLocalDescription(
+                  rtc::make_ref_counted<LocalDescriptionObserver>(
+                      receiver_->name()));
+            }));
+  });
+  receiver_->set_on_gathering_done([this] {
+    sender_->pc()->SetRemoteDescription(
+        CopyDescription(*receiver_->pc()->local_description()),
+        rtc::make_ref_counted<RemoteDescriptionObserver>(sender_->name(),
+                                                         nullptr));
+  });
+  sender_->pc()->SetLocalDescription(
+      rtc::make_ref_counted<LocalDescriptionObserver>(sender_->name()));
+}
+
+void EmulatedCall::Shutdown() {
+  // Peers go before the source and the network they run on, and the network
+  // last since it owns the time controller every thread belongs to.
+  if (sender_) {
+    sender_->Close();
+  }
+  if (receiver_) {
+    receiver_->Close();
+  }
+  sender_ = nullptr;
+  receiver_ = nullptr;
+  video_source_ = nullptr;
+  sender_network_ = nullptr;
+  receiver_network_ = nullptr;
+  network_ = nullptr;
+}
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_EMULATED_CALL_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_EMULATED_CALL_H_
+
+#include <memory>
+#include <string>
+
+#include "api/scoped_refptr.h"
+#include "api/test/network_emulation/network_config_schedule.pb.h"
+#include "api/test/network_emulation_manager.h"
+#include "api/units/time_delta.h"
+#include "examples/peerconnection/client/file_video_source.h"
+#include "examples/peerconnection/client/frame_scheduler.h"
+#include "examples/peerconnection/client/stats_log_writer.h"
+
+// Reads a link trace into a schedule for SchedulableNetworkBehavior. Each
+// non-empty line that does not start with '#' is
+//
+//   <time_ms> <capacity_kbps> <delay_ms> [<loss_percent> [<queue_packets>]]
+//
+// and takes effect `time_ms` after the first packet is sent on the link. A
+// capacity of 0 means unlimited. Lines must be in increasing time order. A
+// line "repeat <ms>" restarts the trace `ms` after its last entry. Returns
+// false and logs the offending line if the file can not be parsed.
+bool ReadLinkTrace(const std::string& path,
+                   webrtc::network_behaviour::NetworkConfigSchedule* schedule);
+
+// Runs both peers of an emulation experiment inside this process. They are
+// connected through NetworkEmulationManager endpoints rather than a shaped
+// kernel interface, and offer and answer are handed over directly instead of
+// through the signaling server, so an experiment needs neither root nor a
+// second machine and gives the same packet schedule on every run.
+//
+// The sender plays `y4m_path` to the receiver over a link whose capacity,
+// delay and loss follow `trace_path`; the receiver writes the same stats
+// files as the client does in <log_dir>/receiver, and the sender its frame
+// send timing in <log_dir>/sender. With TimeMode::kSimulated every WebRTC
+// thread runs on the emulation's simulated clock, so a call runs as fast as
+// the CPU allows rather than in real time.
+class EmulatedCall {
+ public:
+  struct Config {
+    std::string y4m_path;
+    FrameScheduler::Mode pacing = FrameScheduler::Mode::kPaced;
+    FileVideoSource::ReadMode read_mode = FileVideoSource::ReadMode::kMapped;
+    // Sender to receiver link. Empty leaves the link unconstrained.
+    std::string trace_path;
+    // Receiver to sender link. Empty uses `trace_path`, i.e. a symmetric
+    // link.
+    std::string reverse_trace_path;
+    webrtc::TimeMode time_mode = webrtc::TimeMode::kRealTime;
+    webrtc::TimeDelta duration = webrtc::TimeDelta::Seconds(60);
+    std::string log_dir;
+    StatsLogFormat stats_log_format = StatsLogFormat::kCsv;
+    bool per_frame_stats = true;
+    int stats_interval_ms = 200;
+  };
+
+  explicit EmulatedCall(const Config& config);
+  ~EmulatedCall();
+
+  EmulatedCall(const EmulatedCall&) = delete;
+  EmulatedCall& operator=(const EmulatedCall&) = delete;
+
+  // Sets up the emulated network and both peers, connects them and runs the
+  // call for `duration`. Must be called on the thread that created this
+  // object, which becomes the signaling thread of both peers. Returns false
+  // if the call could not be set up.
+  bool Run();
+
+ private:
+  class Peer;
+
+  bool CreateNetwork();
+  void Connect();
+  void Shutdown();
+
+  const Config config_;
+  std::unique_ptr<webrtc::NetworkEmulationManager> network_;
+  webrtc::EmulatedNetworkManagerInterface* sender_network_ = nullptr;
+  webrtc::EmulatedNetworkManagerInterface* receiver_network_ = nullptr;
+  std::unique_ptr<Peer> sender_;
+  std::unique_ptr<Peer> receiver_;
+  rtc::scoped_refptr<FileVideoSource> video_source_;
+};
+
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_EMULATED_CALL_H_
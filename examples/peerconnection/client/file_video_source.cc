@@ -1,146 +1,155 @@
-// file_video_source.h
-#ifndef FILE_VIDEO_SOURCE_H_
-#define FILE_VIDEO_SOURCE_H_
-
-#include "api/video/video_frame.h"
-#include "api/video/video_source_interface.h"
-#include "pc/video_track_source.h"
-#include "rtc_tools/video_file_reader.h"
-#include "rtc_base/thread.h"
-#include "media/base/video_broadcaster.h"
-#include "rtc_base/system/rtc_export.h"
-
-class FileVideoSource : public webrtc::VideoTrackSource {
- public:
-  static rtc::scoped_refptr<FileVideoSource> Create(
-      const std::string& file_path, 
-      int target_fps,
-      int width = 0,    // Only needed for .yuv files
-      int height = 0);  // Only needed for .yuv files
-
- protected:
-  explicit FileVideoSource(rtc::scoped_refptr<webrtc::test::Video> video_file,
-                          int target_fps);
-
- private:
-  class FrameGenerator : public rtc::VideoSourceInterface<webrtc::VideoFrame> {
-   public:
-    FrameGenerator(rtc::scoped_refptr<webrtc::test::Video> video_file,
-                  int target_fps);
-    ~FrameGenerator() override;
-
-    void AddOrUpdateSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
-                        const rtc::VideoSinkWants& wants) override;
-    void RemoveSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink) override;
-
-   private:
-    void StartTimer();
-    void OnFrame();
-
-    rtc::scoped_refptr<webrtc::test::Video> video_file_;
-    cricket::VideoBroadcaster broadcaster_;  // Changed from rtc to cricket
-    std::unique_ptr<rtc::Thread> thread_;
-    webrtc::test::Video::Iterator frame_iterator_;
-    int target_fps_;
-    bool running_;
-  };
-
-  std::unique_ptr<FrameGenerator> frame_generator_;
-  rtc::VideoSourceInterface<webrtc::VideoFrame>* source() override {
-    return frame_generator_.get();
-  }
-};
-
-#endif  // FILE_VIDEO_SOURCE_H_
-
-// file_video_source.cc
-#include "file_video_source.h"
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/file_video_source.h"
+
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include "absl/strings/match.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/clock.h"
+
+namespace {
+
+constexpr double kDefaultFps = 30.0;
+
+// webrtc::test::Video does not expose the frame rate, so read the 'F' tag
+// from the stream header ourselves.
+std::optional<double> ReadY4mFrameRate(const std::string& file_path) {
+  FILE* file = fopen(file_path.c_str(), "rb");
+  if (!file) {
+    return std::nullopt;
+  }
+  char header[256] = {};
+  bool read = fgets(header, sizeof(header), file) != nullptr;
+  fclose(file);
+  if (!read) {
+    return std::nullopt;
+  }
+  for (const char* tag = header; (tag = strstr(tag, " F")) != nullptr;
+       ++tag) {
+    int numerator = 0;
+    int denominator = 0;
+    if (sscanf(tag, " F%d:%d", &numerator, &denominator) == 2 &&
+        numerator > 0 && denominator > 0) {
+      return static_cast<double>(numerator) / denominator;
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace
 
 FileVideoSource::FrameGenerator::FrameGenerator(
     rtc::scoped_refptr<webrtc::test::Video> video_file,
-    int target_fps)
-    : video_file_(video_file),
-      frame_iterator_(video_file->begin()),
+    double target_fps,
+    webrtc::TaskQueueFactory& task_queue_factory,
+    FrameScheduler::Mode pacing)
+    : video_file_(std::move(video_file)),
       target_fps_(target_fps),
-      running_(false) {
-  thread_ = rtc::Thread::CreateWithSocketServer();  // Changed to CreateWithSocketServer
-  thread_->Start();
+      task_queue_(task_queue_factory.CreateTaskQueue(
+          "FileVideoSource", webrtc::TaskQueueFactory::Priority::HIGH)) {
+  scheduler_ = std::make_unique<FrameScheduler>(
+      task_queue_.get(), webrtc::Clock::GetRealTimeClock(), target_fps_,
+      pacing, [this](int64_t frame_index) { OnFrame(frame_index); });
 }
 
 FileVideoSource::FrameGenerator::~FrameGenerator() {
-  running_ = false;
-  thread_->Stop();
+  // Deleting the queue waits for a running tick and drops pending ones, so
+  // nothing touches the scheduler or broadcaster afterwards.
+  task_queue_ = nullptr;
 }
 
 void FileVideoSource::FrameGenerator::AddOrUpdateSink(
     rtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
     const rtc::VideoSinkWants& wants) {
   broadcaster_.AddOrUpdateSink(sink, wants);
-  if (!running_)
-    StartTimer();
+  task_queue_->PostTask([this]() { scheduler_->Start(); });
 }
 
 void FileVideoSource::FrameGenerator::RemoveSink(
     rtc::VideoSinkInterface<webrtc::VideoFrame>* sink) {
   broadcaster_.RemoveSink(sink);
-  if (!broadcaster_.has_sinks())  // Changed from GetSinks().empty()
-    running_ = false;
-}
-
-void FileVideoSource::FrameGenerator::StartTimer() {
-  running_ = true;
-  thread_->PostTask(rtc::ToQueuedTask([this]() {  // Changed to use ToQueuedTask
-    while (running_) {
-      OnFrame();
-      rtc::Thread::Current()->SleepMs(1000 / target_fps_);
+  task_queue_->PostTask([this]() {
+    if (!broadcaster_.frame_wanted()) {
+      scheduler_->Stop();
     }
-  }));
+  });
 }
 
-void FileVideoSource::FrameGenerator::OnFrame() {
-  if (frame_iterator_ == video_file_->end()) {
-    frame_iterator_ = video_file_->begin(); // Loop back to start
-  }
-
+void FileVideoSource::FrameGenerator::OnFrame(int64_t frame_index) {
+  // Index by the scheduler's frame number rather than a running iterator, so
+  // skipped deadlines also skip file frames and playback stays in real time.
+  size_t file_index =
+      static_cast<size_t>(frame_index) % video_file_->number_of_frames();
   webrtc::VideoFrame video_frame =
       webrtc::VideoFrame::Builder()
-          .set_video_frame_buffer(*frame_iterator_)
+          .set_video_frame_buffer(video_file_->GetFrame(file_index))
           .set_timestamp_us(rtc::TimeMicros())
           .set_rotation(webrtc::kVideoRotation_0)
           .build();
-
   broadcaster_.OnFrame(video_frame);
-  ++frame_iterator_;
 }
 
 FileVideoSource::FileVideoSource(
     rtc::scoped_refptr<webrtc::test::Video> video_file,
-    int target_fps)
-    : VideoTrackSource(/*remote=*/false) {
-  frame_generator_ = std::make_unique<FrameGenerator>(video_file, target_fps);
-}
+    double target_fps,
+    webrtc::TaskQueueFactory& task_queue_factory,
+    FrameScheduler::Mode pacing)
+    : VideoTrackSource(/*remote=*/false),
+      frame_generator_(std::make_unique<FrameGenerator>(
+          std::move(video_file), target_fps, task_queue_factory, pacing)) {}
 
 rtc::scoped_refptr<FileVideoSource> FileVideoSource::Create(
     const std::string& file_path,
-    int target_fps,
+    double target_fps,
+    webrtc::TaskQueueFactory& task_queue_factory,
+    FrameScheduler::Mode pacing,
+    ReadMode read_mode,
     int width,
     int height) {
   rtc::scoped_refptr<webrtc::test::Video> video_file;
-  
-  if (width != 0 && height != 0) {
-    // If dimensions are provided, try to open as YUV file
+  if (read_mode == ReadMode::kMapped) {
+    video_file =
+        webrtc::test::OpenMappedYuvOrY4mFile(file_path, width, height);
+  } else if (width != 0 && height != 0) {
     video_file = webrtc::test::OpenYuvFile(file_path, width, height);
   } else {
-    // Try to open as either YUV or Y4M file
     video_file = webrtc::test::OpenYuvOrY4mFile(file_path, width, height);
   }
-
-  if (!video_file) {
+  if (!video_file || video_file->number_of_frames() == 0) {
     RTC_LOG(LS_ERROR) << "Failed to open video file: " << file_path;
     return nullptr;
   }
 
-  return rtc::make_ref_counted<FileVideoSource>(video_file, target_fps);
-}
\ No newline at end of file
+  if (target_fps <= 0) {
+    std::optional<double> file_fps;
+    if (absl::EndsWith(file_path, ".y4m")) {
+      file_fps = ReadY4mFrameRate(file_path);
+    }
+    target_fps = file_fps.value_or(kDefaultFps);
+  }
+  RTC_LOG(LS_INFO) << "Playing " << file_path << " ("
+                   << video_file->width() << "x" << video_file->height()
+                   << ", " << video_file->number_of_frames() << " frames) at "
+                   << target_fps << " fps, "
+                   << (pacing == FrameScheduler::Mode::kBurst ? "burst"
+                                                              : "paced")
+                   << (read_mode == ReadMode::kMapped ? ", memory mapped"
+                                                      : "");
+
+  return rtc::make_ref_counted<FileVideoSource>(std::move(video_file),
+                                                target_fps, task_queue_factory,
+                                                pacing);
+}
@@ -1,53 +1,105 @@
-#ifndef FILE_VIDEO_SOURCE_H_
-#define FILE_VIDEO_SOURCE_H_
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
 
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_FILE_VIDEO_SOURCE_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_FILE_VIDEO_SOURCE_H_
+
+#include <memory>
+#include <string>
+
+#include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_source_interface.h"
+#include "examples/peerconnection/client/frame_scheduler.h"
+#include "media/base/video_broadcaster.h"
 #include "pc/video_track_source.h"
 #include "rtc_tools/video_file_reader.h"
-#include "rtc_base/thread.h"
-#include "media/base/video_broadcaster.h"
-#include "rtc_base/system/rtc_export.h"
 
+// Video track source that plays a .y4m or .yuv file in a loop. Frames are
+// produced by a FrameScheduler on a dedicated task queue, so the delivered
+// rate stays locked to wall clock time (or runs unthrottled in burst mode).
 class FileVideoSource : public webrtc::VideoTrackSource {
  public:
+  enum class ReadMode {
+    // Every frame is read from disk into a newly allocated buffer.
+    kFromDisk,
+    // The file is memory mapped once when the source is created and frames
+    // point straight into the mapping, so playback does no I/O or
+    // allocation. Needs enough memory to keep the whole clip resident.
+    kMapped,
+  };
+
+  // `target_fps` <= 0 uses the frame rate from the .y4m header, or 30 fps
+  // when there is none. `width` and `height` are only needed for .yuv files.
   static rtc::scoped_refptr<FileVideoSource> Create(
-      const std::string& file_path, 
-      int target_fps,
-      int width = 0,    // Only needed for .yuv files
-      int height = 0);  // Only needed for .yuv files
+      const std::string& file_path,
+      double target_fps,
+      webrtc::TaskQueueFactory& task_queue_factory,
+      FrameScheduler::Mode pacing = FrameScheduler::Mode::kPaced,
+      ReadMode read_mode = ReadMode::kFromDisk,
+      int width = 0,
+      int height = 0);
+
+  int width() const { return frame_generator_->width(); }
+  int height() const { return frame_generator_->height(); }
+  double target_fps() const { return frame_generator_->target_fps(); }
+  FrameScheduler::Stats GetPacingStats() const {
+    return frame_generator_->GetPacingStats();
+  }
 
  protected:
-  explicit FileVideoSource(rtc::scoped_refptr<webrtc::test::Video> video_file,
-                          int target_fps);
+  FileVideoSource(rtc::scoped_refptr<webrtc::test::Video> video_file,
+                  double target_fps,
+                  webrtc::TaskQueueFactory& task_queue_factory,
+                  FrameScheduler::Mode pacing);
 
  private:
   class FrameGenerator : public rtc::VideoSourceInterface<webrtc::VideoFrame> {
    public:
     FrameGenerator(rtc::scoped_refptr<webrtc::test::Video> video_file,
-                  int target_fps);
+                   double target_fps,
+                   webrtc::TaskQueueFactory& task_queue_factory,
+                   FrameScheduler::Mode pacing);
     ~FrameGenerator() override;
 
     void AddOrUpdateSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink,
-                        const rtc::VideoSinkWants& wants) override;
+                         const rtc::VideoSinkWants& wants) override;
     void RemoveSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink) override;
 
+    int width() const { return video_file_->width(); }
+    int height() const { return video_file_->height(); }
+    double target_fps() const { return target_fps_; }
+    FrameScheduler::Stats GetPacingStats() const {
+      return scheduler_->GetStats();
+    }
+
    private:
-    void StartTimer();
-    void OnFrame();
-
-    rtc::scoped_refptr<webrtc::test::Video> video_file_;
-    cricket::VideoBroadcaster broadcaster_;  // Changed from rtc to cricket
-    std::unique_ptr<rtc::Thread> thread_;
-    webrtc::test::Video::Iterator frame_iterator_;
-    int target_fps_;
-    bool running_;
+    void OnFrame(int64_t frame_index);
+
+    const rtc::scoped_refptr<webrtc::test::Video> video_file_;
+    const double target_fps_;
+    rtc::VideoBroadcaster broadcaster_;
+    std::unique_ptr<FrameScheduler> scheduler_;
+    // Declared last so it is destroyed, and its pending ticks dropped,
+    // before the members they use.
+    std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter>
+        task_queue_;
   };
 
-  std::unique_ptr<FrameGenerator> frame_generator_;
   rtc::VideoSourceInterface<webrtc::VideoFrame>* source() override {
     return frame_generator_.get();
   }
+
+  std::unique_ptr<FrameGenerator> frame_generator_;
 };
 
-#endif  // FILE_VIDEO_SOURCE_H_
\ No newline at end of file
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_FILE_VIDEO_SOURCE_H_
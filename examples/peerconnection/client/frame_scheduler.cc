@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/frame_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+FrameScheduler::FrameScheduler(webrtc::TaskQueueBase* task_queue,
+                               webrtc::Clock* clock,
+                               double target_fps,
+                               Mode mode,
+                               std::function<void(int64_t)> on_frame)
+    : task_queue_(task_queue),
+      clock_(clock),
+      target_fps_(target_fps),
+      mode_(mode),
+      frame_interval_(webrtc::TimeDelta::Micros(
+          std::llround(1'000'000.0 / target_fps))),
+      on_frame_(std::move(on_frame)) {
+  RTC_DCHECK(task_queue_);
+  RTC_DCHECK(clock_);
+  RTC_DCHECK_GT(target_fps_, 0.0);
+}
+
+FrameScheduler::~FrameScheduler() = default;
+
+void FrameScheduler::Start() {
+  RTC_DCHECK(task_queue_->IsCurrent());
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  // A fresh flag, so ticks posted before an earlier Stop() stay cancelled.
+  safety_flag_ = webrtc::PendingTaskSafetyFlag::Create();
+  start_time_ = clock_->CurrentTime();
+  frame_index_ = 0;
+  Tick();
+}
+
+void FrameScheduler::Stop() {
+  RTC_DCHECK(task_queue_->IsCurrent());
+  if (!running_) {
+    return;
+  }
+  running_ = false;
+  safety_flag_->SetNotAlive();
+  Stats stats = GetStats();
+  RTC_LOG(LS_INFO) << "Frame scheduler stopped: delivered "
+                   << stats.frames_delivered << ", skipped "
+                   << stats.frames_skipped << ", late " << stats.frames_late
+                   << ", max lateness " << stats.max_lateness.ms() << " ms.";
+}
+
+FrameScheduler::Stats FrameScheduler::GetStats() const {
+  webrtc::MutexLock lock(&stats_mutex_);
+  return stats_;
+}
+
+webrtc::Timestamp FrameScheduler::Deadline(int64_t frame_index) const {
+  // Computed from the index each time so the fractional part of the frame
+  // interval never accumulates.
+  return start_time_ +
+         webrtc::TimeDelta::Micros(std::llround(frame_index * 1'000'000.0 /
+                                                target_fps_));
+}
+
+void FrameScheduler::Tick() {
+  RTC_DCHECK(task_queue_->IsCurrent());
+  if (!running_) {
+    return;
+  }
+
+  int64_t skipped = 0;
+  webrtc::TimeDelta lateness = webrtc::TimeDelta::Zero();
+  if (mode_ == Mode::kPaced) {
+    webrtc::Timestamp now = clock_->CurrentTime();
+    lateness = now - Deadline(frame_index_);
+    if (lateness >= frame_interval_) {
+      // Catch up to the most recent deadline instead of bursting out every
+      // frame that was missed. Both are positive, so integer division
+      // rounds down to the number of whole intervals missed.
+      skipped = lateness.us() / frame_interval_.us();
+      frame_index_ += skipped;
+      lateness = now - Deadline(frame_index_);
+    }
+  }
+
+  on_frame_(frame_index_);
+  ++frame_index_;
+
+  {
+    webrtc::MutexLock lock(&stats_mutex_);
+    ++stats_.frames_delivered;
+    stats_.frames_skipped += skipped;
+    if (lateness > kLateThreshold) {
+      ++stats_.frames_late;
+    }
+    stats_.max_lateness = std::max(stats_.max_lateness, lateness);
+  }
+
+  if (mode_ == Mode::kBurst) {
+    // Still go through the queue so Stop() and other tasks get to run.
+    task_queue_->PostTask(
+        webrtc::SafeTask(safety_flag_, [this]() { Tick(); }));
+    return;
+  }
+  webrtc::TimeDelta delay = std::max(
+      Deadline(frame_index_) - clock_->CurrentTime(), webrtc::TimeDelta::Zero());
+  task_queue_->PostDelayedHighPrecisionTask(
+      webrtc::SafeTask(safety_flag_, [this]() { Tick(); }), delay);
+}
+
+bool ParseFrameSchedulerMode(absl::string_view name,
+                             FrameScheduler::Mode* mode) {
+  if (name == "paced") {
+    *mode = FrameScheduler::Mode::kPaced;
+    return true;
+  }
+  if (name == "burst") {
+    *mode = FrameScheduler::Mode::kBurst;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_FRAME_SCHEDULER_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_FRAME_SCHEDULER_H_
+
+#include <cstdint>
+#include <functional>
+
+#include "absl/strings/string_view.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "system_wrappers/include/clock.h"
+
+// Drives a frame callback on a task queue at a fixed rate.
+//
+// In kPaced mode frame N is due at start + N / fps. Deadlines are derived
+// from the frame index rather than from the previous wakeup, so neither
+// rounding of the frame interval nor the time spent in the callback builds
+// up drift, and each wakeup is posted with PostDelayedHighPrecisionTask().
+// If the callback falls a whole interval or more behind, the missed
+// deadlines are skipped (and counted) instead of being delivered in a burst.
+//
+// In kBurst mode frames are delivered back to back with no sleep, to find the
+// maximum rate the encoder can sustain.
+//
+// Start() and Stop() must be called on `task_queue`.
+class FrameScheduler {
+ public:
+  enum class Mode { kPaced, kBurst };
+
+  struct Stats {
+    int64_t frames_delivered = 0;
+    // Deadlines dropped because the callback was a full interval behind.
+    int64_t frames_skipped = 0;
+    // Frames delivered more than kLateThreshold after their deadline.
+    int64_t frames_late = 0;
+    webrtc::TimeDelta max_lateness = webrtc::TimeDelta::Zero();
+  };
+
+  static constexpr webrtc::TimeDelta kLateThreshold =
+      webrtc::TimeDelta::Millis(2);
+
+  // `on_frame` receives the index of the deadline being served, which keeps
+  // increasing across skipped deadlines so sources can stay aligned with
+  // wall clock time.
+  FrameScheduler(webrtc::TaskQueueBase* task_queue,
+                 webrtc::Clock* clock,
+                 double target_fps,
+                 Mode mode,
+                 std::function<void(int64_t frame_index)> on_frame);
+  ~FrameScheduler();
+
+  void Start();
+  void Stop();
+
+  // May be called from any thread.
+  Stats GetStats() const;
+
+ private:
+  void Tick();
+  webrtc::Timestamp Deadline(int64_t frame_index) const;
+
+  webrtc::TaskQueueBase* const task_queue_;
+  webrtc::Clock* const clock_;
+  const double target_fps_;
+  const Mode mode_;
+  const webrtc::TimeDelta frame_interval_;
+  const std::function<void(int64_t)> on_frame_;
+
+  // Only accessed on `task_queue_`.
+  bool running_ = false;
+  webrtc::Timestamp start_time_ = webrtc::Timestamp::Zero();
+  int64_t frame_index_ = 0;
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> safety_flag_;
+
+  mutable webrtc::Mutex stats_mutex_;
+  Stats stats_ RTC_GUARDED_BY(stats_mutex_);
+};
+
+// Parses "paced" or "burst". Returns false for anything else.
+bool ParseFrameSchedulerMode(absl::string_view name,
+                             FrameScheduler::Mode* mode);
+
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_FRAME_SCHEDULER_H_
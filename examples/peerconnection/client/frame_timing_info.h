@@ -4,62 +4,64 @@
 
 #include <fstream>
 #include <string>
-#include "api/video/video_frame.h"
-#include "api/video/video_sink_interface.h"
+#include "api/video/video_timing.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 
-class FrameTimingLogger : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+// Writes one CSV row per TimingFrameInfo. Rows are buffered by the stream;
+// callers decide when to Flush(), so this must not be driven from a
+// latency sensitive thread (see FrameTimingRecorder).
+class FrameTimingLogger {
  public:
-  explicit FrameTimingLogger(const std::string& log_dir) 
+  explicit FrameTimingLogger(const std::string& log_dir)
       : log_file_(log_dir + "/frame_timing.csv") {
+    if (!log_file_.is_open()) {
+      RTC_LOG(LS_ERROR) << "Failed to open " << log_dir << "/frame_timing.csv";
+      return;
+    }
     // Write CSV header
     log_file_ << "timestamp,rtp_timestamp,capture_time,encode_start,encode_finish,"
               << "packetization_finish,pacer_exit,network_timestamp,"
               << "network2_timestamp,receive_start,receive_finish,"
               << "decode_start,decode_finish,render_time,is_outlier,is_timer_triggered"
-              << std::endl;
+              << "\n";
   }
 
-  void OnFrame(const webrtc::VideoFrame& frame) override {
-    const webrtc::TimingFrameInfo& timing = frame.timing();
-    
-    if (!timing.IsInvalid()) {
-      log_file_ << rtc::TimeMillis() << ","
-                << timing.rtp_timestamp << ","
-                << timing.capture_time_ms << ","
-                << timing.encode_start_ms << ","
-                << timing.encode_finish_ms << ","
-                << timing.packetization_finish_ms << ","
-                << timing.pacer_exit_ms << ","
-                << timing.network_timestamp_ms << ","
-                << timing.network2_timestamp_ms << ","
-                << timing.receive_start_ms << ","
-                << timing.receive_finish_ms << ","
-                << timing.decode_start_ms << ","
-                << timing.decode_finish_ms << ","
-                << timing.render_time_ms << ","
-                << timing.IsOutlier() << ","
-                << timing.IsTimerTriggered()
-                << std::endl;
-      
-      RTC_LOG(LS_INFO) << "Frame timing: "
-                       << "Capture-to-render delay: " << timing.EndToEndDelay() << "ms"
-                       << " Encoding time: " 
-                       << (timing.encode_finish_ms - timing.encode_start_ms) << "ms";
-    }
-    
-    // Forward frame to next sink if exists
-    if (next_sink_)
-      next_sink_->OnFrame(frame);
+  bool is_open() const { return log_file_.is_open(); }
+
+  void Log(const webrtc::TimingFrameInfo& timing) {
+    Log(timing, rtc::TimeMillis());
   }
 
-  void SetNextSink(rtc::VideoSinkInterface<webrtc::VideoFrame>* sink) {
-    next_sink_ = sink;
+  // `log_time_ms` is the time the frame was observed, which for queued
+  // frames is earlier than the time the row gets written.
+  void Log(const webrtc::TimingFrameInfo& timing, int64_t log_time_ms) {
+    if (!log_file_.is_open()) {
+      return;
+    }
+    log_file_ << log_time_ms << ","
+              << timing.rtp_timestamp << ","
+              << timing.capture_time_ms << ","
+              << timing.encode_start_ms << ","
+              << timing.encode_finish_ms << ","
+              << timing.packetization_finish_ms << ","
+              << timing.pacer_exit_ms << ","
+              << timing.network_timestamp_ms << ","
+              << timing.network2_timestamp_ms << ","
+              << timing.receive_start_ms << ","
+              << timing.receive_finish_ms << ","
+              << timing.decode_start_ms << ","
+              << timing.decode_finish_ms << ","
+              << timing.render_time_ms << ","
+              << timing.IsOutlier() << ","
+              << timing.IsTimerTriggered()
+              << "\n";
   }
 
+  void Flush() { log_file_.flush(); }
+
  private:
   std::ofstream log_file_;
-  rtc::VideoSinkInterface<webrtc::VideoFrame>* next_sink_ = nullptr;
 };
 
-#endif  // FRAME_TIMING_LOGGER_H_
\ No newline at end of file
+#endif  // FRAME_TIMING_LOGGER_H_
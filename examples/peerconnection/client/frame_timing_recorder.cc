@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/frame_timing_recorder.h"
+
+#include <chrono>
+
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+FrameTimingRecorder::FrameTimingRecorder() : queue_(kCapacity) {}
+
+FrameTimingRecorder::~FrameTimingRecorder() {
+  Stop();
+}
+
+bool FrameTimingRecorder::Start(const std::string& log_dir) {
+  if (IsRunning()) {
+    return true;
+  }
+  logger_ = std::make_unique<FrameTimingLogger>(log_dir);
+  if (!logger_->is_open()) {
+    logger_.reset();
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    stop_requested_ = false;
+  }
+  writer_thread_ = std::thread(&FrameTimingRecorder::WriterLoop, this);
+  RTC_LOG(LS_INFO) << "Recording per-frame timing to " << log_dir
+                   << "/frame_timing.csv";
+  return true;
+}
+
+void FrameTimingRecorder::Stop() {
+  if (!IsRunning()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    stop_requested_ = true;
+  }
+  writer_cv_.notify_all();
+  writer_thread_.join();
+  // The writer drained before exiting; pick up anything pushed since.
+  Drain();
+  logger_->Flush();
+  RTC_LOG(LS_INFO) << "Frame timing recorder stopped, dropped "
+                   << dropped_frames() << " frames.";
+}
+
+void FrameTimingRecorder::OnDecodedFrameTiming(
+    const webrtc::TimingFrameInfo& timing) {
+  Entry entry;
+  entry.observed_time_ms = rtc::TimeMillis();
+  entry.timing = timing;
+  if (!queue_.TryPush(entry)) {
+    dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void FrameTimingRecorder::WriterLoop() {
+  std::unique_lock<std::mutex> lock(writer_mutex_);
+  while (!stop_requested_) {
+    writer_cv_.wait_for(lock, std::chrono::milliseconds(kDrainIntervalMs),
+                        [this]() { return stop_requested_; });
+    lock.unlock();
+    Drain();
+    logger_->Flush();
+    lock.lock();
+  }
+}
+
+void FrameTimingRecorder::Drain() {
+  Entry entry;
+  while (queue_.TryPop(&entry)) {
+    logger_->Log(entry.timing, entry.observed_time_ms);
+    if (frame_callback_) {
+      frame_callback_(entry.timing);
+    }
+  }
+}
@@ -0,0 +1,83 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_FRAME_TIMING_RECORDER_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_FRAME_TIMING_RECORDER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "api/video/video_timing.h"
+#include "examples/peerconnection/client/frame_timing_info.h"
+#include "examples/peerconnection/client/lock_free_ring_buffer.h"
+#include "modules/video_coding/decoded_frame_timing_sink.h"
+
+// Captures the timing of every decoded frame. The decode thread only copies
+// the TimingFrameInfo into a lock-free ring buffer; a background thread
+// drains it into frame_timing.csv through FrameTimingLogger, so file I/O
+// never happens on the decode path. Frames arriving while the buffer is full
+// are dropped and counted instead of blocking the decoder.
+class FrameTimingRecorder : public webrtc::DecodedFrameTimingSinkInterface {
+ public:
+  FrameTimingRecorder();
+  ~FrameTimingRecorder() override;
+
+  // Called on the writer thread with every frame written to the log, e.g. to
+  // feed RTCStatsCollector::AddFrameTiming(). Must be set before Start().
+  void set_frame_callback(
+      std::function<void(const webrtc::TimingFrameInfo&)> callback) {
+    frame_callback_ = std::move(callback);
+  }
+
+  // Opens <log_dir>/frame_timing.csv and starts the writer thread.
+  bool Start(const std::string& log_dir);
+  // Stops the writer thread after draining everything queued so far.
+  void Stop();
+
+  bool IsRunning() const { return writer_thread_.joinable(); }
+  int64_t dropped_frames() const {
+    return dropped_frames_.load(std::memory_order_relaxed);
+  }
+
+  // webrtc::DecodedFrameTimingSinkInterface implementation.
+  void OnDecodedFrameTiming(const webrtc::TimingFrameInfo& timing) override;
+
+ private:
+  struct Entry {
+    int64_t observed_time_ms = 0;
+    webrtc::TimingFrameInfo timing;
+  };
+
+  void WriterLoop();
+  void Drain();
+
+  // About 68 seconds of 60 fps video, or a few seconds of a large gallery.
+  static constexpr size_t kCapacity = 4096;
+  static constexpr int kDrainIntervalMs = 100;
+
+  LockFreeRingBuffer<Entry> queue_;
+  std::atomic<int64_t> dropped_frames_{0};
+
+  std::unique_ptr<FrameTimingLogger> logger_;
+  std::function<void(const webrtc::TimingFrameInfo&)> frame_callback_;
+  std::thread writer_thread_;
+  std::mutex writer_mutex_;
+  std::condition_variable writer_cv_;
+  bool stop_requested_ = false;
+};
+
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_FRAME_TIMING_RECORDER_H_
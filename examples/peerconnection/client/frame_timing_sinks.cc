@@ -0,0 +1,62 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/frame_timing_sinks.h"
+
+#include <mutex>
+
+namespace {
+
+// Serializes the get-then-set sequences below; the sinks themselves are read
+// lock-free by the media threads.
+std::mutex& SinkMutex() {
+  static std::mutex* const mutex = new std::mutex();
+  return *mutex;
+}
+
+}  // namespace
+
+bool ClaimDecodedFrameTimingSink(
+    webrtc::DecodedFrameTimingSinkInterface* sink) {
+  std::lock_guard<std::mutex> lock(SinkMutex());
+  webrtc::DecodedFrameTimingSinkInterface* installed =
+      webrtc::GetDecodedFrameTimingSink();
+  if (installed != nullptr) {
+    return installed == sink;
+  }
+  webrtc::SetDecodedFrameTimingSink(sink);
+  return true;
+}
+
+void ReleaseDecodedFrameTimingSink(
+    webrtc::DecodedFrameTimingSinkInterface* sink) {
+  std::lock_guard<std::mutex> lock(SinkMutex());
+  if (webrtc::GetDecodedFrameTimingSink() == sink) {
+    webrtc::SetDecodedFrameTimingSink(nullptr);
+  }
+}
+
+bool ClaimSentFrameTimingSink(webrtc::SentFrameTimingSinkInterface* sink) {
+  std::lock_guard<std::mutex> lock(SinkMutex());
+  webrtc::SentFrameTimingSinkInterface* installed =
+      webrtc::GetSentFrameTimingSink();
+  if (installed != nullptr) {
+    return installed == sink;
+  }
+  webrtc::SetSentFrameTimingSink(sink);
+  return true;
+}
+
+void ReleaseSentFrameTimingSink(webrtc::SentFrameTimingSinkInterface* sink) {
+  std::lock_guard<std::mutex> lock(SinkMutex());
+  if (webrtc::GetSentFrameTimingSink() == sink) {
+    webrtc::SetSentFrameTimingSink(nullptr);
+  }
+}
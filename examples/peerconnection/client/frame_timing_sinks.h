@@ -0,0 +1,30 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_FRAME_TIMING_SINKS_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_FRAME_TIMING_SINKS_H_
+
+#include "modules/rtp_rtcp/source/sent_frame_timing_sink.h"
+#include "modules/video_coding/decoded_frame_timing_sink.h"
+
+// The decoded and sent frame timing sinks are process wide and carry no
+// connection identity, so only one recorder of each kind can own them. The
+// claim functions install `sink` unless another sink is installed already and
+// return whether `sink` is now installed. The release functions remove `sink`
+// if, and only if, it is the installed one, so a connection that is torn down
+// never removes the sink of another one.
+bool ClaimDecodedFrameTimingSink(webrtc::DecodedFrameTimingSinkInterface* sink);
+void ReleaseDecodedFrameTimingSink(
+    webrtc::DecodedFrameTimingSinkInterface* sink);
+
+bool ClaimSentFrameTimingSink(webrtc::SentFrameTimingSinkInterface* sink);
+void ReleaseSentFrameTimingSink(webrtc::SentFrameTimingSinkInterface* sink);
+
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_FRAME_TIMING_SINKS_H_
@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/inbound_video_stats.h"
+
+#include <charconv>
+#include <limits>
+#include <optional>
+
+#include "api/stats/rtcstats_objects.h"
+
+namespace {
+
+// Number of comma separated fields written by TimingFrameInfo::ToString().
+constexpr int kTimingFrameInfoFieldCount = 16;
+
+template <typename T>
+T ValueOr(const std::optional<T>& member, T default_value) {
+  return member.has_value() ? *member : default_value;
+}
+
+// Parses the next comma separated integer field from `str`, starting at
+// `*pos`, and advances `*pos` past the separator.
+bool ParseNextField(absl::string_view str, size_t* pos, int64_t* value) {
+  if (*pos > str.size()) {
+    return false;
+  }
+  const char* begin = str.data() + *pos;
+  const char* end = str.data() + str.size();
+  auto [ptr, ec] = std::from_chars(begin, end, *value);
+  if (ec != std::errc() || ptr == begin || (ptr != end && *ptr != ',')) {
+    return false;
+  }
+  *pos = (ptr - str.data()) + 1;
+  return true;
+}
+
+}  // namespace
+
+bool IsInboundVideoStats(const webrtc::RTCStats& stats) {
+  if (stats.type() != webrtc::RTCInboundRtpStreamStats::kType) {
+    return false;
+  }
+  const auto& inbound = stats.cast_to<webrtc::RTCInboundRtpStreamStats>();
+  return inbound.kind.has_value() && *inbound.kind == "video";
+}
+
+bool ExtractInboundVideoStats(const webrtc::RTCStats& stats,
+                              InboundVideoStats* out) {
+  if (!IsInboundVideoStats(stats)) {
+    return false;
+  }
+  const auto& inbound = stats.cast_to<webrtc::RTCInboundRtpStreamStats>();
+
+  out->frames_decoded = ValueOr<uint32_t>(inbound.frames_decoded, 0);
+  out->frames_dropped = ValueOr<uint32_t>(inbound.frames_dropped, 0);
+  out->frames_received = ValueOr<uint32_t>(inbound.frames_received, 0);
+  out->frames_per_second = ValueOr(inbound.frames_per_second, 0.0);
+  out->jitter_buffer_delay_ms =
+      ValueOr(inbound.jitter_buffer_delay, 0.0) * 1000.0;
+  out->frame_width = ValueOr<uint32_t>(inbound.frame_width, 0);
+  out->frame_height = ValueOr<uint32_t>(inbound.frame_height, 0);
+  out->total_decode_time_ms = ValueOr(inbound.total_decode_time, 0.0) * 1000.0;
+  out->bytes_received =
+      static_cast<int64_t>(ValueOr<uint64_t>(inbound.bytes_received, 0));
+  out->decoder_implementation =
+      inbound.decoder_implementation.has_value()
+          ? absl::string_view(*inbound.decoder_implementation)
+          : absl::string_view();
+
+  out->has_timing_frame_info =
+      inbound.goog_timing_frame_info.has_value() &&
+      ParseTimingFrameInfo(*inbound.goog_timing_frame_info,
+                           &out->timing_frame_info);
+  return true;
+}
+
+bool ParseTimingFrameInfo(absl::string_view timing_info_str,
+                          webrtc::TimingFrameInfo* timing_info) {
+  if (!timing_info || timing_info_str.empty()) {
+    return false;
+  }
+
+  int64_t fields[kTimingFrameInfoFieldCount];
+  size_t pos = 0;
+  for (int64_t& field : fields) {
+    if (!ParseNextField(timing_info_str, &pos, &field)) {
+      return false;
+    }
+  }
+  // Trailing data means the format is not the one we know how to read.
+  if (pos != timing_info_str.size() + 1) {
+    return false;
+  }
+  if (fields[0] < 0 || fields[0] > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  timing_info->rtp_timestamp = static_cast<uint32_t>(fields[0]);
+  timing_info->capture_time_ms = fields[1];
+  timing_info->encode_start_ms = fields[2];
+  timing_info->encode_finish_ms = fields[3];
+  timing_info->packetization_finish_ms = fields[4];
+  timing_info->pacer_exit_ms = fields[5];
+  timing_info->network_timestamp_ms = fields[6];
+  timing_info->network2_timestamp_ms = fields[7];
+  timing_info->receive_start_ms = fields[8];
+  timing_info->receive_finish_ms = fields[9];
+  timing_info->decode_start_ms = fields[10];
+  timing_info->decode_finish_ms = fields[11];
+  timing_info->render_time_ms = fields[12];
+  // fields[13] is EndToEndDelay(), which is derived from the fields above.
+  uint8_t flags = webrtc::VideoSendTiming::kNotTriggered;
+  if (fields[14] != 0) {
+    flags |= webrtc::VideoSendTiming::kTriggeredBySize;
+  }
+  if (fields[15] != 0) {
+    flags |= webrtc::VideoSendTiming::kTriggeredByTimer;
+  }
+  timing_info->flags = flags;
+  return true;
+}
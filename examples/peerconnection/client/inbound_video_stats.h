@@ -0,0 +1,56 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_INBOUND_VIDEO_STATS_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_INBOUND_VIDEO_STATS_H_
+
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+#include "api/stats/rtc_stats.h"
+#include "api/video/video_timing.h"
+
+// Typed snapshot of the inbound-rtp video fields the client logs. Filled
+// straight from the RTCInboundRtpStreamStats members, so extracting it does
+// no string formatting and no heap allocation. Missing members keep their
+// default value.
+struct InboundVideoStats {
+  int64_t frames_decoded = 0;
+  int64_t frames_dropped = 0;
+  int64_t frames_received = 0;
+  double frames_per_second = 0.0;
+  double jitter_buffer_delay_ms = 0.0;
+  int64_t frame_width = 0;
+  int64_t frame_height = 0;
+  double total_decode_time_ms = 0.0;
+  int64_t bytes_received = 0;
+
+  // Points into the RTCStats object the sample was extracted from, so it is
+  // only valid as long as the owning report is alive. Empty if unknown.
+  absl::string_view decoder_implementation;
+
+  bool has_timing_frame_info = false;
+  webrtc::TimingFrameInfo timing_frame_info;
+};
+
+// Returns true if `stats` is an inbound-rtp entry of kind "video".
+bool IsInboundVideoStats(const webrtc::RTCStats& stats);
+
+// Fills `out` from an inbound-rtp video entry. Returns false, leaving `out`
+// untouched, if `stats` is not one.
+bool ExtractInboundVideoStats(const webrtc::RTCStats& stats,
+                              InboundVideoStats* out);
+
+// Parses the output of TimingFrameInfo::ToString() (as exposed through
+// `googTimingFrameInfo`) back into `timing_info` without allocating.
+bool ParseTimingFrameInfo(absl::string_view timing_info_str,
+                          webrtc::TimingFrameInfo* timing_info);
+
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_INBOUND_VIDEO_STATS_H_
@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "api/stats/attribute.h"
+#include "api/stats/rtcstats_objects.h"
+#include "api/units/timestamp.h"
+#include "api/video/video_timing.h"
+#include "benchmark/benchmark.h"
+#include "examples/peerconnection/client/inbound_video_stats.h"
+#include "rtc_base/system/unused.h"
+
+namespace {
+
+webrtc::RTCInboundRtpStreamStats CreateInboundVideoStats() {
+  webrtc::RTCInboundRtpStreamStats stats("ITbench", webrtc::Timestamp::Zero());
+  stats.kind = "video";
+  stats.frames_decoded = 12345;
+  stats.frames_dropped = 12;
+  stats.frames_received = 12400;
+  stats.frames_per_second = 59.8;
+  stats.jitter_buffer_delay = 123.456;
+  stats.frame_width = 3840;
+  stats.frame_height = 2160;
+  stats.total_decode_time = 45.678;
+  stats.bytes_received = 987654321;
+  stats.decoder_implementation = "libvpx";
+
+  webrtc::TimingFrameInfo timing;
+  timing.rtp_timestamp = 3000000000u;
+  timing.capture_time_ms = 1700000000000;
+  timing.encode_start_ms = 1700000000003;
+  timing.encode_finish_ms = 1700000000011;
+  timing.packetization_finish_ms = 1700000000012;
+  timing.pacer_exit_ms = 1700000000014;
+  timing.network_timestamp_ms = 1700000000020;
+  timing.network2_timestamp_ms = 1700000000024;
+  timing.receive_start_ms = 1700000000025;
+  timing.receive_finish_ms = 1700000000029;
+  timing.decode_start_ms = 1700000000031;
+  timing.decode_finish_ms = 1700000000036;
+  timing.render_time_ms = 1700000000050;
+  timing.flags = webrtc::VideoSendTiming::kTriggeredByTimer;
+  stats.goog_timing_frame_info = timing.ToString();
+  return stats;
+}
+
+// The string based extraction the stats callback used before
+// ExtractInboundVideoStats() existed, minus the logging.
+bool LegacyExtractInboundVideoStats(const webrtc::RTCStats& stats,
+                                    InboundVideoStats* out) {
+  std::vector<webrtc::Attribute> attributes = stats.Attributes();
+  auto find_attribute =
+      [&attributes](const std::string& name) -> const webrtc::Attribute* {
+    for (const auto& attribute : attributes) {
+      if (attribute.name() == name) {
+        return &attribute;
+      }
+    }
+    return nullptr;
+  };
+  auto get_numeric = [&find_attribute](const std::string& name) -> double {
+    const auto* attr = find_attribute(name);
+    if (!attr || attr->ToString() == "null") {
+      return 0;
+    }
+    const std::string& value_str = attr->ToString();
+    char* end;
+    double value = std::strtod(value_str.c_str(), &end);
+    return end == value_str.c_str() ? 0 : value;
+  };
+
+  const auto* kind = find_attribute("kind");
+  if (!kind || kind->ToString() != "video" ||
+      std::string(stats.type()) != "inbound-rtp") {
+    return false;
+  }
+
+  out->has_timing_frame_info = false;
+  if (const auto* timing_attr = find_attribute("googTimingFrameInfo")) {
+    std::istringstream iss(timing_attr->ToString());
+    std::vector<std::string> tokens;
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+      tokens.push_back(token);
+    }
+    if (tokens.size() == 16) {
+      int64_t* fields[] = {&out->timing_frame_info.capture_time_ms,
+                           &out->timing_frame_info.encode_start_ms,
+                           &out->timing_frame_info.encode_finish_ms,
+                           &out->timing_frame_info.packetization_finish_ms,
+                           &out->timing_frame_info.pacer_exit_ms,
+                           &out->timing_frame_info.network_timestamp_ms,
+                           &out->timing_frame_info.network2_timestamp_ms,
+                           &out->timing_frame_info.receive_start_ms,
+                           &out->timing_frame_info.receive_finish_ms,
+                           &out->timing_frame_info.decode_start_ms,
+                           &out->timing_frame_info.decode_finish_ms,
+                           &out->timing_frame_info.render_time_ms};
+      out->timing_frame_info.rtp_timestamp =
+          static_cast<uint32_t>(std::strtoll(tokens[0].c_str(), nullptr, 10));
+      for (size_t i = 0; i < std::size(fields); ++i) {
+        *fields[i] = std::strtoll(tokens[i + 1].c_str(), nullptr, 10);
+      }
+      out->has_timing_frame_info = true;
+    }
+  }
+
+  out->frames_decoded = static_cast<int64_t>(get_numeric("framesDecoded"));
+  out->frames_dropped = static_cast<int64_t>(get_numeric("framesDropped"));
+  out->frames_received = static_cast<int64_t>(get_numeric("framesReceived"));
+  out->frames_per_second = get_numeric("framesPerSecond");
+  out->jitter_buffer_delay_ms = get_numeric("jitterBufferDelay") * 1000.0;
+  out->frame_width = static_cast<int64_t>(get_numeric("frameWidth"));
+  out->frame_height = static_cast<int64_t>(get_numeric("frameHeight"));
+  out->total_decode_time_ms = get_numeric("totalDecodeTime") * 1000.0;
+  out->bytes_received = static_cast<int64_t>(get_numeric("bytesReceived"));
+  return true;
+}
+
+void BM_LegacyExtractInboundVideoStats(benchmark::State& state) {
+  const webrtc::RTCInboundRtpStreamStats stats = CreateInboundVideoStats();
+  InboundVideoStats out;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    bool ok = LegacyExtractInboundVideoStats(stats, &out);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(out);
+  }
+}
+
+void BM_ExtractInboundVideoStats(benchmark::State& state) {
+  const webrtc::RTCInboundRtpStreamStats stats = CreateInboundVideoStats();
+  InboundVideoStats out;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    bool ok = ExtractInboundVideoStats(stats, &out);
+    benchmark::DoNotOptimize(ok);
+    benchmark::DoNotOptimize(out);
+  }
+}
+
+BENCHMARK(BM_LegacyExtractInboundVideoStats);
+BENCHMARK(BM_ExtractInboundVideoStats);
+
+}  // namespace
@@ -0,0 +1,188 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/inbound_video_stats.h"
+
+#include <string>
+
+#include "api/stats/rtcstats_objects.h"
+#include "api/units/timestamp.h"
+#include "api/video/video_timing.h"
+#include "test/gtest.h"
+
+namespace {
+
+webrtc::TimingFrameInfo CreateTimingFrameInfo() {
+  webrtc::TimingFrameInfo timing;
+  timing.rtp_timestamp = 3000000000u;
+  timing.capture_time_ms = 1700000000000;
+  timing.encode_start_ms = 1700000000003;
+  timing.encode_finish_ms = 1700000000011;
+  timing.packetization_finish_ms = 1700000000012;
+  timing.pacer_exit_ms = 1700000000014;
+  timing.network_timestamp_ms = 1700000000020;
+  timing.network2_timestamp_ms = 1700000000024;
+  timing.receive_start_ms = 1700000000025;
+  timing.receive_finish_ms = 1700000000029;
+  timing.decode_start_ms = 1700000000031;
+  timing.decode_finish_ms = 1700000000036;
+  timing.render_time_ms = 1700000000050;
+  timing.flags = webrtc::VideoSendTiming::kTriggeredByTimer;
+  return timing;
+}
+
+void ExpectTimingFrameInfoEq(const webrtc::TimingFrameInfo& actual,
+                             const webrtc::TimingFrameInfo& expected) {
+  EXPECT_EQ(actual.rtp_timestamp, expected.rtp_timestamp);
+  EXPECT_EQ(actual.capture_time_ms, expected.capture_time_ms);
+  EXPECT_EQ(actual.encode_start_ms, expected.encode_start_ms);
+  EXPECT_EQ(actual.encode_finish_ms, expected.encode_finish_ms);
+  EXPECT_EQ(actual.packetization_finish_ms, expected.packetization_finish_ms);
+  EXPECT_EQ(actual.pacer_exit_ms, expected.pacer_exit_ms);
+  EXPECT_EQ(actual.network_timestamp_ms, expected.network_timestamp_ms);
+  EXPECT_EQ(actual.network2_timestamp_ms, expected.network2_timestamp_ms);
+  EXPECT_EQ(actual.receive_start_ms, expected.receive_start_ms);
+  EXPECT_EQ(actual.receive_finish_ms, expected.receive_finish_ms);
+  EXPECT_EQ(actual.decode_start_ms, expected.decode_start_ms);
+  EXPECT_EQ(actual.decode_finish_ms, expected.decode_finish_ms);
+  EXPECT_EQ(actual.render_time_ms, expected.render_time_ms);
+  EXPECT_EQ(actual.flags, expected.flags);
+}
+
+TEST(InboundVideoStatsTest, ParsesTimingFrameInfoString) {
+  const webrtc::TimingFrameInfo expected = CreateTimingFrameInfo();
+  webrtc::TimingFrameInfo parsed;
+  ASSERT_TRUE(ParseTimingFrameInfo(expected.ToString(), &parsed));
+  ExpectTimingFrameInfoEq(parsed, expected);
+}
+
+TEST(InboundVideoStatsTest, ParsesOutlierFlag) {
+  webrtc::TimingFrameInfo expected = CreateTimingFrameInfo();
+  expected.flags = webrtc::VideoSendTiming::kTriggeredBySize;
+  webrtc::TimingFrameInfo parsed;
+  ASSERT_TRUE(ParseTimingFrameInfo(expected.ToString(), &parsed));
+  EXPECT_EQ(parsed.flags, webrtc::VideoSendTiming::kTriggeredBySize);
+}
+
+TEST(InboundVideoStatsTest, RejectsMalformedTimingFrameInfo) {
+  const std::string valid = CreateTimingFrameInfo().ToString();
+  const std::string malformed[] = {
+      "",
+      ",",
+      "garbage",
+      // Too few fields.
+      "1,2,3",
+      valid.substr(0, valid.rfind(',')),
+      // Too many fields and trailing separators.
+      valid + ",1",
+      valid + ",",
+      // Empty and non-numeric fields.
+      "1,,3,4,5,6,7,8,9,10,11,12,13,14,0,0",
+      "1,2,3,4,5,6,7,8,9,10,11,12,13,14,0,x",
+      "1,2,3,4,5,6,7,8,9,10,11,12,13,14,0,0x",
+      // RTP timestamp outside the uint32_t range.
+      "-1,2,3,4,5,6,7,8,9,10,11,12,13,14,0,0",
+      "4294967296,2,3,4,5,6,7,8,9,10,11,12,13,14,0,0",
+  };
+  for (const std::string& str : malformed) {
+    webrtc::TimingFrameInfo parsed = CreateTimingFrameInfo();
+    EXPECT_FALSE(ParseTimingFrameInfo(str, &parsed)) << str;
+  }
+  EXPECT_FALSE(ParseTimingFrameInfo(valid, nullptr));
+}
+
+TEST(InboundVideoStatsTest, ExtractsInboundVideoStats) {
+  webrtc::RTCInboundRtpStreamStats stats("ITtest", webrtc::Timestamp::Zero());
+  stats.kind = "video";
+  stats.frames_decoded = 12345;
+  stats.frames_dropped = 12;
+  stats.frames_received = 12400;
+  stats.frames_per_second = 59.5;
+  stats.jitter_buffer_delay = 1.5;
+  stats.frame_width = 3840;
+  stats.frame_height = 2160;
+  stats.total_decode_time = 0.25;
+  stats.bytes_received = 987654321;
+  stats.decoder_implementation = "libvpx";
+  const webrtc::TimingFrameInfo timing = CreateTimingFrameInfo();
+  stats.goog_timing_frame_info = timing.ToString();
+
+  EXPECT_TRUE(IsInboundVideoStats(stats));
+  InboundVideoStats sample;
+  ASSERT_TRUE(ExtractInboundVideoStats(stats, &sample));
+  EXPECT_EQ(sample.frames_decoded, 12345);
+  EXPECT_EQ(sample.frames_dropped, 12);
+  EXPECT_EQ(sample.frames_received, 12400);
+  EXPECT_DOUBLE_EQ(sample.frames_per_second, 59.5);
+  EXPECT_DOUBLE_EQ(sample.jitter_buffer_delay_ms, 1500.0);
+  EXPECT_EQ(sample.frame_width, 3840);
+  EXPECT_EQ(sample.frame_height, 2160);
+  EXPECT_DOUBLE_EQ(sample.total_decode_time_ms, 250.0);
+  EXPECT_EQ(sample.bytes_received, 987654321);
+  EXPECT_EQ(sample.decoder_implementation, "libvpx");
+  ASSERT_TRUE(sample.has_timing_frame_info);
+  ExpectTimingFrameInfoEq(sample.timing_frame_info, timing);
+}
+
+TEST(InboundVideoStatsTest, MissingOptionalFieldsKeepDefaults) {
+  webrtc::RTCInboundRtpStreamStats stats("ITtest", webrtc::Timestamp::Zero());
+  stats.kind = "video";
+  stats.frames_decoded = 30;
+
+  InboundVideoStats sample;
+  ASSERT_TRUE(ExtractInboundVideoStats(stats, &sample));
+  EXPECT_EQ(sample.frames_decoded, 30);
+  EXPECT_EQ(sample.frames_dropped, 0);
+  EXPECT_EQ(sample.frames_received, 0);
+  EXPECT_DOUBLE_EQ(sample.frames_per_second, 0.0);
+  EXPECT_DOUBLE_EQ(sample.jitter_buffer_delay_ms, 0.0);
+  EXPECT_EQ(sample.frame_width, 0);
+  EXPECT_EQ(sample.frame_height, 0);
+  EXPECT_DOUBLE_EQ(sample.total_decode_time_ms, 0.0);
+  EXPECT_EQ(sample.bytes_received, 0);
+  EXPECT_TRUE(sample.decoder_implementation.empty());
+  EXPECT_FALSE(sample.has_timing_frame_info);
+}
+
+TEST(InboundVideoStatsTest, MalformedTimingFrameInfoIsNotReported) {
+  webrtc::RTCInboundRtpStreamStats stats("ITtest", webrtc::Timestamp::Zero());
+  stats.kind = "video";
+  stats.frames_decoded = 30;
+  stats.goog_timing_frame_info = "1,2,3";
+
+  InboundVideoStats sample;
+  ASSERT_TRUE(ExtractInboundVideoStats(stats, &sample));
+  EXPECT_EQ(sample.frames_decoded, 30);
+  EXPECT_FALSE(sample.has_timing_frame_info);
+}
+
+TEST(InboundVideoStatsTest, IgnoresOtherStats) {
+  webrtc::RTCInboundRtpStreamStats audio("ITaudio", webrtc::Timestamp::Zero());
+  audio.kind = "audio";
+  audio.bytes_received = 1000;
+  webrtc::RTCInboundRtpStreamStats no_kind("ITnokind",
+                                           webrtc::Timestamp::Zero());
+  webrtc::RTCOutboundRtpStreamStats outbound("OTvideo",
+                                             webrtc::Timestamp::Zero());
+  outbound.kind = "video";
+
+  for (const webrtc::RTCStats* stats :
+       {static_cast<const webrtc::RTCStats*>(&audio),
+        static_cast<const webrtc::RTCStats*>(&no_kind),
+        static_cast<const webrtc::RTCStats*>(&outbound)}) {
+    EXPECT_FALSE(IsInboundVideoStats(*stats)) << stats->id();
+    InboundVideoStats sample;
+    sample.bytes_received = 7;
+    EXPECT_FALSE(ExtractInboundVideoStats(*stats, &sample)) << stats->id();
+    EXPECT_EQ(sample.bytes_received, 7);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/latency_sketch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rtc_base/checks.h"
+
+namespace {
+
+constexpr double kGamma = (1 + LatencySketch::kRelativeAccuracy) /
+                          (1 - LatencySketch::kRelativeAccuracy);
+
+const double kLogGamma = std::log(kGamma);
+
+// Bucket 0 holds everything up to kMinValueMs. Bucket i > 0 holds
+// (kMinValueMs * gamma^(i-1), kMinValueMs * gamma^i].
+int BucketIndex(double value_ms) {
+  if (value_ms <= LatencySketch::kMinValueMs) {
+    return 0;
+  }
+  int index = static_cast<int>(std::ceil(
+      std::log(value_ms / LatencySketch::kMinValueMs) / kLogGamma));
+  return std::clamp(index, 1, LatencySketch::kNumBuckets - 1);
+}
+
+// The point whose relative distance to both bucket bounds is
+// kRelativeAccuracy.
+double BucketValue(int index) {
+  if (index == 0) {
+    return 0.0;
+  }
+  return std::min(LatencySketch::kMaxValueMs,
+                  2 * LatencySketch::kMinValueMs * std::pow(kGamma, index) /
+                      (kGamma + 1));
+}
+
+}  // namespace
+
+void LatencySketch::Add(double value_ms) {
+  if (!(value_ms >= 0)) {
+    return;
+  }
+  ++counts_[BucketIndex(value_ms)];
+  ++count_;
+}
+
+void LatencySketch::Merge(const LatencySketch& other) {
+  for (int i = 0; i < kNumBuckets; ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  count_ += other.count_;
+}
+
+void LatencySketch::Clear() {
+  counts_.fill(0);
+  count_ = 0;
+}
+
+std::optional<double> LatencySketch::Quantile(double q) const {
+  RTC_DCHECK_GE(q, 0.0);
+  RTC_DCHECK_LE(q, 1.0);
+  if (count_ == 0) {
+    return std::nullopt;
+  }
+  // Lower nearest rank, rather than the linear interpolation analyze_log.py
+  // gets from numpy.
+  const int64_t rank = static_cast<int64_t>(q * (count_ - 1));
+  int64_t seen = 0;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    seen += counts_[i];
+    if (seen > rank) {
+      return BucketValue(i);
+    }
+  }
+  return BucketValue(kNumBuckets - 1);
+}
+
+RollingLatencySketch::RollingLatencySketch(int num_slots)
+    : slots_(num_slots) {
+  RTC_DCHECK_GT(num_slots, 0);
+}
+
+const LatencySketch& RollingLatencySketch::Window() {
+  window_.Clear();
+  for (const LatencySketch& slot : slots_) {
+    window_.Merge(slot);
+  }
+  return window_;
+}
+
+void RollingLatencySketch::Advance() {
+  current_ = (current_ + 1) % slots_.size();
+  slots_[current_].Clear();
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_LATENCY_SKETCH_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_LATENCY_SKETCH_H_
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Fixed-memory quantile sketch for latencies in milliseconds, in the style of
+// DDSketch. Values are counted in logarithmically sized buckets, so every
+// quantile comes back within kRelativeAccuracy of a value that was actually
+// added, no matter how many values that is, and two sketches merge exactly by
+// adding their counts.
+class LatencySketch {
+ public:
+  static constexpr double kRelativeAccuracy = 0.01;
+  // Values up to kMinValueMs, including 0, are reported as 0; values above
+  // kMaxValueMs are clamped to it.
+  static constexpr double kMinValueMs = 0.1;
+  static constexpr double kMaxValueMs = 100000.0;
+  // ceil(log(kMaxValueMs / kMinValueMs) / log(gamma)) + 1 buckets, where
+  // gamma = (1 + kRelativeAccuracy) / (1 - kRelativeAccuracy).
+  static constexpr int kNumBuckets = 692;
+
+  // Negative values mean "unknown" in the stats logs and are ignored.
+  void Add(double value_ms);
+  void Merge(const LatencySketch& other);
+  void Clear();
+
+  int64_t count() const { return count_; }
+
+  // Returns the value at quantile `q` in [0, 1], or nullopt if the sketch is
+  // empty.
+  std::optional<double> Quantile(double q) const;
+
+ private:
+  std::array<uint32_t, kNumBuckets> counts_{};
+  int64_t count_ = 0;
+};
+
+// LatencySketch over a sliding window of the last `num_slots` intervals. The
+// caller adds samples to the current interval and calls Advance() at the end
+// of each one; Window() covers everything added since the oldest retained
+// interval started.
+class RollingLatencySketch {
+ public:
+  explicit RollingLatencySketch(int num_slots);
+
+  void Add(double value_ms) { slots_[current_].Add(value_ms); }
+
+  // Merges the retained intervals. The result stays valid until the next
+  // call to any method.
+  const LatencySketch& Window();
+  // Starts a new interval, dropping the oldest one.
+  void Advance();
+
+ private:
+  std::vector<LatencySketch> slots_;
+  size_t current_ = 0;
+  LatencySketch window_;
+};
+
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_LATENCY_SKETCH_H_
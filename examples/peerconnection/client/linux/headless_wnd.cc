@@ -46,7 +46,7 @@ void HeadlessWnd::RegisterObserver(MainWndCallback* callback) {
 }
 
 bool HeadlessWnd::IsWindow() {
-  return true;
+  return window_created_;
 }
 
 void HeadlessWnd::MessageBox(const char* caption, const char* text, bool is_error) {
@@ -79,15 +79,12 @@ void HeadlessWnd::StopRemoteRenderer() {
 }
 
 void HeadlessWnd::QueueUIThreadCallback(int msg_id, void* data) {
+  // Called from WebRTC threads; the conductor expects these on the thread
+  // that created the window, like with the GTK window.
   if (callback_) {
-    rtc::Thread* thread = rtc::Thread::Current();
-    if (thread) {
-      thread->PostTask([this, msg_id, data]() {
-        callback_->UIThreadCallback(msg_id, data);
-      });
-    } else {
-      RTC_LOG(LS_ERROR) << "No current thread available for UI callback";
-    }
+    ui_thread_->PostTask([this, msg_id, data]() {
+      callback_->UIThreadCallback(msg_id, data);
+    });
   }
 }
 
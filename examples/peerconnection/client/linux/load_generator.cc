@@ -0,0 +1,290 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/linux/load_generator.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <filesystem>
+#include <utility>
+
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/create_peerconnection_factory.h"
+#include "api/enable_media.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/video_codecs/builtin_video_decoder_factory.h"
+#include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/memory_usage.h"
+#include "rtc_base/time_utils.h"
+
+namespace {
+
+int64_t ThreadCpuTimeNanos(rtc::Thread* thread) {
+  return thread->BlockingCall([] { return rtc::GetThreadCpuTimeNanos(); });
+}
+
+double CpuPercent(int64_t cpu_ns, int64_t wall_ms) {
+  return wall_ms > 0 ? 100.0 * cpu_ns / (wall_ms * 1e6) : 0.0;
+}
+
+}  // namespace
+
+LoadGenerator::LoadGenerator(const Config& config)
+    : config_(config), thread_(rtc::Thread::Current()) {
+  RTC_DCHECK(thread_);
+  RTC_DCHECK_GT(config_.num_connections, 0);
+  RTC_DCHECK_GT(config_.num_rooms, 0);
+  RTC_DCHECK_GT(config_.num_factories, 0);
+}
+
+LoadGenerator::~LoadGenerator() {
+  Stop();
+}
+
+bool LoadGenerator::Start() {
+  RTC_DCHECK_RUN_ON(thread_);
+  RTC_DCHECK(!running_);
+
+  task_queue_factory_ = webrtc::CreateDefaultTaskQueueFactory();
+  factories_.resize(config_.num_factories);
+  for (Factory& factory : factories_) {
+    if (!CreateFactory(factory)) {
+      Stop();
+      return false;
+    }
+  }
+
+  if (config_.is_sender) {
+    video_source_ = FileVideoSource::Create(config_.y4m_path, /*target_fps=*/0,
+                                            *task_queue_factory_,
+                                            config_.pacing, config_.read_mode);
+    if (!video_source_) {
+      RTC_LOG(LS_ERROR) << "Load generator needs a readable --y4m_path";
+      Stop();
+      return false;
+    }
+  }
+
+  std::filesystem::create_directories(config_.log_dir);
+  std::string report_path = config_.log_dir + "/load_stats.csv";
+  report_file_ = fopen(report_path.c_str(), "w");
+  if (!report_file_) {
+    RTC_LOG(LS_ERROR) << "Failed to open " << report_path;
+    Stop();
+    return false;
+  }
+  fprintf(report_file_,
+          "elapsed_ms,connections_started,connections_connected,"
+          "process_cpu_percent,cpu_percent_per_connection,rss_bytes,"
+          "rss_bytes_per_connection,max_signaling_thread_cpu_percent,"
+          "max_worker_thread_cpu_percent,max_network_thread_cpu_percent\n");
+
+  running_ = true;
+  start_time_ms_ = rtc::TimeMillis();
+  last_report_time_ms_ = start_time_ms_;
+  last_process_cpu_ns_ = rtc::GetProcessCpuTimeNanos();
+  baseline_rss_bytes_ = rtc::GetProcessResidentSizeBytes();
+  RTC_LOG(LS_INFO) << "Load generator: " << config_.num_connections
+                   << " connections over " << config_.num_rooms
+                   << " rooms and " << config_.num_factories
+                   << " factories, baseline RSS " << baseline_rss_bytes_
+                   << " bytes";
+  if (config_.num_connections > 1) {
+    RTC_LOG(LS_WARNING) << "Load generator: per-frame timing "
+                           "(frame_timing.csv, sent_frame_timing.bin) is "
+                           "not recorded with more than one connection";
+  }
+
+  connections_.reserve(config_.num_connections);
+  StartNextConnection();
+  thread_->PostDelayedTask(
+      webrtc::SafeTask(safety_.flag(), [this] { Report(); }),
+      webrtc::TimeDelta::Millis(config_.report_interval_ms));
+  return true;
+}
+
+void LoadGenerator::Stop() {
+  RTC_DCHECK_RUN_ON(thread_);
+  running_ = false;
+  safety_.reset();
+
+  for (Connection& connection : connections_) {
+    connection.conductor->Close();
+    connection.wnd->Destroy();
+  }
+  connections_.clear();
+  video_source_ = nullptr;
+  // Factories must go before the threads they run on.
+  for (Factory& factory : factories_) {
+    factory.factory = nullptr;
+  }
+  factories_.clear();
+  task_queue_factory_ = nullptr;
+
+  if (report_file_) {
+    fclose(report_file_);
+    report_file_ = nullptr;
+  }
+}
+
+void LoadGenerator::Service() {
+  RTC_DCHECK_RUN_ON(thread_);
+  for (Connection& connection : connections_) {
+    connection.conductor->ServiceWebSocket();
+  }
+}
+
+bool LoadGenerator::CreateFactory(Factory& factory) {
+  factory.network_thread = rtc::Thread::CreateWithSocketServer();
+  factory.worker_thread = rtc::Thread::Create();
+  factory.signaling_thread = rtc::Thread::Create();
+  factory.network_thread->SetName("load_network", nullptr);
+  factory.worker_thread->SetName("load_worker", nullptr);
+  factory.signaling_thread->SetName("load_signaling", nullptr);
+  if (!factory.network_thread->Start() || !factory.worker_thread->Start() ||
+      !factory.signaling_thread->Start()) {
+    RTC_LOG(LS_ERROR) << "Failed to start load generator threads";
+    return false;
+  }
+
+  // Same media setup as Conductor::InitializePeerConnection(), with the
+  // threads owned here so they can be shared and measured.
+  webrtc::PeerConnectionFactoryDependencies deps;
+  deps.network_thread = factory.network_thread.get();
+  deps.worker_thread = factory.worker_thread.get();
+  deps.signaling_thread = factory.signaling_thread.get();
+  deps.task_queue_factory = webrtc::CreateDefaultTaskQueueFactory();
+  deps.audio_encoder_factory = webrtc::CreateBuiltinAudioEncoderFactory();
+  deps.audio_decoder_factory = webrtc::CreateBuiltinAudioDecoderFactory();
+  deps.video_encoder_factory = webrtc::CreateBuiltinVideoEncoderFactory();
+  deps.video_decoder_factory = webrtc::CreateBuiltinVideoDecoderFactory();
+  webrtc::EnableMedia(deps);
+  factory.factory = webrtc::CreateModularPeerConnectionFactory(std::move(deps));
+  if (!factory.factory) {
+    RTC_LOG(LS_ERROR) << "Failed to create shared PeerConnectionFactory";
+    return false;
+  }
+  return true;
+}
+
+void LoadGenerator::StartNextConnection() {
+  RTC_DCHECK_RUN_ON(thread_);
+  if (!running_ ||
+      connections_.size() >= static_cast<size_t>(config_.num_connections)) {
+    return;
+  }
+
+  const int index = static_cast<int>(connections_.size());
+  Factory& factory = factories_[index % factories_.size()];
+
+  Connection& connection = connections_.emplace_back();
+  connection.wnd = std::make_unique<HeadlessWnd>(config_.server.c_str(),
+                                                 config_.port,
+                                                 /*autoconnect=*/true,
+                                                 /*autocall=*/true);
+  connection.wnd->Create();
+  connection.client = std::make_unique<PeerConnectionClient>();
+  connection.conductor = rtc::make_ref_counted<Conductor>(
+      connection.client.get(), connection.wnd.get(), /*headless=*/true);
+
+  Conductor& conductor = *connection.conductor;
+  conductor.SetRoomId(config_.room_prefix + "_" +
+                      std::to_string(index % config_.num_rooms));
+  std::string log_dir = config_.log_dir + "/conn_" + std::to_string(index);
+  std::filesystem::create_directories(log_dir);
+  conductor.SetLogDirectory(log_dir);
+  conductor.SetStatsLogFormat(config_.stats_log_format);
+  // The per-frame timing sinks are process wide and can't tell connections
+  // apart, so per-frame timing is only recorded when there is one.
+  conductor.SetRecordFrameTiming(config_.num_connections == 1);
+  conductor.SetEmulationMode(/*is_emulation=*/false, config_.is_sender);
+  // The default six port range only fits a single connection.
+  conductor.SetPortRange(0, 0);
+  conductor.SetSharedMedia(factory.factory, video_source_,
+                           task_queue_factory_.get());
+  // Joins the room; blocks on the HTTP request.
+  conductor.Start();
+
+  thread_->PostDelayedTask(
+      webrtc::SafeTask(safety_.flag(), [this] { StartNextConnection(); }),
+      webrtc::TimeDelta::Millis(config_.ramp_interval_ms));
+}
+
+void LoadGenerator::Report() {
+  RTC_DCHECK_RUN_ON(thread_);
+  const int64_t now_ms = rtc::TimeMillis();
+  const int64_t wall_ms = now_ms - last_report_time_ms_;
+  last_report_time_ms_ = now_ms;
+
+  const int64_t process_cpu_ns = rtc::GetProcessCpuTimeNanos();
+  const double process_cpu_percent =
+      CpuPercent(process_cpu_ns - last_process_cpu_ns_, wall_ms);
+  last_process_cpu_ns_ = process_cpu_ns;
+
+  // A single saturated thread caps every connection on its factory, so
+  // report the busiest one of each kind rather than the average.
+  double max_signaling_percent = 0;
+  double max_worker_percent = 0;
+  double max_network_percent = 0;
+  for (Factory& factory : factories_) {
+    const int64_t signaling_ns =
+        ThreadCpuTimeNanos(factory.signaling_thread.get());
+    const int64_t worker_ns = ThreadCpuTimeNanos(factory.worker_thread.get());
+    const int64_t network_ns = ThreadCpuTimeNanos(factory.network_thread.get());
+    max_signaling_percent =
+        std::max(max_signaling_percent,
+                 CpuPercent(signaling_ns - factory.last_signaling_cpu_ns,
+                            wall_ms));
+    max_worker_percent = std::max(
+        max_worker_percent,
+        CpuPercent(worker_ns - factory.last_worker_cpu_ns, wall_ms));
+    max_network_percent = std::max(
+        max_network_percent,
+        CpuPercent(network_ns - factory.last_network_cpu_ns, wall_ms));
+    factory.last_signaling_cpu_ns = signaling_ns;
+    factory.last_worker_cpu_ns = worker_ns;
+    factory.last_network_cpu_ns = network_ns;
+  }
+
+  int connected = 0;
+  for (const Connection& connection : connections_) {
+    if (connection.conductor->media_connected()) {
+      ++connected;
+    }
+  }
+  const int started = static_cast<int>(connections_.size());
+  const int64_t rss_bytes = rtc::GetProcessResidentSizeBytes();
+  const double cpu_percent_per_connection =
+      connected > 0 ? process_cpu_percent / connected : 0.0;
+  const int64_t rss_bytes_per_connection =
+      started > 0 ? (rss_bytes - baseline_rss_bytes_) / started : 0;
+
+  fprintf(report_file_,
+          "%" PRId64 ",%d,%d,%.2f,%.3f,%" PRId64 ",%" PRId64 ",%.2f,%.2f,%.2f\n",
+          now_ms - start_time_ms_, started, connected, process_cpu_percent,
+          cpu_percent_per_connection, rss_bytes, rss_bytes_per_connection,
+          max_signaling_percent, max_worker_percent, max_network_percent);
+  fflush(report_file_);
+  RTC_LOG(LS_INFO) << "Load: " << connected << "/" << started
+                   << " connected, CPU " << process_cpu_percent << "% ("
+                   << cpu_percent_per_connection << "% per connection), RSS "
+                   << rss_bytes << " bytes (" << rss_bytes_per_connection
+                   << " per connection)";
+
+  thread_->PostDelayedTask(
+      webrtc::SafeTask(safety_.flag(), [this] { Report(); }),
+      webrtc::TimeDelta::Millis(config_.report_interval_ms));
+}
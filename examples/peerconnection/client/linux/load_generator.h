@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_LINUX_LOAD_GENERATOR_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_LINUX_LOAD_GENERATOR_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/peer_connection_interface.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "examples/peerconnection/client/conductor.h"
+#include "examples/peerconnection/client/file_video_source.h"
+#include "examples/peerconnection/client/frame_scheduler.h"
+#include "examples/peerconnection/client/linux/headless_wnd.h"
+#include "examples/peerconnection/client/peer_connection_client.h"
+#include "rtc_base/thread.h"
+
+// Runs many headless conductors in one process to find where an SFU, or this
+// client, stops scaling.
+//
+// All connections share one Y4M source, whose VideoBroadcaster fans each
+// frame out to every track, and a small number of PeerConnectionFactories,
+// so decoded frames, codec factories and WebRTC threads are paid for once
+// rather than per connection. Connections are spread round robin over
+// `num_rooms` rooms and `num_factories` factories, and are started one every
+// `ramp_interval_ms` so the report shows the load at which things degrade.
+//
+// Every `report_interval_ms` a row is appended to <log_dir>/load_stats.csv
+// with process CPU and resident memory, both in total and divided by the
+// number of connections, and the load of the busiest signaling, worker and
+// network thread. All methods must be called on the thread that runs the
+// signaling message loop.
+class LoadGenerator {
+ public:
+  struct Config {
+    std::string server;
+    int port = 0;
+    int num_connections = 1;
+    int num_rooms = 1;
+    // Room i is named "<room_prefix>_<i>".
+    std::string room_prefix = "load";
+    // Each factory owns one signaling, worker and network thread.
+    int num_factories = 1;
+    int ramp_interval_ms = 1000;
+    int report_interval_ms = 1000;
+    bool is_sender = true;
+    std::string y4m_path;
+    FrameScheduler::Mode pacing = FrameScheduler::Mode::kPaced;
+    FileVideoSource::ReadMode read_mode = FileVideoSource::ReadMode::kMapped;
+    StatsLogFormat stats_log_format = StatsLogFormat::kCsv;
+    std::string log_dir;
+  };
+
+  explicit LoadGenerator(const Config& config);
+  ~LoadGenerator();
+
+  LoadGenerator(const LoadGenerator&) = delete;
+  LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+  // Creates the shared factories and source and starts ramping up
+  // connections. Returns false if any of the shared resources can not be
+  // created.
+  bool Start();
+  // Closes every connection and tears down the shared resources.
+  void Stop();
+
+  // Drives the signaling websockets; call from the socket server loop.
+  void Service();
+
+ private:
+  struct Factory {
+    std::unique_ptr<rtc::Thread> network_thread;
+    std::unique_ptr<rtc::Thread> worker_thread;
+    std::unique_ptr<rtc::Thread> signaling_thread;
+    rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory;
+    // Thread CPU time at the previous report.
+    int64_t last_network_cpu_ns = 0;
+    int64_t last_worker_cpu_ns = 0;
+    int64_t last_signaling_cpu_ns = 0;
+  };
+
+  struct Connection {
+    std::unique_ptr<HeadlessWnd> wnd;
+    std::unique_ptr<PeerConnectionClient> client;
+    rtc::scoped_refptr<Conductor> conductor;
+  };
+
+  bool CreateFactory(Factory& factory);
+  void StartNextConnection();
+  void Report();
+
+  const Config config_;
+  rtc::Thread* const thread_;
+  bool running_ = false;
+
+  std::unique_ptr<webrtc::TaskQueueFactory> task_queue_factory_;
+  std::vector<Factory> factories_;
+  rtc::scoped_refptr<FileVideoSource> video_source_;
+  std::vector<Connection> connections_;
+
+  FILE* report_file_ = nullptr;
+  int64_t start_time_ms_ = 0;
+  int64_t last_report_time_ms_ = 0;
+  int64_t last_process_cpu_ns_ = 0;
+  // Resident memory once the shared resources exist; everything above it is
+  // attributed to the connections.
+  int64_t baseline_rss_bytes_ = 0;
+
+  webrtc::ScopedTaskSafety safety_;
+};
+
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_LINUX_LOAD_GENERATOR_H_
@@ -16,7 +16,12 @@
 #include "absl/flags/parse.h"
 #include "absl/flags/usage.h"
 #include "api/scoped_refptr.h"
+#include "api/test/network_emulation_manager.h"
+#include "api/units/time_delta.h"
 #include "examples/peerconnection/client/conductor.h"
+#if WEBRTC_ENABLE_PROTOBUF
+#include "examples/peerconnection/client/emulated_call.h"
+#endif
 #include "examples/peerconnection/client/flag_defs.h"
 #include "examples/peerconnection/client/linux/main_wnd.h"
 #include "examples/peerconnection/client/peer_connection_client.h"
@@ -42,6 +47,104 @@ ABSL_FLAG(std::string, log_date, "", "Date for log folder (YYYY-MM-DD)");
 
 ABSL_FLAG(bool, headless, false, 
     "Whether to run in headless or not");
+ABSL_FLAG(std::string, stats_log_format, "csv",
+    "Receiver stats log format: 'csv' or 'binary' (convert with convert_stats_log.py)");
+ABSL_FLAG(bool, per_frame_stats, true,
+    "Write every frame timing sample to per_frame_stats.csv; the rolling "
+    "latency percentiles in average_stats.csv are written either way");
+ABSL_FLAG(int, stats_interval_ms, 200,
+    "How often the receiver polls inbound-rtp stats, in milliseconds");
+ABSL_FLAG(std::string, frame_pacing, "paced",
+    "Y4M frame pacing: 'paced' for the file frame rate or 'burst' for no sleep");
+ABSL_FLAG(bool, y4m_mmap, false,
+    "Memory map the whole Y4M file up front instead of reading each frame from disk");
+ABSL_FLAG(bool, send_packet_batching, false,
+    "Send the video packets of each pacer burst with one sendmmsg() or UDP GSO "
+    "call instead of one sendto() each");
+ABSL_FLAG(bool, decode_thread_pool, false,
+    "Decode all received video streams on one thread pool with a thread per "
+    "core instead of on one decoder thread per stream");
+ABSL_FLAG(std::string, emulation_backend, "interface",
+    "Emulation backend: 'interface' for a shaped network interface or "
+    "'inprocess' to run both peers in this process over an emulated network");
+ABSL_FLAG(std::string, emulation_trace, "",
+    "In-process emulation: link trace for the sender to receiver direction "
+    "(empty for an unconstrained link)");
+ABSL_FLAG(std::string, emulation_reverse_trace, "",
+    "In-process emulation: link trace for the receiver to sender direction "
+    "(empty to reuse --emulation_trace)");
+ABSL_FLAG(webrtc::TimeMode, emulation_clock, webrtc::TimeMode::kRealTime,
+    "In-process emulation clock: 'realtime' or 'simulated'");
+ABSL_FLAG(int, emulation_duration_s, 60,
+    "In-process emulation: call duration in (emulated) seconds");
+
+namespace {
+
+std::string GetLogDate() {
+  std::string date = absl::GetFlag(FLAGS_log_date);
+  if (date.empty()) {
+      std::time_t now = std::time(nullptr);
+      char date_buf[20];  // Increased buffer size for full timestamp
+      std::strftime(date_buf, sizeof(date_buf), "%Y-%m-%d_%H-%M-%S", std::localtime(&now));
+      date = date_buf;
+  }
+  return date;
+}
+
+// Runs sender and receiver in this process; see EmulatedCall.
+int RunInProcessEmulation() {
+#if WEBRTC_ENABLE_PROTOBUF
+  if (absl::GetFlag(FLAGS_y4m_path).empty()) {
+    printf("Error: --y4m_path is required for in-process emulation.\n");
+    return -1;
+  }
+  FrameScheduler::Mode frame_pacing;
+  if (!ParseFrameSchedulerMode(absl::GetFlag(FLAGS_frame_pacing),
+                               &frame_pacing)) {
+    printf("Error: Unknown --frame_pacing '%s'.\n",
+           absl::GetFlag(FLAGS_frame_pacing).c_str());
+    return -1;
+  }
+  StatsLogFormat stats_log_format;
+  if (!ParseStatsLogFormat(absl::GetFlag(FLAGS_stats_log_format),
+                           &stats_log_format)) {
+    printf("Error: Unknown --stats_log_format '%s'.\n",
+           absl::GetFlag(FLAGS_stats_log_format).c_str());
+    return -1;
+  }
+
+  EmulatedCall::Config config;
+  config.y4m_path = absl::GetFlag(FLAGS_y4m_path);
+  config.pacing = frame_pacing;
+  config.read_mode = absl::GetFlag(FLAGS_y4m_mmap)
+                         ? FileVideoSource::ReadMode::kMapped
+                         : FileVideoSource::ReadMode::kFromDisk;
+  config.trace_path = absl::GetFlag(FLAGS_emulation_trace);
+  config.reverse_trace_path = absl::GetFlag(FLAGS_emulation_reverse_trace);
+  config.time_mode = absl::GetFlag(FLAGS_emulation_clock);
+  config.duration =
+      webrtc::TimeDelta::Seconds(absl::GetFlag(FLAGS_emulation_duration_s));
+  config.log_dir = "webrtc_logs/" + GetLogDate() + "_" +
+                   absl::GetFlag(FLAGS_room_id) + "_inprocess";
+  config.stats_log_format = stats_log_format;
+  config.per_frame_stats = absl::GetFlag(FLAGS_per_frame_stats);
+  config.stats_interval_ms = absl::GetFlag(FLAGS_stats_interval_ms);
+
+  rtc::InitializeSSL();
+  bool ok;
+  {
+    EmulatedCall call(config);
+    ok = call.Run();
+  }
+  rtc::CleanupSSL();
+  return ok ? 0 : -1;
+#else
+  printf("Error: In-process emulation needs a build with protobuf.\n");
+  return -1;
+#endif
+}
+
+}  // namespace
 
 class CustomSocketServer : public rtc::PhysicalSocketServer {
  public:
@@ -97,12 +200,71 @@ Experiment Mode Options:
                              - true: Send video only
                              - false: Receive video only
 
-  --network_interface=<name>  Network interface to use (required in emulation mode)
+  --network_interface=<name>  Network interface to use (required in emulation
+                             mode with the 'interface' backend)
                              Example: eth0, wlan0
 
+  --emulation_backend=<name>  How emulation mode shapes the network
+                             (default: interface)
+                             - 'interface': a real, externally shaped network
+                               interface; sender and receiver are separate
+                               processes connected through the server
+                             - 'inprocess': sender and receiver run in this
+                               process over NetworkEmulationManager endpoints;
+                               --is_sender and the server are not used
+  --emulation_trace=<path>    Sender to receiver link trace for 'inprocess'.
+                             One entry per line:
+                               <time_ms> <capacity_kbps> <delay_ms>
+                                   [<loss_percent> [<queue_packets>]]
+                             '#' starts a comment, capacity 0 is unlimited and
+                             "repeat <ms>" loops the trace <ms> after its last
+                             entry
+  --emulation_reverse_trace=<path>
+                             Receiver to sender link trace (default: same as
+                             --emulation_trace)
+  --emulation_clock=<clock>   'realtime' (default) or 'simulated'; simulated
+                             time runs the call as fast as the CPU allows
+  --emulation_duration_s=<s>  Length of an 'inprocess' call (default: 60)
+
+Logging Options:
+  --stats_log_format=<fmt>  Receiver stats log format (default: csv)
+                            - 'csv': per_frame_stats.csv / average_stats.csv
+                            - 'binary': stats.bin, convert with
+                              convert_stats_log.py
+  --per_frame_stats=<bool>  Write a per_frame_stats row for every frame timing
+                            sample (default: true). average_stats.csv always
+                            has p0.1 to p99.9 of encoding, network, decoding,
+                            rendering and e2e latency over the last 10 s,
+                            updated every second, so long runs can turn this
+                            off
+  --stats_interval_ms=<ms>  Receiver stats polling interval (default: 200).
+                            Only inbound-rtp stats are gathered, so 50 ms or
+                            less is fine
+  Senders always write sent_frame_timing.bin, the capture, encode,
+  packetization and pacer exit time of every frame; join it with the
+  receiver's frame_timing.csv using join_frame_timing.py.
+
 Video Source Options:
   --y4m_path=<path>         Path to Y4M file to use as video source
                             If not specified, uses test pattern
+  --frame_pacing=<mode>     How Y4M frames are delivered (default: paced)
+                            - 'paced': at the file frame rate, on absolute
+                              deadlines; late frames are skipped and counted
+                            - 'burst': back to back, to measure the maximum
+                              sustainable encode rate
+  --y4m_mmap                Map the Y4M file into memory once so playback
+                            does no file I/O or allocation per frame
+
+Network Options:
+  --send_packet_batching    Hand the video packets of each pacer burst to
+                            the socket together, sent with one sendmmsg()
+                            call, or one UDP GSO send when they have the
+                            same size (Linux only, default: false)
+
+Receiver Options:
+  --decode_thread_pool      Decode all received video streams on one pool
+                            with a thread per core instead of one thread
+                            per stream (default: false)
 
 Example Commands:
   # Run as video sender using Y4M file:
@@ -113,6 +275,13 @@ Example Commands:
   # Run as video receiver:
   ./peerconnection_client --experiment_mode=emulation --is_sender=false \
       --network_interface=eth0 --server=localhost --port=8888
+
+  # Run both peers in one process over a trace-driven link, 10 minutes of
+  # call in simulated time:
+  ./peerconnection_client --experiment_mode=emulation \
+      --emulation_backend=inprocess --emulation_trace=/path/to/link.trace \
+      --emulation_clock=simulated --emulation_duration_s=600 \
+      --y4m_path=/path/to/video.y4m
 )";
 
   // Set the usage message
@@ -151,10 +320,23 @@ Example Commands:
     printf("Use --help for usage information.\n");
     return -1;
   }
+  if (absl::GetFlag(FLAGS_stats_interval_ms) <= 0) {
+    printf("Error: --stats_interval_ms must be positive.\n");
+    return -1;
+  }
 
   // Validate emulation mode settings
   std::string experiment_mode = absl::GetFlag(FLAGS_experiment_mode);
   bool is_emulation = (experiment_mode == "emulation");
+  const std::string emulation_backend = absl::GetFlag(FLAGS_emulation_backend);
+  if (emulation_backend != "interface" && emulation_backend != "inprocess") {
+    printf("Error: Unknown --emulation_backend '%s'.\n",
+           emulation_backend.c_str());
+    return -1;
+  }
+  if (is_emulation && emulation_backend == "inprocess") {
+    return RunInProcessEmulation();
+  }
   
   if (is_emulation && absl::GetFlag(FLAGS_network_interface).empty()) {
     printf("Error: Network interface (--network_interface) is required in emulation mode.\n");
@@ -179,13 +361,7 @@ Example Commands:
   conductor->SetRoomId(absl::GetFlag(FLAGS_room_id));
 
   // Get log date - if empty, use current date
-  std::string date = absl::GetFlag(FLAGS_log_date);
-  if (date.empty()) {
-      std::time_t now = std::time(nullptr);
-      char date_buf[20];  // Increased buffer size for full timestamp
-      std::strftime(date_buf, sizeof(date_buf), "%Y-%m-%d_%H-%M-%S", std::localtime(&now));
-      date = date_buf;
-  }
+  std::string date = GetLogDate();
     
   // Create log directory path
   std::string room_id = absl::GetFlag(FLAGS_room_id);
@@ -199,10 +375,35 @@ Example Commands:
   // Pass log_dir to conductor
   conductor->SetLogDirectory(log_dir);
 
+  StatsLogFormat stats_log_format;
+  if (!ParseStatsLogFormat(absl::GetFlag(FLAGS_stats_log_format),
+                           &stats_log_format)) {
+    printf("Error: Unknown --stats_log_format '%s'.\n",
+           absl::GetFlag(FLAGS_stats_log_format).c_str());
+    return -1;
+  }
+  conductor->SetStatsLogFormat(stats_log_format);
+  conductor->SetPerFrameStats(absl::GetFlag(FLAGS_per_frame_stats));
+  conductor->SetStatsIntervalMs(absl::GetFlag(FLAGS_stats_interval_ms));
+
   // Configure experiment mode
   conductor->SetEmulationMode(is_emulation, is_sender);
   conductor->SetY4mPath(absl::GetFlag(FLAGS_y4m_path));
 
+  FrameScheduler::Mode frame_pacing;
+  if (!ParseFrameSchedulerMode(absl::GetFlag(FLAGS_frame_pacing),
+                               &frame_pacing)) {
+    printf("Error: Unknown --frame_pacing '%s'.\n",
+           absl::GetFlag(FLAGS_frame_pacing).c_str());
+    return -1;
+  }
+  conductor->SetFramePacing(frame_pacing);
+  conductor->SetSendPacketBatching(absl::GetFlag(FLAGS_send_packet_batching));
+  conductor->SetDecodeThreadPool(absl::GetFlag(FLAGS_decode_thread_pool));
+  conductor->SetY4mReadMode(absl::GetFlag(FLAGS_y4m_mmap)
+                                ? FileVideoSource::ReadMode::kMapped
+                                : FileVideoSource::ReadMode::kFromDisk);
+
   if (is_emulation) {
     conductor->SetNetInterface(absl::GetFlag(FLAGS_network_interface));
   }
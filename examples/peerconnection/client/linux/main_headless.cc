@@ -12,11 +12,17 @@
 #include <gtk/gtk.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <ctime>
+#include <string>
+
+#include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
 #include "api/scoped_refptr.h"
 #include "examples/peerconnection/client/conductor.h"
 #include "examples/peerconnection/client/flag_defs.h"
 #include "examples/peerconnection/client/linux/headless_wnd.h"
+#include "examples/peerconnection/client/linux/load_generator.h"
 #include "examples/peerconnection/client/peer_connection_client.h"
 #include "rtc_base/physical_socket_server.h"
 #include "rtc_base/ssl_adapter.h"
@@ -24,6 +30,25 @@
 #include "system_wrappers/include/field_trial.h"
 #include "test/field_trial.h"
 
+ABSL_FLAG(int, load_connections, 0,
+    "Load mode: number of peer connections to run in this process "
+    "(0 runs a single regular client)");
+ABSL_FLAG(int, load_rooms, 1,
+    "Load mode: rooms to spread the connections over, named <room_id>_<n>");
+ABSL_FLAG(int, load_factories, 1,
+    "Load mode: PeerConnectionFactories, each with its own signaling, worker "
+    "and network thread, to spread the connections over");
+ABSL_FLAG(int, load_ramp_interval_ms, 1000,
+    "Load mode: delay between starting consecutive connections");
+ABSL_FLAG(int, load_report_interval_ms, 1000,
+    "Load mode: interval between rows in load_stats.csv");
+ABSL_FLAG(int, load_duration_s, 0,
+    "Load mode: stop after this many seconds (0 runs until killed)");
+ABSL_FLAG(bool, load_receive, false,
+    "Load mode: receive instead of send on every connection");
+ABSL_FLAG(std::string, y4m_path, "",
+    "Load mode: Y4M file shared by all sending connections");
+
 class CustomSocketServer : public rtc::PhysicalSocketServer {
  public:
   explicit CustomSocketServer(HeadlessWnd* wnd)
@@ -34,15 +59,24 @@ class CustomSocketServer : public rtc::PhysicalSocketServer {
 
   void set_client(PeerConnectionClient* client) { client_ = client; }
   void set_conductor(Conductor* conductor) { conductor_ = conductor; }
+  void set_load_generator(LoadGenerator* load_generator) {
+    load_generator_ = load_generator;
+  }
 
   bool Wait(webrtc::TimeDelta max_wait_duration, bool process_io) override {
+    if (load_generator_) {
+      load_generator_->Service();
+      return rtc::PhysicalSocketServer::Wait(webrtc::TimeDelta::Millis(10),
+                                             process_io);
+    }
+
     // Service WebSocket client
     if (conductor_) {
       conductor_->ServiceWebSocket();
     }
 
     // Check for disconnection
-    if (!conductor_->connection_active() &&
+    if (conductor_ && !conductor_->connection_active() &&
         client_ != NULL && !client_->is_connected()) {
       RTC_LOG(LS_INFO) << "Connection ended, quitting message loop";
       message_queue_->Quit();
@@ -57,8 +91,58 @@ class CustomSocketServer : public rtc::PhysicalSocketServer {
   HeadlessWnd* wnd_;
   Conductor* conductor_;
   PeerConnectionClient* client_;
+  LoadGenerator* load_generator_ = nullptr;
 };
 
+// Runs --load_connections peer connections in this process until
+// --load_duration_s expires or the process is killed.
+int RunLoadGenerator(const std::string& server) {
+  std::string room_id = absl::GetFlag(FLAGS_room_id);
+  if (room_id.empty()) {
+    room_id = "load";
+  }
+  std::time_t now = std::time(nullptr);
+  char date[20];
+  std::strftime(date, sizeof(date), "%Y-%m-%d_%H-%M-%S", std::localtime(&now));
+
+  LoadGenerator::Config config;
+  config.server = server;
+  config.port = absl::GetFlag(FLAGS_port);
+  config.num_connections = absl::GetFlag(FLAGS_load_connections);
+  config.num_rooms = std::max(1, absl::GetFlag(FLAGS_load_rooms));
+  config.room_prefix = room_id;
+  config.num_factories = std::max(1, absl::GetFlag(FLAGS_load_factories));
+  config.ramp_interval_ms = absl::GetFlag(FLAGS_load_ramp_interval_ms);
+  config.report_interval_ms =
+      std::max(100, absl::GetFlag(FLAGS_load_report_interval_ms));
+  config.is_sender = !absl::GetFlag(FLAGS_load_receive);
+  config.y4m_path = absl::GetFlag(FLAGS_y4m_path);
+  config.log_dir = std::string("webrtc_logs/") + date + "_" + room_id + "/load";
+
+  CustomSocketServer socket_server(nullptr);
+  rtc::AutoSocketServerThread thread(&socket_server);
+  rtc::InitializeSSL();
+
+  LoadGenerator load_generator(config);
+  if (!load_generator.Start()) {
+    rtc::CleanupSSL();
+    return -1;
+  }
+  socket_server.set_load_generator(&load_generator);
+
+  const int duration_s = absl::GetFlag(FLAGS_load_duration_s);
+  if (duration_s > 0) {
+    thread.PostDelayedTask([&thread] { thread.Quit(); },
+                           webrtc::TimeDelta::Seconds(duration_s));
+  }
+  thread.Run();
+
+  socket_server.set_load_generator(nullptr);
+  load_generator.Stop();
+  rtc::CleanupSSL();
+  return 0;
+}
+
 
 int main(int argc, char* argv[]) {
   RTC_LOG(LS_INFO) << "Initializing headless WebRTC client...";
@@ -83,6 +167,10 @@ int main(int argc, char* argv[]) {
   // Create headless window
   const std::string server = absl::GetFlag(FLAGS_server);
   RTC_LOG(LS_INFO) << "Connecting to server: " << server;
+
+  if (absl::GetFlag(FLAGS_load_connections) > 0) {
+    return RunLoadGenerator(server);
+  }
   
   HeadlessWnd wnd(server.c_str(), absl::GetFlag(FLAGS_port),
                   true,  // autoconnect
@@ -103,7 +191,8 @@ int main(int argc, char* argv[]) {
 
   // Create peer connection client and conductor
   PeerConnectionClient client;
-  auto conductor = rtc::make_ref_counted<Conductor>(&client, &wnd);
+  auto conductor =
+      rtc::make_ref_counted<Conductor>(&client, &wnd, /*headless=*/true);
   socket_server.set_client(&client);
   socket_server.set_conductor(conductor.get());
 
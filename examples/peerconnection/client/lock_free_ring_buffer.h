@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_LOCK_FREE_RING_BUFFER_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_LOCK_FREE_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "rtc_base/checks.h"
+
+// Bounded, allocation free (after construction) multi-producer ring buffer.
+// Producers never block: TryPush() fails when the buffer is full so the
+// caller can count the drop and move on. TryPop() must only be called from a
+// single consumer thread at a time.
+//
+// Each slot carries a sequence number that tells producers and the consumer
+// whether the slot is free or holds a published value for the current lap,
+// which avoids a lock without needing a separate "committed" index.
+template <typename T>
+class LockFreeRingBuffer {
+ public:
+  // `capacity` is rounded up to the next power of two.
+  explicit LockFreeRingBuffer(size_t capacity)
+      : mask_(RoundUpToPowerOfTwo(capacity) - 1),
+        slots_(new Slot[mask_ + 1]) {
+    for (size_t i = 0; i <= mask_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  LockFreeRingBuffer(const LockFreeRingBuffer&) = delete;
+  LockFreeRingBuffer& operator=(const LockFreeRingBuffer&) = delete;
+
+  size_t capacity() const { return mask_ + 1; }
+
+  bool TryPush(const T& value) {
+    size_t pos = push_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = slots_[pos & mask_];
+      size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (push_pos_.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // The consumer has not released this slot from the previous lap yet.
+        return false;
+      } else {
+        pos = push_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool TryPop(T* value) {
+    RTC_DCHECK(value);
+    size_t pos = pop_pos_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[pos & mask_];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0) {
+      return false;  // Empty, or the producer has not published yet.
+    }
+    *value = slot.value;
+    pop_pos_.store(pos + 1, std::memory_order_relaxed);
+    slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static size_t RoundUpToPowerOfTwo(size_t value) {
+    RTC_DCHECK_GT(value, 0);
+    size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  const size_t mask_;
+  const std::unique_ptr<Slot[]> slots_;
+  // Kept on separate cache lines so producers and the consumer do not
+  // invalidate each other's position on every operation.
+  alignas(64) std::atomic<size_t> push_pos_{0};
+  alignas(64) std::atomic<size_t> pop_pos_{0};
+};
+
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_LOCK_FREE_RING_BUFFER_H_
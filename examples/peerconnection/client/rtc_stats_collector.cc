@@ -2,13 +2,36 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
 
+namespace {
+
+// Latency of each pipeline stage of one frame, -1 where a timestamp is
+// missing. The sender side stages are only known for frames that carried the
+// video-timing header extension.
+std::array<int64_t, kNumLatencyMetrics> StageLatencies(
+    const webrtc::TimingFrameInfo& timing) {
+    auto diff = [](int64_t end_ms, int64_t start_ms) -> int64_t {
+        return end_ms >= 0 && start_ms >= 0 ? end_ms - start_ms : -1;
+    };
+    std::array<int64_t, kNumLatencyMetrics> latency;
+    latency[kEncodingLatency] =
+        diff(timing.encode_finish_ms, timing.encode_start_ms);
+    latency[kNetworkLatency] =
+        diff(timing.network2_timestamp_ms, timing.pacer_exit_ms);
+    latency[kDecodingLatency] =
+        diff(timing.decode_finish_ms, timing.decode_start_ms);
+    latency[kRenderingLatency] =
+        diff(timing.render_time_ms, timing.decode_finish_ms);
+    latency[kE2eLatency] = diff(timing.decode_finish_ms, timing.capture_time_ms);
+    return latency;
+}
+
+}  // namespace
+
 RTCStatsCollectorCallback::RTCStatsCollectorCallback(
-    std::ofstream& per_frame_stats_file,
-    std::ofstream& average_stats_file,
+    StatsLogWriter& stats_log_writer,
     std::mutex& stats_mutex,
     PersistentStats& persistent_stats)  // Add persistent stats
-    : per_frame_stats_file_(per_frame_stats_file),
-        average_stats_file_(average_stats_file),
+    : stats_log_writer_(stats_log_writer),
         stats_mutex_(stats_mutex),
         persistent_stats_(persistent_stats) {
     RTC_LOG(LS_INFO) << "RTCStatsCollectorCallback created.";
@@ -25,121 +48,19 @@ void RTCStatsCollectorCallback::OnStatsDelivered(
 }
 
 
-template <typename T>
-bool safe_parse(const std::string& str, T* out) {
-    static_assert(std::is_integral<T>::value, "safe_parse requires integral types");
-    char* end = nullptr;
-    int64_t value = std::strtoll(str.c_str(), &end, 10);
-    if (end == nullptr || *end != '\0') {
-        return false;
-    }
-    if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max()) {
-        return false;
-    }
-    *out = static_cast<T>(value);
-    return true;
-}
-
-bool ParseTimingFrameInfo(const std::string& timing_info_str, webrtc::TimingFrameInfo* timing_info) {
-    if (!timing_info || timing_info_str.empty()) {
-        return false;
-    }
-
-    std::istringstream iss(timing_info_str);
-    std::vector<std::string> tokens;
-    std::string token;
-
-    // Split the string into tokens by comma
-    while (std::getline(iss, token, ',')) {
-        tokens.push_back(token);
-    }
-
-    if (tokens.size() != 16) {  // Adjust for 16 fields in the log
-        RTC_LOG(LS_ERROR) << "Invalid timing info string: " << timing_info_str;
-        return false;
-    }
-
-    // Use safe_parse to handle the parsing
-    if (!safe_parse(tokens[0], &timing_info->rtp_timestamp) ||
-        !safe_parse(tokens[1], &timing_info->capture_time_ms) ||
-        !safe_parse(tokens[2], &timing_info->encode_start_ms) ||
-        !safe_parse(tokens[3], &timing_info->encode_finish_ms) ||
-        !safe_parse(tokens[4], &timing_info->packetization_finish_ms) ||
-        !safe_parse(tokens[5], &timing_info->pacer_exit_ms) ||
-        !safe_parse(tokens[6], &timing_info->network_timestamp_ms) ||
-        !safe_parse(tokens[7], &timing_info->network2_timestamp_ms) ||
-        !safe_parse(tokens[8], &timing_info->receive_start_ms) ||
-        !safe_parse(tokens[9], &timing_info->receive_finish_ms) ||
-        !safe_parse(tokens[10], &timing_info->decode_start_ms) ||
-        !safe_parse(tokens[11], &timing_info->decode_finish_ms) ||
-        !safe_parse(tokens[12], &timing_info->render_time_ms)) {// bool-like integer
-        RTC_LOG(LS_ERROR) << "Error parsing timing info string: " << timing_info_str;
-        return false;
-    }
-
-    return true;
-}
-
-void RTCStatsCollectorCallback::ProcessInboundRTPStats(const webrtc::RTCStats& stats) {
-    std::vector<webrtc::Attribute> attributes = stats.Attributes();
-    auto find_attribute = [&attributes](const std::string& name) -> const webrtc::Attribute* {
-        for (const auto& attribute : attributes) {
-            if (attribute.name() == name) {
-                RTC_LOG(LS_INFO) << "Found attribute " << name << " = " << attribute.ToString();
-                return &attribute;
-            }
-        }
-        RTC_LOG(LS_WARNING) << "Attribute not found: " << name;
-        return nullptr;
-    };
-
-    // Helper function to get numeric values safely without exceptions
-    auto get_numeric = [&find_attribute](const std::string& name, double default_value = 0) -> double {
-        const auto* attr = find_attribute(name);
-        if (!attr || attr->ToString() == "null") {
-            return default_value;  // Return default if null
-        }
-        const std::string& value_str = attr->ToString();
-        char* end;
-        double value = std::strtod(value_str.c_str(), &end);
-        if (end == value_str.c_str()) {
-            RTC_LOG(LS_WARNING) << "Failed to convert value for " << name << ": " << value_str;
-            return default_value;  // Return default on conversion failure
-        }
-        RTC_LOG(LS_INFO) << "Got numeric value for " << name << ": " << value;
-        return value;
-    };
-
-    const auto* timing_info_attr = find_attribute("googTimingFrameInfo");
-    
+void RTCStatsCollectorCallback::ProcessInboundRTPStats(const InboundVideoStats& stats) {
     std::lock_guard<std::mutex> lock(stats_mutex_); 
-    if (timing_info_attr) {
-         // Extract the timing info as a string
-        std::string timing_info_str = timing_info_attr->ToString();
-
-        // Parse the timing info string into TimingFrameInfo
-        webrtc::TimingFrameInfo timing_info;
-        if (ParseTimingFrameInfo(timing_info_str, &timing_info) && timing_info.encode_start_ms > 10000) {
+    if (stats.has_timing_frame_info) {
+        const webrtc::TimingFrameInfo& timing_info = stats.timing_frame_info;
+        if (timing_info.encode_start_ms > 10000) {
             // Calculate timing stages
-            int64_t encoding_ms = (timing_info.encode_finish_ms >= 0 && timing_info.encode_start_ms >= 0)
-                                    ? timing_info.encode_finish_ms - timing_info.encode_start_ms
-                                    : -1;
-
-            int64_t network_ms = (timing_info.network2_timestamp_ms >= 0 && timing_info.pacer_exit_ms >= 0)
-                                    ? timing_info.network2_timestamp_ms - timing_info.pacer_exit_ms
-                                    : -1;
-
-            int64_t decoding_ms = (timing_info.decode_finish_ms >= 0 && timing_info.decode_start_ms >= 0)
-                                    ? timing_info.decode_finish_ms - timing_info.decode_start_ms
-                                    : -1;
-
-            int64_t rendering_ms = (timing_info.render_time_ms >= 0 && timing_info.decode_finish_ms >= 0)
-                                    ? timing_info.render_time_ms - timing_info.decode_finish_ms
-                                    : -1;
-
-            int64_t e2e_ms = (timing_info.capture_time_ms >= 0 && timing_info.decode_finish_ms >= 0)
-                                ? timing_info.decode_finish_ms - timing_info.capture_time_ms
-                                : -1;
+            const std::array<int64_t, kNumLatencyMetrics> latency =
+                StageLatencies(timing_info);
+            int64_t encoding_ms = latency[kEncodingLatency];
+            int64_t network_ms = latency[kNetworkLatency];
+            int64_t decoding_ms = latency[kDecodingLatency];
+            int64_t rendering_ms = latency[kRenderingLatency];
+            int64_t e2e_ms = latency[kE2eLatency];
 
             // Calculate inter-frame timing (delta between current and last render_time_ms)
             int64_t inter_frame_ms = -1;
@@ -153,19 +74,24 @@ void RTCStatsCollectorCallback::ProcessInboundRTPStats(const webrtc::RTCStats& s
                                                 ? timing_info.receive_finish_ms - timing_info.receive_start_ms
                                                 : -1;
 
-            // Log the frame timings to the file
-            {
-                if (per_frame_stats_file_.is_open()) {
-                    per_frame_stats_file_ << rtc::TimeMillis() << "," << timing_info.rtp_timestamp << ","
-                                        << encoding_ms << ","
-                                        << network_ms << ","
-                                        << decoding_ms << ","
-                                        << rendering_ms << ","
-                                        << e2e_ms << ","
-                                        << inter_frame_ms << ","
-                                        << intra_construction_ms << "\n";
-                    per_frame_stats_file_.flush();
-                }
+            // The percentiles are fed with every decoded frame through
+            // RTCStatsCollector::AddFrameTiming(), not with this one timing
+            // frame per poll, which is the longest frame of the interval.
+
+            // Hand the frame timings to the writer; it buffers in memory and
+            // does the file I/O on its own thread.
+            if (persistent_stats_.write_per_frame_) {
+                PerFrameStatsRecord record;
+                record.timestamp_ms = rtc::TimeMillis();
+                record.rtp_timestamp = timing_info.rtp_timestamp;
+                record.encoding_ms = encoding_ms;
+                record.network_ms = network_ms;
+                record.decoding_ms = decoding_ms;
+                record.rendering_ms = rendering_ms;
+                record.e2e_ms = e2e_ms;
+                record.inter_frame_ms = inter_frame_ms;
+                record.intra_construction_ms = intra_construction_ms;
+                stats_log_writer_.WritePerFrame(record);
             }
             // Update the last processed timestamp
             persistent_stats_.last_timestamp_ = timing_info.rtp_timestamp;
@@ -175,16 +101,16 @@ void RTCStatsCollectorCallback::ProcessInboundRTPStats(const webrtc::RTCStats& s
 
     persistent_stats_.frame_timing_count_ += 1;
 
-    // Extract all stats with null handling
-    int64_t frames_decoded = static_cast<int64_t>(get_numeric("framesDecoded"));
-    int64_t frames_dropped = static_cast<int64_t>(get_numeric("framesDropped"));
-    int64_t frames_received = static_cast<int64_t>(get_numeric("framesReceived"));
-    double framerate = get_numeric("framesPerSecond");
-    double jitter_buffer_delay = get_numeric("jitterBufferDelay") * 1000.0;
-    int64_t width = static_cast<int64_t>(get_numeric("frameWidth"));
-    int64_t height = static_cast<int64_t>(get_numeric("frameHeight"));
-    double total_decode_time = get_numeric("totalDecodeTime") * 1000.0;
-    int64_t bytes_received = static_cast<int64_t>(get_numeric("bytesReceived"));
+    // Missing members were already defaulted to zero by the extraction.
+    int64_t frames_decoded = stats.frames_decoded;
+    int64_t frames_dropped = stats.frames_dropped;
+    int64_t frames_received = stats.frames_received;
+    double framerate = stats.frames_per_second;
+    double jitter_buffer_delay = stats.jitter_buffer_delay_ms;
+    int64_t width = stats.frame_width;
+    int64_t height = stats.frame_height;
+    double total_decode_time = stats.total_decode_time_ms;
+    int64_t bytes_received = stats.bytes_received;
 
     int64_t current_time_ms = rtc::TimeMillis();
 
@@ -234,29 +160,39 @@ void RTCStatsCollectorCallback::ProcessInboundRTPStats(const webrtc::RTCStats& s
         double avg_total_decode_time = persistent_stats_.acc_total_decode_time_ / persistent_stats_.acc_count_;
 
         // Handle decoder implementation
-        const auto* decoder_impl_attr = find_attribute("decoderImplementation");
-        std::string decoder_implementation =
-            decoder_impl_attr ? decoder_impl_attr->ToString() : "unknown";
-        if (decoder_implementation == "null") {
-            decoder_implementation = "unknown";
+        absl::string_view decoder_implementation =
+            stats.decoder_implementation.empty() ? "unknown"
+                                                 : stats.decoder_implementation;
+
+        // Hand the averages to the writer, which does the file I/O on its
+        // own thread.
+        if (avg_frames_decoded > 0) {
+            AverageStatsRecord record;
+            record.timestamp_ms = current_time_ms;
+            record.frames_decoded = avg_frames_decoded;
+            record.frames_dropped = avg_frames_dropped;
+            record.frames_received = avg_frames_received;
+            record.framerate = avg_framerate;
+            record.jitter_buffer_delay_ms = avg_jitter_buffer_delay;
+            record.video_width = width;
+            record.video_height = height;
+            record.total_decode_time_ms = avg_total_decode_time;
+            record.total_bytes_received = bytes_received;
+            record.bitrate_bps = period_average_bitrate;  // Current period bitrate
+            record.overall_avg_bitrate_bps = overall_average_bitrate;
+            record.decoder_implementation = decoder_implementation;
+            for (int metric = 0; metric < kNumLatencyMetrics; ++metric) {
+                const LatencySketch& window =
+                    persistent_stats_.latency_[metric].Window();
+                for (int i = 0; i < kNumLatencyQuantiles; ++i) {
+                    record.latency_percentiles_ms[metric][i] =
+                        window.Quantile(kLatencyQuantiles[i]).value_or(-1);
+                }
+            }
+            stats_log_writer_.WriteAverage(record);
         }
-
-        // Write stats to file with mutex protection
-        if (average_stats_file_.is_open() && avg_frames_decoded > 0) {
-            average_stats_file_ << current_time_ms << ","
-                    << avg_frames_decoded << ","
-                    << avg_frames_dropped << ","
-                    << avg_frames_received << ","
-                    << avg_framerate << ","
-                    << avg_jitter_buffer_delay << ","
-                    << width << ","
-                    << height << ","
-                    << avg_total_decode_time << ","
-                    << bytes_received << ","
-                    << period_average_bitrate << ","  // Current period bitrate
-                    << overall_average_bitrate << ","  // Overall average bitrate
-                    << decoder_implementation << "\n";
-            average_stats_file_.flush();
+        for (RollingLatencySketch& latency : persistent_stats_.latency_) {
+            latency.Advance();
         }
 
         // Reset accumulators
@@ -284,32 +220,12 @@ void RTCStatsCollectorCallback::OnStatsDeliveredOnSignalingThread(
         return;
     }
 
+    InboundVideoStats inbound_video_stats;
     for (const auto& stats : *report) {
-        std::vector<webrtc::Attribute> attributes = stats.Attributes();
-        auto find_attribute = [&attributes](const std::string& name) -> const webrtc::Attribute* {
-            for (const auto& attribute : attributes) {
-                if (attribute.name() == name) {
-                    return &attribute;
-                }
-            }
-            return nullptr;
-        };
-
-        const auto* kind = find_attribute("kind");
-        if (!kind) {
-            RTC_LOG(LS_INFO) << "Skipping stats " << stats.id() << " because 'kind' attribute not found.";
+        if (!ExtractInboundVideoStats(stats, &inbound_video_stats)) {
             continue;
         }
-
-        if (kind->ToString() != "video") {
-            RTC_LOG(LS_INFO) << "Skipping stats " << stats.id() << " because kind is not video.";
-            continue;
-        }
-
-        if (std::string(stats.type()) == "inbound-rtp") {
-            RTC_LOG(LS_INFO) << "Processing inbound-rtp stats: " << stats.id();
-            ProcessInboundRTPStats(stats);
-        }
+        ProcessInboundRTPStats(inbound_video_stats);
     }
 }
 
@@ -324,13 +240,16 @@ RTCStatsCollector::~RTCStatsCollector() {
     if (stats_thread_.joinable()) {
         stats_thread_.join();  // Wait for the thread to finish
     }
+    CloseStatsFile();
 
     RTC_LOG(LS_INFO) << "RTCStatsCollector destroyed.";
 }
 
 bool RTCStatsCollector::Start(
     const std::string& foldername,
-    rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection) {
+    rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection,
+    StatsLogFormat log_format,
+    webrtc::TaskQueueBase* task_queue) {
 
 
     RTC_LOG(LS_INFO) << "RTCStatsCollector starts.";
@@ -345,7 +264,7 @@ bool RTCStatsCollector::Start(
         return false;
     }
 
-    if (!OpenStatsFile(foldername)) {
+    if (!OpenStatsFile(foldername, log_format)) {
         RTC_LOG(LS_ERROR) << "Failed to open stats file. Cannot start stats collection.";
         return false;
     }
@@ -354,6 +273,13 @@ bool RTCStatsCollector::Start(
     should_collect_ = true;
     is_running_ = true;
 
+    if (task_queue) {
+        poll_task_ = webrtc::RepeatingTaskHandle::Start(task_queue, [this] {
+            CollectStats();
+            return webrtc::TimeDelta::Millis(stats_interval_ms_);
+        });
+        return true;
+    }
     stats_thread_ = std::thread(&RTCStatsCollector::ThreadLoop, this);
 
     return true;
@@ -365,56 +291,27 @@ void RTCStatsCollector::Stop() {
         should_collect_ = false;  // Signal the thread to stop
     }
     stop_cv_.notify_all(); // Wake up the thread if it's waiting
+    poll_task_.Stop();
     RTC_LOG(LS_INFO) << "RTCStatsCollector stopped.";
 }
 
-bool RTCStatsCollector::OpenStatsFile(const std::string& foldername) {
+bool RTCStatsCollector::OpenStatsFile(const std::string& foldername,
+                                      StatsLogFormat log_format) {
     RTC_LOG(LS_INFO) << "Opening stats files in folder: " << foldername;
 
-    // Construct file paths for per-frame and average stats files
-    std::string per_frame_filename = foldername + "/per_frame_stats.csv";
-    std::string average_filename = foldername + "/average_stats.csv";
-
-    // Open per-frame stats file
-    /*
-    per_frame_stats_file_.open(per_frame_filename);
-    if (!per_frame_stats_file_.is_open()) {
-        RTC_LOG(LS_ERROR) << "Failed to open per-frame stats file: " << per_frame_filename;
+    stats_log_writer_ = CreateStatsLogWriter(log_format, foldername);
+    if (!stats_log_writer_) {
+        RTC_LOG(LS_ERROR) << "Failed to open stats files in folder: " << foldername;
         return false;
     }
-    RTC_LOG(LS_INFO) << "Per-frame stats file opened successfully: " << per_frame_filename;
-    per_frame_stats_file_ << "timestamp_ms,rtp_timestamp,encoding_ms,network_ms,decoding_ms,rendering_ms,e2e_ms,"
-                          << "inter_frame_ms,intra_construction_ms\n";
-    per_frame_stats_file_.flush();
-    */
-
-    // Open average stats file
-    average_stats_file_.open(average_filename);
-    if (!average_stats_file_.is_open()) {
-        RTC_LOG(LS_ERROR) << "Failed to open average stats file: " << average_filename;
-        per_frame_stats_file_.close();  // Cleanup already opened file
-        return false;
-    }
-    RTC_LOG(LS_INFO) << "Average stats file opened successfully: " << average_filename;
-    average_stats_file_ << "timestamp_ms,frames_decoded,frames_dropped,frames_received,"
-                          << "framerate,jitter_buffer_delay_ms,video_width,video_height,"
-                          << "total_decode_time_ms,total_bytes_received,bitrates,overall_avg_bitrates,decoder_implementation\n";
-    average_stats_file_.flush();
-
     return true;
 }
 
 void RTCStatsCollector::CloseStatsFile() {
-    if (per_frame_stats_file_.is_open()) {
-        RTC_LOG(LS_INFO) << "Closing per-frame stats file.";
-        per_frame_stats_file_.flush();
-        per_frame_stats_file_.close();
-    }
-
-    if (average_stats_file_.is_open()) {
-        RTC_LOG(LS_INFO) << "Closing average stats file.";
-        average_stats_file_.flush();
-        average_stats_file_.close();
+    if (stats_log_writer_) {
+        RTC_LOG(LS_INFO) << "Closing stats files.";
+        // Destroying the writer flushes whatever is still buffered.
+        stats_log_writer_.reset();
     }
 }
 
@@ -425,7 +322,7 @@ void RTCStatsCollector::ThreadLoop() {
         CollectStats();
         lock.lock();  // Explicit lock before waiting
 
-        stop_cv_.wait_for(lock, std::chrono::milliseconds(kStatsIntervalMs),
+        stop_cv_.wait_for(lock, std::chrono::milliseconds(stats_interval_ms_),
                           [this]() { return !should_collect_; });
     }
 }
@@ -437,11 +334,18 @@ void RTCStatsCollector::CollectStats() {
     }
 
     auto stats_callback = rtc::make_ref_counted<RTCStatsCollectorCallback>(
-        per_frame_stats_file_,
-        average_stats_file_,
+        *stats_log_writer_,
         stats_mutex_,
         persistent_stats_); 
 
-    peer_connection_->GetStats(stats_callback.get());
+    peer_connection_->GetSelectedStats(selected_stats_types_, stats_callback);
 }
 
+void RTCStatsCollector::AddFrameTiming(const webrtc::TimingFrameInfo& timing) {
+    const std::array<int64_t, kNumLatencyMetrics> latency =
+        StageLatencies(timing);
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    for (int metric = 0; metric < kNumLatencyMetrics; ++metric) {
+        persistent_stats_.latency_[metric].Add(latency[metric]);
+    }
+}
@@ -1,13 +1,22 @@
 #ifndef RTC_STATS_COLLECTOR_H_
 #define RTC_STATS_COLLECTOR_H_
 
-#include <fstream>
+#include <array>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 #include "api/peer_connection_interface.h"
 #include "api/stats/rtc_stats.h"
 #include "api/stats/rtc_stats_collector_callback.h"
+#include "api/stats/rtcstats_objects.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/video/video_timing.h"
+#include "examples/peerconnection/client/inbound_video_stats.h"
+#include "examples/peerconnection/client/latency_sketch.h"
+#include "examples/peerconnection/client/stats_log_writer.h"
+#include "rtc_base/task_utils/repeating_task.h"
 #include "rtc_base/thread.h"
 #include <thread>
 #include <condition_variable>
@@ -36,13 +45,27 @@ struct PersistentStats {
     // For current period average bitrate
     int64_t period_start_bytes_ = 0;
     int64_t period_start_time_ms_ = 0;
+
+    // Rolling latency percentiles over every decoded frame, advanced with
+    // every average row, so the window spans kLatencyWindowSeconds of rows.
+    // Empty unless frames are fed through RTCStatsCollector::AddFrameTiming().
+    static constexpr int kLatencyWindowSeconds = 10;
+    std::array<RollingLatencySketch, kNumLatencyMetrics> latency_ = {
+        RollingLatencySketch(kLatencyWindowSeconds),
+        RollingLatencySketch(kLatencyWindowSeconds),
+        RollingLatencySketch(kLatencyWindowSeconds),
+        RollingLatencySketch(kLatencyWindowSeconds),
+        RollingLatencySketch(kLatencyWindowSeconds)};
+
+    // Whether every frame timing sample also goes to per_frame_stats.csv.
+    // The percentiles in average_stats.csv are kept either way.
+    bool write_per_frame_ = true;
 };
 
 class RTCStatsCollectorCallback : public webrtc::RTCStatsCollectorCallback {
 public:
     RTCStatsCollectorCallback(
-        std::ofstream& per_frame_stats_file,
-        std::ofstream& average_stats_file,
+        StatsLogWriter& stats_log_writer,
         std::mutex& stats_mutex,
         PersistentStats& persistent_stats);  // Add persistent stats
     ~RTCStatsCollectorCallback();
@@ -56,10 +79,9 @@ private:
     void OnStatsDeliveredOnSignalingThread(
         rtc::scoped_refptr<const webrtc::RTCStatsReport> report);
     
-    void ProcessInboundRTPStats(const webrtc::RTCStats& stats);
+    void ProcessInboundRTPStats(const InboundVideoStats& stats);
 
-    std::ofstream& per_frame_stats_file_;
-    std::ofstream& average_stats_file_;
+    StatsLogWriter& stats_log_writer_;
     std::mutex& stats_mutex_;
     PersistentStats& persistent_stats_;  // Reference to persistent stats
 
@@ -71,30 +93,58 @@ public:
     RTCStatsCollector();
     ~RTCStatsCollector();
 
+    // When `task_queue` is set, stats are polled by a repeating task on it
+    // instead of on a dedicated thread, and Stop() must be called on it too.
+    // Under simulated time only time controller threads may call into the
+    // peer connection, so the in-process emulation passes its signaling
+    // thread here.
     bool Start(const std::string& filename,
-               rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection);
+               rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection,
+               StatsLogFormat log_format = StatsLogFormat::kCsv,
+               webrtc::TaskQueueBase* task_queue = nullptr);
     void Stop();
 
+    // Set to false to keep only the rolling percentiles in the average stats
+    // file instead of one per_frame_stats row per sample, for long runs.
+    // Must be called before Start().
+    void set_write_per_frame(bool write_per_frame) {
+        persistent_stats_.write_per_frame_ = write_per_frame;
+    }
+
+    // How often to poll. Only inbound-rtp stats are requested, which the peer
+    // connection gathers without blocking its signaling thread, so intervals
+    // of 50 ms and below are fine. Must be called before Start().
+    void set_stats_interval_ms(int stats_interval_ms) {
+        stats_interval_ms_ = stats_interval_ms;
+    }
+
     bool IsRunning () { return is_running_;}
 
+    // Feeds the rolling latency percentiles with the timing of one decoded
+    // frame, see FrameTimingRecorder::set_frame_callback(). Thread safe.
+    void AddFrameTiming(const webrtc::TimingFrameInfo& timing);
+
 private:
     void CollectStats();
     void ThreadLoop();
 
-    bool OpenStatsFile(const std::string& filename);
+    bool OpenStatsFile(const std::string& filename, StatsLogFormat log_format);
     void CloseStatsFile();
 
-    std::ofstream per_frame_stats_file_;
-    std::ofstream average_stats_file_;
+    std::unique_ptr<StatsLogWriter> stats_log_writer_;
 
     std::thread stats_thread_;          // Use std::thread instead of rtc::Thread
     std::mutex stats_mutex_;            // Mutex for thread safety
     std::condition_variable stop_cv_;   // To signal the thread to stop
     bool should_collect_ = false;       // Flag to control the thread loop
     rtc::scoped_refptr<webrtc::PeerConnectionInterface> peer_connection_;
+    webrtc::RepeatingTaskHandle poll_task_;
 
     bool is_running_ = false;
-    const int kStatsIntervalMs = 200; // Collection interval in milliseconds
+    int stats_interval_ms_ = 200; // Collection interval in milliseconds
+    // The only stats the callback reads.
+    const std::set<std::string> selected_stats_types_ = {
+        webrtc::RTCInboundRtpStreamStats::kType};
 
     PersistentStats persistent_stats_;
 };
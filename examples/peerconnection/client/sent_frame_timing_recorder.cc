@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/sent_frame_timing_recorder.h"
+
+#include <chrono>
+#include <cstring>
+
+#include "rtc_base/byte_order.h"
+#include "rtc_base/logging.h"
+
+namespace {
+
+// Largest record: size prefix, type and the kPacketized payload.
+constexpr size_t kMaxRecordSize = 4 + 1 + 4 + 4 + 4 * 8 + 4 + 1;
+
+void AppendUint32(std::vector<uint8_t>& buffer, uint32_t value) {
+  size_t offset = buffer.size();
+  buffer.resize(offset + 4);
+  rtc::SetLE32(&buffer[offset], value);
+}
+
+void AppendInt64(std::vector<uint8_t>& buffer, int64_t value) {
+  size_t offset = buffer.size();
+  buffer.resize(offset + 8);
+  rtc::SetLE64(&buffer[offset], static_cast<uint64_t>(value));
+}
+
+}  // namespace
+
+SentFrameTimingRecorder::SentFrameTimingRecorder() : queue_(kCapacity) {
+  write_buffer_.reserve(kCapacity * kMaxRecordSize);
+}
+
+SentFrameTimingRecorder::~SentFrameTimingRecorder() {
+  Stop();
+}
+
+bool SentFrameTimingRecorder::Start(const std::string& log_dir) {
+  if (IsRunning()) {
+    return true;
+  }
+  const std::string path = log_dir + "/sent_frame_timing.bin";
+  file_ = fopen(path.c_str(), "wb");
+  if (!file_) {
+    RTC_LOG(LS_ERROR) << "Failed to open " << path;
+    return false;
+  }
+  uint8_t header[sizeof(kSentFrameTimingMagic) - 1 + 4];
+  std::memcpy(header, kSentFrameTimingMagic, sizeof(kSentFrameTimingMagic) - 1);
+  rtc::SetLE32(&header[sizeof(kSentFrameTimingMagic) - 1],
+               kSentFrameTimingVersion);
+  fwrite(header, 1, sizeof(header), file_);
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    stop_requested_ = false;
+  }
+  writer_thread_ = std::thread(&SentFrameTimingRecorder::WriterLoop, this);
+  RTC_LOG(LS_INFO) << "Recording sent frame timing to " << path;
+  return true;
+}
+
+void SentFrameTimingRecorder::Stop() {
+  if (!IsRunning()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    stop_requested_ = true;
+  }
+  writer_cv_.notify_all();
+  writer_thread_.join();
+  // The writer drained before exiting; pick up anything pushed since.
+  Drain();
+  fclose(file_);
+  file_ = nullptr;
+  RTC_LOG(LS_INFO) << "Sent frame timing recorder stopped, dropped "
+                   << dropped_events() << " events.";
+}
+
+void SentFrameTimingRecorder::OnFramePacketized(
+    const webrtc::SentFrameTiming& timing) {
+  Entry entry;
+  entry.type = SentFrameTimingRecordType::kPacketized;
+  entry.timing = timing;
+  if (!queue_.TryPush(entry)) {
+    dropped_events_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void SentFrameTimingRecorder::OnFramePacerExit(uint32_t ssrc,
+                                               uint32_t rtp_timestamp,
+                                               int64_t pacer_exit_ms) {
+  Entry entry;
+  entry.type = SentFrameTimingRecordType::kPacerExit;
+  entry.timing.ssrc = ssrc;
+  entry.timing.rtp_timestamp = rtp_timestamp;
+  entry.pacer_exit_ms = pacer_exit_ms;
+  if (!queue_.TryPush(entry)) {
+    dropped_events_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void SentFrameTimingRecorder::WriterLoop() {
+  std::unique_lock<std::mutex> lock(writer_mutex_);
+  while (!stop_requested_) {
+    writer_cv_.wait_for(lock, std::chrono::milliseconds(kDrainIntervalMs),
+                        [this]() { return stop_requested_; });
+    lock.unlock();
+    Drain();
+    lock.lock();
+  }
+}
+
+void SentFrameTimingRecorder::Drain() {
+  Entry entry;
+  while (queue_.TryPop(&entry)) {
+    Write(entry);
+  }
+  if (!write_buffer_.empty()) {
+    fwrite(write_buffer_.data(), 1, write_buffer_.size(), file_);
+    fflush(file_);
+    write_buffer_.clear();
+  }
+}
+
+void SentFrameTimingRecorder::Write(const Entry& entry) {
+  const size_t start = write_buffer_.size();
+  // Size prefix, patched below once the payload is known.
+  AppendUint32(write_buffer_, 0);
+  write_buffer_.push_back(static_cast<uint8_t>(entry.type));
+  AppendUint32(write_buffer_, entry.timing.ssrc);
+  AppendUint32(write_buffer_, entry.timing.rtp_timestamp);
+  switch (entry.type) {
+    case SentFrameTimingRecordType::kPacketized:
+      AppendInt64(write_buffer_, entry.timing.capture_time_ms);
+      AppendInt64(write_buffer_, entry.timing.encode_start_ms);
+      AppendInt64(write_buffer_, entry.timing.encode_finish_ms);
+      AppendInt64(write_buffer_, entry.timing.packetization_finish_ms);
+      AppendUint32(write_buffer_,
+                   static_cast<uint32_t>(entry.timing.encoded_size));
+      write_buffer_.push_back(entry.timing.is_key_frame ? 1 : 0);
+      break;
+    case SentFrameTimingRecordType::kPacerExit:
+      AppendInt64(write_buffer_, entry.pacer_exit_ms);
+      break;
+  }
+  rtc::SetLE32(&write_buffer_[start],
+               static_cast<uint32_t>(write_buffer_.size() - start - 4));
+}
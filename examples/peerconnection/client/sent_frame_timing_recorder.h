@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_SENT_FRAME_TIMING_RECORDER_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_SENT_FRAME_TIMING_RECORDER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "examples/peerconnection/client/lock_free_ring_buffer.h"
+#include "modules/rtp_rtcp/source/sent_frame_timing_sink.h"
+
+// Sent frame timing log, stored in <log_dir>/sent_frame_timing.bin. Uses the
+// same framing as stats.bin (see stats_log_writer.h):
+//
+//   file   := magic "WRTCSENT" | uint32 version | record*
+//   record := uint32 payload_size | uint8 type | payload[payload_size - 1]
+//
+//   kPacketized := uint32 ssrc | uint32 rtp_timestamp | int64 capture_time_ms
+//                  | int64 encode_start_ms | int64 encode_finish_ms
+//                  | int64 packetization_finish_ms | uint32 encoded_size
+//                  | uint8 is_key_frame
+//   kPacerExit  := uint32 ssrc | uint32 rtp_timestamp | int64 pacer_exit_ms
+//
+// All times are in milliseconds of the sender's clock, -1 if unknown. The
+// two records of a frame are not necessarily adjacent or in this order;
+// join_frame_timing.py pairs them up and joins them with the receiver's
+// frame_timing.csv.
+constexpr char kSentFrameTimingMagic[] = "WRTCSENT";
+constexpr uint32_t kSentFrameTimingVersion = 1;
+enum class SentFrameTimingRecordType : uint8_t {
+  kPacketized = 1,
+  kPacerExit = 2,
+};
+
+// Captures the sender side timing of every sent video frame. The encoder and
+// pacer threads only copy the event into a lock-free ring buffer; a
+// background thread drains it into sent_frame_timing.bin, so file I/O never
+// happens on the send path. Events arriving while the buffer is full are
+// dropped and counted instead of blocking.
+class SentFrameTimingRecorder : public webrtc::SentFrameTimingSinkInterface {
+ public:
+  SentFrameTimingRecorder();
+  ~SentFrameTimingRecorder() override;
+
+  // Opens <log_dir>/sent_frame_timing.bin and starts the writer thread.
+  bool Start(const std::string& log_dir);
+  // Stops the writer thread after draining everything queued so far.
+  void Stop();
+
+  bool IsRunning() const { return writer_thread_.joinable(); }
+  int64_t dropped_events() const {
+    return dropped_events_.load(std::memory_order_relaxed);
+  }
+
+  // webrtc::SentFrameTimingSinkInterface implementation.
+  void OnFramePacketized(const webrtc::SentFrameTiming& timing) override;
+  void OnFramePacerExit(uint32_t ssrc,
+                        uint32_t rtp_timestamp,
+                        int64_t pacer_exit_ms) override;
+
+ private:
+  struct Entry {
+    SentFrameTimingRecordType type = SentFrameTimingRecordType::kPacketized;
+    // Only ssrc and rtp_timestamp are set for kPacerExit.
+    webrtc::SentFrameTiming timing;
+    int64_t pacer_exit_ms = -1;
+  };
+
+  void WriterLoop();
+  void Drain();
+  void Write(const Entry& entry);
+
+  // Two events per frame, so about 68 seconds of 60 fps video.
+  static constexpr size_t kCapacity = 8192;
+  static constexpr int kDrainIntervalMs = 100;
+
+  LockFreeRingBuffer<Entry> queue_;
+  std::atomic<int64_t> dropped_events_{0};
+
+  // Only touched by the writer thread, and by Start() and Stop() while it is
+  // not running.
+  FILE* file_ = nullptr;
+  std::vector<uint8_t> write_buffer_;
+
+  std::thread writer_thread_;
+  std::mutex writer_mutex_;
+  std::condition_variable writer_cv_;
+  bool stop_requested_ = false;
+};
+
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_SENT_FRAME_TIMING_RECORDER_H_
@@ -0,0 +1,334 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/client/stats_log_writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "rtc_base/byte_order.h"
+#include "rtc_base/logging.h"
+
+namespace {
+
+// Flush once this much is buffered, or every kFlushIntervalMs.
+constexpr size_t kFlushThresholdBytes = 64 * 1024;
+constexpr int kFlushIntervalMs = 1000;
+
+// Appends little-endian fields to a fixed size stack buffer.
+class RecordBuilder {
+ public:
+  explicit RecordBuilder(StatsLogRecordType type) {
+    // Reserve room for the size prefix, patched in Finish().
+    size_ = 4;
+    data_[size_++] = static_cast<uint8_t>(type);
+  }
+
+  void AddInt64(int64_t value) {
+    rtc::SetLE64(&data_[size_], static_cast<uint64_t>(value));
+    size_ += 8;
+  }
+  void AddUint32(uint32_t value) {
+    rtc::SetLE32(&data_[size_], value);
+    size_ += 4;
+  }
+  void AddDouble(double value) {
+    uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(value), "");
+    std::memcpy(&bits, &value, sizeof(bits));
+    rtc::SetLE64(&data_[size_], bits);
+    size_ += 8;
+  }
+  // Strings are stored as uint8 length followed by the bytes, truncated to
+  // 255 bytes.
+  void AddString(absl::string_view value) {
+    size_t length = std::min(value.size(), size_t{255});
+    data_[size_++] = static_cast<uint8_t>(length);
+    std::memcpy(&data_[size_], value.data(), length);
+    size_ += length;
+  }
+
+  // Returns the complete record, including the size prefix.
+  std::pair<const uint8_t*, size_t> Finish() {
+    rtc::SetLE32(&data_[0], static_cast<uint32_t>(size_ - 4));
+    return {data_, size_};
+  }
+
+ private:
+  uint8_t data_[1024];
+  size_t size_ = 0;
+};
+
+class BinaryStatsLogWriter : public StatsLogWriter {
+ public:
+  BinaryStatsLogWriter()
+      : writer_(kFlushThresholdBytes, kFlushIntervalMs) {}
+  ~BinaryStatsLogWriter() override { writer_.Close(); }
+
+  bool Open(const std::string& folder) {
+    if (!writer_.Open(folder + "/stats.bin")) {
+      return false;
+    }
+    uint8_t header[sizeof(kStatsLogMagic) - 1 + 4];
+    std::memcpy(header, kStatsLogMagic, sizeof(kStatsLogMagic) - 1);
+    rtc::SetLE32(&header[sizeof(kStatsLogMagic) - 1], kStatsLogVersion);
+    writer_.Write(header, sizeof(header));
+    return true;
+  }
+
+  void WritePerFrame(const PerFrameStatsRecord& record) override {
+    RecordBuilder builder(StatsLogRecordType::kPerFrame);
+    builder.AddInt64(record.timestamp_ms);
+    builder.AddUint32(record.rtp_timestamp);
+    builder.AddInt64(record.encoding_ms);
+    builder.AddInt64(record.network_ms);
+    builder.AddInt64(record.decoding_ms);
+    builder.AddInt64(record.rendering_ms);
+    builder.AddInt64(record.e2e_ms);
+    builder.AddInt64(record.inter_frame_ms);
+    builder.AddInt64(record.intra_construction_ms);
+    auto [data, size] = builder.Finish();
+    writer_.Write(data, size);
+  }
+
+  void WriteAverage(const AverageStatsRecord& record) override {
+    RecordBuilder builder(StatsLogRecordType::kAverage);
+    builder.AddInt64(record.timestamp_ms);
+    builder.AddDouble(record.frames_decoded);
+    builder.AddDouble(record.frames_dropped);
+    builder.AddDouble(record.frames_received);
+    builder.AddDouble(record.framerate);
+    builder.AddDouble(record.jitter_buffer_delay_ms);
+    builder.AddInt64(record.video_width);
+    builder.AddInt64(record.video_height);
+    builder.AddDouble(record.total_decode_time_ms);
+    builder.AddInt64(record.total_bytes_received);
+    builder.AddDouble(record.bitrate_bps);
+    builder.AddDouble(record.overall_avg_bitrate_bps);
+    builder.AddString(record.decoder_implementation);
+    for (const auto& metric : record.latency_percentiles_ms) {
+      for (double percentile : metric) {
+        builder.AddDouble(percentile);
+      }
+    }
+    auto [data, size] = builder.Finish();
+    writer_.Write(data, size);
+  }
+
+ private:
+  DoubleBufferedFileWriter writer_;
+};
+
+class CsvStatsLogWriter : public StatsLogWriter {
+ public:
+  CsvStatsLogWriter()
+      : per_frame_writer_(kFlushThresholdBytes, kFlushIntervalMs),
+        average_writer_(kFlushThresholdBytes, kFlushIntervalMs) {}
+  ~CsvStatsLogWriter() override {
+    per_frame_writer_.Close();
+    average_writer_.Close();
+  }
+
+  bool Open(const std::string& folder) {
+    if (!per_frame_writer_.Open(folder + "/per_frame_stats.csv") ||
+        !average_writer_.Open(folder + "/average_stats.csv")) {
+      return false;
+    }
+    static constexpr char kPerFrameHeader[] =
+        "timestamp_ms,rtp_timestamp,encoding_ms,network_ms,decoding_ms,"
+        "rendering_ms,e2e_ms,inter_frame_ms,intra_construction_ms\n";
+    std::string average_header =
+        "timestamp_ms,frames_decoded,frames_dropped,frames_received,"
+        "framerate,jitter_buffer_delay_ms,video_width,video_height,"
+        "total_decode_time_ms,total_bytes_received,bitrates,"
+        "overall_avg_bitrates,decoder_implementation";
+    for (const char* metric : kLatencyMetricNames) {
+      for (const char* quantile : kLatencyQuantileNames) {
+        average_header += std::string(",") + metric + "_ms_" + quantile;
+      }
+    }
+    average_header += "\n";
+    per_frame_writer_.Write(kPerFrameHeader, sizeof(kPerFrameHeader) - 1);
+    average_writer_.Write(average_header.data(), average_header.size());
+    return true;
+  }
+
+  void WritePerFrame(const PerFrameStatsRecord& record) override {
+    char line[256];
+    int length = snprintf(
+        line, sizeof(line),
+        "%" PRId64 ",%" PRIu32 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64
+        ",%" PRId64 ",%" PRId64 ",%" PRId64 "\n",
+        record.timestamp_ms, record.rtp_timestamp, record.encoding_ms,
+        record.network_ms, record.decoding_ms, record.rendering_ms,
+        record.e2e_ms, record.inter_frame_ms, record.intra_construction_ms);
+    Append(per_frame_writer_, line, length, sizeof(line));
+  }
+
+  void WriteAverage(const AverageStatsRecord& record) override {
+    char line[1024];
+    int length = snprintf(
+        line, sizeof(line),
+        "%" PRId64 ",%g,%g,%g,%g,%g,%" PRId64 ",%" PRId64 ",%g,%" PRId64
+        ",%g,%g,%.*s",
+        record.timestamp_ms, record.frames_decoded, record.frames_dropped,
+        record.frames_received, record.framerate, record.jitter_buffer_delay_ms,
+        record.video_width, record.video_height, record.total_decode_time_ms,
+        record.total_bytes_received, record.bitrate_bps,
+        record.overall_avg_bitrate_bps,
+        static_cast<int>(record.decoder_implementation.size()),
+        record.decoder_implementation.data());
+    for (const auto& metric : record.latency_percentiles_ms) {
+      for (double percentile : metric) {
+        if (length < 0 || static_cast<size_t>(length) >= sizeof(line)) {
+          break;
+        }
+        length += snprintf(line + length, sizeof(line) - length, ",%g",
+                           percentile);
+      }
+    }
+    if (length >= 0 && static_cast<size_t>(length) < sizeof(line) - 1) {
+      line[length++] = '\n';
+    }
+    Append(average_writer_, line, length, sizeof(line));
+  }
+
+ private:
+  static void Append(DoubleBufferedFileWriter& writer,
+                     const char* line,
+                     int length,
+                     size_t capacity) {
+    if (length <= 0) {
+      return;
+    }
+    writer.Write(line, std::min(static_cast<size_t>(length), capacity - 1));
+  }
+
+  DoubleBufferedFileWriter per_frame_writer_;
+  DoubleBufferedFileWriter average_writer_;
+};
+
+}  // namespace
+
+DoubleBufferedFileWriter::DoubleBufferedFileWriter(size_t flush_threshold_bytes,
+                                                   int flush_interval_ms)
+    : flush_threshold_bytes_(flush_threshold_bytes),
+      flush_interval_ms_(flush_interval_ms) {
+  // Leave headroom so records written while the flush thread is waking up
+  // still fit without reallocating.
+  active_buffer_.reserve(2 * flush_threshold_bytes_);
+  flushing_buffer_.reserve(2 * flush_threshold_bytes_);
+}
+
+DoubleBufferedFileWriter::~DoubleBufferedFileWriter() {
+  Close();
+}
+
+bool DoubleBufferedFileWriter::Open(const std::string& path) {
+  if (file_) {
+    return true;
+  }
+  file_ = fopen(path.c_str(), "wb");
+  if (!file_) {
+    RTC_LOG(LS_ERROR) << "Failed to open stats log file: " << path;
+    return false;
+  }
+  stop_requested_ = false;
+  flush_thread_ = std::thread(&DoubleBufferedFileWriter::FlushLoop, this);
+  RTC_LOG(LS_INFO) << "Stats log file opened successfully: " << path;
+  return true;
+}
+
+void DoubleBufferedFileWriter::Close() {
+  if (!file_) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_requested_ = true;
+  }
+  flush_cv_.notify_all();
+  flush_thread_.join();
+  fclose(file_);
+  file_ = nullptr;
+}
+
+void DoubleBufferedFileWriter::Write(const void* data, size_t size) {
+  bool wake_flush_thread;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    active_buffer_.insert(active_buffer_.end(), bytes, bytes + size);
+    wake_flush_thread = active_buffer_.size() >= flush_threshold_bytes_;
+  }
+  if (wake_flush_thread) {
+    flush_cv_.notify_one();
+  }
+}
+
+void DoubleBufferedFileWriter::FlushLoop() {
+  bool stopping = false;
+  while (!stopping) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      flush_cv_.wait_for(lock, std::chrono::milliseconds(flush_interval_ms_),
+                         [this]() {
+                           return stop_requested_ ||
+                                  active_buffer_.size() >=
+                                      flush_threshold_bytes_;
+                         });
+      stopping = stop_requested_;
+      std::swap(active_buffer_, flushing_buffer_);
+    }
+    if (!flushing_buffer_.empty()) {
+      fwrite(flushing_buffer_.data(), 1, flushing_buffer_.size(), file_);
+      fflush(file_);
+      flushing_buffer_.clear();
+    }
+  }
+}
+
+bool ParseStatsLogFormat(absl::string_view name, StatsLogFormat* format) {
+  if (name == "csv") {
+    *format = StatsLogFormat::kCsv;
+    return true;
+  }
+  if (name == "binary") {
+    *format = StatsLogFormat::kBinary;
+    return true;
+  }
+  return false;
+}
+
+std::unique_ptr<StatsLogWriter> CreateStatsLogWriter(
+    StatsLogFormat format,
+    const std::string& folder) {
+  switch (format) {
+    case StatsLogFormat::kCsv: {
+      auto writer = std::make_unique<CsvStatsLogWriter>();
+      if (!writer->Open(folder)) {
+        return nullptr;
+      }
+      return writer;
+    }
+    case StatsLogFormat::kBinary: {
+      auto writer = std::make_unique<BinaryStatsLogWriter>();
+      if (!writer->Open(folder)) {
+        return nullptr;
+      }
+      return writer;
+    }
+  }
+  return nullptr;
+}
@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2025 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_CLIENT_STATS_LOG_WRITER_H_
+#define EXAMPLES_PEERCONNECTION_CLIENT_STATS_LOG_WRITER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+// One row of per_frame_stats.csv.
+struct PerFrameStatsRecord {
+  int64_t timestamp_ms = 0;
+  uint32_t rtp_timestamp = 0;
+  int64_t encoding_ms = -1;
+  int64_t network_ms = -1;
+  int64_t decoding_ms = -1;
+  int64_t rendering_ms = -1;
+  int64_t e2e_ms = -1;
+  int64_t inter_frame_ms = -1;
+  int64_t intra_construction_ms = -1;
+};
+
+// Latency stages summarized by rolling percentiles in average_stats.csv, in
+// column order.
+enum LatencyMetric {
+  kEncodingLatency,
+  kNetworkLatency,
+  kDecodingLatency,
+  kRenderingLatency,
+  kE2eLatency,
+  kNumLatencyMetrics,
+};
+inline constexpr const char* kLatencyMetricNames[kNumLatencyMetrics] = {
+    "encoding", "network", "decoding", "rendering", "e2e"};
+
+// Quantiles reported for every latency stage, matching analyze_log.py plus
+// the median.
+inline constexpr int kNumLatencyQuantiles = 7;
+inline constexpr double kLatencyQuantiles[kNumLatencyQuantiles] = {
+    0.001, 0.01, 0.05, 0.5, 0.95, 0.99, 0.999};
+inline constexpr const char* kLatencyQuantileNames[kNumLatencyQuantiles] = {
+    "p0.1", "p1", "p5", "p50", "p95", "p99", "p99.9"};
+
+// One row of average_stats.csv.
+struct AverageStatsRecord {
+  int64_t timestamp_ms = 0;
+  double frames_decoded = 0.0;
+  double frames_dropped = 0.0;
+  double frames_received = 0.0;
+  double framerate = 0.0;
+  double jitter_buffer_delay_ms = 0.0;
+  int64_t video_width = 0;
+  int64_t video_height = 0;
+  double total_decode_time_ms = 0.0;
+  int64_t total_bytes_received = 0;
+  double bitrate_bps = 0.0;
+  double overall_avg_bitrate_bps = 0.0;
+  absl::string_view decoder_implementation;
+  // Percentiles of each latency stage over the rolling window that ends at
+  // `timestamp_ms`, -1 when the window has no samples for that stage.
+  double latency_percentiles_ms[kNumLatencyMetrics][kNumLatencyQuantiles] =
+      {};
+};
+
+// Appends to a file from a dedicated thread. Write() only copies into the
+// active in-memory buffer; the flush thread swaps the two buffers once the
+// active one reaches `flush_threshold_bytes` or every `flush_interval_ms`,
+// whichever comes first, and writes the full one out while producers keep
+// filling the other. Buffers keep their capacity between swaps, so steady
+// state writes do not allocate.
+class DoubleBufferedFileWriter {
+ public:
+  DoubleBufferedFileWriter(size_t flush_threshold_bytes, int flush_interval_ms);
+  ~DoubleBufferedFileWriter();
+
+  DoubleBufferedFileWriter(const DoubleBufferedFileWriter&) = delete;
+  DoubleBufferedFileWriter& operator=(const DoubleBufferedFileWriter&) = delete;
+
+  bool Open(const std::string& path);
+  // Writes out everything buffered so far and stops the flush thread.
+  void Close();
+
+  void Write(const void* data, size_t size);
+
+ private:
+  void FlushLoop();
+
+  const size_t flush_threshold_bytes_;
+  const int flush_interval_ms_;
+
+  std::mutex mutex_;
+  std::condition_variable flush_cv_;
+  std::vector<uint8_t> active_buffer_;    // Guarded by `mutex_`.
+  bool stop_requested_ = false;           // Guarded by `mutex_`.
+  std::vector<uint8_t> flushing_buffer_;  // Only used by the flush thread.
+  FILE* file_ = nullptr;
+  std::thread flush_thread_;
+};
+
+// Sink for the rows the stats callback produces. Implementations must not do
+// file I/O in the Write* calls; they are invoked on the stats delivery path.
+class StatsLogWriter {
+ public:
+  virtual ~StatsLogWriter() = default;
+
+  virtual void WritePerFrame(const PerFrameStatsRecord& record) = 0;
+  virtual void WriteAverage(const AverageStatsRecord& record) = 0;
+};
+
+// Binary stats log format, stored in <folder>/stats.bin. All integers are
+// little-endian and doubles are stored as their IEEE-754 bit pattern.
+//
+//   file   := magic "WRTCSTAT" | uint32 version | record*
+//   record := uint32 payload_size | uint8 type | payload[payload_size - 1]
+//
+// Readers skip record types they do not know using `payload_size`, and
+// ignore trailing fields they do not know within a record. See
+// convert_stats_log.py for the field layout of each type.
+constexpr char kStatsLogMagic[] = "WRTCSTAT";
+constexpr uint32_t kStatsLogVersion = 1;
+enum class StatsLogRecordType : uint8_t {
+  kPerFrame = 1,
+  kAverage = 2,
+};
+
+enum class StatsLogFormat {
+  kCsv,     // per_frame_stats.csv and average_stats.csv, as before.
+  kBinary,  // stats.bin, convert with convert_stats_log.py.
+};
+
+// Parses "csv" or "binary". Returns false for anything else.
+bool ParseStatsLogFormat(absl::string_view name, StatsLogFormat* format);
+
+// Returns nullptr if the output files can not be opened.
+std::unique_ptr<StatsLogWriter> CreateStatsLogWriter(StatsLogFormat format,
+                                                     const std::string& folder);
+
+#endif  // EXAMPLES_PEERCONNECTION_CLIENT_STATS_LOG_WRITER_H_
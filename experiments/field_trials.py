@@ -62,6 +62,9 @@ ACTIVE_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-BitrateAdjusterUseNewfangledHeadroomAdjustment',
                349561566,
                date(2025, 8, 26)),
+    FieldTrial('WebRTC-Bwe-L4s',
+               42225697,
+               date(2025, 12, 1)),
     FieldTrial('WebRTC-Bwe-LimitPacingFactorByUpperLinkCapacityEstimate',
                42220543,
                date(2025, 1, 1)),
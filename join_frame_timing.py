@@ -0,0 +1,164 @@
+import csv
+import os
+import struct
+import sys
+
+# Joins the sender's per-frame timing (sent_frame_timing.bin) with the
+# receiver's per-frame timing (frame_timing.csv) on the RTP timestamp, so the
+# latency of every frame can be split into stages, not only that of the
+# sampled timing frames whose sender timestamps cross the wire.
+#
+# Layout (little-endian), see
+# examples/peerconnection/client/sent_frame_timing_recorder.h:
+#   file   := b"WRTCSENT" | uint32 version | record*
+#   record := uint32 payload_size | uint8 type | payload[payload_size - 1]
+#
+# Sender times are on the sender's clock and receiver times on the
+# receiver's. Stages that cross the two (network_ms, e2e_ms) are only
+# meaningful when both run on the same clock, as with
+# --emulation_backend=inprocess, or when the receiver clock offset is passed
+# as clock_offset_ms (receiver - sender).
+
+MAGIC = b"WRTCSENT"
+SUPPORTED_VERSION = 1
+
+RECORD_PACKETIZED = 1
+RECORD_PACER_EXIT = 2
+
+PACKETIZED_FORMAT = struct.Struct("<IIqqqqIB")
+PACER_EXIT_FORMAT = struct.Struct("<IIq")
+
+RECEIVER_COLUMNS = ("receive_start", "receive_finish", "decode_start",
+                    "decode_finish", "render_time")
+
+OUTPUT_HEADER = (
+    "ssrc,rtp_timestamp,is_key_frame,encoded_size,capture_time,encode_start,"
+    "encode_finish,packetization_finish,pacer_exit," +
+    ",".join(RECEIVER_COLUMNS) +
+    ",capture_to_encode_ms,encode_ms,packetization_ms,pacer_ms,network_ms,"
+    "jitter_buffer_ms,decode_ms,e2e_ms\n")
+
+
+def read_records(data):
+    if data[:len(MAGIC)] != MAGIC:
+        raise ValueError("Not a sent frame timing file (bad magic)")
+    offset = len(MAGIC)
+    (version,) = struct.unpack_from("<I", data, offset)
+    if version > SUPPORTED_VERSION:
+        raise ValueError(f"Unsupported sent frame timing version {version}")
+    offset += 4
+
+    while offset + 4 <= len(data):
+        (payload_size,) = struct.unpack_from("<I", data, offset)
+        offset += 4
+        if payload_size == 0 or offset + payload_size > len(data):
+            print(f"Warning: truncated record at offset {offset - 4}, stopping.")
+            return
+        record_type = data[offset]
+        yield record_type, data[offset + 1:offset + payload_size]
+        offset += payload_size
+
+
+def read_sent_frames(path):
+    """Returns {ssrc: {rtp_timestamp: frame}} with both events merged."""
+    with open(path, "rb") as f:
+        data = f.read()
+    streams = {}
+    for record_type, payload in read_records(data):
+        if record_type == RECORD_PACKETIZED:
+            (ssrc, rtp_timestamp, capture, encode_start, encode_finish,
+             packetization_finish, encoded_size,
+             is_key_frame) = PACKETIZED_FORMAT.unpack_from(payload)
+            frame = streams.setdefault(ssrc, {}).setdefault(rtp_timestamp, {})
+            frame.update(capture_time=capture, encode_start=encode_start,
+                         encode_finish=encode_finish,
+                         packetization_finish=packetization_finish,
+                         encoded_size=encoded_size,
+                         is_key_frame=is_key_frame)
+        elif record_type == RECORD_PACER_EXIT:
+            ssrc, rtp_timestamp, pacer_exit = PACER_EXIT_FORMAT.unpack_from(
+                payload)
+            frame = streams.setdefault(ssrc, {}).setdefault(rtp_timestamp, {})
+            frame["pacer_exit"] = pacer_exit
+        # Unknown record types are skipped; newer writers may add more.
+    return streams
+
+
+def read_received_frames(path):
+    frames = {}
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            frames[int(row["rtp_timestamp"])] = {
+                column: int(row[column]) for column in RECEIVER_COLUMNS
+            }
+    return frames
+
+
+def difference(later, earlier, offset=0):
+    # -1 marks unknown times in both logs.
+    if later is None or earlier is None or later < 0 or earlier < 0:
+        return ""
+    return str(later - offset - earlier)
+
+
+def join(sent_path, received_path, output_path, clock_offset_ms):
+    streams = read_sent_frames(sent_path)
+    received = read_received_frames(received_path)
+    if not streams:
+        print(f"No frames in {sent_path}")
+        return
+
+    # The receiver log has no SSRC; with simulcast only the stream that was
+    # decoded matches.
+    ssrc = max(streams,
+               key=lambda s: sum(1 for t in streams[s] if t in received))
+    if len(streams) > 1:
+        print(f"Sender has {len(streams)} streams, joining SSRC {ssrc}")
+    sent = streams[ssrc]
+
+    matched = 0
+    with open(output_path, "w") as out:
+        out.write(OUTPUT_HEADER)
+        for rtp_timestamp, frame in sent.items():
+            get = frame.get
+            rx = received.get(rtp_timestamp, {})
+            if rx:
+                matched += 1
+            fields = [ssrc, rtp_timestamp, get("is_key_frame", ""),
+                      get("encoded_size", ""), get("capture_time", ""),
+                      get("encode_start", ""), get("encode_finish", ""),
+                      get("packetization_finish", ""), get("pacer_exit", "")]
+            fields += [rx.get(column, "") for column in RECEIVER_COLUMNS]
+            fields += [
+                difference(get("encode_start"), get("capture_time")),
+                difference(get("encode_finish"), get("encode_start")),
+                difference(get("packetization_finish"), get("encode_finish")),
+                difference(get("pacer_exit"), get("packetization_finish")),
+                difference(rx.get("receive_finish"), get("pacer_exit"),
+                           clock_offset_ms),
+                difference(rx.get("decode_start"), rx.get("receive_finish")),
+                difference(rx.get("decode_finish"), rx.get("decode_start")),
+                difference(rx.get("decode_finish"), get("capture_time"),
+                           clock_offset_ms),
+            ]
+            out.write(",".join(str(v) for v in fields) + "\n")
+
+    print(f"Wrote {len(sent)} frames to {output_path}, {matched} of them "
+          f"decoded, {len(sent) - matched} not")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print("Usage: python join_frame_timing.py <sent_frame_timing.bin> "
+              "<frame_timing.csv> [output.csv] [clock_offset_ms]")
+        print("Example: python join_frame_timing.py "
+              "webrtc_logs/<run>/sender/sent_frame_timing.bin "
+              "webrtc_logs/<run>/receiver/frame_timing.csv")
+        sys.exit(1)
+
+    sent_path = sys.argv[1]
+    received_path = sys.argv[2]
+    output_path = sys.argv[3] if len(sys.argv) > 3 else os.path.join(
+        os.path.dirname(os.path.abspath(sent_path)), "joined_frame_timing.csv")
+    clock_offset_ms = int(sys.argv[4]) if len(sys.argv) > 4 else 0
+    join(sent_path, received_path, output_path, clock_offset_ms)
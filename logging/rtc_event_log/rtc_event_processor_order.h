@@ -438,6 +438,20 @@ class TieBreaker<LoggedRtcpPacketTransportFeedback> {
   }
 };
 
+template <>
+class TieBreaker<LoggedRtcpCongestionControlFeedback> {
+ public:
+  static constexpr int type_order(PacketDirection direction) {
+    return static_cast<int>(direction == PacketDirection::kIncomingPacket
+                                ? TypeOrder::RtcpIn
+                                : TypeOrder::RtcpOut);
+  }
+  static std::optional<uint16_t> transport_seq_num_accessor(
+      const LoggedRtcpCongestionControlFeedback&) {
+    return std::optional<uint16_t>();
+  }
+};
+
 template <>
 class TieBreaker<LoggedRtcpPacketReceiverReport> {
  public:
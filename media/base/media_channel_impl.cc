@@ -208,6 +208,7 @@ bool MediaChannelUtil::TransportForMediaChannels::SendRtp(
        batchable = options.batchable,
        last_packet_in_batch = options.last_packet_in_batch,
        is_media = options.is_media,
+       send_as_ect1 = options.send_as_ect1,
        packet = rtc::CopyOnWriteBuffer(packet, kMaxRtpPacketLen)]() mutable {
         rtc::PacketOptions rtc_options;
         rtc_options.packet_id = packet_id;
@@ -221,6 +222,7 @@ bool MediaChannelUtil::TransportForMediaChannels::SendRtp(
         rtc_options.info_signaled_after_sent.is_media = is_media;
         rtc_options.batchable = batchable;
         rtc_options.last_packet_in_batch = last_packet_in_batch;
+        rtc_options.ecn_1 = send_as_ect1;
         DoSendPacket(&packet, false, rtc_options);
       };
 
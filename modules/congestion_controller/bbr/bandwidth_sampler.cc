@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bandwidth_sampler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+// Packets that have been in flight this long, measured in later packets sent,
+// are forgotten. Their feedback is most likely lost.
+constexpr size_t kMaxTrackedPackets = 1 << 15;
+// Shorter intervals are dominated by the receive time resolution of the
+// feedback.
+constexpr TimeDelta kMinSampleInterval = TimeDelta::Millis(1);
+}  // namespace
+
+BandwidthSampler::BandwidthSampler() = default;
+BandwidthSampler::~BandwidthSampler() = default;
+
+void BandwidthSampler::OnPacketSent(const SentPacket& packet,
+                                    bool is_app_limited) {
+  const int64_t sequence_number = packet.sequence_number;
+  if (packets_.empty()) {
+    first_sequence_number_ = sequence_number;
+  }
+  const int64_t index = sequence_number - first_sequence_number_;
+  if (index < static_cast<int64_t>(packets_.size())) {
+    // Sent out of order or twice, can't be tracked.
+    return;
+  }
+  if (index - static_cast<int64_t>(packets_.size()) >=
+      static_cast<int64_t>(kMaxTrackedPackets)) {
+    packets_.clear();
+    first_sequence_number_ = sequence_number;
+  }
+  // Sequence numbers that were skipped belong to packets that are not tracked.
+  while (first_sequence_number_ + static_cast<int64_t>(packets_.size()) <
+         sequence_number) {
+    packets_.push_back({.acked_or_lost = true});
+  }
+
+  if (packet.data_in_flight <= packet.size || first_sent_time_.IsInfinite()) {
+    // Nothing was in flight, so the interval starts with this packet.
+    first_sent_time_ = packet.send_time;
+  }
+  if (is_app_limited) {
+    OnAppLimited(packet.data_in_flight);
+  }
+  packets_.push_back({.send_time = packet.send_time,
+                      .size = packet.size,
+                      .data_in_flight = packet.data_in_flight,
+                      .prior_delivered = delivered_,
+                      .prior_delivered_time = delivered_time_,
+                      .first_sent_time = first_sent_time_,
+                      .is_app_limited = app_limited_until_.has_value()});
+  while (packets_.size() > kMaxTrackedPackets) {
+    packets_.pop_front();
+    ++first_sequence_number_;
+  }
+  PopAckedOrLost();
+}
+
+std::optional<BandwidthSample> BandwidthSampler::OnPacketAcked(
+    const PacketResult& packet) {
+  PacketState* state = Find(packet.sent_packet.sequence_number);
+  if (state == nullptr) {
+    return std::nullopt;
+  }
+  state->acked_or_lost = true;
+  delivered_ += state->size;
+  delivered_time_ = std::max(delivered_time_, packet.receive_time);
+  first_sent_time_ = state->send_time;
+  if (app_limited_until_ && delivered_ > *app_limited_until_) {
+    app_limited_until_.reset();
+  }
+
+  BandwidthSample sample;
+  sample.prior_delivered = state->prior_delivered;
+  sample.data_in_flight = state->data_in_flight;
+  sample.is_app_limited = state->is_app_limited;
+  if (state->prior_delivered_time.IsFinite()) {
+    TimeDelta interval =
+        std::max(state->send_time - state->first_sent_time,
+                 delivered_time_ - state->prior_delivered_time);
+    if (interval >= kMinSampleInterval) {
+      sample.delivery_rate = (delivered_ - state->prior_delivered) / interval;
+    }
+  }
+  PopAckedOrLost();
+  return sample;
+}
+
+void BandwidthSampler::OnPacketLost(const PacketResult& packet) {
+  PacketState* state = Find(packet.sent_packet.sequence_number);
+  if (state == nullptr) {
+    return;
+  }
+  state->acked_or_lost = true;
+  PopAckedOrLost();
+}
+
+void BandwidthSampler::OnAppLimited(DataSize data_in_flight) {
+  app_limited_until_ = delivered_ + data_in_flight;
+}
+
+BandwidthSampler::PacketState* BandwidthSampler::Find(int64_t sequence_number) {
+  const int64_t index = sequence_number - first_sequence_number_;
+  if (index < 0 || index >= static_cast<int64_t>(packets_.size()) ||
+      packets_[index].acked_or_lost) {
+    return nullptr;
+  }
+  return &packets_[index];
+}
+
+void BandwidthSampler::PopAckedOrLost() {
+  while (!packets_.empty() && packets_.front().acked_or_lost) {
+    packets_.pop_front();
+    ++first_sequence_number_;
+  }
+}
+
+}  // namespace bbr
+}  // namespace webrtc
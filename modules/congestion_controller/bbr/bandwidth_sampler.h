@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_BANDWIDTH_SAMPLER_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_BANDWIDTH_SAMPLER_H_
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+namespace bbr {
+
+struct BandwidthSample {
+  // Rate at which data was delivered over the interval that ends with the
+  // acknowledged packet. Not set if the interval is unknown or too short.
+  std::optional<DataRate> delivery_rate;
+  // Total data delivered when the acknowledged packet was sent. Used to tell
+  // when a packet-timed round trip has passed.
+  DataSize prior_delivered = DataSize::Zero();
+  // Data in flight when the acknowledged packet was sent, including itself.
+  DataSize data_in_flight = DataSize::Zero();
+  // True if the sender was application limited at any time during the
+  // interval, in which case the rate is a lower bound of the bandwidth.
+  bool is_app_limited = false;
+};
+
+// Estimates the delivery rate of the path from per-packet feedback, as
+// described in draft-cheng-iccrg-delivery-rate-estimation. For each sent packet
+// it remembers how much data had been delivered, and when, at the time it was
+// sent. When the packet is acknowledged, the data delivered since then divided
+// by the longer of the send and the acknowledge interval is a sample of the
+// delivery rate.
+//
+// Acknowledge times are the receive times reported in the feedback, so
+// intervals between them are measured with the receiver's clock and are not
+// affected by how feedback is batched.
+class BandwidthSampler {
+ public:
+  BandwidthSampler();
+  ~BandwidthSampler();
+
+  void OnPacketSent(const SentPacket& packet, bool is_app_limited);
+  // Returns a sample if `packet` was sent after the sampler was created and has
+  // not been acknowledged before. Packets must be acknowledged in order of
+  // receive time.
+  std::optional<BandwidthSample> OnPacketAcked(const PacketResult& packet);
+  void OnPacketLost(const PacketResult& packet);
+
+  // Marks the sender as application limited until all data in flight at this
+  // point has been acknowledged.
+  void OnAppLimited(DataSize data_in_flight);
+
+  DataSize total_delivered() const { return delivered_; }
+
+ private:
+  struct PacketState {
+    Timestamp send_time = Timestamp::MinusInfinity();
+    DataSize size = DataSize::Zero();
+    DataSize data_in_flight = DataSize::Zero();
+    DataSize prior_delivered = DataSize::Zero();
+    // Receive time of the most recently acknowledged packet when this packet
+    // was sent.
+    Timestamp prior_delivered_time = Timestamp::MinusInfinity();
+    // Send time of the most recently acknowledged packet when this packet was
+    // sent.
+    Timestamp first_sent_time = Timestamp::MinusInfinity();
+    bool is_app_limited = false;
+    bool acked_or_lost = false;
+  };
+
+  PacketState* Find(int64_t sequence_number);
+  void PopAckedOrLost();
+
+  // Packets in sequence number order, the first one has sequence number
+  // `first_sequence_number_`.
+  std::deque<PacketState> packets_;
+  int64_t first_sequence_number_ = 0;
+
+  DataSize delivered_ = DataSize::Zero();
+  Timestamp delivered_time_ = Timestamp::MinusInfinity();
+  Timestamp first_sent_time_ = Timestamp::MinusInfinity();
+  // Samples are application limited until `delivered_` exceeds this.
+  std::optional<DataSize> app_limited_until_;
+};
+
+}  // namespace bbr
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_BANDWIDTH_SAMPLER_H_
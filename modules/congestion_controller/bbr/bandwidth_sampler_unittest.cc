@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bandwidth_sampler.h"
+
+#include <cstdint>
+#include <optional>
+#include <set>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+
+constexpr DataSize kPacketSize = DataSize::Bytes(1000);
+constexpr TimeDelta kOneWayDelay = TimeDelta::Millis(50);
+
+class BandwidthSamplerTest : public ::testing::Test {
+ protected:
+  SentPacket Send(bool is_app_limited = false) {
+    SentPacket packet;
+    packet.send_time = now_;
+    packet.size = kPacketSize;
+    packet.sequence_number = next_sequence_number_++;
+    in_flight_.insert(packet.sequence_number);
+    packet.data_in_flight = in_flight_.size() * kPacketSize;
+    sampler_.OnPacketSent(packet, is_app_limited);
+    return packet;
+  }
+
+  std::optional<BandwidthSample> Ack(const SentPacket& packet,
+                                     Timestamp receive_time) {
+    in_flight_.erase(packet.sequence_number);
+    PacketResult result;
+    result.sent_packet = packet;
+    result.receive_time = receive_time;
+    return sampler_.OnPacketAcked(result);
+  }
+
+  void Lose(const SentPacket& packet) {
+    in_flight_.erase(packet.sequence_number);
+    PacketResult result;
+    result.sent_packet = packet;
+    sampler_.OnPacketLost(result);
+  }
+
+  Timestamp now_ = Timestamp::Seconds(100);
+  int64_t next_sequence_number_ = 1;
+  std::set<int64_t> in_flight_;
+  BandwidthSampler sampler_;
+};
+
+TEST_F(BandwidthSamplerTest, FirstAckHasNoDeliveryRate) {
+  SentPacket packet = Send();
+  std::optional<BandwidthSample> sample = Ack(packet, now_ + kOneWayDelay);
+  ASSERT_TRUE(sample.has_value());
+  EXPECT_FALSE(sample->delivery_rate.has_value());
+  EXPECT_EQ(sample->prior_delivered, DataSize::Zero());
+  EXPECT_EQ(sampler_.total_delivered(), kPacketSize);
+}
+
+TEST_F(BandwidthSamplerTest, SamplesRateOfPacedPackets) {
+  const TimeDelta kInterval = TimeDelta::Millis(10);
+  SentPacket first = Send();
+  Ack(first, now_ + kOneWayDelay);
+  std::optional<BandwidthSample> sample;
+  for (int i = 0; i < 10; ++i) {
+    now_ += kInterval;
+    sample = Ack(Send(), now_ + kOneWayDelay);
+  }
+  ASSERT_TRUE(sample.has_value());
+  ASSERT_TRUE(sample->delivery_rate.has_value());
+  EXPECT_EQ(*sample->delivery_rate, kPacketSize / kInterval);
+  EXPECT_FALSE(sample->is_app_limited);
+}
+
+TEST_F(BandwidthSamplerTest, RateIsLimitedByReceiveInterval) {
+  // A burst sent faster than the bottleneck arrives at the bottleneck rate.
+  const TimeDelta kBottleneckInterval = TimeDelta::Millis(8);
+  Timestamp receive_time = now_ + kOneWayDelay;
+  SentPacket first = Send();
+  Ack(first, receive_time);
+  now_ = receive_time;
+  SentPacket packets[10];
+  for (SentPacket& packet : packets) {
+    packet = Send();
+    now_ += TimeDelta::Millis(1);
+  }
+  std::optional<BandwidthSample> sample;
+  for (const SentPacket& packet : packets) {
+    receive_time += kBottleneckInterval;
+    sample = Ack(packet, receive_time);
+  }
+  ASSERT_TRUE(sample.has_value());
+  ASSERT_TRUE(sample->delivery_rate.has_value());
+  EXPECT_EQ(*sample->delivery_rate, kPacketSize / kBottleneckInterval);
+}
+
+TEST_F(BandwidthSamplerTest, MarksSamplesAfterAppLimitedSendAsAppLimited) {
+  SentPacket first = Send();
+  Ack(first, now_ + kOneWayDelay);
+  now_ += TimeDelta::Millis(10);
+  SentPacket app_limited = Send(/*is_app_limited=*/true);
+  now_ += TimeDelta::Millis(10);
+  SentPacket next = Send();
+
+  std::optional<BandwidthSample> sample =
+      Ack(app_limited, app_limited.send_time + kOneWayDelay);
+  ASSERT_TRUE(sample.has_value());
+  EXPECT_TRUE(sample->is_app_limited);
+  sample = Ack(next, next.send_time + kOneWayDelay);
+  ASSERT_TRUE(sample.has_value());
+  EXPECT_TRUE(sample->is_app_limited);
+
+  // Once the data in flight when the sender was application limited has been
+  // delivered, samples are no longer application limited.
+  now_ += TimeDelta::Millis(10);
+  SentPacket last = Send();
+  sample = Ack(last, last.send_time + kOneWayDelay);
+  ASSERT_TRUE(sample.has_value());
+  EXPECT_FALSE(sample->is_app_limited);
+}
+
+TEST_F(BandwidthSamplerTest, IgnoresLostAndDuplicatePackets) {
+  SentPacket lost = Send();
+  SentPacket acked = Send();
+  Lose(lost);
+  EXPECT_FALSE(Ack(lost, now_ + kOneWayDelay).has_value());
+  EXPECT_TRUE(Ack(acked, now_ + kOneWayDelay).has_value());
+  EXPECT_FALSE(Ack(acked, now_ + kOneWayDelay).has_value());
+  EXPECT_EQ(sampler_.total_delivered(), kPacketSize);
+}
+
+TEST_F(BandwidthSamplerTest, TracksPacketsAcrossSkippedSequenceNumbers) {
+  SentPacket first = Send();
+  next_sequence_number_ += 5;
+  SentPacket second = Send();
+  EXPECT_TRUE(Ack(second, now_ + kOneWayDelay).has_value());
+  EXPECT_TRUE(Ack(first, now_ + kOneWayDelay).has_value());
+  EXPECT_EQ(sampler_.total_delivered(), 2 * kPacketSize);
+}
+
+}  // namespace
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,36 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_BBR_FACTORY_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_BBR_FACTORY_H_
+
+#include <memory>
+
+#include "api/transport/network_control.h"
+#include "api/units/time_delta.h"
+#include "modules/congestion_controller/bbr/bbr_network_controller.h"
+
+namespace webrtc {
+
+class BbrNetworkControllerFactory : public NetworkControllerFactoryInterface {
+ public:
+  BbrNetworkControllerFactory();
+  explicit BbrNetworkControllerFactory(bbr::BbrSettings settings);
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override;
+  TimeDelta GetProcessInterval() const override;
+
+ private:
+  const bbr::BbrSettings settings_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_BBR_FACTORY_H_
@@ -0,0 +1,629 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bbr_network_controller.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "api/transport/network_control.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/bbr/bandwidth_sampler.h"
+#include "modules/congestion_controller/goog_cc/probe_bitrate_estimator.h"
+#include "modules/congestion_controller/goog_cc/probe_controller.h"
+#include "modules/remote_bitrate_estimator/include/bwe_defines.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+constexpr DataSize kMinCongestionWindow = DataSize::Bytes(4 * 1500);
+// Used until the first delivery rate sample if no starting rate is configured.
+constexpr DataRate kDefaultStartingRate = DataRate::KilobitsPerSec(300);
+// Number of feedback intervals the congestion window allowance is based on.
+constexpr size_t kFeedbackIntervalWindow = 10;
+// Probing for more bandwidth ends after this many rounds even if the data in
+// flight did not reach the probe target, which is common when the encoders are
+// application limited.
+constexpr int64_t kMaxProbeUpRounds = 3;
+constexpr uint64_t kRandomSeed = 100;
+}  // namespace
+
+BbrNetworkController::BbrNetworkController(NetworkControllerConfig config,
+                                           BbrSettings settings)
+    : env_(config.env),
+      settings_(settings),
+      probe_controller_(&env_.field_trials(), &env_.event_log()),
+      congestion_window_pushback_controller_(env_.field_trials()),
+      alr_detector_(&env_.field_trials(), &env_.event_log()),
+      random_(kRandomSeed),
+      initial_config_(config),
+      starting_rate_(
+          config.constraints.starting_rate.value_or(kDefaultStartingRate)),
+      max_padding_rate_(config.stream_based_config.max_padding_rate.value_or(
+          DataRate::Zero())),
+      probe_bitrate_estimator_(
+          std::make_unique<ProbeBitrateEstimator>(&env_.event_log())) {
+  RTC_DCHECK(config.constraints.at_time.IsFinite());
+  RTC_DCHECK_LE(settings_.min_cruise_duration, settings_.max_cruise_duration);
+}
+
+BbrNetworkController::~BbrNetworkController() = default;
+
+NetworkControlUpdate BbrNetworkController::OnNetworkAvailability(
+    NetworkAvailability msg) {
+  NetworkControlUpdate update;
+  update.probe_cluster_configs = probe_controller_.OnNetworkAvailability(msg);
+  return update;
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkRouteChange(
+    NetworkRouteChange msg) {
+  // Start the new path from what the old one could carry, it is likely to be
+  // of the same kind.
+  if (full_bandwidth_reached_) {
+    msg.constraints.starting_rate =
+        std::min(msg.constraints.starting_rate.value_or(bandwidth()),
+                 bandwidth());
+  }
+  ResetModel();
+  probe_controller_.Reset(msg.at_time);
+  NetworkControlUpdate update;
+  update.probe_cluster_configs = ResetConstraints(msg.constraints);
+  MaybeTriggerOnNetworkChanged(&update, msg.at_time);
+  return update;
+}
+
+NetworkControlUpdate BbrNetworkController::OnProcessInterval(
+    ProcessInterval msg) {
+  NetworkControlUpdate update;
+  if (initial_config_) {
+    update.probe_cluster_configs =
+        ResetConstraints(initial_config_->constraints);
+    const StreamsConfig& streams = initial_config_->stream_based_config;
+    if (streams.requests_alr_probing) {
+      probe_controller_.EnablePeriodicAlrProbing(*streams.requests_alr_probing);
+    }
+    if (streams.enable_repeated_initial_probing) {
+      probe_controller_.EnableRepeatedInitialProbing(
+          *streams.enable_repeated_initial_probing);
+    }
+    if (streams.max_total_allocated_bitrate) {
+      auto probes = probe_controller_.OnMaxTotalAllocatedBitrate(
+          *streams.max_total_allocated_bitrate, msg.at_time);
+      update.probe_cluster_configs.insert(update.probe_cluster_configs.end(),
+                                          probes.begin(), probes.end());
+    }
+    initial_config_.reset();
+  }
+  if (msg.pacer_queue) {
+    pacer_queue_ = *msg.pacer_queue;
+    congestion_window_pushback_controller_.UpdateOutstandingData(
+        (data_in_flight_ + pacer_queue_).bytes());
+  }
+  probe_controller_.SetAlrStartTimeMs(
+      alr_detector_.GetApplicationLimitedRegionStartTime());
+  auto probes = probe_controller_.Process(msg.at_time);
+  update.probe_cluster_configs.insert(update.probe_cluster_configs.end(),
+                                      probes.begin(), probes.end());
+
+  UpdateMode(msg.at_time);
+  MaybeTriggerOnNetworkChanged(&update, msg.at_time);
+  return update;
+}
+
+NetworkControlUpdate BbrNetworkController::OnRemoteBitrateReport(
+    RemoteBitrateReport /* msg */) {
+  // The model is built from packet feedback only.
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnRoundTripTimeUpdate(
+    RoundTripTimeUpdate /* msg */) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnSentPacket(SentPacket msg) {
+  alr_detector_.OnBytesSent(msg.size.bytes(), msg.send_time.ms());
+  // Probe packets are sent at the probe rate whatever the encoders produce.
+  bool is_app_limited =
+      alr_detector_.GetApplicationLimitedRegionStartTime().has_value() &&
+      msg.pacing_info.probe_cluster_id == PacedPacketInfo::kNotAProbe;
+  sampler_.OnPacketSent(msg, is_app_limited);
+
+  data_in_flight_ = msg.data_in_flight;
+  congestion_window_pushback_controller_.UpdateOutstandingData(
+      (data_in_flight_ + pacer_queue_).bytes());
+  NetworkControlUpdate update;
+  MaybeTriggerOnNetworkChanged(&update, msg.send_time);
+  return update;
+}
+
+NetworkControlUpdate BbrNetworkController::OnReceivedPacket(
+    ReceivedPacket /* msg */) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnStreamsConfig(StreamsConfig msg) {
+  NetworkControlUpdate update;
+  if (msg.requests_alr_probing) {
+    probe_controller_.EnablePeriodicAlrProbing(*msg.requests_alr_probing);
+  }
+  if (msg.max_total_allocated_bitrate) {
+    update.probe_cluster_configs = probe_controller_.OnMaxTotalAllocatedBitrate(
+        *msg.max_total_allocated_bitrate, msg.at_time);
+  }
+  if (msg.max_padding_rate) {
+    max_padding_rate_ = *msg.max_padding_rate;
+  }
+  MaybeTriggerOnNetworkChanged(&update, msg.at_time);
+  return update;
+}
+
+NetworkControlUpdate BbrNetworkController::OnTargetRateConstraints(
+    TargetRateConstraints msg) {
+  NetworkControlUpdate update;
+  update.probe_cluster_configs = ResetConstraints(msg);
+  MaybeTriggerOnNetworkChanged(&update, msg.at_time);
+  return update;
+}
+
+NetworkControlUpdate BbrNetworkController::OnTransportLossReport(
+    TransportLossReport /* msg */) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnTransportPacketsFeedback(
+    TransportPacketsFeedback report) {
+  if (report.packet_feedbacks.empty()) {
+    return NetworkControlUpdate();
+  }
+  if (last_feedback_time_.IsFinite()) {
+    feedback_intervals_.push_back(report.feedback_time - last_feedback_time_);
+    if (feedback_intervals_.size() > kFeedbackIntervalWindow) {
+      feedback_intervals_.pop_front();
+    }
+  }
+  last_feedback_time_ = report.feedback_time;
+  data_in_flight_ = report.data_in_flight;
+  congestion_window_pushback_controller_.UpdateOutstandingData(
+      (data_in_flight_ + pacer_queue_).bytes());
+
+  UpdateMinRtt(report);
+  for (const PacketResult& packet : report.LostWithSendInfo()) {
+    sampler_.OnPacketLost(packet);
+    lost_in_round_ += packet.sent_packet.size;
+    ++lost_packets_in_round_;
+  }
+  for (const PacketResult& packet : report.SortedByReceiveTime()) {
+    if (packet.sent_packet.pacing_info.probe_cluster_id !=
+        PacedPacketInfo::kNotAProbe) {
+      probe_bitrate_estimator_->HandleProbeAndEstimateBitrate(packet);
+    }
+    std::optional<BandwidthSample> sample = sampler_.OnPacketAcked(packet);
+    if (!sample) {
+      continue;
+    }
+    delivered_in_round_ += packet.sent_packet.size;
+    if (sample->prior_delivered >= next_round_delivered_) {
+      next_round_delivered_ = sampler_.total_delivered();
+      ++round_count_;
+      OnRoundStart();
+    }
+    UpdateBandwidth(*sample);
+  }
+  std::optional<DataRate> probe_bitrate =
+      probe_bitrate_estimator_->FetchAndResetLastEstimatedBitrate();
+  if (probe_bitrate) {
+    max_bandwidth_[1] = std::max(max_bandwidth_[1], *probe_bitrate);
+  }
+  UpdateMode(report.feedback_time);
+
+  NetworkControlUpdate update;
+  MaybeTriggerOnNetworkChanged(&update, report.feedback_time);
+  return update;
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkStateEstimate(
+    NetworkStateEstimate /* msg */) {
+  return NetworkControlUpdate();
+}
+
+DataRate BbrNetworkController::bandwidth() const {
+  DataRate bandwidth = std::max(max_bandwidth_[0], max_bandwidth_[1]);
+  if (!full_bandwidth_reached_) {
+    // The starting rate is a guess of the bandwidth that startup only revises
+    // upwards, unless there is loss.
+    bandwidth = std::max(bandwidth, starting_rate_);
+  }
+  bandwidth = std::min(bandwidth, bandwidth_lo_);
+  return std::clamp(bandwidth, min_data_rate_, max_data_rate_);
+}
+
+std::vector<ProbeClusterConfig> BbrNetworkController::ResetConstraints(
+    TargetRateConstraints new_constraints) {
+  min_data_rate_ =
+      std::max(new_constraints.min_data_rate.value_or(DataRate::Zero()),
+               kCongestionControllerMinBitrate);
+  max_data_rate_ =
+      new_constraints.max_data_rate.value_or(DataRate::PlusInfinity());
+  if (max_data_rate_ < min_data_rate_) {
+    RTC_LOG(LS_WARNING) << "max bitrate smaller than min bitrate";
+    max_data_rate_ = min_data_rate_;
+  }
+  if (new_constraints.starting_rate) {
+    starting_rate_ = *new_constraints.starting_rate;
+  }
+  starting_rate_ = std::clamp(starting_rate_, min_data_rate_, max_data_rate_);
+  return probe_controller_.SetBitrates(min_data_rate_, starting_rate_,
+                                       max_data_rate_, new_constraints.at_time);
+}
+
+void BbrNetworkController::ResetModel() {
+  sampler_ = BandwidthSampler();
+  probe_bitrate_estimator_ =
+      std::make_unique<ProbeBitrateEstimator>(&env_.event_log());
+  mode_ = Mode::kStartup;
+  probe_phase_ = ProbePhase::kDown;
+  probe_phase_start_ = Timestamp::MinusInfinity();
+  probe_phase_round_ = 0;
+  max_bandwidth_ = {DataRate::Zero(), DataRate::Zero()};
+  bandwidth_lo_ = DataRate::PlusInfinity();
+  inflight_hi_ = DataSize::PlusInfinity();
+  min_rtt_ = TimeDelta::PlusInfinity();
+  min_rtt_time_ = Timestamp::MinusInfinity();
+  probe_rtt_done_time_ = Timestamp::PlusInfinity();
+  probe_rtt_round_done_ = false;
+  round_count_ = 0;
+  next_round_delivered_ = DataSize::Zero();
+  delivered_in_round_ = DataSize::Zero();
+  lost_in_round_ = DataSize::Zero();
+  lost_packets_in_round_ = 0;
+  max_delivery_rate_in_round_ = DataRate::Zero();
+  last_round_loss_ratio_ = 0;
+  full_bandwidth_reached_ = false;
+  full_bandwidth_ = DataRate::Zero();
+  full_bandwidth_count_ = 0;
+  feedback_intervals_.clear();
+  last_feedback_time_ = Timestamp::MinusInfinity();
+}
+
+void BbrNetworkController::UpdateMinRtt(
+    const TransportPacketsFeedback& report) {
+  std::vector<PacketResult> received = report.ReceivedWithSendInfo();
+  Timestamp max_recv_time = Timestamp::MinusInfinity();
+  for (const PacketResult& packet : received) {
+    max_recv_time = std::max(max_recv_time, packet.receive_time);
+  }
+  // Time spent waiting for the feedback to be sent is not part of the RTT.
+  TimeDelta rtt = TimeDelta::PlusInfinity();
+  for (const PacketResult& packet : received) {
+    TimeDelta pending_time = max_recv_time - packet.receive_time;
+    rtt = std::min(rtt, report.feedback_time - packet.sent_packet.send_time -
+                            pending_time);
+  }
+  if (rtt.IsInfinite()) {
+    return;
+  }
+  rtt = std::max(rtt, TimeDelta::Millis(1));
+
+  const bool expired =
+      min_rtt_time_.IsFinite() &&
+      report.feedback_time > min_rtt_time_ + settings_.probe_rtt_interval;
+  if (rtt <= min_rtt_ || expired) {
+    min_rtt_ = rtt;
+    min_rtt_time_ = report.feedback_time;
+  }
+  if (expired && mode_ != Mode::kProbeRtt) {
+    mode_ = Mode::kProbeRtt;
+    probe_rtt_done_time_ = Timestamp::PlusInfinity();
+    probe_rtt_round_done_ = false;
+  }
+}
+
+void BbrNetworkController::UpdateBandwidth(const BandwidthSample& sample) {
+  if (!sample.delivery_rate) {
+    return;
+  }
+  DataRate rate = *sample.delivery_rate;
+  max_delivery_rate_in_round_ = std::max(max_delivery_rate_in_round_, rate);
+  // Application limited samples only tell that the bandwidth is at least this.
+  if (sample.is_app_limited &&
+      rate < std::max(max_bandwidth_[0], max_bandwidth_[1])) {
+    return;
+  }
+  max_bandwidth_[1] = std::max(max_bandwidth_[1], rate);
+}
+
+void BbrNetworkController::OnRoundStart() {
+  DataSize sent_in_round = delivered_in_round_ + lost_in_round_;
+  last_round_loss_ratio_ =
+      sent_in_round.IsZero() ? 0 : lost_in_round_ / sent_in_round;
+  if (last_round_loss_ratio_ > settings_.loss_threshold &&
+      lost_packets_in_round_ >= settings_.min_lost_packets) {
+    OnLossRound();
+  } else if (mode_ == Mode::kProbeBw && probe_phase_ == ProbePhase::kUp &&
+             inflight_hi_.IsFinite()) {
+    // No loss while probing, allow more in flight.
+    inflight_hi_ = inflight_hi_ * settings_.probe_up_pacing_gain;
+  }
+
+  if (!full_bandwidth_reached_) {
+    DataRate max_bandwidth = std::max(max_bandwidth_[0], max_bandwidth_[1]);
+    if (max_bandwidth >= full_bandwidth_ * settings_.startup_growth_target) {
+      full_bandwidth_ = max_bandwidth;
+      full_bandwidth_count_ = 0;
+    } else if (++full_bandwidth_count_ >=
+               settings_.startup_full_bandwidth_rounds) {
+      full_bandwidth_reached_ = true;
+    }
+  }
+  if (mode_ == Mode::kProbeRtt && probe_rtt_done_time_.IsFinite()) {
+    probe_rtt_round_done_ = true;
+  }
+
+  delivered_in_round_ = DataSize::Zero();
+  lost_in_round_ = DataSize::Zero();
+  lost_packets_in_round_ = 0;
+  max_delivery_rate_in_round_ = DataRate::Zero();
+}
+
+void BbrNetworkController::OnLossRound() {
+  // What was in flight when the loss happened is more than the path can hold
+  // without building a queue that overflows.
+  inflight_hi_ = std::max(
+      kMinCongestionWindow,
+      std::max(data_in_flight_, BandwidthDelayProduct(1.0)) * settings_.beta);
+  DataRate bandwidth_lo =
+      std::min(bandwidth_lo_, std::max(max_bandwidth_[0], max_bandwidth_[1]));
+  bandwidth_lo_ =
+      std::max(max_delivery_rate_in_round_, bandwidth_lo * settings_.beta);
+  if (mode_ == Mode::kStartup) {
+    full_bandwidth_reached_ = true;
+  }
+  if (mode_ == Mode::kProbeBw && probe_phase_ == ProbePhase::kUp) {
+    EnterProbePhase(ProbePhase::kDown, last_feedback_time_);
+  }
+}
+
+void BbrNetworkController::UpdateMode(Timestamp at_time) {
+  switch (mode_) {
+    case Mode::kStartup:
+      if (full_bandwidth_reached_) {
+        mode_ = Mode::kDrain;
+      }
+      break;
+    case Mode::kDrain:
+      if (data_in_flight_ <= BandwidthDelayProduct(1.0)) {
+        EnterProbeBw(at_time);
+      }
+      break;
+    case Mode::kProbeBw:
+      UpdateProbePhase(at_time);
+      break;
+    case Mode::kProbeRtt:
+      if (probe_rtt_done_time_.IsInfinite()) {
+        if (data_in_flight_ <= CongestionWindow()) {
+          probe_rtt_done_time_ = at_time + settings_.probe_rtt_duration;
+          probe_rtt_round_done_ = false;
+        }
+      } else if (probe_rtt_round_done_ && at_time >= probe_rtt_done_time_) {
+        min_rtt_time_ = at_time;
+        probe_rtt_done_time_ = Timestamp::PlusInfinity();
+        if (full_bandwidth_reached_) {
+          EnterProbeBw(at_time);
+        } else {
+          mode_ = Mode::kStartup;
+        }
+      }
+      break;
+  }
+}
+
+void BbrNetworkController::EnterProbeBw(Timestamp at_time) {
+  mode_ = Mode::kProbeBw;
+  EnterProbePhase(ProbePhase::kDown, at_time);
+}
+
+void BbrNetworkController::EnterProbePhase(ProbePhase phase,
+                                           Timestamp at_time) {
+  probe_phase_ = phase;
+  probe_phase_start_ = at_time;
+  probe_phase_round_ = round_count_;
+  switch (phase) {
+    case ProbePhase::kDown:
+      // A new probe cycle starts, forget the oldest bandwidth measurements.
+      max_bandwidth_[0] = max_bandwidth_[1];
+      max_bandwidth_[1] = DataRate::Zero();
+      break;
+    case ProbePhase::kCruise:
+      cruise_duration_ =
+          settings_.min_cruise_duration +
+          TimeDelta::Millis(random_.Rand(static_cast<uint32_t>(
+              (settings_.max_cruise_duration - settings_.min_cruise_duration)
+                  .ms())));
+      break;
+    case ProbePhase::kRefill:
+      // Probe from the long term model, the loss that bounded it is likely to
+      // have been transient.
+      bandwidth_lo_ = DataRate::PlusInfinity();
+      break;
+    case ProbePhase::kUp:
+      break;
+  }
+}
+
+void BbrNetworkController::UpdateProbePhase(Timestamp at_time) {
+  switch (probe_phase_) {
+    case ProbePhase::kDown:
+      if (data_in_flight_ <= BandwidthDelayProduct(1.0)) {
+        EnterProbePhase(ProbePhase::kCruise, at_time);
+      }
+      break;
+    case ProbePhase::kCruise:
+      if (at_time - probe_phase_start_ >= cruise_duration_) {
+        EnterProbePhase(ProbePhase::kRefill, at_time);
+      }
+      break;
+    case ProbePhase::kRefill:
+      if (round_count_ > probe_phase_round_) {
+        EnterProbePhase(ProbePhase::kUp, at_time);
+      }
+      break;
+    case ProbePhase::kUp:
+      if (at_time - probe_phase_start_ >= min_rtt_ &&
+          (data_in_flight_ >=
+               BandwidthDelayProduct(settings_.probe_up_pacing_gain) ||
+           round_count_ - probe_phase_round_ >= kMaxProbeUpRounds)) {
+        EnterProbePhase(ProbePhase::kDown, at_time);
+      }
+      break;
+  }
+}
+
+DataSize BbrNetworkController::BandwidthDelayProduct(double gain) const {
+  if (min_rtt_.IsInfinite()) {
+    return DataSize::PlusInfinity();
+  }
+  return bandwidth() * min_rtt_ * gain;
+}
+
+double BbrNetworkController::PacingGain() const {
+  switch (mode_) {
+    case Mode::kStartup:
+      return settings_.startup_pacing_gain;
+    case Mode::kDrain:
+      return settings_.drain_pacing_gain;
+    case Mode::kProbeRtt:
+      return 1.0;
+    case Mode::kProbeBw:
+      break;
+  }
+  switch (probe_phase_) {
+    case ProbePhase::kDown:
+      return settings_.probe_down_pacing_gain;
+    case ProbePhase::kCruise:
+    case ProbePhase::kRefill:
+      return 1.0;
+    case ProbePhase::kUp:
+      return settings_.probe_up_pacing_gain;
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+DataSize BbrNetworkController::CongestionWindow() const {
+  if (min_rtt_.IsInfinite()) {
+    return DataSize::PlusInfinity();
+  }
+  if (mode_ == Mode::kProbeRtt) {
+    return std::max(kMinCongestionWindow,
+                    BandwidthDelayProduct(settings_.probe_rtt_cwnd_gain));
+  }
+  TimeDelta feedback_interval = TimeDelta::Zero();
+  for (TimeDelta interval : feedback_intervals_) {
+    feedback_interval = std::max(feedback_interval, interval);
+  }
+  double gain = full_bandwidth_reached_ ? settings_.cwnd_gain
+                                        : settings_.startup_cwnd_gain;
+  DataSize window = bandwidth() * (min_rtt_ + feedback_interval) * gain;
+  return std::max(kMinCongestionWindow, std::min(window, inflight_hi_));
+}
+
+DataRate BbrNetworkController::TargetRate() const {
+  return bandwidth();
+}
+
+void BbrNetworkController::MaybeTriggerOnNetworkChanged(
+    NetworkControlUpdate* update,
+    Timestamp at_time) {
+  if (initial_config_) {
+    // Nothing is known before the constraints have been applied.
+    return;
+  }
+  DataRate target_rate = TargetRate();
+  DataSize congestion_window = CongestionWindow();
+  if (congestion_window.IsFinite()) {
+    congestion_window_pushback_controller_.SetDataWindow(congestion_window);
+  }
+  DataRate pushback_target_rate = std::max(
+      min_data_rate_,
+      DataRate::BitsPerSec(
+          congestion_window_pushback_controller_.UpdateTargetBitrate(
+              target_rate.bps())));
+
+  if (target_rate != last_target_rate_ ||
+      pushback_target_rate != last_pushback_target_rate_) {
+    last_target_rate_ = target_rate;
+    last_pushback_target_rate_ = pushback_target_rate;
+    alr_detector_.SetEstimatedBitrate(target_rate.bps());
+
+    TargetTransferRate target_rate_msg;
+    target_rate_msg.at_time = at_time;
+    target_rate_msg.target_rate = pushback_target_rate;
+    // The older of the two probe cycles in the bandwidth filter has survived
+    // a full probe without being replaced.
+    target_rate_msg.stable_target_rate = std::min(
+        pushback_target_rate,
+        max_bandwidth_[0].IsZero() ? target_rate : max_bandwidth_[0]);
+    target_rate_msg.network_estimate.at_time = at_time;
+    target_rate_msg.network_estimate.round_trip_time = min_rtt_;
+    target_rate_msg.network_estimate.loss_rate_ratio = last_round_loss_ratio_;
+    target_rate_msg.network_estimate.bwe_period =
+        settings_.max_cruise_duration;
+    update->target_rate = target_rate_msg;
+
+    auto probes = probe_controller_.SetEstimatedBitrate(
+        target_rate,
+        bandwidth_lo_.IsFinite() ? BandwidthLimitedCause::kLossLimitedBwe
+                                 : BandwidthLimitedCause::kDelayBasedLimited,
+        at_time);
+    update->probe_cluster_configs.insert(update->probe_cluster_configs.end(),
+                                         probes.begin(), probes.end());
+  }
+
+  // Pacing is based on the bandwidth before pushback, so that the pacer does
+  // not build a queue when pushback occurs.
+  DataRate pacing_rate = target_rate * PacingGain();
+  DataRate padding_rate = max_padding_rate_;
+  if (mode_ == Mode::kProbeBw && probe_phase_ == ProbePhase::kUp) {
+    // The encoders rarely produce more than the target rate, pad up to the
+    // probe rate so that the probe measures the path.
+    padding_rate = std::max(padding_rate, pacing_rate);
+  }
+  padding_rate = std::min({padding_rate, pacing_rate, max_data_rate_});
+  if (pacing_rate != last_pacing_rate_ || padding_rate != last_padding_rate_) {
+    last_pacing_rate_ = pacing_rate;
+    last_padding_rate_ = padding_rate;
+    PacerConfig pacer_config;
+    pacer_config.at_time = at_time;
+    pacer_config.time_window = TimeDelta::Seconds(1);
+    pacer_config.data_window = pacing_rate * pacer_config.time_window;
+    pacer_config.pad_window = padding_rate * pacer_config.time_window;
+    update->pacer_config = pacer_config;
+  }
+
+  if ((congestion_window.IsFinite() || last_congestion_window_) &&
+      congestion_window != last_congestion_window_) {
+    last_congestion_window_ = congestion_window;
+    update->congestion_window = congestion_window;
+  }
+}
+
+}  // namespace bbr
+}  // namespace webrtc
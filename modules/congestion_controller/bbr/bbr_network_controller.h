@@ -0,0 +1,225 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "api/environment/environment.h"
+#include "api/transport/network_control.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/bbr/bandwidth_sampler.h"
+#include "modules/congestion_controller/goog_cc/alr_detector.h"
+#include "modules/congestion_controller/goog_cc/congestion_window_pushback_controller.h"
+#include "modules/congestion_controller/goog_cc/probe_bitrate_estimator.h"
+#include "modules/congestion_controller/goog_cc/probe_controller.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace bbr {
+
+struct BbrSettings {
+  // Pacing and congestion window gains, relative to the bandwidth and the
+  // bandwidth-delay product of the model.
+  double startup_pacing_gain = 2.77;
+  double startup_cwnd_gain = 2.0;
+  double drain_pacing_gain = 1 / 2.77;
+  double probe_up_pacing_gain = 1.25;
+  double probe_down_pacing_gain = 0.9;
+  double cwnd_gain = 2.0;
+  // Startup ends when the bandwidth has grown less than
+  // `startup_growth_target` in `startup_full_bandwidth_rounds` rounds.
+  double startup_growth_target = 1.25;
+  int startup_full_bandwidth_rounds = 3;
+  // Fraction of the data sent in a round that may be lost before the model
+  // is bounded by the loss.
+  double loss_threshold = 0.02;
+  // At low rates a round trip holds few packets, so a single random loss would
+  // exceed the threshold.
+  int min_lost_packets = 2;
+  // Multiplicative decrease of the in-flight and bandwidth bounds on loss.
+  double beta = 0.7;
+  // Time spent cruising at the estimated bandwidth between probes is picked
+  // uniformly from this range.
+  TimeDelta min_cruise_duration = TimeDelta::Seconds(2);
+  TimeDelta max_cruise_duration = TimeDelta::Seconds(3);
+  // The minimum RTT is remeasured, by draining the queue at the bottleneck,
+  // if it has not been seen for this long.
+  TimeDelta probe_rtt_interval = TimeDelta::Seconds(5);
+  TimeDelta probe_rtt_duration = TimeDelta::Millis(200);
+  // Fraction of the bandwidth-delay product in flight while measuring the
+  // minimum RTT.
+  double probe_rtt_cwnd_gain = 0.5;
+};
+
+// Model-based congestion control in the style of BBRv2
+// (draft-cardwell-iccrg-bbr-congestion-control). The controller estimates the
+// bottleneck bandwidth from delivery rate samples and the propagation delay
+// from the minimum RTT, and paces at, and bounds the data in flight to, small
+// multiples of these. It periodically probes for more bandwidth and drains
+// the queue it built up right after, so that the queue at the bottleneck stays
+// short. Packet loss above `loss_threshold` bounds the model.
+//
+// The target rate given to the encoders is the estimated bandwidth, reduced by
+// CongestionWindowPushbackController when the congestion window fills up.
+// Probing while the encoders are application limited is done with probe
+// clusters from ProbeController. These are too short to fill the pipe for a
+// round trip, so their rate is measured with ProbeBitrateEstimator and added
+// to the bandwidth filter like any other sample.
+class BbrNetworkController : public NetworkControllerInterface {
+ public:
+  enum class Mode {
+    // Exponential search for the bottleneck bandwidth.
+    kStartup,
+    // Drains the queue created in startup.
+    kDrain,
+    // Steady state, cycling through the probe phases.
+    kProbeBw,
+    // Reduces the data in flight to remeasure the minimum RTT.
+    kProbeRtt,
+  };
+
+  enum class ProbePhase {
+    // Drains the queue created while probing.
+    kDown,
+    // Sends at the estimated bandwidth.
+    kCruise,
+    // Refills the pipe for one round before probing.
+    kRefill,
+    // Sends above the estimated bandwidth to probe for more.
+    kUp,
+  };
+
+  BbrNetworkController(NetworkControllerConfig config, BbrSettings settings);
+  ~BbrNetworkController() override;
+
+  // NetworkControllerInterface
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override;
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override;
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override;
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override;
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override;
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override;
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override;
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override;
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override;
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override;
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override;
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override;
+
+  Mode mode() const { return mode_; }
+  ProbePhase probe_phase() const { return probe_phase_; }
+  // Bandwidth used for pacing and as target rate, before pushback.
+  DataRate bandwidth() const;
+  TimeDelta min_rtt() const { return min_rtt_; }
+
+ private:
+  std::vector<ProbeClusterConfig> ResetConstraints(
+      TargetRateConstraints new_constraints);
+  void ResetModel();
+
+  void UpdateMinRtt(const TransportPacketsFeedback& report);
+  void UpdateBandwidth(const BandwidthSample& sample);
+  void OnRoundStart();
+  void OnLossRound();
+  void UpdateMode(Timestamp at_time);
+  void EnterProbeBw(Timestamp at_time);
+  void EnterProbePhase(ProbePhase phase, Timestamp at_time);
+  void UpdateProbePhase(Timestamp at_time);
+
+  DataSize BandwidthDelayProduct(double gain) const;
+  double PacingGain() const;
+  DataSize CongestionWindow() const;
+  DataRate TargetRate() const;
+  void MaybeTriggerOnNetworkChanged(NetworkControlUpdate* update,
+                                    Timestamp at_time);
+
+  const Environment env_;
+  const BbrSettings settings_;
+  ProbeController probe_controller_;
+  CongestionWindowPushbackController congestion_window_pushback_controller_;
+  AlrDetector alr_detector_;
+  Random random_;
+
+  std::optional<NetworkControllerConfig> initial_config_;
+  DataRate min_data_rate_ = DataRate::Zero();
+  DataRate max_data_rate_ = DataRate::PlusInfinity();
+  DataRate starting_rate_;
+  DataRate max_padding_rate_ = DataRate::Zero();
+
+  BandwidthSampler sampler_;
+  std::unique_ptr<ProbeBitrateEstimator> probe_bitrate_estimator_;
+  Mode mode_ = Mode::kStartup;
+  ProbePhase probe_phase_ = ProbePhase::kDown;
+  Timestamp probe_phase_start_ = Timestamp::MinusInfinity();
+  int64_t probe_phase_round_ = 0;
+  TimeDelta cruise_duration_ = TimeDelta::Zero();
+
+  // Max filter of the delivery rate over the current and the previous probe
+  // cycle.
+  std::array<DataRate, 2> max_bandwidth_ = {DataRate::Zero(),
+                                            DataRate::Zero()};
+  // Short term bound on the bandwidth set by loss, reset when probing.
+  DataRate bandwidth_lo_ = DataRate::PlusInfinity();
+  // Bound on the data in flight at which loss was seen.
+  DataSize inflight_hi_ = DataSize::PlusInfinity();
+
+  TimeDelta min_rtt_ = TimeDelta::PlusInfinity();
+  Timestamp min_rtt_time_ = Timestamp::MinusInfinity();
+  Timestamp probe_rtt_done_time_ = Timestamp::PlusInfinity();
+  bool probe_rtt_round_done_ = false;
+
+  // Packet-timed round trips.
+  int64_t round_count_ = 0;
+  DataSize next_round_delivered_ = DataSize::Zero();
+  DataSize delivered_in_round_ = DataSize::Zero();
+  DataSize lost_in_round_ = DataSize::Zero();
+  int lost_packets_in_round_ = 0;
+  DataRate max_delivery_rate_in_round_ = DataRate::Zero();
+  double last_round_loss_ratio_ = 0;
+
+  // Startup exit detection.
+  bool full_bandwidth_reached_ = false;
+  DataRate full_bandwidth_ = DataRate::Zero();
+  int full_bandwidth_count_ = 0;
+
+  DataSize data_in_flight_ = DataSize::Zero();
+  // The pacer holds back data beyond the congestion window, so what is queued
+  // in it counts towards filling the window when pushing back on the encoders.
+  DataSize pacer_queue_ = DataSize::Zero();
+  // Feedback arrives in batches, the congestion window must cover the time
+  // between them in addition to the RTT.
+  std::deque<TimeDelta> feedback_intervals_;
+  Timestamp last_feedback_time_ = Timestamp::MinusInfinity();
+
+  DataRate last_target_rate_ = DataRate::Zero();
+  DataRate last_pushback_target_rate_ = DataRate::Zero();
+  DataRate last_pacing_rate_ = DataRate::Zero();
+  DataRate last_padding_rate_ = DataRate::Zero();
+  std::optional<DataSize> last_congestion_window_;
+};
+
+}  // namespace bbr
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
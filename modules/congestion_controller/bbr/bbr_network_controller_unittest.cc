@@ -0,0 +1,364 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bbr_network_controller.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "api/environment/environment.h"
+#include "api/environment/environment_factory.h"
+#include "api/transport/network_control.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/scenario/scenario.h"
+
+using ::testing::AllOf;
+using ::testing::Field;
+using ::testing::Ge;
+using ::testing::Le;
+using ::testing::Matcher;
+using ::testing::Property;
+
+namespace webrtc {
+namespace bbr {
+namespace {
+
+const DataRate kInitialBitrate = DataRate::KilobitsPerSec(300);
+const Timestamp kDefaultStartTime = Timestamp::Millis(10000000);
+
+constexpr double kDataRateMargin = 0.20;
+constexpr double kMinDataRateFactor = 1 - kDataRateMargin;
+constexpr double kMaxDataRateFactor = 1 + kDataRateMargin;
+inline Matcher<TargetTransferRate> TargetRateCloseTo(DataRate rate) {
+  DataRate min_data_rate = rate * kMinDataRateFactor;
+  DataRate max_data_rate = rate * kMaxDataRateFactor;
+  return Field(&TargetTransferRate::target_rate,
+               AllOf(Ge(min_data_rate), Le(max_data_rate)));
+}
+
+NetworkControllerConfig InitialConfig(const Environment& env) {
+  NetworkControllerConfig config(env);
+  config.constraints.at_time = kDefaultStartTime;
+  config.constraints.min_data_rate = DataRate::KilobitsPerSec(30);
+  config.constraints.max_data_rate = DataRate::KilobitsPerSec(5000);
+  config.constraints.starting_rate = kInitialBitrate;
+  return config;
+}
+
+// Sends packets from a greedy source through a bottleneck link with a drop
+// tail queue, paced and windowed as the controller says, and feeds the
+// transport feedback back to the controller.
+class LinkSimulation {
+ public:
+  struct Link {
+    DataRate capacity;
+    TimeDelta one_way_delay;
+    DataSize queue_limit = DataSize::Bytes(30000);
+  };
+
+  explicit LinkSimulation(NetworkControllerInterface* controller)
+      : controller_(controller) {
+    Apply(controller_->OnNetworkAvailability(
+        {.at_time = now_, .network_available = true}));
+    Apply(controller_->OnProcessInterval({.at_time = now_}));
+  }
+
+  void RunFor(TimeDelta duration, const Link& link) {
+    const Timestamp end = now_ + duration;
+    while (now_ < end) {
+      now_ += kStep;
+      budget_ = std::min(budget_ + pacing_rate_ * kStep, kMaxBudget);
+      while (budget_ >= kPacketSize && data_in_flight_ < congestion_window_) {
+        Send(link);
+      }
+      if (now_ >= next_feedback_time_) {
+        SendFeedback();
+        next_feedback_time_ = now_ + kFeedbackInterval;
+      }
+      while (!feedback_.empty() &&
+             feedback_.front().feedback_time <= now_) {
+        Apply(controller_->OnTransportPacketsFeedback(feedback_.front()));
+        feedback_.pop_front();
+      }
+      if (now_ >= next_process_time_) {
+        Apply(controller_->OnProcessInterval({.at_time = now_}));
+        next_process_time_ = now_ + kProcessInterval;
+      }
+    }
+  }
+
+  DataRate target_rate() const { return target_rate_; }
+  TimeDelta max_queue_delay() const { return max_queue_delay_; }
+  void ResetMaxQueueDelay() { max_queue_delay_ = TimeDelta::Zero(); }
+
+ private:
+  static constexpr TimeDelta kStep = TimeDelta::Millis(1);
+  static constexpr TimeDelta kFeedbackInterval = TimeDelta::Millis(50);
+  static constexpr TimeDelta kProcessInterval = TimeDelta::Millis(25);
+  static constexpr DataSize kPacketSize = DataSize::Bytes(1000);
+  static constexpr DataSize kMaxBudget = DataSize::Bytes(5000);
+
+  void Apply(const NetworkControlUpdate& update) {
+    if (update.target_rate) {
+      target_rate_ = update.target_rate->target_rate;
+    }
+    if (update.pacer_config) {
+      pacing_rate_ = update.pacer_config->data_rate();
+    }
+    if (update.congestion_window) {
+      congestion_window_ = *update.congestion_window;
+    }
+  }
+
+  void Send(const Link& link) {
+    budget_ -= kPacketSize;
+    data_in_flight_ += kPacketSize;
+    SentPacket sent;
+    sent.send_time = now_;
+    sent.size = kPacketSize;
+    sent.sequence_number = next_sequence_number_++;
+    sent.data_in_flight = data_in_flight_;
+    PacketResult result;
+    result.sent_packet = sent;
+    TimeDelta queue_delay = std::max(TimeDelta::Zero(), link_free_time_ - now_);
+    // Dropped packets are reported missing when the packet after them would
+    // have been received.
+    Timestamp report_time =
+        std::max(link_free_time_, now_) + link.one_way_delay;
+    if (queue_delay * link.capacity <= link.queue_limit) {
+      link_free_time_ =
+          std::max(link_free_time_, now_) + kPacketSize / link.capacity;
+      result.receive_time = link_free_time_ + link.one_way_delay;
+      report_time = result.receive_time;
+      max_queue_delay_ = std::max(max_queue_delay_, queue_delay);
+    }
+    in_flight_.push_back({result, report_time, link.one_way_delay});
+    Apply(controller_->OnSentPacket(sent));
+  }
+
+  void SendFeedback() {
+    TransportPacketsFeedback report;
+    TimeDelta return_delay = TimeDelta::Zero();
+    while (!in_flight_.empty() && in_flight_.front().report_time <= now_) {
+      report.packet_feedbacks.push_back(in_flight_.front().result);
+      data_in_flight_ -= in_flight_.front().result.sent_packet.size;
+      return_delay = in_flight_.front().return_delay;
+      in_flight_.pop_front();
+    }
+    if (report.packet_feedbacks.empty()) {
+      return;
+    }
+    report.feedback_time = now_ + return_delay;
+    report.data_in_flight = data_in_flight_;
+    feedback_.push_back(report);
+  }
+
+  struct InFlight {
+    PacketResult result;
+    Timestamp report_time;
+    TimeDelta return_delay;
+  };
+
+  NetworkControllerInterface* const controller_;
+  Timestamp now_ = kDefaultStartTime;
+  DataRate target_rate_ = kInitialBitrate;
+  DataRate pacing_rate_ = kInitialBitrate;
+  DataSize congestion_window_ = DataSize::PlusInfinity();
+  DataSize budget_ = DataSize::Zero();
+  DataSize data_in_flight_ = DataSize::Zero();
+  int64_t next_sequence_number_ = 1;
+  Timestamp link_free_time_ = Timestamp::MinusInfinity();
+  Timestamp next_feedback_time_ = kDefaultStartTime;
+  Timestamp next_process_time_ = kDefaultStartTime;
+  std::deque<InFlight> in_flight_;
+  std::deque<TransportPacketsFeedback> feedback_;
+  TimeDelta max_queue_delay_ = TimeDelta::Zero();
+};
+
+test::CallClient* CreateVideoSendingClient(
+    test::Scenario* s,
+    NetworkControllerFactoryInterface* factory,
+    std::vector<EmulatedNetworkNode*> send_link,
+    std::vector<EmulatedNetworkNode*> return_link) {
+  test::CallClientConfig config;
+  config.transport.cc_factory = factory;
+  config.transport.rates.min_rate = DataRate::KilobitsPerSec(30);
+  config.transport.rates.max_rate = DataRate::KilobitsPerSec(5000);
+  config.transport.rates.start_rate = kInitialBitrate;
+  auto* client = s->CreateClient("send", config);
+  auto* route = s->CreateRoutes(client, send_link,
+                                s->CreateClient("return", test::CallClientConfig()),
+                                return_link);
+  s->CreateVideoStream(route->forward(), test::VideoStreamConfig());
+  return client;
+}
+
+}  // namespace
+
+TEST(BbrNetworkControllerTest, SendsConfigurationOnFirstProcess) {
+  Environment env = CreateEnvironment();
+  BbrNetworkController controller(InitialConfig(env), BbrSettings());
+
+  NetworkControlUpdate update =
+      controller.OnProcessInterval({.at_time = kDefaultStartTime});
+  ASSERT_TRUE(update.target_rate.has_value());
+  EXPECT_THAT(*update.target_rate, TargetRateCloseTo(kInitialBitrate));
+  ASSERT_TRUE(update.pacer_config.has_value());
+  EXPECT_THAT(*update.pacer_config,
+              Property(&PacerConfig::data_rate,
+                       Ge(kInitialBitrate * BbrSettings().startup_pacing_gain *
+                          kMinDataRateFactor)));
+  EXPECT_EQ(controller.mode(), BbrNetworkController::Mode::kStartup);
+}
+
+TEST(BbrNetworkControllerTest, EstimatesBottleneckBandwidthAndMinRtt) {
+  Environment env = CreateEnvironment();
+  BbrNetworkController controller(InitialConfig(env), BbrSettings());
+  LinkSimulation simulation(&controller);
+  const LinkSimulation::Link link = {.capacity = DataRate::KilobitsPerSec(1000),
+                                     .one_way_delay = TimeDelta::Millis(25)};
+
+  simulation.RunFor(TimeDelta::Seconds(5), link);
+  EXPECT_EQ(controller.mode(), BbrNetworkController::Mode::kProbeBw);
+  EXPECT_NEAR(controller.bandwidth().kbps(), 1000, 100);
+  EXPECT_NEAR(controller.min_rtt().ms(), 50, 10);
+  EXPECT_NEAR(simulation.target_rate().kbps(), 1000, 200);
+}
+
+TEST(BbrNetworkControllerTest, KeepsQueueShortInSteadyState) {
+  Environment env = CreateEnvironment();
+  BbrNetworkController controller(InitialConfig(env), BbrSettings());
+  LinkSimulation simulation(&controller);
+  const LinkSimulation::Link link = {.capacity = DataRate::KilobitsPerSec(1000),
+                                     .one_way_delay = TimeDelta::Millis(25)};
+
+  simulation.RunFor(TimeDelta::Seconds(5), link);
+  simulation.ResetMaxQueueDelay();
+  simulation.RunFor(TimeDelta::Seconds(20), link);
+  // Probing for more bandwidth builds a queue of at most a quarter of the
+  // bandwidth-delay product on top of what the feedback interval requires.
+  EXPECT_LT(simulation.max_queue_delay(), TimeDelta::Millis(60));
+  EXPECT_NEAR(simulation.target_rate().kbps(), 1000, 200);
+}
+
+TEST(BbrNetworkControllerTest, ReducesBandwidthWhenCapacityDrops) {
+  Environment env = CreateEnvironment();
+  BbrNetworkController controller(InitialConfig(env), BbrSettings());
+  LinkSimulation simulation(&controller);
+
+  simulation.RunFor(TimeDelta::Seconds(10),
+                    {.capacity = DataRate::KilobitsPerSec(2000),
+                     .one_way_delay = TimeDelta::Millis(25)});
+  EXPECT_NEAR(controller.bandwidth().kbps(), 2000, 200);
+  simulation.RunFor(TimeDelta::Seconds(10),
+                    {.capacity = DataRate::KilobitsPerSec(500),
+                     .one_way_delay = TimeDelta::Millis(25)});
+  EXPECT_NEAR(controller.bandwidth().kbps(), 500, 100);
+  EXPECT_NEAR(simulation.target_rate().kbps(), 500, 150);
+}
+
+TEST(BbrNetworkControllerTest, RemeasuresMinRttPeriodically) {
+  Environment env = CreateEnvironment();
+  BbrSettings settings;
+  BbrNetworkController controller(InitialConfig(env), settings);
+  LinkSimulation simulation(&controller);
+  const LinkSimulation::Link link = {.capacity = DataRate::KilobitsPerSec(1000),
+                                     .one_way_delay = TimeDelta::Millis(25)};
+
+  bool probed_rtt = false;
+  for (int i = 0; i < 200 && !probed_rtt; ++i) {
+    simulation.RunFor(TimeDelta::Millis(50), link);
+    probed_rtt = controller.mode() == BbrNetworkController::Mode::kProbeRtt;
+  }
+  EXPECT_TRUE(probed_rtt);
+  simulation.RunFor(settings.probe_rtt_duration + TimeDelta::Millis(500), link);
+  EXPECT_EQ(controller.mode(), BbrNetworkController::Mode::kProbeBw);
+}
+
+TEST(BbrNetworkControllerTest, FactoryCreatesController) {
+  Environment env = CreateEnvironment();
+  BbrNetworkControllerFactory factory;
+  std::unique_ptr<NetworkControllerInterface> controller =
+      factory.Create(InitialConfig(env));
+  ASSERT_TRUE(controller);
+  NetworkControlUpdate update =
+      controller->OnProcessInterval({.at_time = kDefaultStartTime});
+  EXPECT_TRUE(update.target_rate.has_value());
+  EXPECT_EQ(factory.GetProcessInterval(), TimeDelta::Millis(25));
+}
+
+TEST(BbrScenario, RampsUpToLinkCapacity) {
+  BbrNetworkControllerFactory factory;
+  test::Scenario s("bbr_unit/rampup", false);
+  auto send_net =
+      s.CreateMutableSimulationNode([](test::NetworkSimulationConfig* c) {
+        c->bandwidth = DataRate::KilobitsPerSec(1500);
+        c->delay = TimeDelta::Millis(50);
+      });
+  auto ret_net = s.CreateSimulationNode(
+      [](test::NetworkSimulationConfig* c) { c->delay = TimeDelta::Millis(50); });
+  auto* client =
+      CreateVideoSendingClient(&s, &factory, {send_net->node()}, {ret_net});
+
+  s.RunFor(TimeDelta::Seconds(5));
+  EXPECT_GT(client->target_rate().kbps(), 1000);
+  s.RunFor(TimeDelta::Seconds(15));
+  EXPECT_NEAR(client->target_rate().kbps(), 1500, 300);
+
+  send_net->UpdateConfig([](test::NetworkSimulationConfig* c) {
+    c->bandwidth = DataRate::KilobitsPerSec(3000);
+    c->delay = TimeDelta::Millis(50);
+  });
+  s.RunFor(TimeDelta::Seconds(20));
+  EXPECT_GT(client->target_rate().kbps(), 2200);
+
+  send_net->UpdateConfig([](test::NetworkSimulationConfig* c) {
+    c->bandwidth = DataRate::KilobitsPerSec(500);
+    c->delay = TimeDelta::Millis(50);
+  });
+  s.RunFor(TimeDelta::Seconds(10));
+  EXPECT_LT(client->target_rate().kbps(), 600);
+  EXPECT_GT(client->target_rate().kbps(), 300);
+}
+
+TEST(BbrScenario, KeepsRoundTripTimeLowAtLinkCapacity) {
+  BbrNetworkControllerFactory factory;
+  test::Scenario s("bbr_unit/latency", false);
+  test::NetworkSimulationConfig net_conf;
+  net_conf.bandwidth = DataRate::KilobitsPerSec(1000);
+  net_conf.delay = TimeDelta::Millis(50);
+  auto* send_net = s.CreateSimulationNode(net_conf);
+  auto* ret_net = s.CreateSimulationNode(net_conf);
+  auto* client = CreateVideoSendingClient(&s, &factory, {send_net}, {ret_net});
+
+  s.RunFor(TimeDelta::Seconds(10));
+  int64_t max_rtt_ms = 0;
+  for (int i = 0; i < 20; ++i) {
+    s.RunFor(TimeDelta::Seconds(1));
+    max_rtt_ms = std::max(max_rtt_ms, client->GetStats().rtt_ms);
+  }
+  // The base RTT is 100 ms, the queue must stay well below that.
+  EXPECT_LT(max_rtt_ms, 170);
+  EXPECT_GT(client->target_rate().kbps(), 700);
+  EXPECT_LT(client->GetStats().pacer_delay_ms, 100);
+}
+
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/goog_cc/ecn_based_bwe.h"
+
+#include <algorithm>
+
+#include "api/transport/ecn_marking.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+namespace {
+// Gain of the moving average of the CE fraction, as in DCTCP and TCP Prague.
+constexpr double kAlphaGain = 1.0 / 16;
+// Rounds are never shorter than this, so that the additive increase stays
+// bounded on very short paths.
+constexpr TimeDelta kMinRoundDuration = TimeDelta::Millis(10);
+// The estimate is cleared when the target rate is this far below it, e.g.
+// because another estimator limits the rate.
+constexpr double kReleaseFactor = 2.0;
+}  // namespace
+
+EcnBasedBwe::EcnBasedBwe() = default;
+EcnBasedBwe::~EcnBasedBwe() = default;
+
+void EcnBasedBwe::OnTransportPacketsFeedback(
+    const TransportPacketsFeedback& report,
+    DataRate target_rate) {
+  bool round_ended = false;
+  for (const PacketResult& packet : report.packet_feedbacks) {
+    if (!packet.IsReceived()) {
+      continue;
+    }
+    if (packet.ecn == EcnMarking::kEct1 || packet.ecn == EcnMarking::kCe) {
+      ++ecn_capable_packets_in_round_;
+      ecn_capable_size_in_round_ += packet.sent_packet.size;
+      if (packet.ecn == EcnMarking::kCe) {
+        ++ce_marked_packets_in_round_;
+      }
+    }
+    if (packet.sent_packet.send_time >= round_start_) {
+      round_ended = true;
+    }
+  }
+  if (round_ended) {
+    OnRoundEnd(report.feedback_time, target_rate);
+  }
+}
+
+void EcnBasedBwe::OnRoundEnd(Timestamp at_time, DataRate target_rate) {
+  const TimeDelta round_duration =
+      round_start_.IsFinite() ? std::max(at_time - round_start_,
+                                         kMinRoundDuration)
+                              : kMinRoundDuration;
+  round_start_ = at_time;
+  if (ecn_capable_packets_in_round_ == 0) {
+    return;
+  }
+
+  const double ce_fraction =
+      static_cast<double>(ce_marked_packets_in_round_) /
+      ecn_capable_packets_in_round_;
+  alpha_ = (1 - kAlphaGain) * alpha_ + kAlphaGain * ce_fraction;
+  if (ce_marked_packets_in_round_ > 0) {
+    estimate_ = std::min(estimate_, target_rate) * (1 - alpha_ / 2);
+  } else if (estimate_.IsFinite()) {
+    if (target_rate * kReleaseFactor < estimate_) {
+      estimate_ = DataRate::PlusInfinity();
+    } else {
+      const DataSize packet_size =
+          ecn_capable_size_in_round_ / ecn_capable_packets_in_round_;
+      estimate_ += packet_size / round_duration;
+    }
+  }
+
+  ecn_capable_packets_in_round_ = 0;
+  ce_marked_packets_in_round_ = 0;
+  ecn_capable_size_in_round_ = DataSize::Zero();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_GOOG_CC_ECN_BASED_BWE_H_
+#define MODULES_CONGESTION_CONTROLLER_GOOG_CC_ECN_BASED_BWE_H_
+
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+
+// Scalable congestion response to ECN Congestion Experienced (CE) marks, in
+// the style of TCP Prague (draft-briscoe-iccrg-prague-congestion-control).
+// L4S bottlenecks (RFC 9331) mark ECT(1) packets as soon as a shallow queue
+// builds, so a sender that reduces its rate in proportion to the fraction of
+// marked packets keeps the queueing delay at a few milliseconds.
+//
+// Once per packet-timed round trip the fraction of CE marked packets is folded
+// into a moving average, `alpha`. A round with marks reduces the estimate by
+// `alpha / 2`, a round without marks increases it by one packet per round trip.
+// The estimate is an upper limit on the send rate; it is cleared when it no
+// longer limits the target rate, and it is never set if no packet is reported
+// as ECN capable, e.g. with transport-wide feedback.
+class EcnBasedBwe {
+ public:
+  EcnBasedBwe();
+  ~EcnBasedBwe();
+
+  // `target_rate` is the current target rate of the controller.
+  void OnTransportPacketsFeedback(const TransportPacketsFeedback& report,
+                                  DataRate target_rate);
+
+  // PlusInfinity if not limited.
+  DataRate GetEstimate() const { return estimate_; }
+  // Moving average of the fraction of CE marked packets.
+  double alpha() const { return alpha_; }
+
+ private:
+  void OnRoundEnd(Timestamp at_time, DataRate target_rate);
+
+  DataRate estimate_ = DataRate::PlusInfinity();
+  // Starts at 1, so that the first mark halves the rate like a loss would.
+  double alpha_ = 1.0;
+
+  // The round ends when a packet sent after `round_start_` is acknowledged.
+  Timestamp round_start_ = Timestamp::MinusInfinity();
+  int ecn_capable_packets_in_round_ = 0;
+  int ce_marked_packets_in_round_ = 0;
+  DataSize ecn_capable_size_in_round_ = DataSize::Zero();
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_GOOG_CC_ECN_BASED_BWE_H_
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/goog_cc/ecn_based_bwe.h"
+
+#include "api/transport/ecn_marking.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr DataSize kPacketSize = DataSize::Bytes(1000);
+constexpr TimeDelta kRtt = TimeDelta::Millis(50);
+constexpr int kPacketsPerRound = 20;
+constexpr DataRate kTargetRate = DataRate::KilobitsPerSec(1000);
+
+class EcnBasedBweTest : public ::testing::Test {
+ protected:
+  // Reports one round of `kPacketsPerRound` packets, of which the first
+  // `ce_marked` are marked as CE and the rest carry `ecn`.
+  void ReportRound(int ce_marked,
+                   EcnMarking ecn = EcnMarking::kEct1,
+                   DataRate target_rate = kTargetRate) {
+    TransportPacketsFeedback report;
+    report.feedback_time = now_ + kRtt;
+    for (int i = 0; i < kPacketsPerRound; ++i) {
+      PacketResult packet;
+      packet.sent_packet.send_time = now_;
+      packet.sent_packet.size = kPacketSize;
+      packet.sent_packet.sequence_number = sequence_number_++;
+      packet.receive_time = now_ + kRtt / 2;
+      packet.ecn = i < ce_marked ? EcnMarking::kCe : ecn;
+      report.packet_feedbacks.push_back(packet);
+    }
+    now_ += kRtt;
+    bwe_.OnTransportPacketsFeedback(report, target_rate);
+  }
+
+  Timestamp now_ = Timestamp::Seconds(100);
+  int64_t sequence_number_ = 1;
+  EcnBasedBwe bwe_;
+};
+
+TEST_F(EcnBasedBweTest, NoLimitWithoutCeMarks) {
+  for (int i = 0; i < 10; ++i) {
+    ReportRound(/*ce_marked=*/0);
+  }
+  EXPECT_TRUE(bwe_.GetEstimate().IsPlusInfinity());
+  EXPECT_LT(bwe_.alpha(), 1.0);
+}
+
+TEST_F(EcnBasedBweTest, IgnoresPacketsNotReportedAsEcnCapable) {
+  ReportRound(/*ce_marked=*/0, EcnMarking::kNotEct);
+  ReportRound(/*ce_marked=*/0, EcnMarking::kNotEct);
+  EXPECT_TRUE(bwe_.GetEstimate().IsPlusInfinity());
+  EXPECT_EQ(bwe_.alpha(), 1.0);
+}
+
+TEST_F(EcnBasedBweTest, FirstMarkRoughlyHalvesTargetRate) {
+  ReportRound(/*ce_marked=*/1);
+  EXPECT_GT(bwe_.alpha(), 0.9);
+  EXPECT_NEAR(bwe_.GetEstimate().bps(),
+              kTargetRate.bps() * (1 - bwe_.alpha() / 2), 1);
+}
+
+TEST_F(EcnBasedBweTest, ReductionScalesWithFractionOfMarks) {
+  // Converge alpha to a 10% marking rate.
+  for (int i = 0; i < 100; ++i) {
+    ReportRound(/*ce_marked=*/kPacketsPerRound / 10);
+  }
+  EXPECT_NEAR(bwe_.alpha(), 0.1, 0.01);
+  // Release the limit, then mark again at the full target rate.
+  ReportRound(/*ce_marked=*/0, EcnMarking::kEct1,
+              /*target_rate=*/DataRate::Zero());
+  ASSERT_TRUE(bwe_.GetEstimate().IsPlusInfinity());
+  ReportRound(/*ce_marked=*/kPacketsPerRound / 10);
+  EXPECT_LT(bwe_.alpha(), 0.11);
+  EXPECT_NEAR(bwe_.GetEstimate().bps(),
+              kTargetRate.bps() * (1 - bwe_.alpha() / 2), 1);
+}
+
+TEST_F(EcnBasedBweTest, IncreasesByOnePacketPerRoundWithoutMarks) {
+  ReportRound(/*ce_marked=*/1);
+  const DataRate estimate = bwe_.GetEstimate();
+  ReportRound(/*ce_marked=*/0, EcnMarking::kEct1, /*target_rate=*/estimate);
+  EXPECT_EQ(bwe_.GetEstimate(), estimate + kPacketSize / kRtt);
+}
+
+TEST_F(EcnBasedBweTest, ReleasesLimitWhenTargetRateIsMuchLower) {
+  ReportRound(/*ce_marked=*/1);
+  ReportRound(/*ce_marked=*/0, EcnMarking::kEct1,
+              /*target_rate=*/bwe_.GetEstimate() / 4);
+  EXPECT_TRUE(bwe_.GetEstimate().IsPlusInfinity());
+}
+
+}  // namespace
+}  // namespace webrtc
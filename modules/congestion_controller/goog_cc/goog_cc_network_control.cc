@@ -129,6 +129,9 @@ GoogCcNetworkController::GoogCcNetworkController(NetworkControllerConfig config,
       delay_based_bwe_(new DelayBasedBwe(&env_.field_trials(),
                                          &env_.event_log(),
                                          network_state_predictor_.get())),
+      ecn_based_bwe_(env_.field_trials().IsEnabled("WebRTC-Bwe-L4s")
+                         ? std::make_unique<EcnBasedBwe>()
+                         : nullptr),
       acknowledged_bitrate_estimator_(
           AcknowledgedBitrateEstimatorInterface::Create(&env_.field_trials())),
       initial_config_(config),
@@ -194,6 +197,9 @@ NetworkControlUpdate GoogCcNetworkController::OnNetworkRouteChange(
     network_estimator_->OnRouteChange(msg);
   delay_based_bwe_.reset(new DelayBasedBwe(
       &env_.field_trials(), &env_.event_log(), network_state_predictor_.get()));
+  if (ecn_based_bwe_) {
+    ecn_based_bwe_ = std::make_unique<EcnBasedBwe>();
+  }
   bandwidth_estimation_->OnRouteChange();
   probe_controller_->Reset(msg.at_time);
   NetworkControlUpdate update;
@@ -565,6 +571,16 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
     bandwidth_estimation_->UpdateDelayBasedEstimate(report.feedback_time,
                                                     result.target_bitrate);
   }
+  if (ecn_based_bwe_) {
+    DataRate ecn_estimate = ecn_based_bwe_->GetEstimate();
+    ecn_based_bwe_->OnTransportPacketsFeedback(
+        report, bandwidth_estimation_->target_rate());
+    if (ecn_based_bwe_->GetEstimate() != ecn_estimate) {
+      bandwidth_estimation_->UpdateEcnBasedEstimate(
+          report.feedback_time, ecn_based_bwe_->GetEstimate());
+      result.updated = true;
+    }
+  }
   bandwidth_estimation_->UpdateLossBasedEstimator(
       report, result.delay_detector_state, probe_bitrate,
       alr_start_time.has_value());
@@ -258,6 +258,7 @@ SendSideBandwidthEstimation::SendSideBandwidthEstimation(
       last_round_trip_time_(TimeDelta::Zero()),
       receiver_limit_(DataRate::PlusInfinity()),
       delay_based_limit_(DataRate::PlusInfinity()),
+      ecn_based_limit_(DataRate::PlusInfinity()),
       time_last_decrease_(Timestamp::MinusInfinity()),
       first_report_time_(Timestamp::MinusInfinity()),
       initially_lost_packets_(0),
@@ -311,6 +312,7 @@ void SendSideBandwidthEstimation::OnRouteChange() {
   last_round_trip_time_ = TimeDelta::Zero();
   receiver_limit_ = DataRate::PlusInfinity();
   delay_based_limit_ = DataRate::PlusInfinity();
+  ecn_based_limit_ = DataRate::PlusInfinity();
   time_last_decrease_ = Timestamp::MinusInfinity();
   first_report_time_ = Timestamp::MinusInfinity();
   initially_lost_packets_ = 0;
@@ -407,6 +409,15 @@ void SendSideBandwidthEstimation::UpdateDelayBasedEstimate(Timestamp at_time,
   ApplyTargetLimits(at_time);
 }
 
+void SendSideBandwidthEstimation::UpdateEcnBasedEstimate(Timestamp at_time,
+                                                         DataRate bitrate) {
+  if (bitrate == ecn_based_limit_) {
+    return;
+  }
+  ecn_based_limit_ = bitrate;
+  ApplyTargetLimits(at_time);
+}
+
 void SendSideBandwidthEstimation::SetAcknowledgedRate(
     std::optional<DataRate> acknowledged_rate,
     Timestamp at_time) {
@@ -708,7 +719,7 @@ void SendSideBandwidthEstimation::UpdateMinHistory(Timestamp at_time) {
 }
 
 DataRate SendSideBandwidthEstimation::GetUpperLimit() const {
-  DataRate upper_limit = delay_based_limit_;
+  DataRate upper_limit = std::min(delay_based_limit_, ecn_based_limit_);
   if (disable_receiver_limit_caps_only_)
     upper_limit = std::min(upper_limit, receiver_limit_);
   return std::min(upper_limit, max_bitrate_configured_);
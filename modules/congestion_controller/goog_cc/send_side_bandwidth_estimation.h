@@ -120,6 +120,9 @@ class SendSideBandwidthEstimation {
   // Call when a new delay-based estimate is available.
   void UpdateDelayBasedEstimate(Timestamp at_time, DataRate bitrate);
 
+  // Call when the ECN-based estimate changes. PlusInfinity means no limit.
+  void UpdateEcnBasedEstimate(Timestamp at_time, DataRate bitrate);
+
   // Call when we receive a RTCP message with a ReceiveBlock.
   void UpdatePacketsLost(int64_t packets_lost,
                          int64_t number_of_packets,
@@ -214,6 +217,7 @@ class SendSideBandwidthEstimation {
   // send side delay based estimate.
   DataRate receiver_limit_;
   DataRate delay_based_limit_;
+  DataRate ecn_based_limit_;
   Timestamp time_last_decrease_;
   Timestamp first_report_time_;
   int initially_lost_packets_;
@@ -37,14 +37,28 @@ namespace webrtc {
 
 constexpr TimeDelta kSendTimeHistoryWindow = TimeDelta::Seconds(60);
 
+// Number of RTP sequence numbers per SSRC that map to distinct transport
+// sequence numbers. A packet still awaiting feedback this many RTP sequence
+// numbers later can no longer be looked up by RTP sequence number.
+constexpr size_t kRtpSequenceNumberMapSize = 1 << 12;
+
+// Packets this many transport sequence numbers older than the newest packet
+// can not be told apart in feedback, which carries 16 bit sequence numbers.
+// Bounds the span, and so the memory, of the history.
+constexpr int64_t kMaxTransportSequenceNumberSpan = 1 << 15;
+
+// Smallest ring allocated by PacketFeedbackHistory.
+constexpr int64_t kMinHistoryCapacity = 1 << 8;
+
 void InFlightBytesTracker::AddInFlightPacketBytes(
     const PacketFeedback& packet) {
   RTC_DCHECK(packet.sent.send_time.IsFinite());
-  auto it = in_flight_data_.find(packet.network_route);
+  auto it = Find(packet.network_route);
   if (it != in_flight_data_.end()) {
-    it->second += packet.sent.size;
+    it->in_flight += packet.sent.size;
   } else {
-    in_flight_data_.insert({packet.network_route, packet.sent.size});
+    in_flight_data_.push_back({.network_route = packet.network_route,
+                               .in_flight = packet.sent.size});
   }
 }
 
@@ -52,45 +66,122 @@ void InFlightBytesTracker::RemoveInFlightPacketBytes(
     const PacketFeedback& packet) {
   if (packet.sent.send_time.IsInfinite())
     return;
-  auto it = in_flight_data_.find(packet.network_route);
+  auto it = Find(packet.network_route);
   if (it != in_flight_data_.end()) {
-    RTC_DCHECK_GE(it->second, packet.sent.size);
-    it->second -= packet.sent.size;
-    if (it->second.IsZero())
+    RTC_DCHECK_GE(it->in_flight, packet.sent.size);
+    it->in_flight -= packet.sent.size;
+    if (it->in_flight.IsZero())
       in_flight_data_.erase(it);
   }
 }
 
 DataSize InFlightBytesTracker::GetOutstandingData(
     const rtc::NetworkRoute& network_route) const {
-  auto it = in_flight_data_.find(network_route);
-  if (it != in_flight_data_.end()) {
-    return it->second;
-  } else {
-    return DataSize::Zero();
+  for (const RouteInFlight& route : in_flight_data_) {
+    if (IsSameRoute(route.network_route, network_route)) {
+      return route.in_flight;
+    }
   }
+  return DataSize::Zero();
 }
 
-// Comparator for consistent map with NetworkRoute as key.
-bool InFlightBytesTracker::NetworkRouteComparator::operator()(
-    const rtc::NetworkRoute& a,
-    const rtc::NetworkRoute& b) const {
-  if (a.local.network_id() != b.local.network_id())
-    return a.local.network_id() < b.local.network_id();
-  if (a.remote.network_id() != b.remote.network_id())
-    return a.remote.network_id() < b.remote.network_id();
-
-  if (a.local.adapter_id() != b.local.adapter_id())
-    return a.local.adapter_id() < b.local.adapter_id();
-  if (a.remote.adapter_id() != b.remote.adapter_id())
-    return a.remote.adapter_id() < b.remote.adapter_id();
-
-  if (a.local.uses_turn() != b.local.uses_turn())
-    return a.local.uses_turn() < b.local.uses_turn();
-  if (a.remote.uses_turn() != b.remote.uses_turn())
-    return a.remote.uses_turn() < b.remote.uses_turn();
-
-  return a.connected < b.connected;
+std::vector<InFlightBytesTracker::RouteInFlight>::iterator
+InFlightBytesTracker::Find(const rtc::NetworkRoute& network_route) {
+  return absl::c_find_if(in_flight_data_, [&](const RouteInFlight& route) {
+    return IsSameRoute(route.network_route, network_route);
+  });
+}
+
+// Routes are the same if they only differ in packet overhead or last sent
+// packet id.
+bool InFlightBytesTracker::IsSameRoute(const rtc::NetworkRoute& a,
+                                       const rtc::NetworkRoute& b) {
+  return a.local.network_id() == b.local.network_id() &&
+         a.remote.network_id() == b.remote.network_id() &&
+         a.local.adapter_id() == b.local.adapter_id() &&
+         a.remote.adapter_id() == b.remote.adapter_id() &&
+         a.local.uses_turn() == b.local.uses_turn() &&
+         a.remote.uses_turn() == b.remote.uses_turn() &&
+         a.connected == b.connected;
+}
+
+PacketFeedbackHistory::PacketFeedbackHistory() = default;
+PacketFeedbackHistory::~PacketFeedbackHistory() = default;
+
+void PacketFeedbackHistory::Insert(const PacketFeedback& packet) {
+  const int64_t sequence_number = packet.sent.sequence_number;
+  if (empty()) {
+    begin_ = sequence_number;
+    end_ = sequence_number;
+  }
+  const int64_t begin = std::min(begin_, sequence_number);
+  const int64_t end = std::max(end_, sequence_number + 1);
+  EnsureCapacity(end - begin);
+  Slot& slot = GetSlot(sequence_number);
+  if (slot.used) {
+    return;
+  }
+  slot.used = true;
+  slot.packet = packet;
+  ++size_;
+  begin_ = begin;
+  end_ = end;
+}
+
+PacketFeedback* PacketFeedbackHistory::Find(int64_t sequence_number) {
+  if (sequence_number < begin_ || sequence_number >= end_) {
+    return nullptr;
+  }
+  Slot& slot = GetSlot(sequence_number);
+  return slot.used ? &slot.packet : nullptr;
+}
+
+void PacketFeedbackHistory::Erase(int64_t sequence_number) {
+  if (Find(sequence_number) == nullptr) {
+    return;
+  }
+  GetSlot(sequence_number).used = false;
+  if (--size_ == 0) {
+    begin_ = end_;
+    return;
+  }
+  // Keep both ends of the span populated. Each unused slot is skipped at most
+  // once, so this is amortized O(1).
+  while (!GetSlot(begin_).used) {
+    ++begin_;
+  }
+  while (!GetSlot(end_ - 1).used) {
+    --end_;
+  }
+}
+
+const PacketFeedback& PacketFeedbackHistory::front() const {
+  RTC_DCHECK(!empty());
+  return GetSlot(begin_).packet;
+}
+
+void PacketFeedbackHistory::pop_front() {
+  RTC_DCHECK(!empty());
+  Erase(begin_);
+}
+
+void PacketFeedbackHistory::EnsureCapacity(int64_t span) {
+  if (span <= static_cast<int64_t>(slots_.size())) {
+    return;
+  }
+  int64_t capacity = std::max<int64_t>(slots_.size(), kMinHistoryCapacity);
+  while (capacity < span) {
+    capacity *= 2;
+  }
+  std::vector<Slot> slots(capacity);
+  for (int64_t sequence_number = begin_; sequence_number < end_;
+       ++sequence_number) {
+    Slot& slot = GetSlot(sequence_number);
+    if (slot.used) {
+      slots[sequence_number & (capacity - 1)] = std::move(slot);
+    }
+  }
+  slots_ = std::move(slots);
 }
 
 TransportFeedbackAdapter::TransportFeedbackAdapter() = default;
@@ -117,26 +208,18 @@ void TransportFeedbackAdapter::AddPacket(const RtpPacketToSend& packet_to_send,
   feedback.rtp_sequence_number = packet_to_send.SequenceNumber();
 
   while (!history_.empty() &&
-         creation_time - history_.begin()->second.creation_time >
-             kSendTimeHistoryWindow) {
+         (creation_time - history_.front().creation_time >
+              kSendTimeHistoryWindow ||
+          feedback.sent.sequence_number -
+                  history_.front().sent.sequence_number >=
+              kMaxTransportSequenceNumberSpan)) {
     // TODO(sprang): Warn if erasing (too many) old items?
-    if (history_.begin()->second.sent.sequence_number > last_ack_seq_num_)
-      in_flight_.RemoveInFlightPacketBytes(history_.begin()->second);
-
-    const PacketFeedback& packet = history_.begin()->second;
-    rtp_to_transport_sequence_number_.erase(
-        {.ssrc = packet.ssrc,
-         .rtp_sequence_number = packet.rtp_sequence_number});
-    history_.erase(history_.begin());
+    if (history_.front().sent.sequence_number > last_ack_seq_num_)
+      in_flight_.RemoveInFlightPacketBytes(history_.front());
+    history_.pop_front();
   }
-  // Note that it can happen that the same SSRC and sequence number is sent
-  // again. e.g, audio retransmission.
-  rtp_to_transport_sequence_number_.emplace(
-      SsrcAndRtpSequencenumber(
-          {.ssrc = feedback.ssrc,
-           .rtp_sequence_number = feedback.rtp_sequence_number}),
-      feedback.sent.sequence_number);
-  history_.emplace(feedback.sent.sequence_number, feedback);
+  MapToTransportSequenceNumber(feedback);
+  history_.Insert(feedback);
 }
 
 std::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
@@ -146,10 +229,10 @@ std::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
   if (sent_packet.info.included_in_feedback || sent_packet.packet_id != -1) {
     int64_t unwrapped_seq_num =
         seq_num_unwrapper_.Unwrap(sent_packet.packet_id);
-    auto it = history_.find(unwrapped_seq_num);
-    if (it != history_.end()) {
-      bool packet_retransmit = it->second.sent.send_time.IsFinite();
-      it->second.sent.send_time = send_time;
+    PacketFeedback* packet = history_.Find(unwrapped_seq_num);
+    if (packet) {
+      bool packet_retransmit = packet->sent.send_time.IsFinite();
+      packet->sent.send_time = send_time;
       last_send_time_ = std::max(last_send_time_, send_time);
       // TODO(srte): Don't do this on retransmit.
       if (!pending_untracked_size_.IsZero()) {
@@ -157,14 +240,14 @@ std::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
           RTC_LOG(LS_WARNING)
               << "appending acknowledged data for out of order packet. (Diff: "
               << ToString(last_untracked_send_time_ - send_time) << " ms.)";
-        it->second.sent.prior_unacked_data += pending_untracked_size_;
+        packet->sent.prior_unacked_data += pending_untracked_size_;
         pending_untracked_size_ = DataSize::Zero();
       }
       if (!packet_retransmit) {
-        if (it->second.sent.sequence_number > last_ack_seq_num_)
-          in_flight_.AddInFlightPacketBytes(it->second);
-        it->second.sent.data_in_flight = GetOutstandingData();
-        return it->second.sent;
+        if (packet->sent.sequence_number > last_ack_seq_num_)
+          in_flight_.AddInFlightPacketBytes(*packet);
+        packet->sent.data_in_flight = GetOutstandingData();
+        return packet->sent;
       }
     }
   } else if (sent_packet.info.included_in_allocation) {
@@ -345,38 +428,65 @@ DataSize TransportFeedbackAdapter::GetOutstandingData() const {
   return in_flight_.GetOutstandingData(network_route_);
 }
 
+void TransportFeedbackAdapter::MapToTransportSequenceNumber(
+    const PacketFeedback& packet) {
+  std::vector<int64_t>& transport_sequence_numbers =
+      rtp_to_transport_sequence_number_[packet.ssrc];
+  if (transport_sequence_numbers.empty()) {
+    transport_sequence_numbers.resize(kRtpSequenceNumberMapSize, -1);
+  }
+  int64_t& transport_sequence_number =
+      transport_sequence_numbers[packet.rtp_sequence_number %
+                                 kRtpSequenceNumberMapSize];
+  // Note that it can happen that the same SSRC and sequence number is sent
+  // again. e.g, audio retransmission. Keep mapping to the first packet while
+  // it is in the history.
+  const PacketFeedback* mapped_packet =
+      history_.Find(transport_sequence_number);
+  if (mapped_packet != nullptr && mapped_packet->ssrc == packet.ssrc &&
+      mapped_packet->rtp_sequence_number == packet.rtp_sequence_number) {
+    return;
+  }
+  transport_sequence_number = packet.sent.sequence_number;
+}
+
 std::optional<PacketFeedback> TransportFeedbackAdapter::RetrievePacketFeedback(
     const SsrcAndRtpSequencenumber& key,
     bool received) {
-  auto it = rtp_to_transport_sequence_number_.find(key);
+  auto it = rtp_to_transport_sequence_number_.find(key.ssrc);
   if (it == rtp_to_transport_sequence_number_.end()) {
     return std::nullopt;
   }
-  return RetrievePacketFeedback(it->second, received);
+  int64_t transport_sequence_number =
+      it->second[key.rtp_sequence_number % kRtpSequenceNumberMapSize];
+  const PacketFeedback* packet = history_.Find(transport_sequence_number);
+  if (packet == nullptr || packet->ssrc != key.ssrc ||
+      packet->rtp_sequence_number != key.rtp_sequence_number) {
+    return std::nullopt;
+  }
+  return RetrievePacketFeedback(transport_sequence_number, received);
 }
 
 std::optional<PacketFeedback> TransportFeedbackAdapter::RetrievePacketFeedback(
     int64_t transport_seq_num,
     bool received) {
   if (transport_seq_num > last_ack_seq_num_) {
-    // Starts at history_.begin() if last_ack_seq_num_ < 0, since any
-    // valid sequence number is >= 0.
-    for (auto it = history_.upper_bound(last_ack_seq_num_);
-         it != history_.upper_bound(transport_seq_num); ++it) {
-      in_flight_.RemoveInFlightPacketBytes(it->second);
-    }
+    history_.ForEachInRange(last_ack_seq_num_ + 1, transport_seq_num,
+                            [&](const PacketFeedback& packet) {
+                              in_flight_.RemoveInFlightPacketBytes(packet);
+                            });
     last_ack_seq_num_ = transport_seq_num;
   }
 
-  auto it = history_.find(transport_seq_num);
-  if (it == history_.end()) {
+  PacketFeedback* packet = history_.Find(transport_seq_num);
+  if (packet == nullptr) {
     RTC_LOG(LS_WARNING) << "Failed to lookup send time for packet with "
                         << transport_seq_num
                         << ". Send time history too small?";
     return std::nullopt;
   }
 
-  if (it->second.sent.send_time.IsInfinite()) {
+  if (packet->sent.send_time.IsInfinite()) {
     // TODO(srte): Fix the tests that makes this happen and make this a
     // DCHECK.
     RTC_DLOG(LS_ERROR)
@@ -384,14 +494,11 @@ std::optional<PacketFeedback> TransportFeedbackAdapter::RetrievePacketFeedback(
     return std::nullopt;
   }
 
-  PacketFeedback packet_feedback = it->second;
+  PacketFeedback packet_feedback = *packet;
   if (received) {
     // Note: Lost packets are not removed from history because they might
     // be reported as received by a later feedback.
-    rtp_to_transport_sequence_number_.erase(
-        {.ssrc = packet_feedback.ssrc,
-         .rtp_sequence_number = packet_feedback.rtp_sequence_number});
-    history_.erase(it);
+    history_.Erase(transport_seq_num);
   }
   return packet_feedback;
 }
@@ -11,11 +11,10 @@
 #ifndef MODULES_CONGESTION_CONTROLLER_RTP_TRANSPORT_FEEDBACK_ADAPTER_H_
 #define MODULES_CONGESTION_CONTROLLER_RTP_TRANSPORT_FEEDBACK_ADAPTER_H_
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <map>
 #include <optional>
-#include <tuple>
 #include <vector>
 
 #include "api/transport/network_types.h"
@@ -24,6 +23,7 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/containers/flat_map.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
@@ -54,11 +54,87 @@ class InFlightBytesTracker {
   DataSize GetOutstandingData(const rtc::NetworkRoute& network_route) const;
 
  private:
-  struct NetworkRouteComparator {
-    bool operator()(const rtc::NetworkRoute& a,
-                    const rtc::NetworkRoute& b) const;
+  struct RouteInFlight {
+    rtc::NetworkRoute network_route;
+    DataSize in_flight;
   };
-  std::map<rtc::NetworkRoute, DataSize, NetworkRouteComparator> in_flight_data_;
+  static bool IsSameRoute(const rtc::NetworkRoute& a,
+                          const rtc::NetworkRoute& b);
+  std::vector<RouteInFlight>::iterator Find(
+      const rtc::NetworkRoute& network_route);
+
+  // There is rarely more than one route with data in flight, so a linear
+  // search is cheaper than a map.
+  std::vector<RouteInFlight> in_flight_data_;
+};
+
+// Sent packets awaiting feedback, keyed by unwrapped transport sequence
+// number. Transport sequence numbers are dense and increasing, so packets are
+// kept in a ring indexed by sequence number, with O(1) insert, lookup and
+// removal. The ring covers the span from the oldest to the newest stored
+// packet. Packets removed from the middle of the span, e.g. when feedback
+// arrives for all but a lost packet, leave unused slots. The ring only grows,
+// when the span outgrows it, so storing a packet does not allocate.
+class PacketFeedbackHistory {
+ public:
+  PacketFeedbackHistory();
+  ~PacketFeedbackHistory();
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // Stores `packet` by `packet.sent.sequence_number`. Does nothing if a packet
+  // with that sequence number is already stored.
+  void Insert(const PacketFeedback& packet);
+  // Returns the packet with `sequence_number`, or nullptr if not stored.
+  PacketFeedback* Find(int64_t sequence_number);
+  // Removes the packet with `sequence_number`, if stored.
+  void Erase(int64_t sequence_number);
+
+  // The stored packet with the lowest sequence number. Must not be empty.
+  const PacketFeedback& front() const;
+  void pop_front();
+
+  // Calls `f` with each stored packet with a sequence number in
+  // [`first_sequence_number`, `last_sequence_number`], in order.
+  template <typename F>
+  void ForEachInRange(int64_t first_sequence_number,
+                      int64_t last_sequence_number,
+                      F&& f) const {
+    int64_t begin = std::max(first_sequence_number, begin_);
+    int64_t end = std::min(last_sequence_number + 1, end_);
+    for (int64_t sequence_number = begin; sequence_number < end;
+         ++sequence_number) {
+      const Slot& slot = GetSlot(sequence_number);
+      if (slot.used) {
+        f(slot.packet);
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    bool used = false;
+    PacketFeedback packet;
+  };
+
+  Slot& GetSlot(int64_t sequence_number) {
+    return slots_[sequence_number & (slots_.size() - 1)];
+  }
+  const Slot& GetSlot(int64_t sequence_number) const {
+    return slots_[sequence_number & (slots_.size() - 1)];
+  }
+  // Grows the ring, if needed, so that `span` consecutive sequence numbers
+  // map to distinct slots.
+  void EnsureCapacity(int64_t span);
+
+  // Size is a power of two. Slots outside [`begin_`, `end_`) are unused.
+  std::vector<Slot> slots_;
+  // Sequence numbers of the first and one past the last stored packet. Both
+  // ends of the span are kept populated while not empty.
+  int64_t begin_ = 0;
+  int64_t end_ = 0;
+  size_t size_ = 0;
 };
 
 // TransportFeedbackAdapter converts RTCP feedback packets to RTCP agnostic per
@@ -96,13 +172,9 @@ class TransportFeedbackAdapter {
   struct SsrcAndRtpSequencenumber {
     uint32_t ssrc;
     uint16_t rtp_sequence_number;
-
-    bool operator<(const SsrcAndRtpSequencenumber& other) const {
-      return std::tie(ssrc, rtp_sequence_number) <
-             std::tie(other.ssrc, other.rtp_sequence_number);
-    }
   };
 
+  void MapToTransportSequenceNumber(const PacketFeedback& packet);
   std::optional<PacketFeedback> RetrievePacketFeedback(
       int64_t transport_seq_num,
       bool received);
@@ -132,10 +204,13 @@ class TransportFeedbackAdapter {
   // Used by RFC 8888 congestion control feedback to track base time.
   std::optional<uint32_t> last_feedback_compact_ntp_time_;
 
-  // Map SSRC and RTP sequence number to transport sequence number.
-  std::map<SsrcAndRtpSequencenumber, int64_t /*transport_sequence_number*/>
+  // Map SSRC and RTP sequence number to transport sequence number. Per SSRC,
+  // a table indexed by RTP sequence number modulo its size. An entry is only
+  // valid while `history_` holds a packet with that transport sequence number
+  // and the same SSRC and RTP sequence number, so entries are never erased.
+  flat_map<uint32_t, std::vector<int64_t /*transport_sequence_number*/>>
       rtp_to_transport_sequence_number_;
-  std::map<int64_t, PacketFeedback> history_;
+  PacketFeedbackHistory history_;
 };
 
 }  // namespace webrtc
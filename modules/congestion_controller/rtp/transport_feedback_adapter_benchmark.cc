@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "api/transport/network_types.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/congestion_controller/rtp/transport_feedback_adapter.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/network/sent_packet.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+// 10000 packets per second, with feedback every 50 ms.
+constexpr TimeDelta kPacketInterval = TimeDelta::Micros(100);
+constexpr size_t kPacketsPerFeedback = 500;
+// Every this many packets is lost.
+constexpr size_t kLossInterval = 100;
+constexpr TimeDelta kOneWayDelay = TimeDelta::Millis(40);
+constexpr uint32_t kSsrc = 0x1234;
+constexpr size_t kPayloadSize = 1200;
+
+struct SentPacketInfo {
+  uint16_t transport_sequence_number;
+  uint16_t rtp_sequence_number;
+  Timestamp send_time;
+};
+
+class AdapterFixture {
+ public:
+  AdapterFixture() : prototype_(nullptr) {
+    prototype_.SetSsrc(kSsrc);
+    prototype_.SetPayloadType(96);
+    prototype_.AllocatePayload(kPayloadSize);
+    prototype_.set_packet_type(RtpPacketMediaType::kVideo);
+  }
+
+  // Sends the packets covered by one feedback message, the way
+  // RtpTransportControllerSend reports them to the adapter.
+  void SendPackets() {
+    sent_.clear();
+    for (size_t i = 0; i < kPacketsPerFeedback; ++i) {
+      RtpPacketToSend packet = prototype_;
+      packet.SetSequenceNumber(next_rtp_sequence_number_);
+      packet.set_transport_sequence_number(next_transport_sequence_number_);
+      adapter_.AddPacket(packet, PacedPacketInfo(), /*overhead_bytes=*/28,
+                         now_);
+      std::optional<SentPacket> sent = adapter_.ProcessSentPacket(
+          rtc::SentPacket(next_transport_sequence_number_, now_.ms()));
+      benchmark::DoNotOptimize(sent);
+      sent_.push_back({.transport_sequence_number =
+                           next_transport_sequence_number_,
+                       .rtp_sequence_number = next_rtp_sequence_number_,
+                       .send_time = now_});
+      ++next_transport_sequence_number_;
+      ++next_rtp_sequence_number_;
+      now_ += kPacketInterval;
+    }
+  }
+
+  rtcp::TransportFeedback BuildTransportFeedback() {
+    rtcp::TransportFeedback feedback;
+    feedback.SetBase(sent_[0].transport_sequence_number,
+                     sent_[0].send_time + kOneWayDelay);
+    for (const SentPacketInfo& packet : sent_) {
+      if (IsLost(packet)) {
+        continue;
+      }
+      feedback.AddReceivedPacket(packet.transport_sequence_number,
+                                 packet.send_time + kOneWayDelay);
+    }
+    return feedback;
+  }
+
+  rtcp::CongestionControlFeedback BuildCongestionControlFeedback() {
+    std::vector<rtcp::CongestionControlFeedback::PacketInfo> packet_infos;
+    const Timestamp feedback_send_time = now_ + kOneWayDelay;
+    for (const SentPacketInfo& packet : sent_) {
+      rtcp::CongestionControlFeedback::PacketInfo packet_info = {
+          .ssrc = kSsrc, .sequence_number = packet.rtp_sequence_number};
+      if (!IsLost(packet)) {
+        packet_info.arrival_time_offset =
+            feedback_send_time - (packet.send_time + kOneWayDelay);
+      }
+      packet_infos.push_back(packet_info);
+    }
+    return rtcp::CongestionControlFeedback(std::move(packet_infos),
+                                           /*report_timestamp_compact_ntp=*/0);
+  }
+
+  TransportFeedbackAdapter& adapter() { return adapter_; }
+  Timestamp now() const { return now_; }
+
+ private:
+  static bool IsLost(const SentPacketInfo& packet) {
+    return packet.transport_sequence_number % kLossInterval == 0;
+  }
+
+  TransportFeedbackAdapter adapter_;
+  RtpPacketToSend prototype_;
+  std::vector<SentPacketInfo> sent_;
+  Timestamp now_ = Timestamp::Seconds(1000);
+  uint16_t next_transport_sequence_number_ = 0;
+  uint16_t next_rtp_sequence_number_ = 0;
+};
+
+void BM_ProcessTransportFeedback(benchmark::State& state) {
+  AdapterFixture fixture;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    fixture.SendPackets();
+    rtcp::TransportFeedback feedback = fixture.BuildTransportFeedback();
+    std::optional<TransportPacketsFeedback> result =
+        fixture.adapter().ProcessTransportFeedback(feedback, fixture.now());
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * kPacketsPerFeedback);
+}
+
+void BM_ProcessCongestionControlFeedback(benchmark::State& state) {
+  AdapterFixture fixture;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    fixture.SendPackets();
+    rtcp::CongestionControlFeedback feedback =
+        fixture.BuildCongestionControlFeedback();
+    std::optional<TransportPacketsFeedback> result =
+        fixture.adapter().ProcessCongestionControlFeedback(feedback,
+                                                           fixture.now());
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * kPacketsPerFeedback);
+}
+
+BENCHMARK(BM_ProcessTransportFeedback);
+BENCHMARK(BM_ProcessCongestionControlFeedback);
+
+}  // namespace
+}  // namespace webrtc
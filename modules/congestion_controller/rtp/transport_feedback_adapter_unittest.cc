@@ -528,6 +528,42 @@ TEST_P(TransportFeedbackAdapterTest, TransportPacketFeedbackHasDataInFlight) {
   EXPECT_EQ(adapted_feedback_2->data_in_flight, DataSize::Zero());
 }
 
+TEST_P(TransportFeedbackAdapterTest,
+       LostPacketCanBeReportedReceivedAfterHistoryHasGrown) {
+  TransportFeedbackAdapter adapter;
+
+  // More packets than fit in the initial history, with an early one lost.
+  std::vector<PacketTemplate> packets =
+      CreatePacketTemplates(/*number_of_ssrcs=*/1, /*packets_per_ssrc=*/600);
+  for (size_t i = 0; i < packets.size(); ++i) {
+    packets[i].receive_timestamp = Timestamp::Millis(100 + i);
+  }
+  for (const PacketTemplate& packet : packets) {
+    adapter.AddPacket(CreatePacketToSend(packet), packet.pacing_info,
+                      /*overhead=*/0u, TimeNow());
+    adapter.ProcessSentPacket(rtc::SentPacket(packet.transport_sequence_number,
+                                              packet.send_timestamp.ms()));
+  }
+  PacketTemplate lost_packet = packets[1];
+  lost_packet.receive_timestamp =
+      packets.back().receive_timestamp + TimeDelta::Millis(10);
+  packets[1].receive_timestamp = Timestamp::MinusInfinity();
+
+  std::optional<TransportPacketsFeedback> adapted_feedback_1 =
+      CreateAndProcessFeedback(packets, adapter);
+  ASSERT_TRUE(adapted_feedback_1.has_value());
+  ComparePacketFeedbackVectors(packets, adapted_feedback_1->packet_feedbacks);
+  EXPECT_EQ(adapted_feedback_1->data_in_flight, DataSize::Zero());
+
+  std::optional<TransportPacketsFeedback> adapted_feedback_2 =
+      CreateAndProcessFeedback(rtc::MakeArrayView(&lost_packet, 1), adapter);
+  ASSERT_TRUE(adapted_feedback_2.has_value());
+  ASSERT_THAT(adapted_feedback_2->packet_feedbacks, SizeIs(1));
+  EXPECT_TRUE(adapted_feedback_2->packet_feedbacks[0].IsReceived());
+  EXPECT_EQ(adapted_feedback_2->packet_feedbacks[0].sent_packet.sequence_number,
+            lost_packet.transport_sequence_number);
+}
+
 TEST(TransportFeedbackAdapterCongestionFeedbackTest,
      CongestionControlFeedbackResultHasEcn) {
   TransportFeedbackAdapter adapter;
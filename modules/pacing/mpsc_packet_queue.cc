@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/mpsc_packet_queue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/function_view.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+
+MpscPacketQueue::MpscPacketQueue() = default;
+
+MpscPacketQueue::~MpscPacketQueue() {
+  Batch* batch = head_.exchange(nullptr, std::memory_order_acquire);
+  while (batch != nullptr) {
+    Batch* next = batch->next;
+    delete batch;
+    batch = next;
+  }
+}
+
+bool MpscPacketQueue::Push(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
+  Batch* batch = new Batch{.packets = std::move(packets), .next = nullptr};
+  Batch* head = head_.load(std::memory_order_relaxed);
+  do {
+    batch->next = head;
+  } while (!head_.compare_exchange_weak(head, batch, std::memory_order_release,
+                                        std::memory_order_relaxed));
+  return head == nullptr;
+}
+
+size_t MpscPacketQueue::Drain(
+    rtc::FunctionView<void(std::unique_ptr<RtpPacketToSend>)> on_packet) {
+  Batch* newest = head_.exchange(nullptr, std::memory_order_acquire);
+
+  // Reverse the stack to get the batches in push order.
+  Batch* oldest = nullptr;
+  while (newest != nullptr) {
+    Batch* next = newest->next;
+    newest->next = oldest;
+    oldest = newest;
+    newest = next;
+  }
+
+  size_t num_packets = 0;
+  while (oldest != nullptr) {
+    std::unique_ptr<Batch> batch(oldest);
+    oldest = batch->next;
+    for (std::unique_ptr<RtpPacketToSend>& packet : batch->packets) {
+      on_packet(std::move(packet));
+      ++num_packets;
+    }
+  }
+  return num_packets;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_MPSC_PACKET_QUEUE_H_
+#define MODULES_PACING_MPSC_PACKET_QUEUE_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/function_view.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+
+// Lock-free queue of packet batches, handed from any number of producer
+// threads (e.g. one per encoder) to a single consumer (the pacer).
+//
+// Producers push onto an intrusive stack with a single compare-and-swap; the
+// consumer takes the whole stack with one exchange and reverses it, so each
+// producer's batches come out in the order they were pushed. Push() reports
+// when the queue goes from empty to non-empty, which lets the producer wake
+// the consumer once per drain rather than once per batch.
+class MpscPacketQueue {
+ public:
+  MpscPacketQueue();
+  ~MpscPacketQueue();
+
+  MpscPacketQueue(const MpscPacketQueue&) = delete;
+  MpscPacketQueue& operator=(const MpscPacketQueue&) = delete;
+
+  // Adds a batch of packets. May be called from any thread. Returns true if
+  // the queue was empty, in which case the caller is responsible for making
+  // the consumer call Drain().
+  bool Push(std::vector<std::unique_ptr<RtpPacketToSend>> packets);
+
+  // Removes all queued batches and passes their packets to `on_packet`.
+  // Must only be called from the consumer thread. Returns the number of
+  // packets drained.
+  size_t Drain(
+      rtc::FunctionView<void(std::unique_ptr<RtpPacketToSend>)> on_packet);
+
+ private:
+  struct Batch {
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+    Batch* next;
+  };
+
+  // Most recently pushed batch, linked to the ones pushed before it.
+  std::atomic<Batch*> head_{nullptr};
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_MPSC_PACKET_QUEUE_H_
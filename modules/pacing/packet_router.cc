@@ -80,6 +80,11 @@ bool PacketRouter::SupportsRtxPayloadPadding() const {
   return false;
 }
 
+void PacketRouter::SetSendRtpPacketsAsEct1(bool send_rtp_packets_as_ect1) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  send_rtp_packets_as_ect1_ = send_rtp_packets_as_ect1;
+}
+
 void PacketRouter::RegisterNotifyBweCallback(
     absl::AnyInvocable<void(const RtpPacketToSend& packet,
                             const PacedPacketInfo& pacing_info)> callback) {
@@ -189,6 +194,9 @@ void PacketRouter::SendPacket(std::unique_ptr<RtpPacketToSend> packet,
     packet->set_transport_sequence_number(transport_seq_++);
   }
   rtp_module->AssignSequenceNumber(*packet);
+  if (send_rtp_packets_as_ect1_) {
+    packet->set_send_as_ect1();
+  }
   if (notify_bwe_callback_) {
     notify_bwe_callback_(*packet, cluster_info);
   }
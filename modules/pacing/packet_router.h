@@ -61,6 +61,11 @@ class PacketRouter : public PacingController::PacketSender {
 
   bool SupportsRtxPayloadPadding() const;
 
+  // If set, RTP packets sent from now on are marked as ECN capable with
+  // ECT(1), so that L4S bottlenecks mark them instead of dropping them or
+  // queueing them.
+  void SetSendRtpPacketsAsEct1(bool send_rtp_packets_as_ect1);
+
   void AddReceiveRtpModule(RtcpFeedbackSenderInterface* rtcp_sender,
                            bool remb_candidate);
   void RemoveReceiveRtpModule(RtcpFeedbackSenderInterface* rtcp_sender);
@@ -116,6 +121,7 @@ class PacketRouter : public PacingController::PacketSender {
       RTC_GUARDED_BY(thread_checker_);
 
   uint64_t transport_seq_ RTC_GUARDED_BY(thread_checker_);
+  bool send_rtp_packets_as_ect1_ RTC_GUARDED_BY(thread_checker_) = false;
   absl::AnyInvocable<void(RtpPacketToSend& packet,
                           const PacedPacketInfo& pacing_info)>
       notify_bwe_callback_ RTC_GUARDED_BY(thread_checker_) = nullptr;
@@ -429,6 +429,28 @@ TEST_F(PacketRouterTest, SendPacketWithoutTransportSequenceNumbers) {
   packet_router_.RemoveSendRtpModule(&rtp_1);
 }
 
+TEST_F(PacketRouterTest, SendsPacketsAsEct1IfConfigured) {
+  const uint16_t kSsrc1 = 1234;
+  NiceMock<MockRtpRtcpInterface> rtp_1;
+  ON_CALL(rtp_1, SendingMedia).WillByDefault(Return(true));
+  ON_CALL(rtp_1, SSRC).WillByDefault(Return(kSsrc1));
+  ON_CALL(rtp_1, CanSendPacket).WillByDefault(Return(true));
+  packet_router_.AddSendRtpModule(&rtp_1, false);
+
+  EXPECT_CALL(rtp_1, SendPacket(Pointee(Property(
+                                    &RtpPacketToSend::send_as_ect1, false)),
+                                _));
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc1), PacedPacketInfo());
+
+  packet_router_.SetSendRtpPacketsAsEct1(true);
+  EXPECT_CALL(rtp_1, SendPacket(Pointee(Property(
+                                    &RtpPacketToSend::send_as_ect1, true)),
+                                _));
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc1), PacedPacketInfo());
+  packet_router_.OnBatchComplete();
+  packet_router_.RemoveSendRtpModule(&rtp_1);
+}
+
 TEST_F(PacketRouterTest, DoesNotIncrementTransportSequenceNumberOnSendFailure) {
   NiceMock<MockRtpRtcpInterface> rtp;
   constexpr uint32_t kSsrc = 1234;
@@ -18,6 +18,7 @@
 #include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "api/units/data_size.h"
@@ -32,6 +33,8 @@ namespace webrtc {
 namespace {
 
 constexpr int kAudioPrioLevel = 0;
+// Initial number of distinct enqueue times tracked before the ring grows.
+constexpr size_t kInitialEnqueueTimesSize = 64;
 
 int GetPriorityForType(
     RtpPacketMediaType type,
@@ -83,6 +86,41 @@ DataSize PrioritizedPacketQueue::QueuedPacket::PacketSize() const {
   return DataSize::Bytes(packet->payload_size() + packet->padding_size());
 }
 
+PrioritizedPacketQueue::EnqueueTimes::EnqueueTimes()
+    : ring_(kInitialEnqueueTimesSize) {}
+
+PrioritizedPacketQueue::EnqueueTimes::~EnqueueTimes() = default;
+
+uint64_t PrioritizedPacketQueue::EnqueueTimes::Add(Timestamp enqueue_time) {
+  if (begin_ != end_ && at(end_ - 1).enqueue_time == enqueue_time) {
+    // Packets of a batch are pushed with the same enqueue time.
+    ++at(end_ - 1).num_packets;
+    return end_ - 1;
+  }
+  if (end_ - begin_ == ring_.size()) {
+    std::vector<Entry> ring(2 * ring_.size());
+    for (uint64_t i = begin_; i != end_; ++i) {
+      ring[i & (ring.size() - 1)] = at(i);
+    }
+    ring_ = std::move(ring);
+  }
+  at(end_) = {.enqueue_time = enqueue_time, .num_packets = 1};
+  return end_++;
+}
+
+void PrioritizedPacketQueue::EnqueueTimes::Remove(uint64_t index) {
+  RTC_CHECK(index >= begin_ && index < end_);
+  RTC_DCHECK_GT(at(index).num_packets, 0);
+  --at(index).num_packets;
+  while (begin_ != end_ && at(begin_).num_packets == 0) {
+    ++begin_;
+  }
+}
+
+Timestamp PrioritizedPacketQueue::EnqueueTimes::Oldest() const {
+  return begin_ == end_ ? Timestamp::MinusInfinity() : at(begin_).enqueue_time;
+}
+
 PrioritizedPacketQueue::StreamQueue::StreamQueue(Timestamp creation_time)
     : last_enqueue_time_(creation_time), num_keyframe_packets_(0) {}
 
@@ -168,8 +206,7 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   }
   stream_queue = it->second.get();
 
-  auto enqueue_time_iterator =
-      enqueue_times_.insert(enqueue_times_.end(), enqueue_time);
+  uint64_t enqueue_time_index = enqueue_times_.Add(enqueue_time);
   RTC_DCHECK(packet->packet_type().has_value());
   RtpPacketMediaType packet_type = packet->packet_type().value();
   int prio_level =
@@ -181,7 +218,7 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   RTC_DCHECK_LT(prio_level, kNumPriorityLevels);
   QueuedPacket queued_packed = {.packet = std::move(packet),
                                 .enqueue_time = enqueue_time,
-                                .enqueue_time_iterator = enqueue_time_iterator};
+                                .enqueue_time_index = enqueue_time_index};
   // In order to figure out how much time a packet has spent in the queue
   // while not in a paused state, we subtract the total amount of time the
   // queue has been paused so far, and when the packet is popped we subtract
@@ -300,8 +337,7 @@ Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTimeForRetransmission()
 }
 
 Timestamp PrioritizedPacketQueue::OldestEnqueueTime() const {
-  return enqueue_times_.empty() ? Timestamp::MinusInfinity()
-                                : enqueue_times_.front();
+  return enqueue_times_.Oldest();
 }
 
 TimeDelta PrioritizedPacketQueue::AverageQueueTime() const {
@@ -410,8 +446,7 @@ void PrioritizedPacketQueue::DequeuePacketInternal(QueuedPacket& packet) {
 
   RTC_DCHECK(size_packets_ > 0 || queue_time_sum_ == TimeDelta::Zero());
 
-  RTC_CHECK(packet.enqueue_time_iterator != enqueue_times_.end());
-  enqueue_times_.erase(packet.enqueue_time_iterator);
+  enqueue_times_.Remove(packet.enqueue_time_index);
 }
 
 void PrioritizedPacketQueue::MaybeUpdateTopPrioLevel() {
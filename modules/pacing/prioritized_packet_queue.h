@@ -16,9 +16,9 @@
 #include <array>
 #include <cstdint>
 #include <deque>
-#include <list>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "api/units/data_size.h"
@@ -111,7 +111,41 @@ class PrioritizedPacketQueue {
 
     std::unique_ptr<RtpPacketToSend> packet;
     Timestamp enqueue_time;
-    std::list<Timestamp>::iterator enqueue_time_iterator;
+    uint64_t enqueue_time_index;
+  };
+
+  // Enqueue times of the packets in the queue, in push order. Packets pushed
+  // at the same time share one entry that counts how many of them are still
+  // queued, and entries are kept in a ring that only grows, so adding and
+  // removing are O(1) and do not allocate in steady state.
+  class EnqueueTimes {
+   public:
+    EnqueueTimes();
+    ~EnqueueTimes();
+
+    // Returns the index to pass to Remove() when the packet leaves the queue.
+    uint64_t Add(Timestamp enqueue_time);
+    void Remove(uint64_t index);
+    // Enqueue time of the oldest packet still in the queue,
+    // Timestamp::MinusInfinity() if there is none.
+    Timestamp Oldest() const;
+
+   private:
+    struct Entry {
+      Timestamp enqueue_time = Timestamp::MinusInfinity();
+      int num_packets = 0;
+    };
+
+    Entry& at(uint64_t index) { return ring_[index & (ring_.size() - 1)]; }
+    const Entry& at(uint64_t index) const {
+      return ring_[index & (ring_.size() - 1)];
+    }
+
+    // Size is a power of two.
+    std::vector<Entry> ring_;
+    // Entries [`begin_`, `end_`) are in use, the first one has packets left.
+    uint64_t begin_ = 0;
+    uint64_t end_ = 0;
   };
 
   // Class containing packets for an RTP stream.
@@ -188,10 +222,9 @@ class PrioritizedPacketQueue {
   // The first index into `stream_by_prio_` that is non-empty.
   int top_active_prio_level_;
 
-  // Ordered list of enqueue times. Additions are always increasing and added to
-  // the end. QueuedPacket instances have a iterators into this list for fast
-  // removal.
-  std::list<Timestamp> enqueue_times_;
+  // Enqueue times, in push order. Additions are always increasing.
+  // QueuedPacket instances have an index into it for fast removal.
+  EnqueueTimes enqueue_times_;
 };
 
 }  // namespace webrtc
@@ -213,6 +213,33 @@ TEST(PrioritizedPacketQueue, ReportsOldestEnqueueTime) {
   EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::MinusInfinity());
 }
 
+TEST(PrioritizedPacketQueue, ReportsOldestEnqueueTimeWithManyEnqueueTimes) {
+  PrioritizedPacketQueue queue(/*creation_time=*/Timestamp::Zero());
+
+  // Two packets per enqueue time, padding first so that every video packet
+  // is sent before the padding packet pushed at the same time.
+  const int kNumEnqueueTimes = 200;
+  for (int i = 0; i < kNumEnqueueTimes; ++i) {
+    queue.Push(Timestamp::Millis(i),
+               CreatePacket(RtpPacketMediaType::kPadding, /*seq=*/2 * i));
+    queue.Push(Timestamp::Millis(i),
+               CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/2 * i + 1));
+  }
+  EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::Millis(0));
+
+  for (int i = 0; i < kNumEnqueueTimes; ++i) {
+    queue.Pop();
+  }
+  // Only padding left, which was pushed at every enqueue time.
+  EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::Millis(0));
+
+  for (int i = 0; i < kNumEnqueueTimes; ++i) {
+    EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::Millis(i));
+    queue.Pop();
+  }
+  EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::MinusInfinity());
+}
+
 TEST(PrioritizedPacketQueue, ReportsAverageQueueTime) {
   PrioritizedPacketQueue queue(/*creation_time=*/Timestamp::Zero());
   EXPECT_EQ(queue.AverageQueueTime(), TimeDelta::Zero());
@@ -111,32 +111,42 @@ void TaskQueuePacedSender::SetPacingRates(DataRate pacing_rate,
 
 void TaskQueuePacedSender::EnqueuePackets(
     std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
-  task_queue_->PostTask(
-      SafeTask(safety_.flag(), [this, packets = std::move(packets)]() mutable {
-        RTC_DCHECK_RUN_ON(task_queue_);
-        TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("webrtc"),
-                     "TaskQueuePacedSender::EnqueuePackets");
-        for (auto& packet : packets) {
-          TRACE_EVENT2(TRACE_DISABLED_BY_DEFAULT("webrtc"),
-                       "TaskQueuePacedSender::EnqueuePackets::Loop",
-                       "sequence_number", packet->SequenceNumber(),
-                       "rtp_timestamp", packet->Timestamp());
-
-          size_t packet_size = packet->payload_size() + packet->padding_size();
-          if (include_overhead_) {
-            packet_size += packet->headers_size();
-          }
-          packet_size_.Apply(1, packet_size);
-          RTC_DCHECK_GE(packet->capture_time(), Timestamp::Zero());
-          pacing_controller_.EnqueuePacket(std::move(packet));
-        }
-        MaybeProcessPackets(Timestamp::MinusInfinity());
-      }));
+  if (!enqueued_packets_.Push(std::move(packets))) {
+    // The queue was not empty, so a task draining it is already pending.
+    return;
+  }
+  task_queue_->PostTask(SafeTask(safety_.flag(), [this]() {
+    RTC_DCHECK_RUN_ON(task_queue_);
+    MaybeProcessPackets(Timestamp::MinusInfinity());
+  }));
+}
+
+// RTC_RUN_ON(task_queue_)
+void TaskQueuePacedSender::DrainEnqueuedPackets() {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("webrtc"),
+               "TaskQueuePacedSender::EnqueuePackets");
+  enqueued_packets_.Drain([&](std::unique_ptr<RtpPacketToSend> packet) {
+    RTC_DCHECK_RUN_ON(task_queue_);
+    TRACE_EVENT2(TRACE_DISABLED_BY_DEFAULT("webrtc"),
+                 "TaskQueuePacedSender::EnqueuePackets::Loop",
+                 "sequence_number", packet->SequenceNumber(), "rtp_timestamp",
+                 packet->Timestamp());
+
+    size_t packet_size = packet->payload_size() + packet->padding_size();
+    if (include_overhead_) {
+      packet_size += packet->headers_size();
+    }
+    packet_size_.Apply(1, packet_size);
+    RTC_DCHECK_GE(packet->capture_time(), Timestamp::Zero());
+    pacing_controller_.EnqueuePacket(std::move(packet));
+  });
 }
 
 void TaskQueuePacedSender::RemovePacketsForSsrc(uint32_t ssrc) {
   task_queue_->PostTask(SafeTask(safety_.flag(), [this, ssrc] {
     RTC_DCHECK_RUN_ON(task_queue_);
+    // Packets enqueued before this call may not have been drained yet.
+    DrainEnqueuedPackets();
     pacing_controller_.RemovePacketsForSsrc(ssrc);
     MaybeProcessPackets(Timestamp::MinusInfinity());
   }));
@@ -212,6 +222,10 @@ void TaskQueuePacedSender::MaybeProcessPackets(
   TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("webrtc"),
                "TaskQueuePacedSender::MaybeProcessPackets");
 
+  // Pick up packets from all producers, including those whose drain task is
+  // still pending, so that they can go out in this round.
+  DrainEnqueuedPackets();
+
   if (is_shutdown_ || !is_started_) {
     return;
   }
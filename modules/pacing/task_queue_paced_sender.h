@@ -28,6 +28,7 @@
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "modules/pacing/mpsc_packet_queue.h"
 #include "modules/pacing/pacing_controller.h"
 #include "modules/pacing/rtp_packet_pacer.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
@@ -73,6 +74,8 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
 
   // Adds the packet to the queue and calls
   // PacingController::PacketSender::SendPacket() when it's time to send.
+  // May be called from any thread; the packets are handed to the pacer's
+  // task queue without taking a lock.
   void EnqueuePackets(
       std::vector<std::unique_ptr<RtpPacketToSend>> packets) override;
   // Remove any pending packets matching this SSRC from the packet queue.
@@ -145,6 +148,9 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   // method again with desired (finite) scheduled process time.
   void MaybeProcessPackets(Timestamp scheduled_process_time);
 
+  // Moves packets from `enqueued_packets_` into the pacing controller.
+  void DrainEnqueuedPackets() RTC_RUN_ON(task_queue_);
+
   void UpdateStats() RTC_RUN_ON(task_queue_);
   Stats GetStats() const;
 
@@ -181,6 +187,11 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   // Protects against ProcessPackets reentry from packet sent receipts.
   bool processing_packets_ RTC_GUARDED_BY(task_queue_) = false;
 
+  // Packets passed to EnqueuePackets() that have not yet been moved to
+  // `pacing_controller_`. A task to drain it is posted only when it goes from
+  // empty to non-empty.
+  MpscPacketQueue enqueued_packets_;
+
   ScopedTaskSafety safety_;
   TaskQueueBase* task_queue_;
 };
@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/pacing/pacing_controller.h"
+#include "modules/pacing/task_queue_paced_sender.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "rtc_base/thread.h"
+#include "system_wrappers/include/clock.h"
+#include "test/explicit_key_value_config.h"
+
+namespace webrtc {
+namespace {
+
+// A frame of a 720p stream, more or less.
+constexpr int kPacketsPerFrame = 10;
+constexpr size_t kPayloadSize = 1200;
+
+// Measures how long packets take from EnqueuePackets() to SendPacket().
+class LatencyMeasuringPacketSender : public PacingController::PacketSender {
+ public:
+  explicit LatencyMeasuringPacketSender(Clock* clock) : clock_(clock) {}
+
+  void SendPacket(std::unique_ptr<RtpPacketToSend> packet,
+                  const PacedPacketInfo& /* cluster_info */) override {
+    // The capture time is set to the enqueue time by the producers.
+    total_latency_ += clock_->CurrentTime() - packet->capture_time();
+    num_packets_sent_.fetch_add(1, std::memory_order_release);
+  }
+  std::vector<std::unique_ptr<RtpPacketToSend>> FetchFec() override {
+    return {};
+  }
+  std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
+      DataSize /* size */) override {
+    return {};
+  }
+
+  int64_t num_packets_sent() const {
+    return num_packets_sent_.load(std::memory_order_acquire);
+  }
+  // Only read once all packets have been sent.
+  TimeDelta total_latency() const { return total_latency_; }
+
+ private:
+  Clock* const clock_;
+  std::atomic<int64_t> num_packets_sent_{0};
+  TimeDelta total_latency_ = TimeDelta::Zero();
+};
+
+// A pacer on its own task queue, shared by all benchmark threads.
+class PacerFixture {
+ public:
+  PacerFixture()
+      : clock_(Clock::GetRealTimeClock()),
+        field_trials_(""),
+        packet_sender_(clock_),
+        task_queue_("pacer", TaskQueueFactory::Priority::HIGH) {
+    task_queue_.SendTask([this] {
+      pacer_ = std::make_unique<TaskQueuePacedSender>(
+          clock_, &packet_sender_, field_trials_,
+          PacingController::kMinSleepTime,
+          TaskQueuePacedSender::kNoPacketHoldback);
+      // Fast enough that pacing itself does not add to the latency.
+      pacer_->SetPacingRates(DataRate::KilobitsPerSec(10'000'000),
+                             DataRate::Zero());
+      pacer_->EnsureStarted();
+    });
+  }
+
+  ~PacerFixture() {
+    task_queue_.SendTask([this] { pacer_.reset(); });
+  }
+
+  // Enqueues one frame worth of packets on `ssrc`, like RTPSenderVideo does
+  // from the encoder thread.
+  void EnqueueFrame(uint32_t ssrc, uint16_t& sequence_number) {
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+    packets.reserve(kPacketsPerFrame);
+    const Timestamp now = clock_->CurrentTime();
+    for (int i = 0; i < kPacketsPerFrame; ++i) {
+      auto packet = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+      packet->SetSsrc(ssrc);
+      packet->SetSequenceNumber(sequence_number++);
+      packet->SetPayloadSize(kPayloadSize);
+      packet->set_packet_type(RtpPacketMediaType::kVideo);
+      packet->set_capture_time(now);
+      packets.push_back(std::move(packet));
+    }
+    num_packets_enqueued_.fetch_add(kPacketsPerFrame);
+    pacer_->EnqueuePackets(std::move(packets));
+  }
+
+  // Waits until everything enqueued so far has been sent and returns the
+  // average time packets spent between enqueue and send.
+  TimeDelta WaitForAllSentAndGetAverageLatency() {
+    const int64_t num_packets = num_packets_enqueued_.load();
+    while (packet_sender_.num_packets_sent() < num_packets) {
+      rtc::Thread::SleepMs(1);
+    }
+    TimeDelta total_latency = TimeDelta::Zero();
+    task_queue_.SendTask(
+        [&] { total_latency = packet_sender_.total_latency(); });
+    return num_packets > 0 ? total_latency / num_packets : TimeDelta::Zero();
+  }
+
+ private:
+  Clock* const clock_;
+  const test::ExplicitKeyValueConfig field_trials_;
+  LatencyMeasuringPacketSender packet_sender_;
+  std::atomic<int64_t> num_packets_enqueued_{0};
+  TaskQueueForTest task_queue_;
+  std::unique_ptr<TaskQueuePacedSender> pacer_;
+};
+
+PacerFixture* fixture = nullptr;
+
+// Every benchmark thread is an encoder of its own stream, all feeding the
+// same pacer.
+void BM_PacerMultiStreamEnqueue(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    fixture = new PacerFixture();
+  }
+  const uint32_t ssrc = 1000 + state.thread_index();
+  uint16_t sequence_number = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    fixture->EnqueueFrame(ssrc, sequence_number);
+  }
+  state.SetItemsProcessed(state.iterations() * kPacketsPerFrame);
+  if (state.thread_index() == 0) {
+    state.counters["latency_us"] =
+        fixture->WaitForAllSentAndGetAverageLatency().us<double>();
+    delete fixture;
+    fixture = nullptr;
+  }
+}
+
+BENCHMARK(BM_PacerMultiStreamEnqueue)->Threads(1)->UseRealTime();
+BENCHMARK(BM_PacerMultiStreamEnqueue)->Threads(4)->UseRealTime();
+BENCHMARK(BM_PacerMultiStreamEnqueue)->Threads(16)->UseRealTime();
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_RECEIVER_H_
+#define MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_RECEIVER_H_
+
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "api/sequence_checker.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/recovered_packet_receiver.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/ulpfec_receiver.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/numerics/sequence_number_unwrapper.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class Clock;
+
+// Receiving end of ReedSolomonFecSender, used in place of FlexfecReceiver.
+// Keeps the most recent media packets of the protected stream, and as soon as
+// a block has at least as many repair packets as it misses media packets,
+// recovers all of them and hands them to `recovered_packet_receiver`.
+class ReedSolomonFecReceiver {
+ public:
+  ReedSolomonFecReceiver(Clock* clock,
+                         uint32_t ssrc,
+                         uint32_t protected_media_ssrc,
+                         RecoveredPacketReceiver* recovered_packet_receiver);
+  ~ReedSolomonFecReceiver();
+
+  // Inserts a received packet, either media or FEC. Newly recovered packets
+  // are sent back through the callback.
+  void OnRtpPacket(const RtpPacketReceived& packet);
+
+  // Returns a counter describing the added and recovered packets.
+  FecPacketCounter GetPacketCounter() const;
+
+ private:
+  struct Block {
+    int64_t base_sequence_number = 0;
+    uint64_t source_mask = 0;
+    // Repair index and shard.
+    std::vector<std::pair<int, rtc::CopyOnWriteBuffer>> repairs;
+  };
+
+  void AddMediaPacket(const RtpPacketReceived& packet)
+      RTC_RUN_ON(sequence_checker_);
+  void AddRepairPacket(const RtpPacketReceived& packet)
+      RTC_RUN_ON(sequence_checker_);
+  // Recovers the missing media packets of `block` if it can. Returns true once
+  // the block is of no further use.
+  bool MaybeRecover(const Block& block) RTC_RUN_ON(sequence_checker_);
+  void OnRecovered(rtc::CopyOnWriteBuffer packet)
+      RTC_RUN_ON(sequence_checker_);
+
+  // Config.
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+  RecoveredPacketReceiver* const recovered_packet_receiver_;
+  Clock* const clock_;
+
+  RtpSequenceNumberUnwrapper unwrapper_ RTC_GUARDED_BY(sequence_checker_);
+  // Source shards of the most recent media packets, by unwrapped sequence
+  // number, and the first sequence number that has not been evicted.
+  std::map<int64_t, std::vector<uint8_t>> source_shards_
+      RTC_GUARDED_BY(sequence_checker_);
+  int64_t first_kept_sequence_number_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  std::deque<Block> blocks_ RTC_GUARDED_BY(sequence_checker_);
+  RtpHeaderExtensionMap extensions_ RTC_GUARDED_BY(sequence_checker_);
+
+  // Logging and stats.
+  Timestamp last_recovered_packet_ RTC_GUARDED_BY(sequence_checker_) =
+      Timestamp::MinusInfinity();
+  FecPacketCounter packet_counter_ RTC_GUARDED_BY(sequence_checker_);
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_RECEIVER_H_
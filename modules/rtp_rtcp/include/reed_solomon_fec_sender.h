@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_SENDER_H_
+#define MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_SENDER_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/array_view.h"
+#include "api/environment/environment.h"
+#include "api/rtp_parameters.h"
+#include "api/units/data_rate.h"
+#include "api/units/timestamp.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_header_extension_size.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/video_fec_generator.h"
+#include "rtc_base/bitrate_tracker.h"
+#include "rtc_base/random.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Protects a media stream with the Reed-Solomon erasure code of
+// reed_solomon_code.h, sending the repair packets on a stream of their own
+// like FlexfecSender does (packet format in reed_solomon_fec_format.h). Any K
+// of the K + M packets of a block recover all K media packets, where the XOR
+// masks of ULPFEC and FlexFEC need more, or particular, packets to recover a
+// burst. A block is closed, and its M = K * fec_rate / 256 repair packets
+// generated, at the end of every `max_fec_frames` frame; `fec_mask_type` has
+// no meaning for this code and is ignored.
+//
+// Like FlexfecSender, this class is not thread safe except for
+// CurrentFecRate(), and is called from RtpSenderEgress.
+class ReedSolomonFecSender : public VideoFecGenerator {
+ public:
+  ReedSolomonFecSender(const Environment& env,
+                       int payload_type,
+                       uint32_t ssrc,
+                       uint32_t protected_media_ssrc,
+                       absl::string_view mid,
+                       const std::vector<RtpExtension>& rtp_header_extensions,
+                       rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+                       const RtpState* rtp_state);
+  ~ReedSolomonFecSender() override;
+
+  FecType GetFecType() const override {
+    return VideoFecGenerator::FecType::kReedSolomon;
+  }
+  std::optional<uint32_t> FecSsrc() override { return ssrc_; }
+  size_t MaxPacketOverhead() const override;
+  DataRate CurrentFecRate() const override;
+  void SetProtectionParameters(const FecProtectionParams& delta_params,
+                               const FecProtectionParams& key_params) override;
+  void AddPacketAndGenerateFec(const RtpPacketToSend& packet) override;
+  std::vector<std::unique_ptr<RtpPacketToSend>> GetFecPackets() override;
+  std::optional<RtpState> GetRtpState() override;
+
+ private:
+  const FecProtectionParams& CurrentParams() const;
+  // Generates the repair packets of the current block and starts a new one.
+  void CloseBlock();
+
+  const Environment env_;
+  Random random_;
+  Timestamp last_generated_packet_ = Timestamp::MinusInfinity();
+
+  // Config.
+  const int payload_type_;
+  const uint32_t timestamp_offset_;
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+  // MID value to send in the MID header extension.
+  const std::string mid_;
+  const RtpHeaderExtensionMap rtp_header_extension_map_;
+  const size_t header_extensions_size_;
+  // Sequence number of next packet to generate.
+  uint16_t seq_num_;
+
+  FecProtectionParams delta_params_;
+  FecProtectionParams key_params_;
+
+  // The block being collected.
+  std::vector<std::vector<uint8_t>> source_shards_;
+  uint16_t base_sequence_number_ = 0;
+  uint64_t source_mask_ = 0;
+  int num_protected_frames_ = 0;
+  bool block_contains_key_frame_ = false;
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> generated_fec_packets_;
+
+  mutable Mutex mutex_;
+  BitrateTracker fec_bitrate_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_INCLUDE_REED_SOLOMON_FEC_SENDER_H_
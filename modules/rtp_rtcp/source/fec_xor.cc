@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "modules/rtp_rtcp/source/fec_xor_kernels.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kSSE2, kAVX2
+#endif
+
+namespace webrtc {
+namespace fec_xor {
+
+void XorC(const uint8_t* const* sources,
+          size_t num_sources,
+          size_t offset,
+          size_t length,
+          uint8_t* dst) {
+  // Eight bytes at a time; memcpy keeps the unaligned accesses well defined
+  // and compiles to plain loads and stores.
+  size_t i = offset;
+  for (; i + 8 <= offset + length; i += 8) {
+    uint64_t value;
+    memcpy(&value, dst + i, 8);
+    for (size_t s = 0; s < num_sources; ++s) {
+      uint64_t source;
+      memcpy(&source, sources[s] + i, 8);
+      value ^= source;
+    }
+    memcpy(dst + i, &value, 8);
+  }
+  XorBytes(sources, num_sources, i, offset + length - i, dst);
+}
+
+}  // namespace fec_xor
+
+namespace {
+
+fec_xor::Kernel SelectKernel() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // x86 CPU detection required.
+  if (GetCPUInfo(kAVX2)) {
+    return &fec_xor::XorAvx2;
+  }
+  if (GetCPUInfo(kSSE2)) {
+    return &fec_xor::XorSse2;
+  }
+  return &fec_xor::XorC;
+#elif defined(WEBRTC_HAS_NEON)
+  return &fec_xor::XorNeon;
+#else
+  return &fec_xor::XorC;
+#endif
+}
+
+fec_xor::Kernel GetKernel() {
+  static const fec_xor::Kernel kernel = SelectKernel();
+  return kernel;
+}
+
+}  // namespace
+
+void FecXor(const uint8_t* src, size_t length, uint8_t* dst) {
+  GetKernel()(&src, 1, 0, length, dst);
+}
+
+void FecXorMultiple(rtc::ArrayView<FecXorSource> sources, uint8_t* dst) {
+  if (sources.empty()) {
+    return;
+  }
+  // Longest first, so that every range of bytes covered by the same set of
+  // sources takes a single kernel call.
+  std::sort(sources.begin(), sources.end(),
+            [](const FecXorSource& a, const FecXorSource& b) {
+              return a.length > b.length;
+            });
+  constexpr size_t kMaxSourcesPerPass = 64;
+  const uint8_t* data[kMaxSourcesPerPass];
+  const fec_xor::Kernel kernel = GetKernel();
+  for (size_t first = 0; first < sources.size(); first += kMaxSourcesPerPass) {
+    const size_t count = std::min(kMaxSourcesPerPass, sources.size() - first);
+    for (size_t s = 0; s < count; ++s) {
+      data[s] = sources[first + s].data;
+    }
+    // The first n sources, and only those, cover [length of source n,
+    // length of source n - 1).
+    for (size_t n = count; n > 0; --n) {
+      const size_t begin = n < count ? sources[first + n].length : 0;
+      const size_t end = sources[first + n - 1].length;
+      if (end > begin) {
+        kernel(data, n, begin, end - begin, dst);
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,41 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// XOR kernels used by ForwardErrorCorrection for both generating FEC payloads
+// and recovering media packets from them. The implementation (SSE2, AVX2,
+// NEON or portable C) is picked once, on first use, from the CPU features.
+
+// XORs `length` bytes of `src` into `dst`.
+void FecXor(const uint8_t* src, size_t length, uint8_t* dst);
+
+struct FecXorSource {
+  const uint8_t* data = nullptr;
+  size_t length = 0;
+};
+
+// XORs all of `sources` into `dst`, loading and storing every byte of `dst`
+// once rather than once per source. Sources shorter than the longest one are
+// treated as zero padded, so `dst` must hold at least as many bytes as the
+// longest source. `sources` is reordered.
+void FecXorMultiple(rtc::ArrayView<FecXorSource> sources, uint8_t* dst);
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "modules/rtp_rtcp/source/fec_xor_kernels.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+// Payloads of roughly MTU size, as protected by video FEC.
+constexpr size_t kPayloadSize = 1200;
+
+std::vector<std::vector<uint8_t>> RandomPayloads(int count) {
+  Random random(0x1234);
+  std::vector<std::vector<uint8_t>> payloads(count);
+  for (auto& payload : payloads) {
+    payload.resize(kPayloadSize);
+    for (uint8_t& byte : payload) {
+      byte = random.Rand<uint8_t>();
+    }
+  }
+  return payloads;
+}
+
+// What ForwardErrorCorrection did before the kernels: one byte at a time,
+// one media packet at a time.
+void BM_FecXorByteLoop(benchmark::State& state) {
+  const auto payloads = RandomPayloads(state.range(0));
+  std::vector<uint8_t> dst(kPayloadSize);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    for (const auto& payload : payloads) {
+      const uint8_t* src = payload.data();
+      fec_xor::XorBytes(&src, 1, 0, kPayloadSize, dst.data());
+    }
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * kPayloadSize);
+}
+
+void BM_FecXorPortable(benchmark::State& state) {
+  const auto payloads = RandomPayloads(state.range(0));
+  std::vector<uint8_t> dst(kPayloadSize);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    for (const auto& payload : payloads) {
+      const uint8_t* src = payload.data();
+      fec_xor::XorC(&src, 1, 0, kPayloadSize, dst.data());
+    }
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * kPayloadSize);
+}
+
+void BM_FecXor(benchmark::State& state) {
+  const auto payloads = RandomPayloads(state.range(0));
+  std::vector<uint8_t> dst(kPayloadSize);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    for (const auto& payload : payloads) {
+      FecXor(payload.data(), kPayloadSize, dst.data());
+    }
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * kPayloadSize);
+}
+
+void BM_FecXorMultiple(benchmark::State& state) {
+  const auto payloads = RandomPayloads(state.range(0));
+  std::vector<FecXorSource> sources;
+  for (const auto& payload : payloads) {
+    sources.push_back({payload.data(), payload.size()});
+  }
+  std::vector<uint8_t> dst(kPayloadSize);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    FecXorMultiple(sources, dst.data());
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * kPayloadSize);
+}
+
+// Number of media packets protected by one FEC packet.
+BENCHMARK(BM_FecXorByteLoop)->Arg(1)->Arg(4)->Arg(12)->Arg(48);
+BENCHMARK(BM_FecXorPortable)->Arg(1)->Arg(4)->Arg(12)->Arg(48);
+BENCHMARK(BM_FecXor)->Arg(1)->Arg(4)->Arg(12)->Arg(48);
+BENCHMARK(BM_FecXorMultiple)->Arg(1)->Arg(4)->Arg(12)->Arg(48);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_KERNELS_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_KERNELS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace fec_xor {
+
+// XORs bytes [offset, offset + length) of each of the `num_sources` buffers
+// in `sources` into the same bytes of `dst`. Buffers need not be aligned.
+using Kernel = void (*)(const uint8_t* const* sources,
+                        size_t num_sources,
+                        size_t offset,
+                        size_t length,
+                        uint8_t* dst);
+
+void XorC(const uint8_t* const* sources,
+          size_t num_sources,
+          size_t offset,
+          size_t length,
+          uint8_t* dst);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorSse2(const uint8_t* const* sources,
+             size_t num_sources,
+             size_t offset,
+             size_t length,
+             uint8_t* dst);
+void XorAvx2(const uint8_t* const* sources,
+             size_t num_sources,
+             size_t offset,
+             size_t length,
+             uint8_t* dst);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void XorNeon(const uint8_t* const* sources,
+             size_t num_sources,
+             size_t offset,
+             size_t length,
+             uint8_t* dst);
+#endif
+
+// Byte at a time, for the tails the vector kernels leave over.
+inline void XorBytes(const uint8_t* const* sources,
+                     size_t num_sources,
+                     size_t offset,
+                     size_t length,
+                     uint8_t* dst) {
+  for (size_t i = offset; i < offset + length; ++i) {
+    uint8_t value = dst[i];
+    for (size_t s = 0; s < num_sources; ++s) {
+      value ^= sources[s][i];
+    }
+    dst[i] = value;
+  }
+}
+
+}  // namespace fec_xor
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_KERNELS_H_
@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor_kernels.h"
+
+#include <emmintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+namespace fec_xor {
+
+void XorSse2(const uint8_t* const* sources,
+             size_t num_sources,
+             size_t offset,
+             size_t length,
+             uint8_t* dst) {
+  size_t i = offset;
+  for (; i + 16 <= offset + length; i += 16) {
+    __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    for (size_t s = 0; s < num_sources; ++s) {
+      value = _mm_xor_si128(
+          value,
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(sources[s] + i)));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), value);
+  }
+  XorBytes(sources, num_sources, i, offset + length - i, dst);
+}
+
+}  // namespace fec_xor
+}  // namespace webrtc
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "modules/rtp_rtcp/source/fec_xor_kernels.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+std::vector<uint8_t> RandomBytes(Random& random, size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    byte = random.Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+std::vector<fec_xor::Kernel> SupportedKernels() {
+  std::vector<fec_xor::Kernel> kernels = {&fec_xor::XorC};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kSSE2)) {
+    kernels.push_back(&fec_xor::XorSse2);
+  }
+  if (GetCPUInfo(kAVX2)) {
+    kernels.push_back(&fec_xor::XorAvx2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  kernels.push_back(&fec_xor::XorNeon);
+#endif
+  return kernels;
+}
+
+TEST(FecXorTest, KernelsMatchByteLoop) {
+  Random random(0x1234);
+  constexpr size_t kBufferSize = 200;
+  for (fec_xor::Kernel kernel : SupportedKernels()) {
+    for (size_t num_sources : {1, 2, 5}) {
+      std::vector<std::vector<uint8_t>> buffers;
+      std::vector<const uint8_t*> sources;
+      for (size_t s = 0; s < num_sources; ++s) {
+        buffers.push_back(RandomBytes(random, kBufferSize));
+        sources.push_back(buffers.back().data());
+      }
+      // Every combination of misalignment and a length that leaves a tail
+      // for each vector width.
+      for (size_t offset : {0, 1, 7, 16, 31}) {
+        for (size_t length : {0, 1, 15, 16, 17, 33, 64, 100, 165}) {
+          std::vector<uint8_t> expected = RandomBytes(random, kBufferSize);
+          std::vector<uint8_t> actual = expected;
+          fec_xor::XorBytes(sources.data(), num_sources, offset, length,
+                            expected.data());
+          kernel(sources.data(), num_sources, offset, length, actual.data());
+          EXPECT_THAT(actual, ElementsAreArray(expected))
+              << "sources " << num_sources << " offset " << offset
+              << " length " << length;
+        }
+      }
+    }
+  }
+}
+
+TEST(FecXorTest, XorsSingleSource) {
+  Random random(0x5678);
+  const std::vector<uint8_t> src = RandomBytes(random, 1200);
+  std::vector<uint8_t> dst = RandomBytes(random, 1200);
+  std::vector<uint8_t> expected = dst;
+  for (size_t i = 0; i < src.size(); ++i) {
+    expected[i] ^= src[i];
+  }
+  FecXor(src.data(), src.size(), dst.data());
+  EXPECT_THAT(dst, ElementsAreArray(expected));
+}
+
+TEST(FecXorTest, MultipleZeroPadsShorterSources) {
+  Random random(0x9abc);
+  // More sources than fit in a single pass, with repeated lengths.
+  std::vector<std::vector<uint8_t>> buffers;
+  std::vector<FecXorSource> sources;
+  for (int i = 0; i < 100; ++i) {
+    buffers.push_back(RandomBytes(random, random.Rand(0, 1200)));
+    if (i % 10 == 0) {
+      buffers.back().resize(500);
+    }
+  }
+  for (const auto& buffer : buffers) {
+    sources.push_back({buffer.data(), buffer.size()});
+  }
+  std::vector<uint8_t> dst = RandomBytes(random, 1200);
+  std::vector<uint8_t> expected = dst;
+  for (const auto& buffer : buffers) {
+    for (size_t i = 0; i < buffer.size(); ++i) {
+      expected[i] ^= buffer[i];
+    }
+  }
+  FecXorMultiple(sources, dst.data());
+  EXPECT_THAT(dst, ElementsAreArray(expected));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -16,9 +16,11 @@
 #include <utility>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/inlined_vector.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/flexfec_03_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
@@ -218,23 +220,20 @@ void ForwardErrorCorrection::GenerateFecPayloads(
     auto media_packets_it = media_packets.cbegin();
     uint16_t prev_seq_num =
         ParseSequenceNumber((*media_packets_it)->data.data());
+    size_t fec_packet_length = 0;
+    protected_packets_.clear();
+    xor_sources_.clear();
     while (media_packets_it != media_packets.end()) {
       Packet* const media_packet = media_packets_it->get();
       // Should `media_packet` be protected by `fec_packet`?
       if (packet_masks_[pkt_mask_idx] & (1 << (7 - media_pkt_idx))) {
         size_t media_payload_length =
             media_packet->data.size() - kRtpHeaderSize;
-
-        size_t fec_packet_length = fec_header_size + media_payload_length;
-        if (fec_packet_length > fec_packet->data.size()) {
-          size_t old_size = fec_packet->data.size();
-          fec_packet->data.SetSize(fec_packet_length);
-          memset(fec_packet->data.MutableData() + old_size, 0,
-                 fec_packet_length - old_size);
-        }
-        XorHeaders(*media_packet, fec_packet);
-        XorPayloads(*media_packet, media_payload_length, fec_header_size,
-                    fec_packet);
+        fec_packet_length = std::max(fec_packet_length,
+                                     fec_header_size + media_payload_length);
+        protected_packets_.push_back(media_packet);
+        xor_sources_.push_back({media_packet->data.cdata() + kRtpHeaderSize,
+                                media_payload_length});
       }
       media_packets_it++;
       if (media_packets_it != media_packets.end()) {
@@ -246,6 +245,18 @@ void ForwardErrorCorrection::GenerateFecPayloads(
       pkt_mask_idx += media_pkt_idx / 8;
       media_pkt_idx %= 8;
     }
+    if (fec_packet_length > fec_packet->data.size()) {
+      size_t old_size = fec_packet->data.size();
+      fec_packet->data.SetSize(fec_packet_length);
+      memset(fec_packet->data.MutableData() + old_size, 0,
+             fec_packet_length - old_size);
+    }
+    for (const Packet* media_packet : protected_packets_) {
+      XorHeaders(*media_packet, fec_packet);
+    }
+    // All protected payloads in one pass over the FEC payload.
+    FecXorMultiple(xor_sources_,
+                   fec_packet->data.MutableData() + fec_header_size);
     RTC_DCHECK_GT(fec_packet->data.size(), 0)
         << "Packet mask is wrong or poorly designed.";
   }
@@ -635,11 +646,8 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
     dst->data.SetSize(new_size);
     memset(dst->data.MutableData() + old_size, 0, new_size - old_size);
   }
-  uint8_t* dst_data = dst->data.MutableData();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  FecXor(src.data.cdata() + kRtpHeaderSize, payload_length,
+         dst->data.MutableData() + dst_offset);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -647,18 +655,30 @@ bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
   if (!StartPacketRecovery(fec_packet, recovered_packet)) {
     return false;
   }
+  Packet* const recovered = recovered_packet->pkt.get();
+  absl::InlinedVector<FecXorSource, kUlpfecMaxMediaPackets> sources;
+  size_t recovered_length = recovered->data.size();
   for (const auto& protected_packet : fec_packet.protected_packets) {
     if (protected_packet->pkt == nullptr) {
       // This is the packet we're recovering.
       recovered_packet->seq_num = protected_packet->seq_num;
       recovered_packet->ssrc = protected_packet->ssrc;
     } else {
-      XorHeaders(*protected_packet->pkt, recovered_packet->pkt.get());
-      XorPayloads(*protected_packet->pkt,
-                  protected_packet->pkt->data.size() - kRtpHeaderSize,
-                  kRtpHeaderSize, recovered_packet->pkt.get());
+      const Packet& src = *protected_packet->pkt;
+      XorHeaders(src, recovered);
+      sources.push_back({src.data.cdata() + kRtpHeaderSize,
+                         src.data.size() - kRtpHeaderSize});
+      recovered_length = std::max(recovered_length, src.data.size());
     }
   }
+  RTC_DCHECK_LE(recovered_length, recovered->data.capacity());
+  if (recovered_length > recovered->data.size()) {
+    size_t old_size = recovered->data.size();
+    recovered->data.SetSize(recovered_length);
+    memset(recovered->data.MutableData() + old_size, 0,
+           recovered_length - old_size);
+  }
+  FecXorMultiple(sources, recovered->data.MutableData() + kRtpHeaderSize);
   if (!FinishPacketRecovery(fec_packet, recovered_packet)) {
     return false;
   }
@@ -24,6 +24,7 @@
 #include "modules/include/module_fec_types.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
@@ -367,6 +368,11 @@ class ForwardErrorCorrection {
   uint8_t packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   uint8_t tmp_packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   size_t packet_mask_size_;
+  // The media packets protected by the FEC packet GenerateFecPayloads() is
+  // working on, and their payloads.
+  absl::InlinedVector<const Packet*, kUlpfecMaxMediaPackets>
+      protected_packets_;
+  absl::InlinedVector<FecXorSource, kUlpfecMaxMediaPackets> xor_sources_;
 };
 
 // Classes derived from FecHeader{Reader,Writer} encapsulate the
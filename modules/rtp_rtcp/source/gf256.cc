@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256.h"
+
+#include "modules/rtp_rtcp/source/gf256_kernels.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kAVX2
+#endif
+
+namespace webrtc {
+namespace {
+
+constexpr int kPolynomial = 0x11d;
+
+struct Tables {
+  Tables() {
+    // 2 generates the multiplicative group for this polynomial.
+    int x = 1;
+    for (int i = 0; i < 255; ++i) {
+      exp[i] = x;
+      exp[i + 255] = x;
+      log[x] = i;
+      x <<= 1;
+      if (x & 0x100) {
+        x ^= kPolynomial;
+      }
+    }
+    log[0] = 0;
+    for (int c = 0; c < 256; ++c) {
+      for (int n = 0; n < 16; ++n) {
+        nibble_products[c][n] = Mul(c, n);
+        nibble_products[c][16 + n] = Mul(c, n << 4);
+      }
+    }
+  }
+
+  uint8_t Mul(int a, int b) const {
+    if (a == 0 || b == 0) {
+      return 0;
+    }
+    return exp[log[a] + log[b]];
+  }
+
+  uint8_t exp[510];
+  uint8_t log[256];
+  uint8_t nibble_products[256][32];
+};
+
+const Tables& GetTables() {
+  static const Tables* const tables = new Tables();
+  return *tables;
+}
+
+gf256::MulAddKernel SelectKernel() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // x86 CPU detection required. SSE2 has no byte shuffle, so without AVX2
+  // the table lookups are done one byte at a time.
+  if (GetCPUInfo(kAVX2)) {
+    return &gf256::MulAddAvx2;
+  }
+  return &gf256::MulAddC;
+#elif defined(WEBRTC_HAS_NEON)
+  return &gf256::MulAddNeon;
+#else
+  return &gf256::MulAddC;
+#endif
+}
+
+gf256::MulAddKernel GetKernel() {
+  static const gf256::MulAddKernel kernel = SelectKernel();
+  return kernel;
+}
+
+}  // namespace
+
+namespace gf256 {
+
+void MulAddC(const uint8_t* nibble_products,
+             const uint8_t* src,
+             size_t length,
+             uint8_t* dst) {
+  MulAddBytes(nibble_products, src, length, dst);
+}
+
+}  // namespace gf256
+
+uint8_t Gf256Mul(uint8_t a, uint8_t b) {
+  return GetTables().Mul(a, b);
+}
+
+uint8_t Gf256Inverse(uint8_t a) {
+  RTC_DCHECK_NE(a, 0);
+  const Tables& tables = GetTables();
+  return tables.exp[255 - tables.log[a]];
+}
+
+void Gf256MulAdd(uint8_t coefficient,
+                 const uint8_t* src,
+                 size_t length,
+                 uint8_t* dst) {
+  if (coefficient == 0 || length == 0) {
+    return;
+  }
+  GetKernel()(GetTables().nibble_products[coefficient], src, length, dst);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_GF256_H_
+#define MODULES_RTP_RTCP_SOURCE_GF256_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+
+// Arithmetic in GF(2^8) with the reducing polynomial
+// x^8 + x^4 + x^3 + x^2 + 1 (0x11d), for the Reed-Solomon FEC scheme.
+// Addition and subtraction are both XOR.
+
+uint8_t Gf256Mul(uint8_t a, uint8_t b);
+
+// `a` must not be zero.
+uint8_t Gf256Inverse(uint8_t a);
+
+// dst[i] ^= coefficient * src[i] for all i in [0, length). This is the inner
+// loop of both encoding and decoding; the implementation (AVX2, NEON or
+// portable C) is picked once, on first use, from the CPU features.
+void Gf256MulAdd(uint8_t coefficient,
+                 const uint8_t* src,
+                 size_t length,
+                 uint8_t* dst);
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_GF256_H_
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256_kernels.h"
+
+#include <immintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+namespace gf256 {
+
+void MulAddAvx2(const uint8_t* nibble_products,
+                const uint8_t* src,
+                size_t length,
+                uint8_t* dst) {
+  // The shuffle looks up within each 128-bit lane, so both lanes get a copy
+  // of the tables.
+  const __m256i low_products = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(nibble_products)));
+  const __m256i high_products = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(nibble_products + 16)));
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    const __m256i x =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i low = _mm256_and_si256(x, nibble_mask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi64(x, 4), nibble_mask);
+    const __m256i product =
+        _mm256_xor_si256(_mm256_shuffle_epi8(low_products, low),
+                         _mm256_shuffle_epi8(high_products, high));
+    __m256i value =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+    value = _mm256_xor_si256(value, product);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), value);
+  }
+  MulAddBytes(nibble_products, src + i, length - i, dst + i);
+}
+
+}  // namespace gf256
+}  // namespace webrtc
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_GF256_KERNELS_H_
+#define MODULES_RTP_RTCP_SOURCE_GF256_KERNELS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace gf256 {
+
+// A GF(2^8) product c * x splits over the nibbles of x:
+//   c * x = c * (x & 0x0f) ^ c * (x & 0xf0).
+// For a fixed coefficient c the kernels get both 16 entry product tables,
+// `nibble_products[0..15]` for the low nibble and `nibble_products[16..31]`
+// for the high one, which is what a byte shuffle instruction can look up.
+//
+// dst[i] ^= c * src[i] for all i in [0, length). Buffers need not be aligned.
+using MulAddKernel = void (*)(const uint8_t* nibble_products,
+                              const uint8_t* src,
+                              size_t length,
+                              uint8_t* dst);
+
+void MulAddC(const uint8_t* nibble_products,
+             const uint8_t* src,
+             size_t length,
+             uint8_t* dst);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void MulAddAvx2(const uint8_t* nibble_products,
+                const uint8_t* src,
+                size_t length,
+                uint8_t* dst);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void MulAddNeon(const uint8_t* nibble_products,
+                const uint8_t* src,
+                size_t length,
+                uint8_t* dst);
+#endif
+
+// Byte at a time, for the tails the vector kernels leave over.
+inline void MulAddBytes(const uint8_t* nibble_products,
+                        const uint8_t* src,
+                        size_t length,
+                        uint8_t* dst) {
+  for (size_t i = 0; i < length; ++i) {
+    dst[i] ^= nibble_products[src[i] & 0x0f] ^
+              nibble_products[16 + (src[i] >> 4)];
+  }
+}
+
+}  // namespace gf256
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_GF256_KERNELS_H_
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256_kernels.h"
+
+#include <arm_neon.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+namespace gf256 {
+
+void MulAddNeon(const uint8_t* nibble_products,
+                const uint8_t* src,
+                size_t length,
+                uint8_t* dst) {
+  const uint8x16_t nibble_mask = vdupq_n_u8(0x0f);
+  size_t i = 0;
+#if defined(__aarch64__)
+  const uint8x16_t low_products = vld1q_u8(nibble_products);
+  const uint8x16_t high_products = vld1q_u8(nibble_products + 16);
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t x = vld1q_u8(src + i);
+    const uint8x16_t product =
+        veorq_u8(vqtbl1q_u8(low_products, vandq_u8(x, nibble_mask)),
+                 vqtbl1q_u8(high_products, vshrq_n_u8(x, 4)));
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), product));
+  }
+#else
+  // ARMv7 only has 64-bit table lookups, over up to four 8 byte registers.
+  const uint8x8x2_t low_products = {
+      {vld1_u8(nibble_products), vld1_u8(nibble_products + 8)}};
+  const uint8x8x2_t high_products = {
+      {vld1_u8(nibble_products + 16), vld1_u8(nibble_products + 24)}};
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t x = vld1q_u8(src + i);
+    const uint8x16_t low = vandq_u8(x, nibble_mask);
+    const uint8x16_t high = vshrq_n_u8(x, 4);
+    const uint8x16_t product = vcombine_u8(
+        veor_u8(vtbl2_u8(low_products, vget_low_u8(low)),
+                vtbl2_u8(high_products, vget_low_u8(high))),
+        veor_u8(vtbl2_u8(low_products, vget_high_u8(low)),
+                vtbl2_u8(high_products, vget_high_u8(high))));
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), product));
+  }
+#endif
+  MulAddBytes(nibble_products, src + i, length - i, dst + i);
+}
+
+}  // namespace gf256
+}  // namespace webrtc
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "modules/rtp_rtcp/source/gf256_kernels.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+// Shift-and-add multiplication, independent of the tables.
+uint8_t SlowMul(uint8_t a, uint8_t b) {
+  int product = 0;
+  int x = a;
+  for (int bit = 0; bit < 8; ++bit) {
+    if (b & (1 << bit)) {
+      product ^= x;
+    }
+    x <<= 1;
+    if (x & 0x100) {
+      x ^= 0x11d;
+    }
+  }
+  return product;
+}
+
+std::vector<uint8_t> RandomBytes(Random& random, size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    byte = random.Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+TEST(Gf256Test, MulMatchesPolynomialMultiplication) {
+  for (int a = 0; a < 256; ++a) {
+    for (int b = 0; b < 256; ++b) {
+      ASSERT_EQ(Gf256Mul(a, b), SlowMul(a, b)) << a << " * " << b;
+    }
+  }
+}
+
+TEST(Gf256Test, InverseIsInverse) {
+  for (int a = 1; a < 256; ++a) {
+    EXPECT_EQ(Gf256Mul(a, Gf256Inverse(a)), 1) << a;
+  }
+}
+
+TEST(Gf256Test, MulAddMatchesMul) {
+  Random random(0x1234);
+  for (int coefficient : {0, 1, 2, 0x53, 0xff}) {
+    for (size_t length : {0, 1, 15, 16, 31, 32, 33, 100, 1200}) {
+      const std::vector<uint8_t> src = RandomBytes(random, length);
+      std::vector<uint8_t> dst = RandomBytes(random, length);
+      std::vector<uint8_t> expected = dst;
+      for (size_t i = 0; i < length; ++i) {
+        expected[i] ^= SlowMul(coefficient, src[i]);
+      }
+      Gf256MulAdd(coefficient, src.data(), length, dst.data());
+      EXPECT_THAT(dst, ElementsAreArray(expected))
+          << "coefficient " << coefficient << " length " << length;
+    }
+  }
+}
+
+TEST(Gf256Test, KernelsMatchByteLoop) {
+  std::vector<gf256::MulAddKernel> kernels = {&gf256::MulAddC};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2)) {
+    kernels.push_back(&gf256::MulAddAvx2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  kernels.push_back(&gf256::MulAddNeon);
+#endif
+  Random random(0x5678);
+  for (gf256::MulAddKernel kernel : kernels) {
+    for (int coefficient : {1, 0x8e, 0xc3}) {
+      uint8_t nibble_products[32];
+      for (int n = 0; n < 16; ++n) {
+        nibble_products[n] = SlowMul(coefficient, n);
+        nibble_products[16 + n] = SlowMul(coefficient, n << 4);
+      }
+      for (size_t length : {1, 16, 17, 32, 47, 64, 165}) {
+        const std::vector<uint8_t> src = RandomBytes(random, length);
+        std::vector<uint8_t> expected = RandomBytes(random, length);
+        std::vector<uint8_t> actual = expected;
+        gf256::MulAddBytes(nibble_products, src.data(), length,
+                           expected.data());
+        kernel(nibble_products, src.data(), length, actual.data());
+        EXPECT_THAT(actual, ElementsAreArray(expected))
+            << "coefficient " << coefficient << " length " << length;
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+
+#include <string.h>
+
+#include <utility>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "modules/rtp_rtcp/source/gf256.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace reed_solomon {
+
+uint8_t Coefficient(int repair_index, int source_index) {
+  RTC_DCHECK_GE(repair_index, 0);
+  RTC_DCHECK_LT(repair_index, kMaxRepairShards);
+  RTC_DCHECK_GE(source_index, 0);
+  RTC_DCHECK_LT(source_index, kMaxSourceShards);
+  // x_r has bit 6 set and y_j has not, so the sum is never zero.
+  return Gf256Inverse((kMaxSourceShards + repair_index) ^ source_index);
+}
+
+void Encode(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> sources,
+            int repair_index,
+            rtc::ArrayView<uint8_t> repair) {
+  RTC_DCHECK_LE(sources.size(), kMaxSourceShards);
+  memset(repair.data(), 0, repair.size());
+  for (size_t j = 0; j < sources.size(); ++j) {
+    RTC_DCHECK_LE(sources[j].size(), repair.size());
+    Gf256MulAdd(Coefficient(repair_index, j), sources[j].data(),
+                sources[j].size(), repair.data());
+  }
+}
+
+bool Decode(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> sources,
+            rtc::ArrayView<const int> missing,
+            rtc::ArrayView<const RepairShard> repairs,
+            rtc::ArrayView<const rtc::ArrayView<uint8_t>> recovered) {
+  RTC_DCHECK_EQ(missing.size(), recovered.size());
+  const size_t num_missing = missing.size();
+  if (num_missing == 0) {
+    return true;
+  }
+  if (repairs.size() < num_missing || sources.size() > kMaxSourceShards) {
+    return false;
+  }
+  const size_t shard_length = repairs[0].data.size();
+  std::vector<bool> is_missing(sources.size(), false);
+  for (int j : missing) {
+    if (j < 0 || static_cast<size_t>(j) >= sources.size() || is_missing[j]) {
+      return false;
+    }
+    is_missing[j] = true;
+  }
+  for (size_t a = 0; a < num_missing; ++a) {
+    if (repairs[a].index < 0 || repairs[a].index >= kMaxRepairShards ||
+        repairs[a].data.size() != shard_length ||
+        recovered[a].size() != shard_length) {
+      return false;
+    }
+  }
+  for (size_t j = 0; j < sources.size(); ++j) {
+    if (!is_missing[j] && sources[j].size() > shard_length) {
+      return false;
+    }
+  }
+
+  // With the received sources subtracted, repair shard a is a combination of
+  // the missing sources only:
+  //   residual[a] = sum over b of C(r_a, m_b) * source[m_b].
+  std::vector<std::vector<uint8_t>> residuals(num_missing);
+  for (size_t a = 0; a < num_missing; ++a) {
+    const int r = repairs[a].index;
+    residuals[a].assign(repairs[a].data.begin(), repairs[a].data.end());
+    for (size_t j = 0; j < sources.size(); ++j) {
+      if (!is_missing[j]) {
+        Gf256MulAdd(Coefficient(r, j), sources[j].data(), sources[j].size(),
+                    residuals[a].data());
+      }
+    }
+  }
+
+  // Invert that num_missing x num_missing Cauchy submatrix with Gauss-Jordan
+  // elimination; it is at most kMaxSourceShards wide.
+  const size_t n = num_missing;
+  absl::InlinedVector<uint8_t, 64> matrix(n * n);
+  absl::InlinedVector<uint8_t, 64> inverse(n * n, 0);
+  for (size_t a = 0; a < n; ++a) {
+    for (size_t b = 0; b < n; ++b) {
+      matrix[a * n + b] = Coefficient(repairs[a].index, missing[b]);
+    }
+    inverse[a * n + a] = 1;
+  }
+  for (size_t col = 0; col < n; ++col) {
+    size_t pivot = col;
+    while (pivot < n && matrix[pivot * n + col] == 0) {
+      ++pivot;
+    }
+    if (pivot == n) {
+      // Only possible if two repair shards have the same index.
+      return false;
+    }
+    if (pivot != col) {
+      for (size_t k = 0; k < n; ++k) {
+        std::swap(matrix[pivot * n + k], matrix[col * n + k]);
+        std::swap(inverse[pivot * n + k], inverse[col * n + k]);
+      }
+    }
+    const uint8_t scale = Gf256Inverse(matrix[col * n + col]);
+    for (size_t k = 0; k < n; ++k) {
+      matrix[col * n + k] = Gf256Mul(matrix[col * n + k], scale);
+      inverse[col * n + k] = Gf256Mul(inverse[col * n + k], scale);
+    }
+    for (size_t row = 0; row < n; ++row) {
+      const uint8_t factor = matrix[row * n + col];
+      if (row == col || factor == 0) {
+        continue;
+      }
+      for (size_t k = 0; k < n; ++k) {
+        matrix[row * n + k] ^= Gf256Mul(factor, matrix[col * n + k]);
+        inverse[row * n + k] ^= Gf256Mul(factor, inverse[col * n + k]);
+      }
+    }
+  }
+
+  for (size_t b = 0; b < n; ++b) {
+    memset(recovered[b].data(), 0, shard_length);
+    for (size_t a = 0; a < n; ++a) {
+      Gf256MulAdd(inverse[b * n + a], residuals[a].data(), shard_length,
+                  recovered[b].data());
+    }
+  }
+  return true;
+}
+
+}  // namespace reed_solomon
+}  // namespace webrtc
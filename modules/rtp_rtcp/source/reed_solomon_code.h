@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+namespace reed_solomon {
+
+// A systematic Reed-Solomon erasure code over GF(2^8), built from a Cauchy
+// matrix. A block of K source shards is sent as is, followed by any number of
+// repair shards; repair shard r is
+//
+//   repair[r] = sum over j of C(r, j) * source[j],  C(r, j) = 1 / (x_r + y_j)
+//
+// with x_r = kMaxSourceShards + r and y_j = j. Every square submatrix of a
+// Cauchy matrix is invertible, so any K of the shards recover all K source
+// shards: the code is maximum distance separable.
+//
+// Shards of a block can differ in length. Shorter source shards are treated
+// as zero padded, and repair shards are as long as the longest source shard.
+
+constexpr int kMaxSourceShards = 64;
+constexpr int kMaxRepairShards = 64;
+
+uint8_t Coefficient(int repair_index, int source_index);
+
+// Computes repair shard `repair_index` of `sources` into `repair`, which must
+// be at least as long as the longest source.
+void Encode(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> sources,
+            int repair_index,
+            rtc::ArrayView<uint8_t> repair);
+
+struct RepairShard {
+  int index = 0;
+  rtc::ArrayView<const uint8_t> data;
+};
+
+// Recovers the lost source shards of a block. `sources` holds every source
+// shard of the block in order, with the entries listed in `missing` ignored.
+// `repairs` must hold at least as many repair shards as there are missing
+// sources, all of the same length, and the first that many are used. The
+// recovered shards are written to `recovered`, one buffer of that length per
+// entry in `missing`. Returns false, and leaves `recovered` untouched, if
+// there are too few repair shards or they can not be used for this block.
+bool Decode(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> sources,
+            rtc::ArrayView<const int> missing,
+            rtc::ArrayView<const RepairShard> repairs,
+            rtc::ArrayView<const rtc::ArrayView<uint8_t>> recovered);
+
+}  // namespace reed_solomon
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_format.h"
+
+#include <string.h>
+
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+void WriteReedSolomonFecHeader(const ReedSolomonFecHeader& header,
+                               uint8_t* data) {
+  ByteWriter<uint32_t>::WriteBigEndian(&data[0], header.protected_ssrc);
+  ByteWriter<uint16_t>::WriteBigEndian(&data[4], header.base_sequence_number);
+  data[6] = header.repair_index;
+  data[7] = header.repair_count;
+  ByteWriter<uint64_t>::WriteBigEndian(&data[8], header.source_mask);
+}
+
+std::optional<ReedSolomonFecHeader> ParseReedSolomonFecHeader(
+    rtc::ArrayView<const uint8_t> payload) {
+  if (payload.size() <
+      kReedSolomonFecHeaderSize + kReedSolomonShardHeaderSize) {
+    return std::nullopt;
+  }
+  ReedSolomonFecHeader header;
+  header.protected_ssrc = ByteReader<uint32_t>::ReadBigEndian(&payload[0]);
+  header.base_sequence_number =
+      ByteReader<uint16_t>::ReadBigEndian(&payload[4]);
+  header.repair_index = payload[6];
+  header.repair_count = payload[7];
+  header.source_mask = ByteReader<uint64_t>::ReadBigEndian(&payload[8]);
+  // The first set bit is the base sequence number itself.
+  if ((header.source_mask >> 63) == 0 ||
+      header.repair_index >= header.repair_count ||
+      header.repair_count > reed_solomon::kMaxRepairShards) {
+    return std::nullopt;
+  }
+  return header;
+}
+
+size_t ReedSolomonSourceShardSize(size_t packet_size) {
+  RTC_DCHECK_GE(packet_size, kRtpHeaderSize);
+  return packet_size - kRtpHeaderSize + kReedSolomonShardHeaderSize;
+}
+
+void WriteReedSolomonSourceShard(rtc::ArrayView<const uint8_t> packet,
+                                 rtc::ArrayView<uint8_t> shard) {
+  RTC_DCHECK_EQ(shard.size(), ReedSolomonSourceShardSize(packet.size()));
+  ByteWriter<uint16_t>::WriteBigEndian(&shard[0],
+                                       packet.size() - kRtpHeaderSize);
+  shard[2] = packet[0] & 0x3f;
+  shard[3] = packet[1];
+  memcpy(&shard[4], &packet[4], 4);
+  memcpy(&shard[kReedSolomonShardHeaderSize], &packet[kRtpHeaderSize],
+         packet.size() - kRtpHeaderSize);
+}
+
+rtc::CopyOnWriteBuffer ReadReedSolomonSourceShard(
+    rtc::ArrayView<const uint8_t> shard,
+    uint32_t ssrc,
+    uint16_t sequence_number) {
+  if (shard.size() < kReedSolomonShardHeaderSize) {
+    return rtc::CopyOnWriteBuffer();
+  }
+  const size_t length = ByteReader<uint16_t>::ReadBigEndian(&shard[0]);
+  if (kReedSolomonShardHeaderSize + length > shard.size()) {
+    return rtc::CopyOnWriteBuffer();
+  }
+  rtc::CopyOnWriteBuffer packet(kRtpHeaderSize + length);
+  uint8_t* data = packet.MutableData();
+  data[0] = 0x80 | (shard[2] & 0x3f);
+  data[1] = shard[3];
+  ByteWriter<uint16_t>::WriteBigEndian(&data[2], sequence_number);
+  memcpy(&data[4], &shard[4], 4);
+  ByteWriter<uint32_t>::WriteBigEndian(&data[8], ssrc);
+  memcpy(&data[kRtpHeaderSize], &shard[kReedSolomonShardHeaderSize], length);
+  return packet;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_FORMAT_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_FORMAT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+
+#include "api/array_view.h"
+#include "rtc_base/copy_on_write_buffer.h"
+
+namespace webrtc {
+
+// Packet format of the Reed-Solomon FEC scheme, see reed_solomon_code.h for
+// the code itself. Like FlexFEC, repair packets are sent on an SSRC of their
+// own. Their RTP payload is this header followed by one repair shard:
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                     protected media SSRC                      |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |     base sequence number      | repair index  | repair count  |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |                                                               |
+//   +                          source mask                          +
+//   |                                                               |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//
+// Bit i of the source mask, counting from the most significant one, is set if
+// media packet base sequence number + i belongs to the block. Source shard j
+// is the packet of the j:th set bit. Repair count is the number of repair
+// packets sent for the block.
+//
+// A source shard is the media packet with the RTP header fields that follow
+// from the block (version, sequence number and SSRC) replaced by the length
+// of what follows the fixed header:
+//
+//   | length (16) | P/X/CC (8) | M/PT (8) | timestamp (32) | packet[12:] |
+
+constexpr size_t kReedSolomonFecHeaderSize = 16;
+constexpr size_t kReedSolomonShardHeaderSize = 8;
+
+struct ReedSolomonFecHeader {
+  uint32_t protected_ssrc = 0;
+  uint16_t base_sequence_number = 0;
+  uint8_t repair_index = 0;
+  uint8_t repair_count = 0;
+  uint64_t source_mask = 0;
+};
+
+void WriteReedSolomonFecHeader(const ReedSolomonFecHeader& header,
+                               uint8_t* data);
+
+// Parses the header at the start of a repair packet payload. Returns nullopt
+// if the payload is too short or the header is not valid.
+std::optional<ReedSolomonFecHeader> ParseReedSolomonFecHeader(
+    rtc::ArrayView<const uint8_t> payload);
+
+// Size of the source shard of a media packet of `packet_size` bytes.
+size_t ReedSolomonSourceShardSize(size_t packet_size);
+
+// Writes the source shard of the RTP packet `packet` to `shard`, which must be
+// ReedSolomonSourceShardSize(packet.size()) bytes.
+void WriteReedSolomonSourceShard(rtc::ArrayView<const uint8_t> packet,
+                                 rtc::ArrayView<uint8_t> shard);
+
+// Rebuilds the media packet from its, possibly zero padded, source shard.
+// Returns an empty buffer if the shard is not consistent.
+rtc::CopyOnWriteBuffer ReadReedSolomonSourceShard(
+    rtc::ArrayView<const uint8_t> shard,
+    uint32_t ssrc,
+    uint16_t sequence_number);
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_FORMAT_H_
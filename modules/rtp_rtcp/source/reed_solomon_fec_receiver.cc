@@ -0,0 +1,239 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/reed_solomon_fec_receiver.h"
+
+#include <iterator>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "api/array_view.h"
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_format.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Media packets kept for recovery. A block spans at most
+// reed_solomon::kMaxSourceShards sequence numbers, and its repair packets
+// follow its last media packet, so this leaves room for reordering and for
+// repair packets delayed behind a few blocks of media.
+constexpr size_t kMaxStoredSourceShards = 4 * reed_solomon::kMaxSourceShards;
+
+// Blocks waiting for more media or repair packets.
+constexpr size_t kMaxPendingBlocks = 16;
+
+// How often to log the recovered packets to the text log.
+constexpr TimeDelta kPacketLogInterval = TimeDelta::Seconds(10);
+
+}  // namespace
+
+ReedSolomonFecReceiver::ReedSolomonFecReceiver(
+    Clock* clock,
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    RecoveredPacketReceiver* recovered_packet_receiver)
+    : ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      recovered_packet_receiver_(recovered_packet_receiver),
+      clock_(clock) {
+  // It's OK to create this object on a different thread/task queue than
+  // the one used during main operation.
+  sequence_checker_.Detach();
+}
+
+ReedSolomonFecReceiver::~ReedSolomonFecReceiver() = default;
+
+void ReedSolomonFecReceiver::OnRtpPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  // Packets recovered here come back through the callback; see
+  // FlexfecReceiver::OnRtpPacket.
+  if (packet.recovered()) {
+    return;
+  }
+  if (packet.Ssrc() == ssrc_) {
+    AddRepairPacket(packet);
+  } else if (packet.Ssrc() == protected_media_ssrc_) {
+    AddMediaPacket(packet);
+  }
+}
+
+FecPacketCounter ReedSolomonFecReceiver::GetPacketCounter() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return packet_counter_;
+}
+
+void ReedSolomonFecReceiver::AddMediaPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_GE(packet.size(), kRtpHeaderSize);
+  ++packet_counter_.num_packets;
+  extensions_ = packet.extension_manager();
+  const int64_t sequence_number = unwrapper_.Unwrap(packet.SequenceNumber());
+  if (sequence_number < first_kept_sequence_number_ ||
+      source_shards_.count(sequence_number) > 0) {
+    return;
+  }
+  // The sender protects the packet before the pacer writes the mutable
+  // extensions, so they are zeroed here as for FlexFEC.
+  RtpPacketReceived packet_copy(packet);
+  packet_copy.ZeroMutableExtensions();
+  std::vector<uint8_t> shard(ReedSolomonSourceShardSize(packet_copy.size()));
+  WriteReedSolomonSourceShard(packet_copy, shard);
+  source_shards_.emplace(sequence_number, std::move(shard));
+  while (source_shards_.size() > kMaxStoredSourceShards) {
+    first_kept_sequence_number_ = source_shards_.begin()->first + 1;
+    source_shards_.erase(source_shards_.begin());
+  }
+
+  for (auto it = blocks_.begin(); it != blocks_.end();) {
+    const int64_t offset = sequence_number - it->base_sequence_number;
+    const bool in_block =
+        offset >= 0 && offset < reed_solomon::kMaxSourceShards &&
+        (it->source_mask >> (63 - offset)) & 1;
+    if (in_block && MaybeRecover(*it)) {
+      it = blocks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ReedSolomonFecReceiver::AddRepairPacket(const RtpPacketReceived& packet) {
+  std::optional<ReedSolomonFecHeader> header =
+      ParseReedSolomonFecHeader(packet.payload());
+  if (!header || header->protected_ssrc != protected_media_ssrc_) {
+    RTC_LOG(LS_WARNING) << "Invalid Reed-Solomon FEC packet, discarding.";
+    return;
+  }
+  ++packet_counter_.num_packets;
+  ++packet_counter_.num_fec_packets;
+  rtc::CopyOnWriteBuffer shard = packet.Buffer().Slice(
+      packet.headers_size() + kReedSolomonFecHeaderSize,
+      packet.payload_size() - kReedSolomonFecHeaderSize);
+
+  const int64_t base_sequence_number =
+      unwrapper_.PeekUnwrap(header->base_sequence_number);
+  auto it = absl::c_find_if(blocks_, [&](const Block& block) {
+    return block.base_sequence_number == base_sequence_number &&
+           block.source_mask == header->source_mask;
+  });
+  if (it == blocks_.end()) {
+    blocks_.push_back({.base_sequence_number = base_sequence_number,
+                       .source_mask = header->source_mask});
+    if (blocks_.size() > kMaxPendingBlocks) {
+      blocks_.pop_front();
+    }
+    it = std::prev(blocks_.end());
+  }
+  for (const auto& [index, repair] : it->repairs) {
+    if (index == header->repair_index || repair.size() != shard.size()) {
+      // A duplicate, or not from the same block after all.
+      return;
+    }
+  }
+  it->repairs.emplace_back(header->repair_index, std::move(shard));
+  if (MaybeRecover(*it)) {
+    blocks_.erase(it);
+  }
+}
+
+bool ReedSolomonFecReceiver::MaybeRecover(const Block& block) {
+  if (block.base_sequence_number < first_kept_sequence_number_) {
+    // Can not tell the lost media packets of this block from the evicted.
+    return true;
+  }
+  std::vector<rtc::ArrayView<const uint8_t>> sources;
+  std::vector<int> missing;
+  std::vector<int64_t> missing_sequence_numbers;
+  for (int i = 0; i < reed_solomon::kMaxSourceShards; ++i) {
+    if (((block.source_mask >> (63 - i)) & 1) == 0) {
+      continue;
+    }
+    const int64_t sequence_number = block.base_sequence_number + i;
+    auto it = source_shards_.find(sequence_number);
+    if (it == source_shards_.end()) {
+      missing.push_back(sources.size());
+      missing_sequence_numbers.push_back(sequence_number);
+      sources.emplace_back();
+    } else {
+      sources.push_back(it->second);
+    }
+  }
+  if (missing.empty()) {
+    return true;
+  }
+  if (missing.size() > block.repairs.size()) {
+    return false;
+  }
+
+  const size_t shard_length = block.repairs[0].second.size();
+  std::vector<reed_solomon::RepairShard> repairs;
+  for (const auto& [index, repair] : block.repairs) {
+    repairs.push_back({.index = index, .data = repair});
+  }
+  std::vector<std::vector<uint8_t>> recovered_shards(
+      missing.size(), std::vector<uint8_t>(shard_length));
+  std::vector<rtc::ArrayView<uint8_t>> recovered;
+  for (std::vector<uint8_t>& shard : recovered_shards) {
+    recovered.push_back(shard);
+  }
+  if (!reed_solomon::Decode(sources, missing, repairs, recovered)) {
+    RTC_LOG(LS_WARNING) << "Failed to decode Reed-Solomon FEC block.";
+    return true;
+  }
+
+  for (size_t b = 0; b < recovered_shards.size(); ++b) {
+    rtc::CopyOnWriteBuffer packet = ReadReedSolomonSourceShard(
+        recovered_shards[b], protected_media_ssrc_,
+        static_cast<uint16_t>(missing_sequence_numbers[b]));
+    if (packet.empty()) {
+      continue;
+    }
+    std::vector<uint8_t>& shard = recovered_shards[b];
+    shard.resize(ReedSolomonSourceShardSize(packet.size()));
+    source_shards_.emplace(missing_sequence_numbers[b], std::move(shard));
+    OnRecovered(std::move(packet));
+  }
+  return true;
+}
+
+void ReedSolomonFecReceiver::OnRecovered(rtc::CopyOnWriteBuffer packet) {
+  RtpPacketReceived parsed_packet(&extensions_);
+  if (!parsed_packet.Parse(std::move(packet))) {
+    return;
+  }
+  ++packet_counter_.num_recovered_packets;
+  parsed_packet.set_recovered(true);
+  parsed_packet.set_payload_type_frequency(kVideoPayloadTypeFrequency);
+  recovered_packet_receiver_->OnRecoveredPacket(parsed_packet);
+
+  // Periodically log the recovered packets at LS_INFO.
+  Timestamp now = clock_->CurrentTime();
+  bool should_log_periodically =
+      now - last_recovered_packet_ > kPacketLogInterval;
+  if (RTC_LOG_CHECK_LEVEL(LS_VERBOSE) || should_log_periodically) {
+    rtc::LoggingSeverity level =
+        should_log_periodically ? rtc::LS_INFO : rtc::LS_VERBOSE;
+    RTC_LOG_V(level) << "Recovered media packet with SSRC: "
+                     << parsed_packet.Ssrc() << " seq "
+                     << parsed_packet.SequenceNumber()
+                     << " from Reed-Solomon FEC stream with SSRC: " << ssrc_;
+    if (should_log_periodically) {
+      last_recovered_packet_ = now;
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,253 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "api/environment/environment.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_format.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+// Let first sequence number be in the first half of the interval.
+constexpr uint16_t kMaxInitRtpSeqNumber = 0x7fff;
+
+// Same clock as the protected video stream, see FlexfecSender.
+constexpr int kMsToRtpTimestamp = kVideoPayloadTypeFrequency / 1000;
+
+// How often to log the generated FEC packets to the text log.
+constexpr TimeDelta kPacketLogInterval = TimeDelta::Seconds(10);
+
+// The BWE and MID extensions, as for FlexFEC.
+RtpHeaderExtensionMap RegisterSupportedExtensions(
+    const std::vector<RtpExtension>& rtp_header_extensions) {
+  RtpHeaderExtensionMap map;
+  for (const auto& extension : rtp_header_extensions) {
+    if (extension.uri == TransportSequenceNumber::Uri()) {
+      map.Register<TransportSequenceNumber>(extension.id);
+    } else if (extension.uri == AbsoluteSendTime::Uri()) {
+      map.Register<AbsoluteSendTime>(extension.id);
+    } else if (extension.uri == TransmissionOffset::Uri()) {
+      map.Register<TransmissionOffset>(extension.id);
+    } else if (extension.uri == RtpMid::Uri()) {
+      map.Register<RtpMid>(extension.id);
+    }
+  }
+  return map;
+}
+
+// Number of repair packets for `num_media_packets` at `fec_rate` (Q8), as
+// ForwardErrorCorrection::NumFecPackets() rounds it.
+int NumRepairPackets(int num_media_packets, int fec_rate) {
+  int num_repair_packets = (num_media_packets * fec_rate + (1 << 7)) >> 8;
+  if (fec_rate > 0 && num_repair_packets == 0) {
+    num_repair_packets = 1;
+  }
+  return std::min(num_repair_packets, reed_solomon::kMaxRepairShards);
+}
+
+}  // namespace
+
+ReedSolomonFecSender::ReedSolomonFecSender(
+    const Environment& env,
+    int payload_type,
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    absl::string_view mid,
+    const std::vector<RtpExtension>& rtp_header_extensions,
+    rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+    const RtpState* rtp_state)
+    : env_(env),
+      random_(env_.clock().TimeInMicroseconds()),
+      payload_type_(payload_type),
+      timestamp_offset_(rtp_state ? rtp_state->start_timestamp
+                                  : random_.Rand<uint32_t>()),
+      ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      mid_(mid),
+      rtp_header_extension_map_(
+          RegisterSupportedExtensions(rtp_header_extensions)),
+      header_extensions_size_(
+          RtpHeaderExtensionSize(extension_sizes, rtp_header_extension_map_)),
+      seq_num_(rtp_state ? rtp_state->sequence_number
+                         : random_.Rand(1, kMaxInitRtpSeqNumber)),
+      fec_bitrate_(/*max_window_size=*/TimeDelta::Seconds(1)) {
+  RTC_DCHECK_GE(payload_type, 0);
+  RTC_DCHECK_LE(payload_type, 127);
+}
+
+ReedSolomonFecSender::~ReedSolomonFecSender() = default;
+
+// A repair packet is as long as the longest media packet of its block plus
+// the header extensions and the FEC and shard headers; the fixed RTP header
+// is in both.
+size_t ReedSolomonFecSender::MaxPacketOverhead() const {
+  return header_extensions_size_ + kReedSolomonFecHeaderSize +
+         kReedSolomonShardHeaderSize;
+}
+
+DataRate ReedSolomonFecSender::CurrentFecRate() const {
+  MutexLock lock(&mutex_);
+  return fec_bitrate_.Rate(env_.clock().CurrentTime())
+      .value_or(DataRate::Zero());
+}
+
+void ReedSolomonFecSender::SetProtectionParameters(
+    const FecProtectionParams& delta_params,
+    const FecProtectionParams& key_params) {
+  RTC_DCHECK_GE(delta_params.fec_rate, 0);
+  RTC_DCHECK_LE(delta_params.fec_rate, 255);
+  RTC_DCHECK_GE(key_params.fec_rate, 0);
+  RTC_DCHECK_LE(key_params.fec_rate, 255);
+  delta_params_ = delta_params;
+  key_params_ = key_params;
+}
+
+void ReedSolomonFecSender::AddPacketAndGenerateFec(
+    const RtpPacketToSend& packet) {
+  RTC_DCHECK_EQ(packet.Ssrc(), protected_media_ssrc_);
+  const uint16_t sequence_number = packet.SequenceNumber();
+  // The source mask covers kMaxSourceShards sequence numbers from the first
+  // packet of the block.
+  if (!source_shards_.empty() &&
+      static_cast<uint16_t>(sequence_number - base_sequence_number_) >=
+          reed_solomon::kMaxSourceShards) {
+    CloseBlock();
+  }
+  if (source_shards_.empty()) {
+    base_sequence_number_ = sequence_number;
+  }
+  source_mask_ |=
+      uint64_t{1} << (63 - static_cast<uint16_t>(sequence_number -
+                                                 base_sequence_number_));
+  source_shards_.emplace_back(ReedSolomonSourceShardSize(packet.size()));
+  WriteReedSolomonSourceShard(packet, source_shards_.back());
+  if (packet.is_key_frame()) {
+    block_contains_key_frame_ = true;
+  }
+  if (packet.Marker()) {
+    ++num_protected_frames_;
+  }
+
+  if (source_shards_.size() == reed_solomon::kMaxSourceShards ||
+      (packet.Marker() &&
+       num_protected_frames_ >= CurrentParams().max_fec_frames)) {
+    CloseBlock();
+  }
+}
+
+const FecProtectionParams& ReedSolomonFecSender::CurrentParams() const {
+  return block_contains_key_frame_ ? key_params_ : delta_params_;
+}
+
+void ReedSolomonFecSender::CloseBlock() {
+  const int num_repair_packets =
+      NumRepairPackets(source_shards_.size(), CurrentParams().fec_rate);
+  size_t shard_length = 0;
+  std::vector<rtc::ArrayView<const uint8_t>> sources;
+  sources.reserve(source_shards_.size());
+  for (const std::vector<uint8_t>& shard : source_shards_) {
+    shard_length = std::max(shard_length, shard.size());
+    sources.push_back(shard);
+  }
+
+  ReedSolomonFecHeader header;
+  header.protected_ssrc = protected_media_ssrc_;
+  header.base_sequence_number = base_sequence_number_;
+  header.repair_count = num_repair_packets;
+  header.source_mask = source_mask_;
+  for (int r = 0; r < num_repair_packets; ++r) {
+    auto fec_packet =
+        std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_);
+    fec_packet->set_packet_type(RtpPacketMediaType::kForwardErrorCorrection);
+    fec_packet->set_allow_retransmission(false);
+
+    // RTP header.
+    fec_packet->SetMarker(false);
+    fec_packet->SetPayloadType(payload_type_);
+    fec_packet->SetSequenceNumber(seq_num_++);
+    fec_packet->SetTimestamp(
+        timestamp_offset_ +
+        static_cast<uint32_t>(kMsToRtpTimestamp *
+                              env_.clock().TimeInMilliseconds()));
+    // Set "capture time" so that the TransmissionOffset header extension
+    // can be set by the RTPSender.
+    fec_packet->set_capture_time(env_.clock().CurrentTime());
+    fec_packet->SetSsrc(ssrc_);
+    // Reserve extensions, if registered. These will be set by the RTPSender.
+    fec_packet->ReserveExtension<AbsoluteSendTime>();
+    fec_packet->ReserveExtension<TransmissionOffset>();
+    fec_packet->ReserveExtension<TransportSequenceNumber>();
+    if (!mid_.empty()) {
+      // This is a no-op if the MID header extension is not registered.
+      fec_packet->SetExtension<RtpMid>(mid_);
+    }
+
+    // RTP payload.
+    header.repair_index = r;
+    uint8_t* payload = fec_packet->AllocatePayload(kReedSolomonFecHeaderSize +
+                                                   shard_length);
+    WriteReedSolomonFecHeader(header, payload);
+    reed_solomon::Encode(
+        sources, r,
+        rtc::MakeArrayView(payload + kReedSolomonFecHeaderSize, shard_length));
+    generated_fec_packets_.push_back(std::move(fec_packet));
+  }
+
+  source_shards_.clear();
+  source_mask_ = 0;
+  num_protected_frames_ = 0;
+  block_contains_key_frame_ = false;
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>>
+ReedSolomonFecSender::GetFecPackets() {
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets;
+  fec_packets.swap(generated_fec_packets_);
+  size_t total_fec_data_bytes = 0;
+  for (const auto& fec_packet : fec_packets) {
+    total_fec_data_bytes += fec_packet->size();
+  }
+
+  Timestamp now = env_.clock().CurrentTime();
+  if (!fec_packets.empty() &&
+      now - last_generated_packet_ > kPacketLogInterval) {
+    RTC_LOG(LS_VERBOSE) << "Generated " << fec_packets.size()
+                        << " Reed-Solomon FEC packets with payload type: "
+                        << payload_type_ << " and SSRC: " << ssrc_ << ".";
+    last_generated_packet_ = now;
+  }
+
+  MutexLock lock(&mutex_);
+  fec_bitrate_.Update(total_fec_data_bytes, now);
+
+  return fec_packets;
+}
+
+std::optional<RtpState> ReedSolomonFecSender::GetRtpState() {
+  RtpState rtp_state;
+  rtp_state.sequence_number = seq_num_;
+  rtp_state.start_timestamp = timestamp_offset_;
+  return rtp_state;
+}
+
+}  // namespace webrtc
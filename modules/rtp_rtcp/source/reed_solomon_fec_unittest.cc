@@ -0,0 +1,327 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "api/array_view.h"
+#include "api/environment/environment.h"
+#include "api/environment/environment_factory.h"
+#include "api/rtp_parameters.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/include/recovered_packet_receiver.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_receiver.h"
+#include "modules/rtp_rtcp/include/reed_solomon_fec_sender.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_format.h"
+#include "modules/rtp_rtcp/source/rtp_header_extension_size.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::testing::SizeIs;
+
+constexpr int kFecPayloadType = 123;
+constexpr int kMediaPayloadType = 96;
+constexpr uint32_t kMediaSsrc = 1234;
+constexpr uint32_t kFecSsrc = 5678;
+const std::vector<RtpExtension> kNoRtpHeaderExtensions;
+const std::vector<RtpExtensionSize> kNoRtpHeaderExtensionSizes;
+
+std::vector<uint8_t> RandomBytes(Random& random, size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    byte = random.Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>> MakeFrame(Random& random,
+                                                        uint16_t first_seq,
+                                                        uint32_t timestamp,
+                                                        int num_packets) {
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  for (int i = 0; i < num_packets; ++i) {
+    auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+    packet->SetPayloadType(kMediaPayloadType);
+    packet->SetSequenceNumber(first_seq + i);
+    packet->SetTimestamp(timestamp);
+    packet->SetSsrc(kMediaSsrc);
+    packet->SetMarker(i == num_packets - 1);
+    const std::vector<uint8_t> payload =
+        RandomBytes(random, random.Rand(1, 1100));
+    memcpy(packet->AllocatePayload(payload.size()), payload.data(),
+           payload.size());
+    packets.push_back(std::move(packet));
+  }
+  return packets;
+}
+
+RtpPacketReceived Receive(const RtpPacketToSend& packet) {
+  RtpPacketReceived received;
+  EXPECT_TRUE(received.Parse(packet.Buffer()));
+  return received;
+}
+
+class RecordingRecoveredPacketReceiver : public RecoveredPacketReceiver {
+ public:
+  void OnRecoveredPacket(const RtpPacketReceived& packet) override {
+    EXPECT_TRUE(packet.recovered());
+    packets.push_back(packet.Buffer());
+  }
+
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+};
+
+class ReedSolomonFecTest : public ::testing::Test {
+ protected:
+  ReedSolomonFecTest()
+      : clock_(1),
+        env_(CreateEnvironment(&clock_)),
+        random_(0x1234),
+        sender_(env_,
+                kFecPayloadType,
+                kFecSsrc,
+                kMediaSsrc,
+                /*mid=*/"",
+                kNoRtpHeaderExtensions,
+                kNoRtpHeaderExtensionSizes,
+                /*rtp_state=*/nullptr),
+        receiver_(&clock_, kFecSsrc, kMediaSsrc, &recovered_) {}
+
+  void SetFecRate(int fec_rate) {
+    FecProtectionParams params;
+    params.fec_rate = fec_rate;
+    params.max_fec_frames = 1;
+    sender_.SetProtectionParameters(params, params);
+  }
+
+  // Protects `media`, returning the repair packets.
+  std::vector<std::unique_ptr<RtpPacketToSend>> Protect(
+      const std::vector<std::unique_ptr<RtpPacketToSend>>& media) {
+    std::vector<std::unique_ptr<RtpPacketToSend>> repair;
+    for (const auto& packet : media) {
+      sender_.AddPacketAndGenerateFec(*packet);
+      for (auto& fec_packet : sender_.GetFecPackets()) {
+        repair.push_back(std::move(fec_packet));
+      }
+    }
+    return repair;
+  }
+
+  SimulatedClock clock_;
+  const Environment env_;
+  Random random_;
+  ReedSolomonFecSender sender_;
+  RecordingRecoveredPacketReceiver recovered_;
+  ReedSolomonFecReceiver receiver_;
+};
+
+TEST(ReedSolomonCodeTest, AnySourcesAndRepairsAsManyAsTheBlockRecover) {
+  constexpr int kNumSources = 5;
+  constexpr int kNumRepairs = 3;
+  Random random(0x5678);
+  std::vector<std::vector<uint8_t>> sources;
+  size_t shard_length = 0;
+  for (int j = 0; j < kNumSources; ++j) {
+    sources.push_back(RandomBytes(random, random.Rand(1, 300)));
+    shard_length = std::max(shard_length, sources.back().size());
+  }
+  std::vector<rtc::ArrayView<const uint8_t>> source_views(sources.begin(),
+                                                          sources.end());
+  std::vector<std::vector<uint8_t>> repairs(
+      kNumRepairs, std::vector<uint8_t>(shard_length));
+  for (int r = 0; r < kNumRepairs; ++r) {
+    reed_solomon::Encode(source_views, r, repairs[r]);
+  }
+
+  // Every way of losing up to kNumRepairs of the kNumSources + kNumRepairs
+  // shards.
+  for (int lost = 0; lost < (1 << (kNumSources + kNumRepairs)); ++lost) {
+    if (absl::popcount(static_cast<unsigned>(lost)) > kNumRepairs) {
+      continue;
+    }
+    std::vector<int> missing;
+    for (int j = 0; j < kNumSources; ++j) {
+      if (lost & (1 << j)) {
+        missing.push_back(j);
+      }
+    }
+    std::vector<reed_solomon::RepairShard> received_repairs;
+    for (int r = 0; r < kNumRepairs; ++r) {
+      if (!(lost & (1 << (kNumSources + r)))) {
+        received_repairs.push_back({.index = r, .data = repairs[r]});
+      }
+    }
+    std::vector<std::vector<uint8_t>> recovered(
+        missing.size(), std::vector<uint8_t>(shard_length));
+    std::vector<rtc::ArrayView<uint8_t>> recovered_views(recovered.begin(),
+                                                         recovered.end());
+    ASSERT_TRUE(reed_solomon::Decode(source_views, missing, received_repairs,
+                                     recovered_views))
+        << "lost " << lost;
+    for (size_t b = 0; b < missing.size(); ++b) {
+      std::vector<uint8_t> expected = sources[missing[b]];
+      expected.resize(shard_length, 0);
+      EXPECT_THAT(recovered[b], ElementsAreArray(expected)) << "lost " << lost;
+    }
+  }
+}
+
+TEST(ReedSolomonCodeTest, DecodeFailsWithFewerRepairsThanLostSources) {
+  const std::vector<uint8_t> source(100, 1);
+  std::vector<uint8_t> repair(100);
+  std::vector<rtc::ArrayView<const uint8_t>> sources = {source, source};
+  reed_solomon::Encode(sources, 0, repair);
+  const std::vector<reed_solomon::RepairShard> repairs = {
+      {.index = 0, .data = repair}};
+  std::vector<uint8_t> recovered_0(100), recovered_1(100);
+  std::vector<rtc::ArrayView<uint8_t>> recovered = {recovered_0, recovered_1};
+  EXPECT_FALSE(reed_solomon::Decode(sources, std::vector<int>{0, 1}, repairs,
+                                    recovered));
+}
+
+TEST(ReedSolomonFecFormatTest, SourceShardRoundTrip) {
+  Random random(0x9abc);
+  RtpPacketToSend packet(nullptr);
+  packet.SetPayloadType(kMediaPayloadType);
+  packet.SetMarker(true);
+  packet.SetSequenceNumber(4711);
+  packet.SetTimestamp(0x12345678);
+  packet.SetSsrc(kMediaSsrc);
+  packet.SetCsrcs(std::vector<uint32_t>{1, 2});
+  const std::vector<uint8_t> payload = RandomBytes(random, 200);
+  memcpy(packet.AllocatePayload(payload.size()), payload.data(),
+         payload.size());
+
+  std::vector<uint8_t> shard(ReedSolomonSourceShardSize(packet.size()));
+  WriteReedSolomonSourceShard(packet, shard);
+  // Recovered shards are as long as the longest of their block.
+  shard.resize(shard.size() + 37, 0);
+  rtc::CopyOnWriteBuffer rebuilt =
+      ReadReedSolomonSourceShard(shard, kMediaSsrc, 4711);
+  EXPECT_EQ(rebuilt, packet.Buffer());
+}
+
+TEST_F(ReedSolomonFecTest, GeneratesRepairPacketsAtEndOfFrame) {
+  SetFecRate(103);  // ~40%, 4 repair packets for 10 media packets.
+  auto media = MakeFrame(random_, 1000, 90000, 10);
+  for (int i = 0; i < 9; ++i) {
+    sender_.AddPacketAndGenerateFec(*media[i]);
+    EXPECT_TRUE(sender_.GetFecPackets().empty());
+  }
+  sender_.AddPacketAndGenerateFec(*media[9]);
+  std::vector<std::unique_ptr<RtpPacketToSend>> repair =
+      sender_.GetFecPackets();
+  ASSERT_THAT(repair, SizeIs(4));
+  for (size_t r = 0; r < repair.size(); ++r) {
+    EXPECT_EQ(repair[r]->Ssrc(), kFecSsrc);
+    EXPECT_EQ(repair[r]->PayloadType(), kFecPayloadType);
+    EXPECT_FALSE(repair[r]->Marker());
+    std::optional<ReedSolomonFecHeader> header =
+        ParseReedSolomonFecHeader(repair[r]->payload());
+    ASSERT_TRUE(header);
+    EXPECT_EQ(header->protected_ssrc, kMediaSsrc);
+    EXPECT_EQ(header->base_sequence_number, 1000);
+    EXPECT_EQ(header->repair_index, r);
+    EXPECT_EQ(header->repair_count, 4);
+    EXPECT_EQ(header->source_mask, ~uint64_t{0} << 54);
+  }
+}
+
+TEST_F(ReedSolomonFecTest, RecoversBurstAsLongAsTheRepairPackets) {
+  SetFecRate(103);
+  auto media = MakeFrame(random_, 65530, 90000, 10);
+  auto repair = Protect(media);
+  ASSERT_THAT(repair, SizeIs(4));
+
+  // Lose four media packets in a row, across the sequence number wrap.
+  for (int i = 0; i < 10; ++i) {
+    if (i < 3 || i > 6) {
+      receiver_.OnRtpPacket(Receive(*media[i]));
+    }
+  }
+  EXPECT_TRUE(recovered_.packets.empty());
+  for (const auto& packet : repair) {
+    receiver_.OnRtpPacket(Receive(*packet));
+  }
+
+  ASSERT_THAT(recovered_.packets, SizeIs(4));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(recovered_.packets[i], media[3 + i]->Buffer());
+  }
+  EXPECT_EQ(receiver_.GetPacketCounter().num_recovered_packets, 4u);
+}
+
+TEST_F(ReedSolomonFecTest, RecoversOnceLateMediaPacketArrives) {
+  SetFecRate(52);  // ~20%, 2 repair packets for 10 media packets.
+  auto media = MakeFrame(random_, 200, 90000, 10);
+  auto repair = Protect(media);
+  ASSERT_THAT(repair, SizeIs(2));
+
+  // Three lost, one of them reordered behind the repair packets.
+  for (int i = 3; i < 10; ++i) {
+    receiver_.OnRtpPacket(Receive(*media[i]));
+  }
+  receiver_.OnRtpPacket(Receive(*repair[1]));
+  receiver_.OnRtpPacket(Receive(*repair[0]));
+  EXPECT_TRUE(recovered_.packets.empty());
+
+  receiver_.OnRtpPacket(Receive(*media[1]));
+  ASSERT_THAT(recovered_.packets, SizeIs(2));
+  EXPECT_EQ(recovered_.packets[0], media[0]->Buffer());
+  EXPECT_EQ(recovered_.packets[1], media[2]->Buffer());
+}
+
+TEST_F(ReedSolomonFecTest, RecoversFromRepairPacketsAlone) {
+  SetFecRate(255);
+  auto media = MakeFrame(random_, 300, 90000, 3);
+  auto repair = Protect(media);
+  ASSERT_THAT(repair, SizeIs(3));
+
+  for (const auto& packet : repair) {
+    receiver_.OnRtpPacket(Receive(*packet));
+  }
+  ASSERT_THAT(recovered_.packets, SizeIs(3));
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(recovered_.packets[i], media[i]->Buffer());
+  }
+}
+
+TEST_F(ReedSolomonFecTest, DoesNotRecoverReceivedPackets) {
+  SetFecRate(103);
+  auto media = MakeFrame(random_, 400, 90000, 10);
+  auto repair = Protect(media);
+  for (const auto& packet : media) {
+    receiver_.OnRtpPacket(Receive(*packet));
+  }
+  for (const auto& packet : repair) {
+    receiver_.OnRtpPacket(Receive(*packet));
+  }
+  EXPECT_TRUE(recovered_.packets.empty());
+  EXPECT_EQ(receiver_.GetPacketCounter().num_fec_packets, repair.size());
+}
+
+}  // namespace
+}  // namespace webrtc
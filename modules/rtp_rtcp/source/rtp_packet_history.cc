@@ -28,24 +28,35 @@ namespace {
 
 constexpr size_t kOldPayloadPaddingSizeHysteresis = 100;
 constexpr uint16_t kMaxOldPayloadPaddingSequenceNumber = 1 << 13;
+// Smallest ring allocated when storage is enabled.
+constexpr size_t kMinRingSize = 64;
 
-}  // namespace
+size_t RingSizeFor(size_t span) {
+  size_t size = kMinRingSize;
+  while (size < span) {
+    size *= 2;
+  }
+  return size;
+}
 
-RtpPacketHistory::StoredPacket::StoredPacket(
-    std::unique_ptr<RtpPacketToSend> packet,
-    Timestamp send_time,
-    uint64_t insert_order)
-    : packet_(std::move(packet)),
-      pending_transmission_(false),
-      send_time_(send_time),
-      insert_order_(insert_order),
-      times_retransmitted_(0) {}
+}  // namespace
 
+RtpPacketHistory::StoredPacket::StoredPacket() = default;
 RtpPacketHistory::StoredPacket::StoredPacket(StoredPacket&&) = default;
 RtpPacketHistory::StoredPacket& RtpPacketHistory::StoredPacket::operator=(
     RtpPacketHistory::StoredPacket&&) = default;
 RtpPacketHistory::StoredPacket::~StoredPacket() = default;
 
+void RtpPacketHistory::StoredPacket::Store(RtpPacketToSend&& packet,
+                                           Timestamp send_time,
+                                           uint64_t insert_order) {
+  packet_.emplace(std::move(packet));
+  pending_transmission_ = false;
+  send_time_ = send_time;
+  insert_order_ = insert_order;
+  times_retransmitted_ = 0;
+}
+
 void RtpPacketHistory::StoredPacket::IncrementTimesRetransmitted() {
   ++times_retransmitted_;
 }
@@ -57,6 +68,8 @@ RtpPacketHistory::RtpPacketHistory(const Environment& env,
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_(TimeDelta::MinusInfinity()),
+      first_sequence_number_(0),
+      history_span_(0),
       packets_inserted_(0) {}
 
 RtpPacketHistory::~RtpPacketHistory() {}
@@ -71,6 +84,11 @@ void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
   Reset();
   mode_ = mode;
   number_to_store_ = std::min(kMaxCapacity, number_to_store);
+  if (mode_ == StorageMode::kDisabled) {
+    packet_history_ = std::vector<StoredPacket>();
+  } else {
+    packet_history_ = std::vector<StoredPacket>(RingSizeFor(number_to_store_));
+  }
 }
 
 RtpPacketHistory::StorageMode RtpPacketHistory::GetStorageMode() const {
@@ -104,41 +122,48 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
-  if (packet_index >= 0 &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+  if (packet_index >= 0 && static_cast<size_t>(packet_index) < history_span_ &&
+      GetSlot(packet_index).packet_.has_value()) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
     packet_index = GetPacketIndex(rtp_seq_no);
   }
 
-  // Packet to be inserted ahead of first packet, expand front.
-  for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front();
+  if (history_span_ == 0) {
+    first_sequence_number_ = rtp_seq_no;
+    packet_index = 0;
   }
-  // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back();
+  if (packet_index < 0) {
+    // Packet to be inserted ahead of first packet, expand front.
+    EnsureCapacity(history_span_ - packet_index);
+    first_sequence_number_ = rtp_seq_no;
+    history_span_ -= packet_index;
+    packet_index = 0;
+  } else if (static_cast<size_t>(packet_index) >= history_span_) {
+    // Packet to be inserted behind last packet, expand back.
+    EnsureCapacity(packet_index + 1);
+    history_span_ = packet_index + 1;
   }
 
-  RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
+  StoredPacket& stored_packet = GetSlot(packet_index);
+  RTC_DCHECK(!stored_packet.packet_.has_value());
+  stored_packet.Store(std::move(*packet), send_time, packets_inserted_++);
 
   if (padding_mode_ == PaddingMode::kRecentLargePacket) {
-    if ((!large_payload_packet_ ||
-         packet->payload_size() + kOldPayloadPaddingSizeHysteresis >
-             large_payload_packet_->payload_size() ||
-         IsNewerSequenceNumber(packet->SequenceNumber(),
-                               large_payload_packet_->SequenceNumber() +
+    const RtpPacketToSend* large_payload_packet = GetLargePayloadPacket();
+    if ((!large_payload_packet ||
+         stored_packet.packet_->payload_size() +
+                 kOldPayloadPaddingSizeHysteresis >
+             large_payload_packet->payload_size() ||
+         IsNewerSequenceNumber(rtp_seq_no,
+                               large_payload_packet->SequenceNumber() +
                                    kMaxOldPayloadPaddingSequenceNumber))) {
-      large_payload_packet_.emplace(*packet);
+      // Refer to the stored packet rather than copying it.
+      large_payload_sequence_number_ = rtp_seq_no;
+      large_payload_packet_ = std::nullopt;
     }
   }
-
-  packet_history_[packet_index] =
-      StoredPacket(std::move(packet), send_time, packets_inserted_++);
 }
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
@@ -208,12 +233,11 @@ bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
   }
 
   int packet_index = GetPacketIndex(sequence_number);
-  if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
+  if (packet_index < 0 || static_cast<size_t>(packet_index) >= history_span_) {
     return false;
   }
-  const StoredPacket& packet = packet_history_[packet_index];
-  if (packet.packet_ == nullptr) {
+  const StoredPacket& packet = GetSlot(packet_index);
+  if (!packet.packet_.has_value()) {
     return false;
   }
 
@@ -251,25 +275,17 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   if (mode_ == StorageMode::kDisabled) {
     return nullptr;
   }
-  if (padding_mode_ == PaddingMode::kRecentLargePacket &&
-      large_payload_packet_) {
-    return encapsulate(*large_payload_packet_);
-  }
-
-  StoredPacket* best_packet = nullptr;
-  if (!packet_history_.empty()) {
-    // Pick the last packet.
-    for (auto it = packet_history_.rbegin(); it != packet_history_.rend();
-         ++it) {
-      if (it->packet_ != nullptr) {
-        best_packet = &(*it);
-        break;
-      }
+  if (padding_mode_ == PaddingMode::kRecentLargePacket) {
+    if (const RtpPacketToSend* large_payload_packet = GetLargePayloadPacket()) {
+      return encapsulate(*large_payload_packet);
     }
   }
-  if (best_packet == nullptr) {
+
+  if (history_span_ == 0) {
     return nullptr;
   }
+  // Pick the last packet, the end of the span is always populated.
+  StoredPacket* best_packet = &GetSlot(history_span_ - 1);
 
   if (best_packet->pending_transmission_) {
     // Because PacedSender releases it's lock when it calls
@@ -296,7 +312,7 @@ void RtpPacketHistory::CullAcknowledgedPackets(
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
     if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
+        static_cast<size_t>(packet_index) >= history_span_) {
       continue;
     }
     RemovePacket(packet_index);
@@ -309,7 +325,11 @@ void RtpPacketHistory::Clear() {
 }
 
 void RtpPacketHistory::Reset() {
-  packet_history_.clear();
+  for (size_t i = 0; i < history_span_; ++i) {
+    GetSlot(i).packet_ = std::nullopt;
+  }
+  history_span_ = 0;
+  large_payload_sequence_number_ = std::nullopt;
   large_payload_packet_ = std::nullopt;
 }
 
@@ -319,15 +339,15 @@ void RtpPacketHistory::CullOldPackets() {
       rtt_.IsFinite()
           ? std::max(kMinPacketDurationRtt * rtt_, kMinPacketDuration)
           : kMinPacketDuration;
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (history_span_ > 0) {
+    if (history_span_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
       RemovePacket(0);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
+    const StoredPacket& stored_packet = GetSlot(0);
     if (stored_packet.pending_transmission_) {
       // Don't remove packets in the pacer queue, pending tranmission.
       return;
@@ -338,7 +358,7 @@ void RtpPacketHistory::CullOldPackets() {
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (history_span_ >= number_to_store_ ||
         stored_packet.send_time() +
                 (packet_duration * kPacketCullingDelayFactor) <=
             now) {
@@ -352,28 +372,40 @@ void RtpPacketHistory::CullOldPackets() {
   }
 }
 
-std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
-    int packet_index) {
-  // Move the packet out from the StoredPacket container.
-  std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+void RtpPacketHistory::RemovePacket(int packet_index) {
+  StoredPacket& stored_packet = GetSlot(packet_index);
+  if (!stored_packet.packet_.has_value()) {
+    return;
+  }
+  if (large_payload_sequence_number_ ==
+      stored_packet.packet_->SequenceNumber()) {
+    // Kept for padding even after it has been removed from the history.
+    large_payload_packet_.emplace(std::move(*stored_packet.packet_));
+    large_payload_sequence_number_ = std::nullopt;
+  }
+  stored_packet.packet_ = std::nullopt;
+
+  // Keep both ends of the span populated.
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+    while (history_span_ > 0 && !GetSlot(0).packet_.has_value()) {
+      ++first_sequence_number_;
+      --history_span_;
+    }
+  } else if (static_cast<size_t>(packet_index) == history_span_ - 1) {
+    while (history_span_ > 0 &&
+           !GetSlot(history_span_ - 1).packet_.has_value()) {
+      --history_span_;
     }
   }
-
-  return rtp_packet;
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (history_span_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  RTC_DCHECK(GetSlot(0).packet_.has_value());
+  int first_seq = first_sequence_number_;
   if (first_seq == sequence_number) {
     return 0;
   }
@@ -394,14 +426,54 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
   return packet_index;
 }
 
+RtpPacketHistory::StoredPacket& RtpPacketHistory::GetSlot(int packet_index) {
+  RTC_DCHECK(!packet_history_.empty());
+  const uint16_t sequence_number = first_sequence_number_ + packet_index;
+  return packet_history_[sequence_number & (packet_history_.size() - 1)];
+}
+
+const RtpPacketHistory::StoredPacket& RtpPacketHistory::GetSlot(
+    int packet_index) const {
+  RTC_DCHECK(!packet_history_.empty());
+  const uint16_t sequence_number = first_sequence_number_ + packet_index;
+  return packet_history_[sequence_number & (packet_history_.size() - 1)];
+}
+
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size() ||
-      packet_history_[index].packet_ == nullptr) {
+  if (index < 0 || static_cast<size_t>(index) >= history_span_ ||
+      !GetSlot(index).packet_.has_value()) {
     return nullptr;
   }
-  return &packet_history_[index];
+  return &GetSlot(index);
+}
+
+void RtpPacketHistory::EnsureCapacity(size_t span) {
+  if (span <= packet_history_.size()) {
+    return;
+  }
+  // Happens when packets stay in the history for longer than
+  // `number_to_store_` packets, e.g. because the RTT is high, or on a
+  // sequence number jump.
+  std::vector<StoredPacket> ring(RingSizeFor(span));
+  for (size_t i = 0; i < history_span_; ++i) {
+    const uint16_t sequence_number = first_sequence_number_ + i;
+    ring[sequence_number & (ring.size() - 1)] = std::move(GetSlot(i));
+  }
+  packet_history_ = std::move(ring);
+}
+
+const RtpPacketToSend* RtpPacketHistory::GetLargePayloadPacket() const {
+  if (large_payload_sequence_number_.has_value()) {
+    int index = GetPacketIndex(*large_payload_sequence_number_);
+    RTC_DCHECK(GetSlot(index).packet_.has_value());
+    return &*GetSlot(index).packet_;
+  }
+  if (large_payload_packet_.has_value()) {
+    return &*large_payload_packet_;
+  }
+  return nullptr;
 }
 
 }  // namespace webrtc
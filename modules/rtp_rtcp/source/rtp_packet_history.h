@@ -11,11 +11,8 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
-#include <map>
 #include <memory>
 #include <optional>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -124,16 +121,20 @@ class RtpPacketHistory {
   void Clear();
 
  private:
+  // A slot in the history ring. Slots are reused, so the packet is stored by
+  // value rather than as a separate heap allocation.
   class StoredPacket {
    public:
-    StoredPacket() = default;
-    StoredPacket(std::unique_ptr<RtpPacketToSend> packet,
-                 Timestamp send_time,
-                 uint64_t insert_order);
+    StoredPacket();
     StoredPacket(StoredPacket&&);
     StoredPacket& operator=(StoredPacket&&);
     ~StoredPacket();
 
+    // Takes over the contents of `packet` and resets the transmission state.
+    void Store(RtpPacketToSend&& packet,
+               Timestamp send_time,
+               uint64_t insert_order);
+
     uint64_t insert_order() const { return insert_order_; }
     size_t times_retransmitted() const { return times_retransmitted_; }
     void IncrementTimesRetransmitted();
@@ -142,21 +143,21 @@ class RtpPacketHistory {
     Timestamp send_time() const { return send_time_; }
     void set_send_time(Timestamp value) { send_time_ = value; }
 
-    // The actual packet.
-    std::unique_ptr<RtpPacketToSend> packet_;
+    // The actual packet, empty if the slot is unused.
+    std::optional<RtpPacketToSend> packet_;
 
     // True if the packet is currently in the pacer queue pending transmission.
-    bool pending_transmission_;
+    bool pending_transmission_ = false;
 
    private:
     Timestamp send_time_ = Timestamp::Zero();
 
     // Unique number per StoredPacket, incremented by one for each added
     // packet. Used to sort on insert order.
-    uint64_t insert_order_;
+    uint64_t insert_order_ = 0;
 
     // Number of times RE-transmitted, ie excluding the first transmission.
-    size_t times_retransmitted_;
+    size_t times_retransmitted_ = 0;
   };
 
   // Helper method to check if packet has too recently been sent.
@@ -165,13 +166,23 @@ class RtpPacketHistory {
   void Reset() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void CullOldPackets() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   // Removes the packet from the history, and context/mapping that has been
-  // stored. Returns the RTP packet instance contained within the StoredPacket.
-  std::unique_ptr<RtpPacketToSend> RemovePacket(int packet_index)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // stored. If it is the packet used for padding with
+  // PaddingMode::kRecentLargePacket, it is moved to `large_payload_packet_`.
+  void RemovePacket(int packet_index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the position of `sequence_number` relative to the first packet in
+  // the history. May be negative or beyond the end of the history.
   int GetPacketIndex(uint16_t sequence_number) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  StoredPacket& GetSlot(int packet_index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket& GetSlot(int packet_index) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   StoredPacket* GetStoredPacket(uint16_t sequence_number)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Grows the ring, if needed, so that `span` consecutive sequence numbers
+  // map to distinct slots.
+  void EnsureCapacity(size_t span) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const RtpPacketToSend* GetLargePayloadPacket() const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   Clock* const clock_;
   const PaddingMode padding_mode_;
@@ -180,17 +191,25 @@ class RtpPacketHistory {
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   TimeDelta rtt_ RTC_GUARDED_BY(lock_);
 
-  // Queue of stored packets, ordered by sequence number, with older packets in
-  // the front and new packets being added to the back. Note that there may be
-  // wrap-arounds so the back may have a lower sequence number.
-  // Packets may also be removed out-of-order, in which case there will be
-  // instances of StoredPacket with `packet_` set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // Ring of stored packets, indexed by sequence number modulo its size, which
+  // is a power of two. The history covers the `history_span_` sequence numbers
+  // starting at `first_sequence_number_`. Packets may be removed out-of-order,
+  // leaving unused slots inside the span, but the first and last slot of the
+  // span are always populated. Slots are allocated when storage is enabled and
+  // only reallocated when the span outgrows the ring, so storing a packet
+  // does not allocate.
+  std::vector<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  uint16_t first_sequence_number_ RTC_GUARDED_BY(lock_);
+  size_t history_span_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
 
+  // With PaddingMode::kRecentLargePacket, the sequence number of the padding
+  // packet while it is still in the history. Once it is removed from the
+  // history it is moved to `large_payload_packet_`, so the packet is only
+  // copied when it is sent as padding.
+  std::optional<uint16_t> large_payload_sequence_number_ RTC_GUARDED_BY(lock_);
   std::optional<RtpPacketToSend> large_payload_packet_ RTC_GUARDED_BY(lock_);
 };
 }  // namespace webrtc
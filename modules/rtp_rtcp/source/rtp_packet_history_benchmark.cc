@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/environment/environment.h"
+#include "api/environment/environment_factory.h"
+#include "api/units/time_delta.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/system/unused.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+
+// Video sender defaults: the history is sized for 600 packets and packets
+// are sent at about 1000 per second, so culling is exercised as well.
+constexpr size_t kNumberToStore = 600;
+constexpr size_t kPayloadSize = 1200;
+constexpr TimeDelta kPacketInterval = TimeDelta::Millis(1);
+
+RtpPacketToSend CreatePrototypePacket() {
+  RtpPacketToSend packet(nullptr);
+  packet.SetSsrc(0x1234);
+  packet.SetPayloadType(96);
+  packet.AllocatePayload(kPayloadSize);
+  packet.set_allow_retransmission(true);
+  return packet;
+}
+
+class HistoryFixture {
+ public:
+  explicit HistoryFixture(RtpPacketHistory::PaddingMode padding_mode)
+      : clock_(1'000'000),
+        env_(CreateEnvironment(&clock_)),
+        history_(env_, padding_mode),
+        prototype_(CreatePrototypePacket()) {
+    history_.SetStorePacketsStatus(
+        RtpPacketHistory::StorageMode::kStoreAndCull, kNumberToStore);
+  }
+
+  // Stores the next packet, the way RtpSenderEgress does once it is sent.
+  void PutNextPacket() {
+    auto packet = std::make_unique<RtpPacketToSend>(prototype_);
+    packet->SetSequenceNumber(next_sequence_number_++);
+    history_.PutRtpPacket(std::move(packet), clock_.CurrentTime());
+    clock_.AdvanceTime(kPacketInterval);
+  }
+
+  RtpPacketHistory& history() { return history_; }
+  uint16_t next_sequence_number() const { return next_sequence_number_; }
+
+ private:
+  SimulatedClock clock_;
+  const Environment env_;
+  RtpPacketHistory history_;
+  const RtpPacketToSend prototype_;
+  // Starts close to the wrap-around so that it is exercised too.
+  uint16_t next_sequence_number_ = 0xff00;
+};
+
+void BM_PutRtpPacket(benchmark::State& state) {
+  HistoryFixture fixture(
+      static_cast<RtpPacketHistory::PaddingMode>(state.range(0)));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    fixture.PutNextPacket();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetPacketAndMarkAsPending(benchmark::State& state) {
+  HistoryFixture fixture(RtpPacketHistory::PaddingMode::kDefault);
+  for (size_t i = 0; i < kNumberToStore; ++i) {
+    fixture.PutNextPacket();
+  }
+  const uint16_t first_sequence_number =
+      fixture.next_sequence_number() - kNumberToStore;
+  size_t i = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    // NACKs hit packets all over the history.
+    const uint16_t sequence_number =
+        first_sequence_number + (i++ * 7) % kNumberToStore;
+    std::unique_ptr<RtpPacketToSend> packet =
+        fixture.history().GetPacketAndMarkAsPending(sequence_number);
+    benchmark::DoNotOptimize(packet.get());
+    fixture.history().MarkPacketAsSent(sequence_number);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetPayloadPaddingPacket(benchmark::State& state) {
+  HistoryFixture fixture(
+      static_cast<RtpPacketHistory::PaddingMode>(state.range(0)));
+  for (size_t i = 0; i < kNumberToStore; ++i) {
+    fixture.PutNextPacket();
+  }
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    std::unique_ptr<RtpPacketToSend> packet =
+        fixture.history().GetPayloadPaddingPacket();
+    benchmark::DoNotOptimize(packet.get());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PutRtpPacket)
+    ->Arg(static_cast<int>(RtpPacketHistory::PaddingMode::kDefault))
+    ->Arg(static_cast<int>(RtpPacketHistory::PaddingMode::kRecentLargePacket));
+BENCHMARK(BM_GetPacketAndMarkAsPending);
+BENCHMARK(BM_GetPayloadPaddingPacket)
+    ->Arg(static_cast<int>(RtpPacketHistory::PaddingMode::kDefault))
+    ->Arg(static_cast<int>(RtpPacketHistory::PaddingMode::kRecentLargePacket));
+
+}  // namespace
+}  // namespace webrtc
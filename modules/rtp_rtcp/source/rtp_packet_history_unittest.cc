@@ -578,6 +578,27 @@ TEST_P(RtpPacketHistoryTest, OutOfOrderInsertRemoval) {
   }
 }
 
+TEST_P(RtpPacketHistoryTest, KeepsPacketsWhenHistoryGrowsBeyondNumberToStore) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+
+  // Packets are kept for at least one second, so all of these stay in the
+  // history even though it is configured for ten packets.
+  const size_t kNumPackets = 1000;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.CurrentTime());
+  }
+  // A packet inserted ahead of the first one also grows the history.
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum - 1)),
+                     fake_clock_.CurrentTime());
+
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + i)));
+  }
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum - 1)));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + kNumPackets)));
+}
+
 TEST_P(RtpPacketHistoryTest, UsesLastPacketAsPaddingWithDefaultMode) {
   if (GetParam() != RtpPacketHistory::PaddingMode::kDefault) {
     GTEST_SKIP() << "Default padding prioritization required for this test";
@@ -148,6 +148,11 @@ class RtpPacketToSend : public RtpPacket {
     transport_sequence_number_ = transport_sequence_number;
   }
 
+  // Indicates if the packet should be sent with the ECN codepoint ECT(1), as
+  // used by L4S, https://www.rfc-editor.org/rfc/rfc9331.html
+  void set_send_as_ect1() { send_as_ect1_ = true; }
+  bool send_as_ect1() const { return send_as_ect1_; }
+
  private:
   webrtc::Timestamp capture_time_ = webrtc::Timestamp::Zero();
   std::optional<RtpPacketMediaType> packet_type_;
@@ -161,6 +166,7 @@ class RtpPacketToSend : public RtpPacket {
   bool is_key_frame_ = false;
   bool fec_protect_packet_ = false;
   bool is_red_ = false;
+  bool send_as_ect1_ = false;
   std::optional<TimeDelta> time_in_send_queue_;
 };
 
@@ -38,6 +38,7 @@
 #include "modules/rtp_rtcp/source/rtp_packet_history.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "modules/rtp_rtcp/source/rtp_sequence_number_map.h"
+#include "modules/rtp_rtcp/source/sent_frame_timing_sink.h"
 #include "rtc_base/bitrate_tracker.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/copy_on_write_buffer.h"
@@ -187,6 +188,14 @@ void RtpSenderEgress::SendPacket(std::unique_ptr<RtpPacketToSend> packet,
             timestamp, packet->is_first_packet_of_frame(), packet->Marker()));
   }
 
+  if (packet->packet_type() == RtpPacketMediaType::kVideo &&
+      packet->Ssrc() == ssrc_ && packet->Marker()) {
+    if (SentFrameTimingSinkInterface* timing_sink = GetSentFrameTimingSink()) {
+      timing_sink->OnFramePacerExit(packet->Ssrc(), packet->Timestamp(),
+                                    now.ms());
+    }
+  }
+
   if (fec_generator_ && packet->fec_protect_packet()) {
     // This packet should be protected by FEC, add it to packet generator.
     RTC_DCHECK(fec_generator_);
@@ -306,6 +315,7 @@ void RtpSenderEgress::CompleteSendPacket(const Packet& compound_packet,
   }
   options.batchable = enable_send_packet_batching_ && !is_audio_;
   options.last_packet_in_batch = last_in_batch;
+  options.send_as_ect1 = packet->send_as_ect1();
   const bool send_success = SendPacketToNetwork(*packet, options, pacing_info);
 
   // Put packet in retransmission history or update pending status even if
@@ -56,6 +56,7 @@
 #include "modules/rtp_rtcp/source/rtp_sender_video_frame_transformer_delegate.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
 #include "modules/rtp_rtcp/source/rtp_video_layers_allocation_extension.h"
+#include "modules/rtp_rtcp/source/sent_frame_timing_sink.h"
 #include "modules/rtp_rtcp/source/video_fec_generator.h"
 #include "modules/video_coding/codecs/h264/include/h264_globals.h"
 #include "modules/video_coding/codecs/interface/common_constants.h"
@@ -820,10 +821,25 @@ bool RTPSenderVideo::SendEncodedImage(int payload_type,
         payload_type, codec_type, rtp_timestamp, encoded_image, video_header,
         expected_retransmission_time);
   }
-  return SendVideo(payload_type, codec_type, rtp_timestamp,
-                   encoded_image.CaptureTime(), encoded_image,
-                   encoded_image.size(), video_header,
-                   expected_retransmission_time, /*csrcs=*/{});
+  const bool sent = SendVideo(payload_type, codec_type, rtp_timestamp,
+                              encoded_image.CaptureTime(), encoded_image,
+                              encoded_image.size(), video_header,
+                              expected_retransmission_time, /*csrcs=*/{});
+  if (sent) {
+    ReportSentFrameTiming(CreateSentFrameTiming(rtp_timestamp, encoded_image));
+  }
+  return sent;
+}
+
+void RTPSenderVideo::ReportSentFrameTiming(SentFrameTiming timing) {
+  SentFrameTimingSinkInterface* timing_sink = GetSentFrameTimingSink();
+  if (!timing_sink) {
+    return;
+  }
+  timing.ssrc = rtp_sender_->SSRC();
+  // SendVideo() returns once the packets are queued in the pacer.
+  timing.packetization_finish_ms = clock_->CurrentTime().ms();
+  timing_sink->OnFramePacketized(timing);
 }
 
 DataRate RTPSenderVideo::PostEncodeOverhead() const {
@@ -136,6 +136,12 @@ class RTPSenderVideo : public RTPVideoFrameSenderInterface {
   void SetVideoLayersAllocationAfterTransformation(
       VideoLayersAllocation allocation) override;
 
+  // Completes `timing` with the SSRC and the packetization time and passes it
+  // to the sink installed with SetSentFrameTimingSink(), if any. Called after
+  // SendVideo(), by SendEncodedImage() or, for transformed frames, by the
+  // RTPSenderVideoFrameTransformerDelegate.
+  void ReportSentFrameTiming(SentFrameTiming timing) override;
+
   // Returns the current post encode overhead rate, in bps. Note that this is
   // the payload overhead, eg the VP8 payload headers and any other added
   // metadata added by transforms. It does not include the RTP headers or
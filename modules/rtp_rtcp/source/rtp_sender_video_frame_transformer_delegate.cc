@@ -33,6 +33,7 @@
 #include "api/video/video_layers_allocation.h"
 #include "api/video_codecs/video_codec.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/rtp_rtcp/source/sent_frame_timing_sink.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/synchronization/mutex.h"
 
@@ -66,6 +67,8 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
         timestamp_(rtp_timestamp),
         capture_time_(encoded_image.CaptureTime()),
         presentation_timestamp_(encoded_image.PresentationTimestamp()),
+        sent_frame_timing_(
+            CreateSentFrameTiming(rtp_timestamp, encoded_image)),
         expected_retransmission_time_(expected_retransmission_time),
         ssrc_(ssrc),
         csrcs_(csrcs) {
@@ -125,6 +128,13 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
     return expected_retransmission_time_;
   }
 
+  // The timing of the encoded frame, with the RTP timestamp it is sent with.
+  SentFrameTiming GetSentFrameTiming() const {
+    SentFrameTiming timing = sent_frame_timing_;
+    timing.rtp_timestamp = timestamp_;
+    return timing;
+  }
+
   Direction GetDirection() const override { return Direction::kSender; }
   std::string GetMimeType() const override {
     if (!codec_type_.has_value()) {
@@ -145,6 +155,7 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
   const Timestamp capture_time_;
   const std::optional<Timestamp> presentation_timestamp_;
   const TimeDelta expected_retransmission_time_;
+  const SentFrameTiming sent_frame_timing_;
 
   uint32_t ssrc_;
   std::vector<uint32_t> csrcs_;
@@ -177,11 +188,14 @@ bool RTPSenderVideoFrameTransformerDelegate::TransformFrame(
   {
     MutexLock lock(&sender_lock_);
     if (short_circuit_) {
-      sender_->SendVideo(payload_type, codec_type, rtp_timestamp,
-                         encoded_image.CaptureTime(),
-                         *encoded_image.GetEncodedData(), encoded_image.size(),
-                         video_header, expected_retransmission_time,
-                         /*csrcs=*/{});
+      if (sender_->SendVideo(payload_type, codec_type, rtp_timestamp,
+                             encoded_image.CaptureTime(),
+                             *encoded_image.GetEncodedData(),
+                             encoded_image.size(), video_header,
+                             expected_retransmission_time, /*csrcs=*/{})) {
+        sender_->ReportSentFrameTiming(
+            CreateSentFrameTiming(rtp_timestamp, encoded_image));
+      }
       return true;
     }
   }
@@ -222,15 +236,19 @@ void RTPSenderVideoFrameTransformerDelegate::SendVideo(
       TransformableFrameInterface::Direction::kSender) {
     auto* transformed_video_frame =
         static_cast<TransformableVideoSenderFrame*>(transformed_frame.get());
-    sender_->SendVideo(transformed_video_frame->GetPayloadType(),
-                       transformed_video_frame->GetCodecType(),
-                       transformed_video_frame->GetTimestamp(),
-                       transformed_video_frame->GetCaptureTime(),
-                       transformed_video_frame->GetData(),
-                       transformed_video_frame->GetPreTransformPayloadSize(),
-                       transformed_video_frame->GetHeader(),
-                       transformed_video_frame->GetExpectedRetransmissionTime(),
-                       transformed_video_frame->Metadata().GetCsrcs());
+    if (sender_->SendVideo(
+            transformed_video_frame->GetPayloadType(),
+            transformed_video_frame->GetCodecType(),
+            transformed_video_frame->GetTimestamp(),
+            transformed_video_frame->GetCaptureTime(),
+            transformed_video_frame->GetData(),
+            transformed_video_frame->GetPreTransformPayloadSize(),
+            transformed_video_frame->GetHeader(),
+            transformed_video_frame->GetExpectedRetransmissionTime(),
+            transformed_video_frame->Metadata().GetCsrcs())) {
+      sender_->ReportSentFrameTiming(
+          transformed_video_frame->GetSentFrameTiming());
+    }
   } else {
     auto* transformed_video_frame =
         static_cast<TransformableVideoFrameInterface*>(transformed_frame.get());
@@ -24,6 +24,7 @@
 #include "api/video/encoded_image.h"
 #include "api/video/video_layers_allocation.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/rtp_rtcp/source/sent_frame_timing_sink.h"
 #include "rtc_base/synchronization/mutex.h"
 
 namespace webrtc {
@@ -46,6 +47,8 @@ class RTPVideoFrameSenderInterface {
       const FrameDependencyStructure* video_structure) = 0;
   virtual void SetVideoLayersAllocationAfterTransformation(
       VideoLayersAllocation allocation) = 0;
+  // Reports a frame sent by SendVideo() to the sent frame timing sink, if any.
+  virtual void ReportSentFrameTiming(SentFrameTiming timing) = 0;
 
  protected:
   virtual ~RTPVideoFrameSenderInterface() = default;
@@ -51,6 +51,7 @@ class MockRTPVideoFrameSenderInterface : public RTPVideoFrameSenderInterface {
               SetVideoLayersAllocationAfterTransformation,
               (VideoLayersAllocation allocation),
               (override));
+  MOCK_METHOD(void, ReportSentFrameTiming, (SentFrameTiming timing), (override));
 };
 
 class RtpSenderVideoFrameTransformerDelegateTest : public ::testing::Test {
@@ -46,6 +46,7 @@
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_impl2.h"
 #include "modules/rtp_rtcp/source/rtp_video_layers_allocation_extension.h"
+#include "modules/rtp_rtcp/source/sent_frame_timing_sink.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -1518,6 +1519,78 @@ TEST_F(RtpSenderVideoTest, SendRawVideo) {
   EXPECT_THAT(sent_payload, ElementsAreArray(kPayload));
 }
 
+class RecordingSentFrameTimingSink : public SentFrameTimingSinkInterface {
+ public:
+  void OnFramePacketized(const SentFrameTiming& timing) override {
+    timings_.push_back(timing);
+  }
+  void OnFramePacerExit(uint32_t ssrc,
+                        uint32_t rtp_timestamp,
+                        int64_t pacer_exit_ms) override {
+    pacer_exits_.push_back({ssrc, rtp_timestamp, pacer_exit_ms});
+  }
+
+  struct PacerExit {
+    uint32_t ssrc;
+    uint32_t rtp_timestamp;
+    int64_t pacer_exit_ms;
+  };
+  const std::vector<SentFrameTiming>& timings() const { return timings_; }
+  const std::vector<PacerExit>& pacer_exits() const { return pacer_exits_; }
+
+ private:
+  std::vector<SentFrameTiming> timings_;
+  std::vector<PacerExit> pacer_exits_;
+};
+
+TEST_F(RtpSenderVideoTest, ReportsTimingOfEverySentFrameToSink) {
+  constexpr uint32_t kStartTimestamp = 1000;
+  rtp_module_.SetStartTimestamp(kStartTimestamp);
+  RecordingSentFrameTimingSink sink;
+  SetSentFrameTimingSink(&sink);
+
+  // Neither frame is a timing frame, so the header extension would carry no
+  // timestamps for them.
+  constexpr int kNumFrames = 2;
+  for (int i = 0; i < kNumFrames; ++i) {
+    const uint8_t kData[] = {1, 2, 3, 4};
+    EncodedImage encoded_image;
+    encoded_image.SetEncodedData(
+        EncodedImageBuffer::Create(kData, sizeof(kData)));
+    encoded_image._frameType = i == 0 ? VideoFrameType::kVideoFrameKey
+                                      : VideoFrameType::kVideoFrameDelta;
+    encoded_image.capture_time_ms_ = fake_clock_.TimeInMilliseconds();
+    encoded_image.SetEncodeTime(encoded_image.capture_time_ms_ + 1,
+                                encoded_image.capture_time_ms_ + 5);
+    encoded_image.timing_.flags = VideoSendTiming::kNotTriggered;
+    fake_clock_.AdvanceTimeMilliseconds(10);
+
+    RTPVideoHeader video_header;
+    video_header.frame_type = encoded_image._frameType;
+    ASSERT_TRUE(rtp_sender_video_->SendEncodedImage(
+        kPayload, kType, kStartTimestamp + kTimestamp * (i + 1), encoded_image,
+        video_header, kDefaultExpectedRetransmissionTime));
+  }
+  SetSentFrameTimingSink(nullptr);
+
+  ASSERT_THAT(sink.timings(), SizeIs(kNumFrames));
+  ASSERT_THAT(sink.pacer_exits(), SizeIs(kNumFrames));
+  for (int i = 0; i < kNumFrames; ++i) {
+    const SentFrameTiming& timing = sink.timings()[i];
+    EXPECT_EQ(timing.ssrc, kSsrc);
+    EXPECT_EQ(timing.rtp_timestamp, kStartTimestamp + kTimestamp * (i + 1));
+    EXPECT_EQ(timing.rtp_timestamp, transport_.sent_packets()[i].Timestamp());
+    EXPECT_EQ(timing.encode_start_ms, timing.capture_time_ms + 1);
+    EXPECT_EQ(timing.encode_finish_ms, timing.capture_time_ms + 5);
+    EXPECT_EQ(timing.packetization_finish_ms, timing.capture_time_ms + 10);
+    EXPECT_EQ(timing.is_key_frame, i == 0);
+    EXPECT_EQ(sink.pacer_exits()[i].ssrc, kSsrc);
+    EXPECT_EQ(sink.pacer_exits()[i].rtp_timestamp, timing.rtp_timestamp);
+    EXPECT_EQ(sink.pacer_exits()[i].pacer_exit_ms,
+              timing.packetization_finish_ms);
+  }
+}
+
 class RtpSenderVideoWithFrameTransformerTest : public ::testing::Test {
  public:
   RtpSenderVideoWithFrameTransformerTest()
@@ -1659,6 +1732,59 @@ TEST_F(RtpSenderVideoWithFrameTransformerTest, OnTransformedFrameSendsVideo) {
   EXPECT_EQ(transport_.packets_sent(), 2);
 }
 
+TEST_F(RtpSenderVideoWithFrameTransformerTest,
+       ReportsTimingOfTransformedFrameToSink) {
+  auto mock_frame_transformer =
+      rtc::make_ref_counted<NiceMock<MockFrameTransformer>>();
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*mock_frame_transformer, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  std::unique_ptr<RTPSenderVideo> rtp_sender_video =
+      CreateSenderWithFrameTransformer(mock_frame_transformer);
+  ASSERT_TRUE(callback);
+  RecordingSentFrameTimingSink sink;
+  SetSentFrameTimingSink(&sink);
+
+  auto encoded_image = CreateDefaultEncodedImage();
+  encoded_image->_frameType = VideoFrameType::kVideoFrameKey;
+  encoded_image->capture_time_ms_ =
+      time_controller_.GetClock()->TimeInMilliseconds();
+  encoded_image->SetEncodeTime(encoded_image->capture_time_ms_ + 1,
+                               encoded_image->capture_time_ms_ + 5);
+  encoded_image->timing_.flags = VideoSendTiming::kNotTriggered;
+  RTPVideoHeader video_header;
+  video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  auto encoder_queue = time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+      "encoder_queue", TaskQueueFactory::Priority::NORMAL);
+  // The transformer hands the frame back 10 ms later.
+  ON_CALL(*mock_frame_transformer, Transform)
+      .WillByDefault([&](std::unique_ptr<TransformableFrameInterface> frame) {
+        encoder_queue->PostDelayedTask(
+            [&callback, frame = std::move(frame)]() mutable {
+              callback->OnTransformedFrame(std::move(frame));
+            },
+            TimeDelta::Millis(10));
+      });
+  encoder_queue->PostTask([&] {
+    rtp_sender_video->SendEncodedImage(kPayload, kType, kTimestamp,
+                                       *encoded_image, video_header,
+                                       kDefaultExpectedRetransmissionTime);
+  });
+  time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  SetSentFrameTimingSink(nullptr);
+
+  ASSERT_EQ(transport_.packets_sent(), 1);
+  ASSERT_THAT(sink.timings(), SizeIs(1));
+  const SentFrameTiming& timing = sink.timings()[0];
+  EXPECT_EQ(timing.ssrc, kSsrc);
+  EXPECT_EQ(timing.rtp_timestamp, kTimestamp);
+  EXPECT_EQ(timing.encode_start_ms, timing.capture_time_ms + 1);
+  EXPECT_EQ(timing.encode_finish_ms, timing.capture_time_ms + 5);
+  EXPECT_EQ(timing.packetization_finish_ms, timing.capture_time_ms + 10);
+  EXPECT_EQ(timing.encoded_size, encoded_image->size());
+  EXPECT_TRUE(timing.is_key_frame);
+}
+
 TEST_F(RtpSenderVideoWithFrameTransformerTest,
        TransformOverheadCorrectlyAccountedFor) {
   auto mock_frame_transformer =
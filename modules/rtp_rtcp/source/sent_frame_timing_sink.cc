@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/sent_frame_timing_sink.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include "api/video/encoded_image.h"
+#include "api/video/video_frame_type.h"
+#include "api/video/video_timing.h"
+
+namespace webrtc {
+
+namespace {
+
+std::atomic<SentFrameTimingSinkInterface*> g_sent_frame_timing_sink{nullptr};
+
+}  // namespace
+
+void SetSentFrameTimingSink(SentFrameTimingSinkInterface* sink) {
+  g_sent_frame_timing_sink.store(sink, std::memory_order_release);
+}
+
+SentFrameTimingSinkInterface* GetSentFrameTimingSink() {
+  return g_sent_frame_timing_sink.load(std::memory_order_acquire);
+}
+
+SentFrameTiming CreateSentFrameTiming(uint32_t rtp_timestamp,
+                                      const EncodedImage& encoded_image) {
+  SentFrameTiming timing;
+  timing.rtp_timestamp = rtp_timestamp;
+  timing.capture_time_ms = encoded_image.capture_time_ms_;
+  if (encoded_image.timing_.flags != VideoSendTiming::kInvalid) {
+    timing.encode_start_ms = encoded_image.timing_.encode_start_ms;
+    timing.encode_finish_ms = encoded_image.timing_.encode_finish_ms;
+  }
+  timing.encoded_size = encoded_image.size();
+  timing.is_key_frame =
+      encoded_image._frameType == VideoFrameType::kVideoFrameKey;
+  return timing;
+}
+
+}  // namespace webrtc
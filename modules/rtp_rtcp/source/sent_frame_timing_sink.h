@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_SENT_FRAME_TIMING_SINK_H_
+#define MODULES_RTP_RTCP_SOURCE_SENT_FRAME_TIMING_SINK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "api/video/encoded_image.h"
+
+namespace webrtc {
+
+// Sender side timestamps of one video frame, in milliseconds of the sender's
+// clock. Unlike the video-timing header extension, which only carries them
+// for sampled and outlier frames, these are reported for every frame.
+struct SentFrameTiming {
+  uint32_t ssrc = 0;
+  // The RTP timestamp as sent on the wire, i.e. including the random start
+  // offset of the stream; this is what the receiver reports the frame as.
+  uint32_t rtp_timestamp = 0;
+  int64_t capture_time_ms = -1;
+  // -1 if the encoder did not report them, e.g. for encoders with an
+  // internal source.
+  int64_t encode_start_ms = -1;
+  int64_t encode_finish_ms = -1;
+  // Time all packets of the frame had been handed to the pacer.
+  int64_t packetization_finish_ms = -1;
+  size_t encoded_size = 0;
+  bool is_key_frame = false;
+};
+
+// The timing of `encoded_image` as handed to the RTP sender. `ssrc` and
+// `packetization_finish_ms` are left for the sender to fill in.
+SentFrameTiming CreateSentFrameTiming(uint32_t rtp_timestamp,
+                                      const EncodedImage& encoded_image);
+
+// Receives the sender side timing of every sent video frame. Both methods
+// are invoked synchronously, OnFramePacketized() on the encoder queue, or on
+// the frame transformer's queue if a frame transformer is installed, and
+// OnFramePacerExit() on the pacer's queue, so implementations must not block;
+// they are expected to hand the data off to another thread. The two events
+// of one frame may be reported in either order.
+class SentFrameTimingSinkInterface {
+ public:
+  virtual ~SentFrameTimingSinkInterface() = default;
+
+  // Frames from a frame transformer are reported once transformed, with the
+  // encoder output size as `encoded_size`. Frames the transformer inserts
+  // that were not encoded by this sender are not reported.
+  virtual void OnFramePacketized(const SentFrameTiming& timing) = 0;
+  // Called when the last media packet of a frame, the one carrying the marker
+  // bit, leaves the pacer. Retransmissions and FEC are not reported.
+  virtual void OnFramePacerExit(uint32_t ssrc,
+                                uint32_t rtp_timestamp,
+                                int64_t pacer_exit_ms) = 0;
+};
+
+// Installs the process wide sink fed by every RTPSenderVideo and
+// RtpSenderEgress. Pass nullptr to remove it. The same lifetime rules as for
+// SetDecodedFrameTimingSink() apply: the sink must outlive the send streams
+// that may still be calling it when it is removed.
+void SetSentFrameTimingSink(SentFrameTimingSinkInterface* sink);
+SentFrameTimingSinkInterface* GetSentFrameTimingSink();
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_SENT_FRAME_TIMING_SINK_H_
@@ -25,9 +25,9 @@ class VideoFecGenerator {
   VideoFecGenerator() = default;
   virtual ~VideoFecGenerator() = default;
 
-  enum class FecType { kFlexFec, kUlpFec };
+  enum class FecType { kFlexFec, kUlpFec, kReedSolomon };
   virtual FecType GetFecType() const = 0;
-  // Returns the SSRC used for FEC packets (i.e. FlexFec SSRC).
+  // Returns the SSRC used for FEC packets (i.e. FlexFec or Reed-Solomon SSRC).
   virtual std::optional<uint32_t> FecSsrc() = 0;
   // Returns the overhead, in bytes per packet, for FEC (and possibly RED).
   virtual size_t MaxPacketOverhead() const = 0;
@@ -16,6 +16,7 @@
 #include "api/array_view.h"
 #include "api/scoped_refptr.h"
 #include "api/video/encoded_image.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -28,7 +29,7 @@ rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizer::AssembleFrame(
   }
 
   rtc::scoped_refptr<EncodedImageBuffer> bitstream =
-      EncodedImageBuffer::Create(frame_size);
+      CreateFrameBuffer(frame_size);
 
   uint8_t* write_at = bitstream->data();
   for (rtc::ArrayView<const uint8_t> payload : rtp_payloads) {
@@ -39,4 +40,10 @@ rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizer::AssembleFrame(
   return bitstream;
 }
 
+rtc::scoped_refptr<EncodedImageBuffer> VideoRtpDepacketizer::CreateFrameBuffer(
+    size_t size) {
+  return frame_buffer_pool_ != nullptr ? frame_buffer_pool_->CreateBuffer(size)
+                                       : EncodedImageBuffer::Create(size);
+}
+
 }  // namespace webrtc
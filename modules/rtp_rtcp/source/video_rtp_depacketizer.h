@@ -18,6 +18,7 @@
 #include "api/array_view.h"
 #include "api/scoped_refptr.h"
 #include "api/video/encoded_image.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
@@ -35,6 +36,19 @@ class VideoRtpDepacketizer {
       rtc::CopyOnWriteBuffer rtp_payload) = 0;
   virtual rtc::scoped_refptr<EncodedImageBuffer> AssembleFrame(
       rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads);
+
+  // If set, AssembleFrame takes frame buffers from `pool` instead of
+  // allocating them. `pool` must outlive the depacketizer.
+  void SetFrameBufferPool(EncodedImageBufferPool* pool) {
+    frame_buffer_pool_ = pool;
+  }
+
+ protected:
+  // Returns a buffer of `size` bytes for an assembled frame.
+  rtc::scoped_refptr<EncodedImageBuffer> CreateFrameBuffer(size_t size);
+
+ private:
+  EncodedImageBufferPool* frame_buffer_pool_ = nullptr;
 };
 
 }  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include "modules/rtp_rtcp/source/video_rtp_depacketizer_av1.h"
 
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -125,6 +126,29 @@ TEST(VideoRtpDepacketizerAv1Test, AssembleFrameSetsOBUPayloadSizeWhenAbsent) {
   EXPECT_EQ(frame_view[1], 3);
 }
 
+TEST(VideoRtpDepacketizerAv1Test, AssembleFrameReusesPooledBuffer) {
+  const uint8_t payload1[] = {0b00'01'0000,  // aggregation header
+                              0b0'0110'000,  // /  Frame
+                              20, 30, 40};   // \  OBU
+  rtc::ArrayView<const uint8_t> payloads[] = {payload1};
+  EncodedImageBufferPool pool;
+  VideoRtpDepacketizerAv1 depacketizer;
+  depacketizer.SetFrameBufferPool(&pool);
+
+  rtc::scoped_refptr<EncodedImageBuffer> frame =
+      depacketizer.AssembleFrame(payloads);
+  ASSERT_TRUE(frame);
+  const uint8_t* frame_data = frame->data();
+  frame = nullptr;
+
+  frame = depacketizer.AssembleFrame(payloads);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->data(), frame_data);
+  EXPECT_THAT(rtc::ArrayView<const uint8_t>(*frame),
+              ElementsAre(0b0'0110'010, 3, 20, 30, 40));
+  EXPECT_EQ(pool.size(), 1u);
+}
+
 TEST(VideoRtpDepacketizerAv1Test, AssembleFrameSetsOBUPayloadSizeWhenPresent) {
   const uint8_t payload1[] = {0b00'01'0000,  // aggregation header
                               0b0'0110'010,  // /  Frame OBU header
@@ -14,9 +14,12 @@
 
 #include "api/scoped_refptr.h"
 #include "api/video/encoded_image.h"
+#include "api/video/render_resolution.h"
 #include "api/video/video_frame_buffer.h"
+#include "api/video/video_frame_type.h"
 #include "common_video/include/video_frame_buffer.h"
 #include "modules/video_coding/include/video_error_codes.h"
+#include "modules/video_coding/utility/decoder_thread_budget.h"
 #include "rtc_base/logging.h"
 #include "third_party/dav1d/libdav1d/include/dav1d/dav1d.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
@@ -43,8 +46,18 @@ class Dav1dDecoder : public VideoDecoder {
   const char* ImplementationName() const override;
 
  private:
+  // Number of threads wanted for frames of `resolution`.
+  int WantedThreads(const RenderResolution& resolution) const;
+  // Opens `context_` with threads from the process wide budget.
+  bool OpenContext(int wanted_threads);
+
   Dav1dContext* context_ = nullptr;
   DecodedImageCallback* decode_complete_callback_ = nullptr;
+  int number_of_cores_ = 1;
+  int wanted_threads_ = 0;
+  DecoderThreadBudget::Lease thread_lease_;
+  // Resolution of the last decoded picture.
+  RenderResolution picture_resolution_;
 };
 
 class ScopedDav1dData {
@@ -81,10 +94,31 @@ Dav1dDecoder::~Dav1dDecoder() {
 }
 
 bool Dav1dDecoder::Configure(const Settings& settings) {
+  number_of_cores_ = settings.number_of_cores();
+  return OpenContext(WantedThreads(settings.max_render_resolution()));
+}
+
+int Dav1dDecoder::WantedThreads(const RenderResolution& resolution) const {
+  if (!resolution.Valid()) {
+    return 1;
+  }
+  return std::min(number_of_cores_,
+                  DecoderThreadBudget::ThreadsForResolution(
+                      resolution.Width(), resolution.Height()));
+}
+
+bool Dav1dDecoder::OpenContext(int wanted_threads) {
+  dav1d_close(&context_);
+  // Return the threads of the previous context before asking for new ones, so
+  // that they are not counted twice.
+  thread_lease_ = DecoderThreadBudget::Lease();
+  thread_lease_ = DecoderThreadBudget::Get().Acquire(wanted_threads);
+  wanted_threads_ = wanted_threads;
+
   Dav1dSettings s;
   dav1d_default_settings(&s);
 
-  s.n_threads = std::max(2, settings.number_of_cores());
+  s.n_threads = thread_lease_.num_threads();
   s.max_frame_delay = 1;   // For low latency decoding.
   s.all_layers = 0;        // Don't output a frame for every spatial layer.
   // Limit max frame size to avoid OOM'ing fuzzers. crbug.com/325284120.
@@ -102,6 +136,7 @@ int32_t Dav1dDecoder::RegisterDecodeCompleteCallback(
 
 int32_t Dav1dDecoder::Release() {
   dav1d_close(&context_);
+  thread_lease_ = DecoderThreadBudget::Lease();
   if (context_ != nullptr) {
     return WEBRTC_VIDEO_CODEC_MEMORY;
   }
@@ -125,6 +160,23 @@ int32_t Dav1dDecoder::Decode(const EncodedImage& encoded_image,
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
   }
 
+  if (encoded_image._frameType == VideoFrameType::kVideoFrameKey) {
+    // Nothing is referenced across a key frame, so this is where the decoder
+    // can be reopened with the number of threads suitable for the new
+    // resolution.
+    RenderResolution resolution(encoded_image._encodedWidth,
+                                encoded_image._encodedHeight);
+    if (!resolution.Valid()) {
+      resolution = picture_resolution_;
+    }
+    const int wanted_threads = WantedThreads(resolution);
+    if (resolution.Valid() && wanted_threads != wanted_threads_ &&
+        !OpenContext(wanted_threads)) {
+      RTC_LOG(LS_WARNING) << "Dav1dDecoder::Decode failed to reopen decoder.";
+      return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+    }
+  }
+
   ScopedDav1dData scoped_dav1d_data;
   Dav1dData& dav1d_data = scoped_dav1d_data.Data();
   dav1d_data_wrap(&dav1d_data, encoded_image.data(), encoded_image.size(),
@@ -154,6 +206,7 @@ int32_t Dav1dDecoder::Decode(const EncodedImage& encoded_image,
                       << dav1d_picture.p.bpc;
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
+  picture_resolution_ = RenderResolution(dav1d_picture.p.w, dav1d_picture.p.h);
 
   rtc::scoped_refptr<VideoFrameBuffer> wrapped_buffer;
   if (dav1d_picture.p.layout == DAV1D_PIXEL_LAYOUT_I420) {
@@ -22,6 +22,8 @@
 
 #include "absl/algorithm/container.h"
 #include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_timing.h"
@@ -359,6 +361,9 @@ int LibvpxVp8Encoder::Release() {
     libvpx_->img_free(&*it);
   }
   raw_images_.clear();
+  for (VideoFrameBufferPool& pool : scaled_buffer_pools_) {
+    pool.Release();
+  }
 
   frame_buffer_controller_.reset();
   inited_ = false;
@@ -1454,8 +1459,7 @@ LibvpxVp8Encoder::PrepareBuffers(rtc::scoped_refptr<VideoFrameBuffer> buffer) {
             ? buffer.get()
             : prepared_buffers.back().get();
 
-    auto scaled_buffer =
-        buffer_to_scale->Scale(raw_images_[i].d_w, raw_images_[i].d_h);
+    auto scaled_buffer = ScaleBuffer(i, *buffer_to_scale);
     if (scaled_buffer->type() == VideoFrameBuffer::Type::kNative) {
       auto mapped_scaled_buffer =
           scaled_buffer->GetMappedFrameBuffer(mapped_type);
@@ -1492,4 +1496,39 @@ LibvpxVp8Encoder::PrepareBuffers(rtc::scoped_refptr<VideoFrameBuffer> buffer) {
   return prepared_buffers;
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> LibvpxVp8Encoder::ScaleBuffer(
+    size_t stream_index,
+    VideoFrameBuffer& buffer) {
+  const int width = static_cast<int>(raw_images_[stream_index].d_w);
+  const int height = static_cast<int>(raw_images_[stream_index].d_h);
+  VideoFrameBufferPool& pool = scaled_buffer_pools_[stream_index];
+  switch (buffer.type()) {
+    case VideoFrameBuffer::Type::kI420:
+    case VideoFrameBuffer::Type::kI420A: {
+      // The alpha plane is dropped, as by VideoFrameBuffer::Scale().
+      rtc::scoped_refptr<I420Buffer> scaled_buffer =
+          pool.CreateI420Buffer(width, height);
+      if (scaled_buffer) {
+        scaled_buffer->ScaleFrom(*buffer.GetI420());
+        return scaled_buffer;
+      }
+      break;
+    }
+    case VideoFrameBuffer::Type::kNV12: {
+      rtc::scoped_refptr<NV12Buffer> scaled_buffer =
+          pool.CreateNV12Buffer(width, height);
+      if (scaled_buffer) {
+        scaled_buffer->CropAndScaleFrom(*buffer.GetNV12(), /*offset_x=*/0,
+                                        /*offset_y=*/0, buffer.width(),
+                                        buffer.height());
+        return scaled_buffer;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return buffer.Scale(width, height);
+}
+
 }  // namespace webrtc
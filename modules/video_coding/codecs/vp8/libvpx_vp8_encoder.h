@@ -11,6 +11,7 @@
 #ifndef MODULES_VIDEO_CODING_CODECS_VP8_LIBVPX_VP8_ENCODER_H_
 #define MODULES_VIDEO_CODING_CODECS_VP8_LIBVPX_VP8_ENCODER_H_
 
+#include <array>
 #include <memory>
 #include <string>
 #include <utility>
@@ -22,10 +23,12 @@
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "api/video/encoded_image.h"
+#include "api/video/video_codec_constants.h"
 #include "api/video/video_frame.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp8_frame_buffer_controller.h"
 #include "api/video_codecs/vp8_frame_config.h"
+#include "common_video/include/video_frame_buffer_pool.h"
 #include "modules/video_coding/codecs/interface/libvpx_interface.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/video_codec_interface.h"
@@ -109,6 +112,11 @@ class LibvpxVp8Encoder : public VideoEncoder {
   // returned.
   std::vector<rtc::scoped_refptr<VideoFrameBuffer>> PrepareBuffers(
       rtc::scoped_refptr<VideoFrameBuffer> buffer);
+  // Scales `buffer` to the size of `raw_images_[stream_index]`. I420, I420A
+  // and NV12 buffers are scaled into a buffer from
+  // `scaled_buffer_pools_[stream_index]`.
+  rtc::scoped_refptr<VideoFrameBuffer> ScaleBuffer(size_t stream_index,
+                                                   VideoFrameBuffer& buffer);
 
   const Environment env_;
   const std::unique_ptr<LibvpxInterface> libvpx_;
@@ -137,6 +145,9 @@ class LibvpxVp8Encoder : public VideoEncoder {
   std::vector<Vp8EncoderConfig> config_overrides_;
   std::vector<vpx_rational_t> downsampling_factors_;
   std::vector<Timestamp> last_encoder_output_time_;
+  // Buffers for the downscaled simulcast streams, one pool per stream since a
+  // pool only keeps buffers of one resolution.
+  std::array<VideoFrameBufferPool, kMaxSimulcastStreams> scaled_buffer_pools_;
 
   FramerateControllerDeprecated framerate_controller_;
   int num_steady_state_frames_ = 0;
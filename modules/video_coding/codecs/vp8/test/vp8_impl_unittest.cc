@@ -19,6 +19,7 @@
 #include "api/test/frame_generator_interface.h"
 #include "api/test/mock_video_decoder.h"
 #include "api/test/mock_video_encoder.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp8_temporal_layers.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
@@ -30,6 +31,7 @@
 #include "modules/video_coding/utility/vp8_header_parser.h"
 #include "rtc_base/time_utils.h"
 #include "test/field_trial.h"
+#include "test/frame_utils.h"
 #include "test/mappable_native_buffer.h"
 #include "test/scoped_key_value_config.h"
 #include "test/video_codec_settings.h"
@@ -44,6 +46,8 @@ using ::testing::Field;
 using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::Return;
+using ::testing::WithArg;
+using ::testing::WithArgs;
 using EncoderInfo = webrtc::VideoEncoder::EncoderInfo;
 using FramerateFractions =
     absl::InlinedVector<uint8_t, webrtc::kMaxTemporalStreams>;
@@ -1052,4 +1056,159 @@ INSTANTIATE_TEST_SUITE_P(All,
                          ::testing::Values(VideoFrameBuffer::Type::kI420,
                                            VideoFrameBuffer::Type::kNV12));
 
+// Returns true if `raw_image` wraps the pixels of `buffer`.
+bool RawImageEquals(const vpx_image_t& raw_image,
+                    const VideoFrameBuffer& buffer) {
+  if (static_cast<int>(raw_image.d_w) != buffer.width() ||
+      static_cast<int>(raw_image.d_h) != buffer.height()) {
+    return false;
+  }
+  const int chroma_width = (buffer.width() + 1) / 2;
+  const int chroma_height = (buffer.height() + 1) / 2;
+  if (buffer.type() == VideoFrameBuffer::Type::kNV12) {
+    const NV12BufferInterface* nv12_buffer = buffer.GetNV12();
+    return raw_image.fmt == VPX_IMG_FMT_NV12 &&
+           test::EqualPlane(raw_image.planes[VPX_PLANE_Y], nv12_buffer->DataY(),
+                            raw_image.stride[VPX_PLANE_Y],
+                            nv12_buffer->StrideY(), buffer.width(),
+                            buffer.height()) &&
+           test::EqualPlane(raw_image.planes[VPX_PLANE_U],
+                            nv12_buffer->DataUV(),
+                            raw_image.stride[VPX_PLANE_U],
+                            nv12_buffer->StrideUV(), 2 * chroma_width,
+                            chroma_height);
+  }
+  const I420BufferInterface* i420_buffer = buffer.GetI420();
+  return raw_image.fmt == VPX_IMG_FMT_I420 &&
+         test::EqualPlane(raw_image.planes[VPX_PLANE_Y], i420_buffer->DataY(),
+                          raw_image.stride[VPX_PLANE_Y], i420_buffer->StrideY(),
+                          buffer.width(), buffer.height()) &&
+         test::EqualPlane(raw_image.planes[VPX_PLANE_U], i420_buffer->DataU(),
+                          raw_image.stride[VPX_PLANE_U], i420_buffer->StrideU(),
+                          chroma_width, chroma_height) &&
+         test::EqualPlane(raw_image.planes[VPX_PLANE_V], i420_buffer->DataV(),
+                          raw_image.stride[VPX_PLANE_V], i420_buffer->StrideV(),
+                          chroma_width, chroma_height);
+}
+
+// Runs a simulcast LibvpxVp8Encoder on a mocked libvpx, which lets the tests
+// look at the downscaled images it passes to libvpx.
+class TestVp8ImplScaleBuffer
+    : public TestVp8Impl,
+      public ::testing::WithParamInterface<
+          test::FrameGeneratorInterface::OutputType> {
+ public:
+  TestVp8ImplScaleBuffer()
+      : vpx_(new NiceMock<MockLibvpxInterface>()),
+        vpx_encoder_(CreateEnvironment(), {}, absl::WrapUnique(vpx_)) {
+    auto set_image_format = [](vpx_image_t* img, vpx_img_fmt_t fmt,
+                               unsigned int d_w, unsigned int d_h) {
+      img->fmt = fmt;
+      img->d_w = d_w;
+      img->d_h = d_h;
+      return img;
+    };
+    ON_CALL(*vpx_, img_wrap)
+        .WillByDefault(WithArgs<0, 1, 2, 3>(set_image_format));
+    ON_CALL(*vpx_, img_alloc)
+        .WillByDefault(WithArgs<0, 1, 2, 3>(set_image_format));
+    vpx_encoder_.RegisterEncodeCompleteCallback(&callback_);
+  }
+
+ protected:
+  // Configures three simulcast streams for `width`x`height` input, and input
+  // frames of that size and of the tested buffer type.
+  void ConfigureSimulcast(int width, int height) {
+    codec_settings_.width = width;
+    codec_settings_.height = height;
+    codec_settings_.numberOfSimulcastStreams = 3;
+    for (int i = 0; i < 3; ++i) {
+      codec_settings_.simulcastStream[i] = {.width = width >> (2 - i),
+                                            .height = height >> (2 - i),
+                                            .maxFramerate = kFramerateFps,
+                                            .numberOfTemporalLayers = 1,
+                                            .maxBitrate = 4000,
+                                            .targetBitrate = 3000,
+                                            .minBitrate = 2000,
+                                            .qpMax = 80,
+                                            .active = true};
+    }
+    input_frame_generator_ = test::CreateSquareFrameGenerator(
+        width, height, GetParam(), std::nullopt);
+  }
+
+  // Encodes the next input frame, expects the downscaled images passed to
+  // libvpx to equal the input scaled by VideoFrameBuffer::Scale(), and returns
+  // their Y plane pointers.
+  std::vector<const uint8_t*> EncodeAndCheckScaledImages() {
+    VideoFrame input_frame = NextInputFrame();
+    // Each stream is scaled from the next larger one, full resolution first.
+    std::vector<rtc::scoped_refptr<VideoFrameBuffer>> expected_buffers = {
+        input_frame.video_frame_buffer()};
+    for (int i = 1; i < 3; ++i) {
+      expected_buffers.push_back(expected_buffers.back()->Scale(
+          codec_settings_.simulcastStream[2 - i].width,
+          codec_settings_.simulcastStream[2 - i].height));
+    }
+
+    std::vector<const uint8_t*> scaled_data;
+    EXPECT_CALL(*vpx_, codec_encode)
+        .WillOnce(WithArg<1>([&](const vpx_image_t* raw_images) {
+          // libvpx reads the images of all streams as one array.
+          for (int i = 1; i < 3; ++i) {
+            EXPECT_TRUE(RawImageEquals(raw_images[i], *expected_buffers[i]))
+                << "Stream " << i;
+            scaled_data.push_back(raw_images[i].planes[VPX_PLANE_Y]);
+          }
+          return VPX_CODEC_OK;
+        }));
+    vpx_encoder_.Encode(input_frame, nullptr);
+    return scaled_data;
+  }
+
+  MockEncodedImageCallback callback_;
+  // Owned by `vpx_encoder_`.
+  NiceMock<MockLibvpxInterface>* const vpx_;
+  LibvpxVp8Encoder vpx_encoder_;
+};
+
+TEST_P(TestVp8ImplScaleBuffer, ScalesSimulcastStreamsIntoReusedBuffers) {
+  ConfigureSimulcast(kWidth, kHeight);
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            vpx_encoder_.InitEncode(&codec_settings_, kSettings));
+
+  std::vector<const uint8_t*> first_scaled_data = EncodeAndCheckScaledImages();
+  std::vector<const uint8_t*> second_scaled_data = EncodeAndCheckScaledImages();
+  // The downscaled buffers go back to the pools once a frame is encoded, and
+  // are reused for the next frame.
+  ASSERT_EQ(first_scaled_data.size(), 2u);
+  EXPECT_EQ(first_scaled_data, second_scaled_data);
+}
+
+TEST_P(TestVp8ImplScaleBuffer, ScalesIntoBuffersOfNewResolutionAfterRelease) {
+  ConfigureSimulcast(kWidth, kHeight);
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            vpx_encoder_.InitEncode(&codec_settings_, kSettings));
+  EncodeAndCheckScaledImages();
+
+  // Release() empties the pools, and the streams of the new configuration are
+  // scaled into buffers of their own resolution.
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK, vpx_encoder_.Release());
+  ConfigureSimulcast(2 * kWidth, 2 * kHeight);
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            vpx_encoder_.InitEncode(&codec_settings_, kSettings));
+  std::vector<const uint8_t*> first_scaled_data = EncodeAndCheckScaledImages();
+  EXPECT_EQ(first_scaled_data, EncodeAndCheckScaledImages());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    All,
+    TestVp8ImplScaleBuffer,
+    ::testing::Values(test::FrameGeneratorInterface::OutputType::kI420,
+                      test::FrameGeneratorInterface::OutputType::kI420A,
+                      test::FrameGeneratorInterface::OutputType::kNV12),
+    [](const auto& info) {
+      return test::FrameGeneratorInterface::OutputTypeToString(info.param);
+    });
+
 }  // namespace webrtc
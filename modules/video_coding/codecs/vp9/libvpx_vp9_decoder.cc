@@ -19,6 +19,7 @@
 #include "api/video/color_space.h"
 #include "api/video/i010_buffer.h"
 #include "common_video/include/video_frame_buffer.h"
+#include "modules/video_coding/utility/decoder_thread_budget.h"
 #include "modules/video_coding/utility/vp9_uncompressed_header_parser.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -140,18 +141,15 @@ bool LibvpxVp9Decoder::Configure(const Settings& settings) {
   } else {
     // We want to use multithreading when decoding high resolution videos. But
     // not too many in order to avoid overhead when many stream are decoded
-    // concurrently.
-    // Set 2 thread as target for 1280x720 pixel count, and then scale up
-    // linearly from there - but cap at physical core count.
-    // For common resolutions this results in:
-    // 1 for 360p
-    // 2 for 720p
-    // 4 for 1080p
-    // 8 for 1440p
-    // 18 for 4K
-    int num_threads = std::max(
-        1, 2 * resolution.Width() * resolution.Height() / (1280 * 720));
-    cfg.threads = std::min(settings.number_of_cores(), num_threads);
+    // concurrently, so the threads come from a budget shared by all decoders
+    // of the process and are rebalanced whenever the resolution changes.
+    // Each decoder wants 2 threads for 1280x720 pixel count, scaled up
+    // linearly from there - but capped at physical core count.
+    thread_lease_ = DecoderThreadBudget::Get().Acquire(
+        std::min(settings.number_of_cores(),
+                 DecoderThreadBudget::ThreadsForResolution(
+                     resolution.Width(), resolution.Height())));
+    cfg.threads = thread_lease_.num_threads();
   }
 #endif
 
@@ -381,6 +379,7 @@ int LibvpxVp9Decoder::Release() {
   // still referenced externally are deleted once fully released, not returning
   // to the pool.
   libvpx_buffer_pool_.ClearPool();
+  thread_lease_ = DecoderThreadBudget::Lease();
   inited_ = false;
   return ret_val;
 }
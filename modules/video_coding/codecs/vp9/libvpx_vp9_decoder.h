@@ -17,6 +17,7 @@
 #include "api/video_codecs/video_decoder.h"
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
 #include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
+#include "modules/video_coding/utility/decoder_thread_budget.h"
 #include "vpx/vp8cx.h"
 
 namespace webrtc {
@@ -51,6 +52,8 @@ class LibvpxVp9Decoder : public VP9Decoder {
   vpx_codec_ctx_t* decoder_;
   bool key_frame_required_;
   Settings current_settings_;
+  // Decoding threads, sized for the resolution of `current_settings_`.
+  DecoderThreadBudget::Lease thread_lease_;
 };
 }  // namespace webrtc
 
@@ -67,6 +67,7 @@
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/trace_event.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
 #include "vpx/vp8cx.h"
 #include "vpx/vpx_encoder.h"
 #include "vpx/vpx_image.h"
@@ -323,6 +324,7 @@ int LibvpxVp9Encoder::Release() {
     libvpx_->img_free(raw_);
     raw_ = nullptr;
   }
+  i010_buffer_pool_.Release();
   inited_ = false;
   return ret_val;
 }
@@ -1146,7 +1148,7 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
   // through reference counting until after encoding has finished.
   rtc::scoped_refptr<const VideoFrameBuffer> mapped_buffer;
   const I010BufferInterface* i010_buffer;
-  rtc::scoped_refptr<const I010BufferInterface> i010_copy;
+  rtc::scoped_refptr<I010Buffer> i010_copy;
   switch (profile_) {
     case VP9Profile::kProfile0: {
       mapped_buffer =
@@ -1177,7 +1179,21 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                               << " image to I420. Can't encode frame.";
             return WEBRTC_VIDEO_CODEC_ERROR;
           }
-          i010_copy = I010Buffer::Copy(*i420_buffer);
+          i010_copy = i010_buffer_pool_.CreateI010Buffer(
+              i420_buffer->width(), i420_buffer->height());
+          if (!i010_copy) {
+            RTC_LOG(LS_WARNING) << "Failed to get an I010 buffer from the "
+                                   "pool. Can't encode frame.";
+            return WEBRTC_VIDEO_CODEC_ERROR;
+          }
+          libyuv::I420ToI010(
+              i420_buffer->DataY(), i420_buffer->StrideY(),
+              i420_buffer->DataU(), i420_buffer->StrideU(),
+              i420_buffer->DataV(), i420_buffer->StrideV(),
+              i010_copy->MutableDataY(), i010_copy->StrideY(),
+              i010_copy->MutableDataU(), i010_copy->StrideU(),
+              i010_copy->MutableDataV(), i010_copy->StrideV(),
+              i420_buffer->width(), i420_buffer->height());
           i010_buffer = i010_copy.get();
         }
       }
@@ -13,6 +13,7 @@
 #include "api/test/frame_generator_interface.h"
 #include "api/test/mock_video_encoder.h"
 #include "api/video/color_space.h"
+#include "api/video/i010_buffer.h"
 #include "api/video/i420_buffer.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp9_profile.h"
@@ -29,6 +30,7 @@
 #include "rtc_base/strings/string_builder.h"
 #include "test/explicit_key_value_config.h"
 #include "test/field_trial.h"
+#include "test/frame_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/mappable_native_buffer.h"
@@ -2326,6 +2328,81 @@ GetWrapImageFunction(vpx_image_t* img) {
   };
 }
 
+TEST(Vp9ImplTest, Profile2ConvertsInputIntoReusedI010Buffers) {
+  // Keep a raw pointer for EXPECT calls and the like. Ownership is otherwise
+  // passed on to LibvpxVp9Encoder.
+  auto* const vpx = new NiceMock<MockLibvpxInterface>();
+  LibvpxVp9Encoder encoder(CreateEnvironment(),
+                           {.profile = VP9Profile::kProfile2},
+                           absl::WrapUnique<LibvpxInterface>(vpx));
+
+  VideoCodec settings = DefaultCodecSettings();
+  vpx_image_t img;
+  ON_CALL(*vpx, img_wrap).WillByDefault(GetWrapImageFunction(&img));
+  ON_CALL(*vpx, codec_enc_init)
+      .WillByDefault(WithArg<0>([](vpx_codec_ctx_t* ctx) {
+        memset(ctx, 0, sizeof(*ctx));
+        return VPX_CODEC_OK;
+      }));
+  ON_CALL(*vpx, codec_enc_config_default)
+      .WillByDefault(DoAll(WithArg<1>([](vpx_codec_enc_cfg_t* cfg) {
+                             memset(cfg, 0, sizeof(vpx_codec_enc_cfg_t));
+                           }),
+                           Return(VPX_CODEC_OK)));
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder.InitEncode(&settings, kSettings));
+
+  VideoBitrateAllocation bitrate_allocation;
+  bitrate_allocation.SetBitrate(0, 0, kBitrateKbps * 1000);
+  encoder.SetRates(VideoEncoder::RateControlParameters(bitrate_allocation,
+                                                       settings.maxFramerate));
+  MockEncodedImageCallback callback;
+  encoder.RegisterEncodeCompleteCallback(&callback);
+
+  auto frame_generator = test::CreateSquareFrameGenerator(
+      kWidth, kHeight, test::FrameGeneratorInterface::OutputType::kI420,
+      std::nullopt);
+  std::vector<const uint8_t*> converted_data;
+  for (int i = 0; i < 2; ++i) {
+    VideoFrame frame =
+        VideoFrame::Builder()
+            .set_video_frame_buffer(frame_generator->NextFrame().buffer)
+            .build();
+    // The pooled conversion must produce what I010Buffer::Copy() does.
+    rtc::scoped_refptr<I010Buffer> expected_buffer =
+        I010Buffer::Copy(*frame.video_frame_buffer()->ToI420());
+    EXPECT_CALL(*vpx, codec_encode)
+        .WillOnce(WithArg<1>([&](const vpx_image_t* raw) {
+          // The strides of the raw image are in bytes.
+          EXPECT_EQ(raw->fmt, VPX_IMG_FMT_I42016);
+          EXPECT_TRUE(test::EqualPlane(
+              raw->planes[VPX_PLANE_Y],
+              reinterpret_cast<const uint8_t*>(expected_buffer->DataY()),
+              raw->stride[VPX_PLANE_Y], 2 * expected_buffer->StrideY(),
+              2 * expected_buffer->width(), expected_buffer->height()));
+          EXPECT_TRUE(test::EqualPlane(
+              raw->planes[VPX_PLANE_U],
+              reinterpret_cast<const uint8_t*>(expected_buffer->DataU()),
+              raw->stride[VPX_PLANE_U], 2 * expected_buffer->StrideU(),
+              2 * expected_buffer->ChromaWidth(),
+              expected_buffer->ChromaHeight()));
+          EXPECT_TRUE(test::EqualPlane(
+              raw->planes[VPX_PLANE_V],
+              reinterpret_cast<const uint8_t*>(expected_buffer->DataV()),
+              raw->stride[VPX_PLANE_V], 2 * expected_buffer->StrideV(),
+              2 * expected_buffer->ChromaWidth(),
+              expected_buffer->ChromaHeight()));
+          converted_data.push_back(raw->planes[VPX_PLANE_Y]);
+          return VPX_CODEC_OK;
+        }));
+    encoder.Encode(frame, nullptr);
+  }
+
+  // The converted buffer goes back to the pool once a frame is encoded, and
+  // is reused for the next frame.
+  ASSERT_THAT(converted_data, SizeIs(2));
+  EXPECT_EQ(converted_data[0], converted_data[1]);
+}
+
 TEST(Vp9SpeedSettingsTrialsTest, NoSvcUsesGlobalSpeedFromTl0InLayerConfig) {
   // TL0 speed 8 at >= 480x270, 5 if below that.
   test::ExplicitKeyValueConfig trials(
@@ -0,0 +1,32 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/decoded_frame_timing_sink.h"
+
+#include <atomic>
+
+namespace webrtc {
+
+namespace {
+
+std::atomic<DecodedFrameTimingSinkInterface*> g_decoded_frame_timing_sink{
+    nullptr};
+
+}  // namespace
+
+void SetDecodedFrameTimingSink(DecodedFrameTimingSinkInterface* sink) {
+  g_decoded_frame_timing_sink.store(sink, std::memory_order_release);
+}
+
+DecodedFrameTimingSinkInterface* GetDecodedFrameTimingSink() {
+  return g_decoded_frame_timing_sink.load(std::memory_order_acquire);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_DECODED_FRAME_TIMING_SINK_H_
+#define MODULES_VIDEO_CODING_DECODED_FRAME_TIMING_SINK_H_
+
+#include "api/video/video_timing.h"
+
+namespace webrtc {
+
+// Receives the TimingFrameInfo of every decoded frame, as opposed to the
+// single longest frame per GetStats() interval exposed through
+// `googTimingFrameInfo`. OnDecodedFrameTiming() is invoked synchronously on
+// the decoder callback thread, so implementations must not block; they are
+// expected to hand the data off to another thread.
+class DecodedFrameTimingSinkInterface {
+ public:
+  virtual ~DecodedFrameTimingSinkInterface() = default;
+
+  // `timing.flags` is VideoSendTiming::kInvalid for frames that did not carry
+  // the video-timing header extension; the sender side timestamps are unset
+  // (-1) for those, the receiver side ones are always filled in.
+  virtual void OnDecodedFrameTiming(const TimingFrameInfo& timing) = 0;
+};
+
+// Installs the process wide sink fed by every VCMDecodedFrameCallback. Pass
+// nullptr to remove it. The sink must outlive all decode callbacks that may
+// still be running when it is removed, i.e. remove it only after the receive
+// streams using it have been stopped, or keep it alive.
+void SetDecodedFrameTimingSink(DecodedFrameTimingSinkInterface* sink);
+DecodedFrameTimingSinkInterface* GetDecodedFrameTimingSink();
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_DECODED_FRAME_TIMING_SINK_H_
@@ -50,8 +50,10 @@ bool TargetVideoDelayIsTooLarge(TimeDelta target_video_delay) {
   return false;
 }
 
-std::unique_ptr<EncodedFrame> CombineAndDeleteFrames(
-    absl::InlinedVector<std::unique_ptr<EncodedFrame>, 4> frames) {
+namespace {
+std::unique_ptr<EncodedFrame> CombineAndDeleteFramesInternal(
+    absl::InlinedVector<std::unique_ptr<EncodedFrame>, 4> frames,
+    EncodedImageBufferPool* buffer_pool) {
   RTC_DCHECK(!frames.empty());
 
   if (frames.size() == 1) {
@@ -64,7 +66,9 @@ std::unique_ptr<EncodedFrame> CombineAndDeleteFrames(
   }
   const EncodedFrame& last_frame = *frames.back();
   std::unique_ptr<EncodedFrame> first_frame = std::move(frames[0]);
-  auto encoded_image_buffer = EncodedImageBuffer::Create(total_length);
+  rtc::scoped_refptr<EncodedImageBuffer> encoded_image_buffer =
+      buffer_pool != nullptr ? buffer_pool->CreateBuffer(total_length)
+                             : EncodedImageBuffer::Create(total_length);
   uint8_t* buffer = encoded_image_buffer->data();
   first_frame->SetSpatialLayerFrameSize(first_frame->SpatialIndex().value_or(0),
                                         first_frame->size());
@@ -92,5 +96,18 @@ std::unique_ptr<EncodedFrame> CombineAndDeleteFrames(
   first_frame->SetEncodedData(encoded_image_buffer);
   return first_frame;
 }
+}  // namespace
+
+std::unique_ptr<EncodedFrame> CombineAndDeleteFrames(
+    absl::InlinedVector<std::unique_ptr<EncodedFrame>, 4> frames) {
+  return CombineAndDeleteFramesInternal(std::move(frames),
+                                        /*buffer_pool=*/nullptr);
+}
+
+std::unique_ptr<EncodedFrame> CombineAndDeleteFrames(
+    absl::InlinedVector<std::unique_ptr<EncodedFrame>, 4> frames,
+    EncodedImageBufferPool& buffer_pool) {
+  return CombineAndDeleteFramesInternal(std::move(frames), &buffer_pool);
+}
 
 }  // namespace webrtc
@@ -15,6 +15,7 @@
 
 #include "absl/container/inlined_vector.h"
 #include "api/video/encoded_frame.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 
 namespace webrtc {
 
@@ -24,6 +25,11 @@ bool TargetVideoDelayIsTooLarge(TimeDelta target_video_delay);
 
 std::unique_ptr<EncodedFrame> CombineAndDeleteFrames(
     absl::InlinedVector<std::unique_ptr<EncodedFrame>, 4> frames);
+// Same as above, but the buffer of a combined frame is taken from
+// `buffer_pool`.
+std::unique_ptr<EncodedFrame> CombineAndDeleteFrames(
+    absl::InlinedVector<std::unique_ptr<EncodedFrame>, 4> frames,
+    EncodedImageBufferPool& buffer_pool);
 
 }  // namespace webrtc
 
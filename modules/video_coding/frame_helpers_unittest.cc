@@ -10,7 +10,14 @@
 
 #include "modules/video_coding/frame_helpers.h"
 
+#include <memory>
+#include <utility>
+
+#include "absl/container/inlined_vector.h"
 #include "api/units/timestamp.h"
+#include "api/video/encoded_frame.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
+#include "test/fake_encoded_frame.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -30,5 +37,28 @@ TEST(FrameHasBadRenderTimingTest, LargeNegativeFrameDelayIsBad) {
   EXPECT_TRUE(FrameHasBadRenderTiming(render_time, now));
 }
 
+TEST(CombineAndDeleteFramesTest, CombinesSpatialLayersIntoPooledBuffer) {
+  EncodedImageBufferPool pool;
+  absl::InlinedVector<std::unique_ptr<EncodedFrame>, 4> frames;
+  frames.push_back(
+      test::FakeFrameBuilder().Time(0).Id(0).SpatialLayer(0).Size(10).Build());
+  frames.push_back(test::FakeFrameBuilder()
+                       .Time(0)
+                       .Id(1)
+                       .SpatialLayer(1)
+                       .Size(20)
+                       .AsLast()
+                       .Build());
+
+  std::unique_ptr<EncodedFrame> frame =
+      CombineAndDeleteFrames(std::move(frames), pool);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->size(), 30u);
+  EXPECT_EQ(frame->SpatialIndex(), 1);
+  EXPECT_EQ(frame->SpatialLayerFrameSize(0), 10u);
+  EXPECT_EQ(frame->SpatialLayerFrameSize(1), 20u);
+  EXPECT_EQ(pool.size(), 1u);
+}
+
 }  // namespace
 }  // namespace webrtc
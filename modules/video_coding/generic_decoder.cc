@@ -25,6 +25,7 @@
 #include "common_video/frame_instrumentation_data.h"
 #include "common_video/include/corruption_score_calculator.h"
 #include "modules/include/module_common_types_public.h"
+#include "modules/video_coding/decoded_frame_timing_sink.h"
 #include "modules/video_coding/include/video_error_codes.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -234,7 +235,10 @@ void VCMDecodedFrameCallback::Decoded(VideoFrame& decodedImage,
       "WebRTC.Video.GenericDecoder.DecodeDelay",
       timing_frame_info.decode_finish_ms - timing_frame_info.decode_start_ms);
   _timing->SetTimingFrameInfo(timing_frame_info);
-  
+  if (DecodedFrameTimingSinkInterface* sink = GetDecodedFrameTimingSink()) {
+    sink->OnDecodedFrameTiming(timing_frame_info);
+  }
+
   // Create and populate frame timing
   VideoFrame::FrameTiming frame_timing;
 
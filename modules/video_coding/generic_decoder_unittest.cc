@@ -25,10 +25,12 @@
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_frame_type.h"
+#include "api/video/video_timing.h"
 #include "api/video_codecs/video_decoder.h"
 #include "common_video/frame_instrumentation_data.h"
 #include "common_video/include/corruption_score_calculator.h"
 #include "common_video/test/utilities.h"
+#include "modules/video_coding/decoded_frame_timing_sink.h"
 #include "modules/video_coding/timing/timing.h"
 #include "system_wrappers/include/clock.h"
 #include "test/fake_decoder.h"
@@ -251,5 +253,37 @@ TEST_F(GenericDecoderTest, CallCalculateCorruptionScoreInDecoded) {
   EXPECT_EQ(user_callback_.last_corruption_score(), kCorruptionScore);
 }
 
+class RecordingFrameTimingSink : public DecodedFrameTimingSinkInterface {
+ public:
+  void OnDecodedFrameTiming(const TimingFrameInfo& timing) override {
+    timings_.push_back(timing);
+  }
+
+  const std::vector<TimingFrameInfo>& timings() const { return timings_; }
+
+ private:
+  std::vector<TimingFrameInfo> timings_;
+};
+
+TEST_F(GenericDecoderTest, ReportsTimingOfEveryDecodedFrameToSink) {
+  RecordingFrameTimingSink sink;
+  SetDecodedFrameTimingSink(&sink);
+  constexpr int kNumFrames = 3;
+  for (int i = 0; i < kNumFrames; ++i) {
+    EncodedFrame encoded_frame;
+    encoded_frame.SetRtpTimestamp(90000 * (i + 1));
+    generic_decoder_.Decode(encoded_frame, clock_->CurrentTime());
+    time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  }
+  SetDecodedFrameTimingSink(nullptr);
+
+  ASSERT_EQ(sink.timings().size(), static_cast<size_t>(kNumFrames));
+  for (int i = 0; i < kNumFrames; ++i) {
+    EXPECT_EQ(sink.timings()[i].rtp_timestamp, 90000u * (i + 1));
+    EXPECT_GE(sink.timings()[i].decode_finish_ms,
+              sink.timings()[i].decode_start_ms);
+  }
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -65,6 +66,40 @@ PacketBuffer::~PacketBuffer() {
   Clear();
 }
 
+std::unique_ptr<PacketBuffer::Packet> PacketBuffer::CreatePacket(
+    const RtpPacketReceived& rtp_packet,
+    int64_t sequence_number,
+    const RTPVideoHeader& video_header) {
+  if (free_packets_.empty()) {
+    return std::make_unique<Packet>(rtp_packet, sequence_number, video_header);
+  }
+  std::unique_ptr<Packet> packet = std::move(free_packets_.back());
+  free_packets_.pop_back();
+  // Construct the new packet in the memory of the recycled one.
+  std::destroy_at(packet.get());
+  std::construct_at(packet.get(), rtp_packet, sequence_number, video_header);
+  return packet;
+}
+
+void PacketBuffer::ReturnPackets(std::vector<std::unique_ptr<Packet>> packets) {
+  for (std::unique_ptr<Packet>& packet : packets) {
+    RecyclePacket(std::move(packet));
+  }
+  packets.clear();
+  if (packets.capacity() > spare_found_frames_.capacity()) {
+    spare_found_frames_ = std::move(packets);
+  }
+}
+
+void PacketBuffer::RecyclePacket(std::unique_ptr<Packet> packet) {
+  if (packet == nullptr || free_packets_.size() >= max_size_) {
+    return;
+  }
+  // Don't keep the RTP packet alive while the packet is unused.
+  packet->video_payload = rtc::CopyOnWriteBuffer();
+  free_packets_.push_back(std::move(packet));
+}
+
 PacketBuffer::InsertResult PacketBuffer::InsertPacket(
     std::unique_ptr<PacketBuffer::Packet> packet) {
   PacketBuffer::InsertResult result;
@@ -79,6 +114,7 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
     // If we have explicitly cleared past this packet then it's old,
     // don't insert it, just silently ignore it.
     if (is_cleared_to_first_seq_num_) {
+      RecyclePacket(std::move(packet));
       return result;
     }
 
@@ -95,6 +131,7 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
   if (buffer_[index] != nullptr) {
     // Duplicate packet, just delete the payload.
     if (buffer_[index]->seq_num() == packet->seq_num()) {
+      RecyclePacket(std::move(packet));
       return result;
     }
 
@@ -108,6 +145,7 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
       // Clear the buffer, delete payload, and return false to signal that a
       // new keyframe is needed.
       RTC_LOG(LS_WARNING) << "Clear PacketBuffer and request key frame.";
+      RecyclePacket(std::move(packet));
       ClearInternal();
       result.buffer_cleared = true;
       return result;
@@ -146,7 +184,7 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   for (size_t i = 0; i < iterations; ++i) {
     auto& stored = buffer_[first_seq_num_ % buffer_.size()];
     if (stored != nullptr && AheadOf<uint16_t>(seq_num, stored->seq_num())) {
-      stored = nullptr;
+      RecyclePacket(std::move(stored));
     }
     ++first_seq_num_;
   }
@@ -185,7 +223,7 @@ void PacketBuffer::ResetSpsPpsIdrIsH264Keyframe() {
 
 void PacketBuffer::ClearInternal() {
   for (auto& entry : buffer_) {
-    entry = nullptr;
+    RecyclePacket(std::move(entry));
   }
 
   first_packet_received_ = false;
@@ -240,7 +278,9 @@ bool PacketBuffer::PotentialNewFrame(uint16_t seq_num) const {
 
 std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
     uint16_t seq_num) {
-  std::vector<std::unique_ptr<PacketBuffer::Packet>> found_frames;
+  std::vector<std::unique_ptr<PacketBuffer::Packet>> found_frames =
+      std::move(spare_found_frames_);
+  spare_found_frames_.clear();
   auto start = seq_num;
 
   for (size_t i = 0; i < buffer_.size(); ++i) {
@@ -77,6 +77,16 @@ class PacketBuffer {
   PacketBuffer(size_t start_buffer_size, size_t max_buffer_size);
   ~PacketBuffer();
 
+  // Returns a packet to be filled in and passed to InsertPacket(). Packets
+  // dropped by the buffer or handed back with ReturnPackets() are reused, so
+  // that a steady stream of packets does not allocate.
+  std::unique_ptr<Packet> CreatePacket(const RtpPacketReceived& rtp_packet,
+                                       int64_t sequence_number,
+                                       const RTPVideoHeader& video_header);
+  // Hands back the packets of an InsertResult once their frames have been
+  // assembled. The capacity of `packets` is reused for the next result.
+  void ReturnPackets(std::vector<std::unique_ptr<Packet>> packets);
+
   ABSL_MUST_USE_RESULT InsertResult
   InsertPacket(std::unique_ptr<Packet> packet);
   ABSL_MUST_USE_RESULT InsertResult InsertPadding(uint16_t seq_num);
@@ -101,6 +111,9 @@ class PacketBuffer {
 
   void UpdateMissingPackets(uint16_t seq_num);
 
+  // Keeps `packet` for reuse by CreatePacket().
+  void RecyclePacket(std::unique_ptr<Packet> packet);
+
   // buffer_.size() and max_size_ must always be a power of two.
   const size_t max_size_;
 
@@ -117,6 +130,12 @@ class PacketBuffer {
   // determine continuity between them.
   std::vector<std::unique_ptr<Packet>> buffer_;
 
+  // Packets to be handed out by CreatePacket(), at most `max_size_`. Their
+  // payload has been released.
+  std::vector<std::unique_ptr<Packet>> free_packets_;
+  // Empty vector whose capacity is reused for the packets of found frames.
+  std::vector<std::unique_ptr<Packet>> spare_found_frames_;
+
   std::optional<uint16_t> newest_inserted_seq_num_;
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_;
 
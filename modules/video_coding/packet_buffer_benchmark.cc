@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/video/video_codec_type.h"
+#include "api/video/video_frame_type.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/video_coding/packet_buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+using video_coding::PacketBuffer;
+
+// One second of 50 fps video at 20000 packets per second.
+constexpr int kPacketsPerSecond = 20000;
+constexpr int kFramesPerSecond = 50;
+constexpr int kPacketsPerFrame = kPacketsPerSecond / kFramesPerSecond;
+static_assert(kPacketsPerSecond % kFramesPerSecond == 0);
+constexpr uint32_t kRtpTicksPerFrame = 90000 / kFramesPerSecond;
+// Packets are shuffled within windows of this many packets.
+constexpr int kReorderWindow = 8;
+// One packet in this many is lost and arrives as a retransmission
+// `kRetransmissionDelay` packets later.
+constexpr int kLossInterval = 100;
+constexpr int kRetransmissionDelay = 64;
+constexpr size_t kPayloadSize = 1200;
+// As used by RtpVideoStreamReceiver2.
+constexpr size_t kStartBufferSize = 512;
+constexpr size_t kMaxBufferSize = 2048;
+
+// Arrival order of one second of packets, as offsets from the first sequence
+// number of that second.
+std::vector<int> ArrivalOrder() {
+  Random random(0x1234);
+  std::vector<int> order(kPacketsPerSecond);
+  for (int i = 0; i < kPacketsPerSecond; ++i) {
+    order[i] = i;
+  }
+  for (int i = 0; i < kPacketsPerSecond; i += kReorderWindow) {
+    for (int j = std::min(i + kReorderWindow, kPacketsPerSecond) - 1; j > i;
+         --j) {
+      std::swap(order[j], order[i + random.Rand(j - i)]);
+    }
+  }
+  for (int i = kLossInterval / 2; i < kPacketsPerSecond; i += kLossInterval) {
+    const int lost = order[i];
+    const int arrival =
+        std::min(i + kRetransmissionDelay, kPacketsPerSecond - 1);
+    order.erase(order.begin() + i);
+    order.insert(order.begin() + arrival, lost);
+  }
+  return order;
+}
+
+class PacketBufferFixture {
+ public:
+  PacketBufferFixture()
+      : packet_buffer_(kStartBufferSize, kMaxBufferSize),
+        arrival_order_(ArrivalOrder()),
+        payload_(kPayloadSize) {
+    rtp_packet_.SetPayloadType(96);
+    rtp_packet_.SetSsrc(0x1234);
+    video_header_.codec = kVideoCodecGeneric;
+    video_header_.frame_type = VideoFrameType::kVideoFrameDelta;
+  }
+
+  // Inserts one second of packets. With `recycle_packets` packets are created
+  // with PacketBuffer::CreatePacket() and returned once the frames are found,
+  // otherwise every packet is allocated and the result is dropped.
+  int InsertPackets(bool recycle_packets) {
+    int frames = 0;
+    for (int offset : arrival_order_) {
+      const int64_t sequence_number = first_sequence_number_ + offset;
+      const int frame_index = offset / kPacketsPerFrame;
+      rtp_packet_.SetSequenceNumber(static_cast<uint16_t>(sequence_number));
+      rtp_packet_.SetTimestamp(first_timestamp_ +
+                               frame_index * kRtpTicksPerFrame);
+      video_header_.is_first_packet_in_frame = offset % kPacketsPerFrame == 0;
+      video_header_.is_last_packet_in_frame =
+          offset % kPacketsPerFrame == kPacketsPerFrame - 1;
+      rtp_packet_.SetMarker(video_header_.is_last_packet_in_frame);
+
+      std::unique_ptr<PacketBuffer::Packet> packet =
+          recycle_packets
+              ? packet_buffer_.CreatePacket(rtp_packet_, sequence_number,
+                                            video_header_)
+              : std::make_unique<PacketBuffer::Packet>(
+                    rtp_packet_, sequence_number, video_header_);
+      packet->video_payload = payload_;
+      PacketBuffer::InsertResult result =
+          packet_buffer_.InsertPacket(std::move(packet));
+      if (result.packets.empty()) {
+        continue;
+      }
+      for (const auto& found : result.packets) {
+        frames += found->is_last_packet_in_frame();
+      }
+      // As RtpVideoStreamReceiver2 does once the frames have been decoded.
+      const uint16_t last_seq_num = result.packets.back()->seq_num();
+      if (recycle_packets) {
+        packet_buffer_.ReturnPackets(std::move(result.packets));
+      }
+      packet_buffer_.ClearTo(last_seq_num);
+    }
+    first_sequence_number_ += kPacketsPerSecond;
+    first_timestamp_ += kFramesPerSecond * kRtpTicksPerFrame;
+    return frames;
+  }
+
+ private:
+  PacketBuffer packet_buffer_;
+  const std::vector<int> arrival_order_;
+  const rtc::CopyOnWriteBuffer payload_;
+  RtpPacketReceived rtp_packet_;
+  RTPVideoHeader video_header_;
+  int64_t first_sequence_number_ = 0;
+  uint32_t first_timestamp_ = 0;
+};
+
+void BM_InsertPacketsAllocating(benchmark::State& state) {
+  PacketBufferFixture fixture;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    benchmark::DoNotOptimize(fixture.InsertPackets(/*recycle_packets=*/false));
+  }
+  state.SetItemsProcessed(state.iterations() * kPacketsPerSecond);
+}
+
+void BM_InsertPacketsRecycled(benchmark::State& state) {
+  PacketBufferFixture fixture;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    benchmark::DoNotOptimize(fixture.InsertPackets(/*recycle_packets=*/true));
+  }
+  state.SetItemsProcessed(state.iterations() * kPacketsPerSecond);
+}
+
+BENCHMARK(BM_InsertPacketsAllocating);
+BENCHMARK(BM_InsertPacketsRecycled);
+
+}  // namespace
+}  // namespace webrtc
@@ -281,6 +281,53 @@ TEST_F(PacketBufferTest, Frames) {
               StartSeqNumsAre(seq_num + 3));
 }
 
+TEST_F(PacketBufferTest, CreatePacketReusesReturnedPackets) {
+  RtpPacketReceived rtp_packet;
+  rtp_packet.SetSequenceNumber(1);
+  RTPVideoHeader video_header;
+  video_header.codec = kVideoCodecGeneric;
+  video_header.is_first_packet_in_frame = true;
+  video_header.is_last_packet_in_frame = true;
+  std::unique_ptr<PacketBuffer::Packet> packet =
+      packet_buffer_.CreatePacket(rtp_packet, 1, video_header);
+  const PacketBuffer::Packet* const packet_memory = packet.get();
+  const uint8_t kPayload[] = {1, 2, 3};
+  packet->video_payload.SetData(kPayload);
+  packet->times_nacked = 2;
+
+  PacketBuffer::InsertResult result =
+      packet_buffer_.InsertPacket(std::move(packet));
+  ASSERT_THAT(result.packets, SizeIs(1));
+  EXPECT_EQ(result.packets[0].get(), packet_memory);
+  packet_buffer_.ReturnPackets(std::move(result.packets));
+
+  rtp_packet.SetSequenceNumber(2);
+  packet = packet_buffer_.CreatePacket(rtp_packet, 2, video_header);
+  EXPECT_EQ(packet.get(), packet_memory);
+  EXPECT_EQ(packet->seq_num(), 2);
+  EXPECT_EQ(packet->times_nacked, -1);
+  EXPECT_FALSE(packet->continuous);
+  EXPECT_EQ(packet->video_payload.size(), 0u);
+}
+
+TEST_F(PacketBufferTest, CreatePacketReusesClearedPackets) {
+  RtpPacketReceived rtp_packet;
+  rtp_packet.SetSequenceNumber(1);
+  RTPVideoHeader video_header;
+  video_header.codec = kVideoCodecGeneric;
+  video_header.is_first_packet_in_frame = true;
+  std::unique_ptr<PacketBuffer::Packet> packet =
+      packet_buffer_.CreatePacket(rtp_packet, 1, video_header);
+  const PacketBuffer::Packet* const packet_memory = packet.get();
+  EXPECT_THAT(packet_buffer_.InsertPacket(std::move(packet)).packets,
+              IsEmpty());
+  packet_buffer_.ClearTo(1);
+
+  rtp_packet.SetSequenceNumber(2);
+  EXPECT_EQ(packet_buffer_.CreatePacket(rtp_packet, 2, video_header).get(),
+            packet_memory);
+}
+
 TEST_F(PacketBufferTest, ClearSinglePacket) {
   const int64_t seq_num = Rand();
 
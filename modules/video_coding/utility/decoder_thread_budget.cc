@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/decoder_thread_budget.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+DecoderThreadBudget::Lease::Lease(DecoderThreadBudget* budget,
+                                  int wanted_threads,
+                                  int num_threads)
+    : budget_(budget),
+      wanted_threads_(wanted_threads),
+      num_threads_(num_threads) {}
+
+DecoderThreadBudget::Lease::Lease(Lease&& other)
+    : budget_(std::exchange(other.budget_, nullptr)),
+      wanted_threads_(std::exchange(other.wanted_threads_, 0)),
+      num_threads_(std::exchange(other.num_threads_, 0)) {}
+
+DecoderThreadBudget::Lease& DecoderThreadBudget::Lease::operator=(
+    Lease&& other) {
+  if (this != &other) {
+    if (budget_ != nullptr) {
+      budget_->Release(wanted_threads_);
+    }
+    budget_ = std::exchange(other.budget_, nullptr);
+    wanted_threads_ = std::exchange(other.wanted_threads_, 0);
+    num_threads_ = std::exchange(other.num_threads_, 0);
+  }
+  return *this;
+}
+
+DecoderThreadBudget::Lease::~Lease() {
+  if (budget_ != nullptr) {
+    budget_->Release(wanted_threads_);
+  }
+}
+
+DecoderThreadBudget& DecoderThreadBudget::Get() {
+  static DecoderThreadBudget* const budget =
+      new DecoderThreadBudget(CpuInfo::DetectNumberOfCores());
+  return *budget;
+}
+
+int DecoderThreadBudget::ThreadsForResolution(int width, int height) {
+  // For common resolutions this results in:
+  // 1 for 360p
+  // 2 for 720p
+  // 4 for 1080p
+  // 8 for 1440p
+  // 18 for 4K
+  return std::max(
+      1, static_cast<int>(2 * int64_t{width} * height / (1280 * 720)));
+}
+
+DecoderThreadBudget::DecoderThreadBudget(int num_threads)
+    : num_threads_(std::max(1, num_threads)) {}
+
+DecoderThreadBudget::~DecoderThreadBudget() {
+  RTC_DCHECK_EQ(wanted_threads_, 0);
+}
+
+DecoderThreadBudget::Lease DecoderThreadBudget::Acquire(int wanted_threads) {
+  wanted_threads = std::max(1, wanted_threads);
+  int num_threads;
+  {
+    MutexLock lock(&mutex_);
+    wanted_threads_ += wanted_threads;
+    num_threads =
+        wanted_threads_ <= num_threads_
+            ? wanted_threads
+            : std::max(1, static_cast<int>(int64_t{wanted_threads} *
+                                           num_threads_ / wanted_threads_));
+  }
+  return Lease(this, wanted_threads, num_threads);
+}
+
+int DecoderThreadBudget::wanted_threads() const {
+  MutexLock lock(&mutex_);
+  return wanted_threads_;
+}
+
+void DecoderThreadBudget::Release(int wanted_threads) {
+  MutexLock lock(&mutex_);
+  wanted_threads_ -= wanted_threads;
+  RTC_DCHECK_GE(wanted_threads_, 0);
+}
+
+}  // namespace webrtc
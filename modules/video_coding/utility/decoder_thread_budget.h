@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_DECODER_THREAD_BUDGET_H_
+#define MODULES_VIDEO_CODING_UTILITY_DECODER_THREAD_BUDGET_H_
+
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Shares the cores of the machine between the multithreaded software decoders
+// of the process. Each decoder asks for the number of tile threads its
+// resolution can use and gets a lease. As long as the sum of the requests
+// fits the budget every decoder gets what it asked for; otherwise the budget
+// is split in proportion to the requests, with at least one thread per
+// decoder, so that many concurrent streams don't start more threads than
+// there are cores.
+//
+// Grants are computed when a lease is acquired. Decoders acquire a new lease
+// when they are reconfigured, e.g. on a resolution change, which is when the
+// threads are rebalanced.
+class DecoderThreadBudget {
+ public:
+  // Threads granted to one decoder, returned to the budget on destruction.
+  class Lease {
+   public:
+    Lease() = default;
+    Lease(Lease&& other);
+    Lease& operator=(Lease&& other);
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    ~Lease();
+
+    // Number of threads the decoder may use. Zero for a default constructed
+    // lease.
+    int num_threads() const { return num_threads_; }
+
+   private:
+    friend class DecoderThreadBudget;
+    Lease(DecoderThreadBudget* budget, int wanted_threads, int num_threads);
+
+    DecoderThreadBudget* budget_ = nullptr;
+    int wanted_threads_ = 0;
+    int num_threads_ = 0;
+  };
+
+  // The budget shared by all decoders of the process, with one thread per
+  // core.
+  static DecoderThreadBudget& Get();
+
+  // Number of threads a decoder wants for frames of `width`x`height`: two for
+  // 1280x720, scaled linearly by pixel count, and at least one.
+  static int ThreadsForResolution(int width, int height);
+
+  explicit DecoderThreadBudget(int num_threads);
+  DecoderThreadBudget(const DecoderThreadBudget&) = delete;
+  DecoderThreadBudget& operator=(const DecoderThreadBudget&) = delete;
+  ~DecoderThreadBudget();
+
+  // Acquires between one and `wanted_threads` threads.
+  Lease Acquire(int wanted_threads);
+
+  // Sum of the threads wanted by all leases.
+  int wanted_threads() const;
+
+ private:
+  void Release(int wanted_threads);
+
+  const int num_threads_;
+  mutable Mutex mutex_;
+  int wanted_threads_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_DECODER_THREAD_BUDGET_H_
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/decoder_thread_budget.h"
+
+#include <utility>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(DecoderThreadBudgetTest, ThreadsForResolution) {
+  EXPECT_EQ(DecoderThreadBudget::ThreadsForResolution(320, 180), 1);
+  EXPECT_EQ(DecoderThreadBudget::ThreadsForResolution(640, 360), 1);
+  EXPECT_EQ(DecoderThreadBudget::ThreadsForResolution(1280, 720), 2);
+  EXPECT_EQ(DecoderThreadBudget::ThreadsForResolution(1920, 1080), 4);
+  EXPECT_EQ(DecoderThreadBudget::ThreadsForResolution(3840, 2160), 18);
+}
+
+TEST(DecoderThreadBudgetTest, GrantsWantedThreadsWhenBudgetSuffices) {
+  DecoderThreadBudget budget(/*num_threads=*/8);
+  DecoderThreadBudget::Lease lease1 = budget.Acquire(4);
+  DecoderThreadBudget::Lease lease2 = budget.Acquire(4);
+  EXPECT_EQ(lease1.num_threads(), 4);
+  EXPECT_EQ(lease2.num_threads(), 4);
+  EXPECT_EQ(budget.wanted_threads(), 8);
+}
+
+TEST(DecoderThreadBudgetTest, SplitsBudgetInProportionWhenOversubscribed) {
+  DecoderThreadBudget budget(/*num_threads=*/8);
+  DecoderThreadBudget::Lease lease1 = budget.Acquire(4);
+  DecoderThreadBudget::Lease lease2 = budget.Acquire(4);
+  DecoderThreadBudget::Lease lease3 = budget.Acquire(8);
+  EXPECT_EQ(lease3.num_threads(), 4);
+  DecoderThreadBudget::Lease lease4 = budget.Acquire(2);
+  EXPECT_EQ(lease4.num_threads(), 1);
+}
+
+TEST(DecoderThreadBudgetTest, GrantsAtLeastOneThread) {
+  DecoderThreadBudget budget(/*num_threads=*/2);
+  DecoderThreadBudget::Lease lease1 = budget.Acquire(18);
+  DecoderThreadBudget::Lease lease2 = budget.Acquire(1);
+  EXPECT_EQ(lease1.num_threads(), 2);
+  EXPECT_EQ(lease2.num_threads(), 1);
+  DecoderThreadBudget::Lease lease3 = budget.Acquire(0);
+  EXPECT_EQ(lease3.num_threads(), 1);
+}
+
+TEST(DecoderThreadBudgetTest, ReleasedLeasesReturnThreadsToBudget) {
+  DecoderThreadBudget budget(/*num_threads=*/4);
+  DecoderThreadBudget::Lease lease1 = budget.Acquire(4);
+  {
+    DecoderThreadBudget::Lease lease2 = budget.Acquire(4);
+    EXPECT_EQ(lease2.num_threads(), 2);
+  }
+  EXPECT_EQ(budget.wanted_threads(), 4);
+
+  // Reacquiring, as a decoder does on a resolution change, is rebalanced
+  // against the remaining leases only.
+  lease1 = DecoderThreadBudget::Lease();
+  lease1 = budget.Acquire(4);
+  EXPECT_EQ(lease1.num_threads(), 4);
+  EXPECT_EQ(budget.wanted_threads(), 4);
+}
+
+TEST(DecoderThreadBudgetTest, MovedLeaseIsReleasedOnce) {
+  DecoderThreadBudget budget(/*num_threads=*/4);
+  {
+    DecoderThreadBudget::Lease lease1 = budget.Acquire(2);
+    DecoderThreadBudget::Lease lease2 = std::move(lease1);
+    EXPECT_EQ(lease1.num_threads(), 0);
+    EXPECT_EQ(lease2.num_threads(), 2);
+    EXPECT_EQ(budget.wanted_threads(), 2);
+  }
+  EXPECT_EQ(budget.wanted_threads(), 0);
+}
+
+}  // namespace
+}  // namespace webrtc
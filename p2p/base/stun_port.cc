@@ -15,6 +15,7 @@
 
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
+#include "api/array_view.h"
 #include "api/transport/stun.h"
 #include "p2p/base/connection.h"
 #include "p2p/base/p2p_constants.h"
@@ -205,9 +206,10 @@ bool UDPPort::Init() {
       RTC_LOG(LS_WARNING) << ToString() << ": UDP socket creation failed";
       return false;
     }
-    socket_->RegisterReceivedPacketCallback(
-        [&](rtc::AsyncPacketSocket* socket, const rtc::ReceivedPacket& packet) {
-          OnReadPacket(socket, packet);
+    socket_->RegisterReceivedPacketBatchCallback(
+        [&](rtc::AsyncPacketSocket* socket,
+            rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+          OnReadPackets(socket, packets);
         });
   }
   socket_->SignalSentPacket.connect(this, &UDPPort::OnSentPacket);
@@ -396,6 +398,15 @@ void UDPPort::OnReadPacket(rtc::AsyncPacketSocket* socket,
   }
 }
 
+void UDPPort::OnReadPackets(rtc::AsyncPacketSocket* socket,
+                            rtc::ArrayView<const rtc::ReceivedPacket> packets) {
+  // Connections still take one packet at a time. The connection is looked up
+  // for every packet, since handling a packet may destroy a connection.
+  for (const rtc::ReceivedPacket& packet : packets) {
+    OnReadPacket(socket, packet);
+  }
+}
+
 void UDPPort::OnSentPacket(rtc::AsyncPacketSocket* /* socket */,
                            const rtc::SentPacket& sent_packet) {
   PortInterface::SignalSentPacket(sent_packet);
@@ -22,6 +22,7 @@
 #include "rtc_base/internal/default_socket_server.h"
 #include "rtc_base/socket_server.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
 
 namespace webrtc {
 
@@ -180,6 +181,11 @@ ConnectionContext::~ConnectionContext() {
   RTC_DCHECK_RUN_ON(signaling_thread_);
   // `media_engine_` requires destruction to happen on the worker thread.
   worker_thread_->PostTask([media_engine = std::move(media_engine_)] {});
+  // Joining the pool threads may block, so don't do it on this thread.
+  if (decode_thread_pool_) {
+    worker_thread_->PostTask(
+        [decode_thread_pool = std::move(decode_thread_pool_)] {});
+  }
 
   // Make sure `worker_thread()` and `signaling_thread()` outlive
   // `default_socket_factory_` and `default_network_manager_`.
@@ -190,4 +196,13 @@ ConnectionContext::~ConnectionContext() {
     rtc::ThreadManager::Instance()->UnwrapCurrentThread();
 }
 
+DecodeThreadPool* ConnectionContext::decode_thread_pool() {
+  RTC_DCHECK_RUN_ON(worker_thread());
+  if (!decode_thread_pool_) {
+    decode_thread_pool_ =
+        std::make_unique<DecodeThreadPool>(CpuInfo::DetectNumberOfCores());
+  }
+  return decode_thread_pool_.get();
+}
+
 }  // namespace webrtc
@@ -30,6 +30,7 @@
 #include "rtc_base/socket_factory.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/thread_annotations.h"
+#include "video/decode_thread_pool.h"
 
 namespace rtc {
 class BasicPacketSocketFactory;
@@ -91,6 +92,9 @@ class ConnectionContext final : public RefCountedNonVirtual<ConnectionContext> {
     RTC_DCHECK_RUN_ON(worker_thread());
     return call_factory_.get();
   }
+  // Returns the decode thread pool shared by the calls of all PeerConnections
+  // that enable it. Created on first use.
+  DecodeThreadPool* decode_thread_pool();
   rtc::UniqueRandomIdGenerator* ssrc_generator() { return &ssrc_generator_; }
   // Note: There is lots of code that wants to know whether or not we
   // use RTX, but so far, no code has been found that sets it to false.
@@ -136,6 +140,10 @@ class ConnectionContext final : public RefCountedNonVirtual<ConnectionContext> {
       RTC_GUARDED_BY(signaling_thread_);
   std::unique_ptr<MediaFactory> const call_factory_
       RTC_GUARDED_BY(worker_thread());
+  // Outlives the calls that use it, since every PeerConnection holds a
+  // reference to this object.
+  std::unique_ptr<DecodeThreadPool> decode_thread_pool_
+      RTC_GUARDED_BY(worker_thread());
 
   std::unique_ptr<rtc::PacketSocketFactory> default_socket_factory_
       RTC_GUARDED_BY(signaling_thread_);
@@ -502,6 +502,7 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
     std::vector<rtc::NetworkMask> vpn_list;
     PortAllocatorConfig port_allocator_config;
     std::optional<TimeDelta> pacer_burst_interval;
+    bool enable_decode_thread_pool;
     std::string logging_folder;
   };
   static_assert(sizeof(stuff_being_tested_for_equality) == sizeof(*this),
@@ -565,6 +566,7 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
          port_allocator_config.max_port == o.port_allocator_config.max_port &&
          port_allocator_config.flags == o.port_allocator_config.flags &&
          pacer_burst_interval == o.pacer_burst_interval &&
+         enable_decode_thread_pool == o.enable_decode_thread_pool &&
          logging_folder == o.logging_folder;
 }
 
@@ -1448,6 +1450,19 @@ void PeerConnection::GetStats(
   RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(2);
 }
 
+void PeerConnection::GetSelectedStats(
+    const std::set<std::string>& stats_types,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  TRACE_EVENT0("webrtc", "PeerConnection::GetSelectedStats");
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  RTC_DCHECK(stats_collector_);
+  RTC_DCHECK(callback);
+  RTC_LOG_THREAD_BLOCK_COUNT();
+  stats_collector_->GetSelectedStatsReport(stats_types, std::move(callback));
+  // Only selections that need a full gathering block.
+  RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(2);
+}
+
 PeerConnectionInterface::SignalingState PeerConnection::signaling_state() {
   RTC_DCHECK_RUN_ON(signaling_thread());
   return sdp_handler_->signaling_state();
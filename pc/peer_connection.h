@@ -178,6 +178,9 @@ class PeerConnection : public PeerConnectionInternal,
   void GetStats(
       rtc::scoped_refptr<RtpReceiverInterface> selector,
       rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override;
+  void GetSelectedStats(
+      const std::set<std::string>& stats_types,
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override;
   void ClearStatsCache() override;
 
   SignalingState signaling_state() override;
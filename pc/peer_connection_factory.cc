@@ -360,6 +360,9 @@ std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
   call_config.decode_metronome = decode_metronome_.get();
   call_config.encode_metronome = encode_metronome_.get();
   call_config.pacer_burst_interval = configuration.pacer_burst_interval;
+  if (configuration.enable_decode_thread_pool) {
+    call_config.decode_thread_pool = context_->decode_thread_pool();
+  }
   call_config.logging_folder = configuration.logging_folder;
   return context_->call_factory()->CreateCall(std::move(call_config));
 }
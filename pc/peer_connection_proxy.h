@@ -12,6 +12,7 @@
 #define PC_PEER_CONNECTION_PROXY_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -82,6 +83,10 @@ PROXY_METHOD2(void,
               GetStats,
               rtc::scoped_refptr<RtpReceiverInterface>,
               rtc::scoped_refptr<RTCStatsCollectorCallback>)
+PROXY_METHOD2(void,
+              GetSelectedStats,
+              const std::set<std::string>&,
+              rtc::scoped_refptr<RTCStatsCollectorCallback>)
 PROXY_METHOD0(void, ClearStatsCache)
 PROXY_METHOD2(RTCErrorOr<rtc::scoped_refptr<DataChannelInterface>>,
               CreateDataChannelOrError,
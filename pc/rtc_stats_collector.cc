@@ -1041,6 +1041,55 @@ void SetAudioProcessingStats(StatsType* stats,
   }
 }
 
+// Stats types that ProduceRTPStreamStats_n() makes from receiver infos and
+// sender infos respectively. Codecs come from both.
+bool SelectsReceiveRtpStats(const std::set<std::string>& stats_types) {
+  return stats_types.count(RTCInboundRtpStreamStats::kType) ||
+         stats_types.count(RTCRemoteOutboundRtpStreamStats::kType) ||
+         stats_types.count(RTCCodecStats::kType);
+}
+
+bool SelectsSendRtpStats(const std::set<std::string>& stats_types) {
+  return stats_types.count(RTCOutboundRtpStreamStats::kType) ||
+         stats_types.count(RTCRemoteInboundRtpStreamStats::kType) ||
+         stats_types.count(RTCCodecStats::kType);
+}
+
+bool SelectsIceStats(const std::set<std::string>& stats_types) {
+  return stats_types.count(RTCIceCandidatePairStats::kType) ||
+         stats_types.count(RTCLocalIceCandidateStats::kType) ||
+         stats_types.count(RTCRemoteIceCandidateStats::kType);
+}
+
+// Whether none of `stats_types` is produced on the signaling thread.
+bool CanSelectOnNetworkThread(const std::set<std::string>& stats_types) {
+  return !stats_types.count(RTCAudioSourceStats::kType) &&
+         !stats_types.count(RTCPeerConnectionStats::kType) &&
+         !stats_types.count(RTCAudioPlayoutStats::kType);
+}
+
+rtc::scoped_refptr<const RTCStatsReport> CreateReportFilteredByType(
+    rtc::scoped_refptr<const RTCStatsReport> report,
+    const std::set<std::string>& stats_types) {
+  bool all_selected = true;
+  for (const RTCStats& stats : *report) {
+    if (!stats_types.count(stats.type())) {
+      all_selected = false;
+      break;
+    }
+  }
+  // Reports from a selected gathering usually need no filtering.
+  if (all_selected)
+    return report;
+  rtc::scoped_refptr<RTCStatsReport> filtered_report =
+      RTCStatsReport::Create(report->timestamp());
+  for (const RTCStats& stats : *report) {
+    if (stats_types.count(stats.type()))
+      filtered_report->AddStats(stats.copy());
+  }
+  return filtered_report;
+}
+
 }  // namespace
 
 rtc::scoped_refptr<RTCStatsReport>
@@ -1118,6 +1167,16 @@ RTCStatsCollector::RequestInfo::RequestInfo(
                   nullptr,
                   std::move(selector)) {}
 
+RTCStatsCollector::RequestInfo::RequestInfo(
+    std::set<std::string> stats_types,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback)
+    : RequestInfo(FilterMode::kStatsTypes,
+                  std::move(callback),
+                  nullptr,
+                  nullptr) {
+  stats_types_ = std::move(stats_types);
+}
+
 RTCStatsCollector::RequestInfo::RequestInfo(
     RTCStatsCollector::RequestInfo::FilterMode filter_mode,
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback,
@@ -1182,15 +1241,30 @@ void RTCStatsCollector::GetStatsReport(
   GetStatsReportInternal(RequestInfo(std::move(selector), std::move(callback)));
 }
 
+void RTCStatsCollector::GetSelectedStatsReport(
+    std::set<std::string> stats_types,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  GetStatsReportInternal(
+      RequestInfo(std::move(stats_types), std::move(callback)));
+}
+
 void RTCStatsCollector::GetStatsReportInternal(
     RTCStatsCollector::RequestInfo request) {
   RTC_DCHECK_RUN_ON(signaling_thread_);
-  requests_.push_back(std::move(request));
 
   // "Now" using a monotonically increasing timer.
   int64_t cache_now_us = rtc::TimeMicros();
-  if (cached_report_ &&
-      cache_now_us - cache_timestamp_us_ <= cache_lifetime_us_) {
+  bool cache_is_fresh =
+      cached_report_ &&
+      cache_now_us - cache_timestamp_us_ <= cache_lifetime_us_;
+  if (!cache_is_fresh && num_pending_partial_reports_ &&
+      !PendingGatheringCovers(request)) {
+    deferred_requests_.push_back(std::move(request));
+    return;
+  }
+  requests_.push_back(std::move(request));
+
+  if (cache_is_fresh) {
     // We have a fresh cached report to deliver. Deliver asynchronously, since
     // the caller may not be expecting a synchronous callback, and it avoids
     // reentrancy problems.
@@ -1214,9 +1288,21 @@ void RTCStatsCollector::GetStatsReportInternal(
             // and is not necessarily monotonically increasing.
             Timestamp::Micros(rtc::TimeUTCMicros());
 
-    num_pending_partial_reports_ = 2;
     partial_report_timestamp_us_ = cache_now_us;
 
+    // Only the request that started a gathering decides what it produces.
+    RTC_DCHECK_EQ(requests_.size(), 1u);
+    const RequestInfo& first_request = requests_.front();
+    if (first_request.filter_mode() == RequestInfo::FilterMode::kStatsTypes &&
+        CanSelectOnNetworkThread(first_request.stats_types())) {
+      selected_stats_types_ = first_request.stats_types();
+      num_pending_partial_reports_ = 1;
+      StartSelectedStatsGathering_s(timestamp);
+      return;
+    }
+    selected_stats_types_ = std::nullopt;
+    num_pending_partial_reports_ = 2;
+
     // Prepare `transceiver_stats_infos_` and `call_stats_` for use in
     // `ProducePartialResultsOnNetworkThread` and
     // `ProducePartialResultsOnSignalingThread`.
@@ -1236,6 +1322,23 @@ void RTCStatsCollector::GetStatsReportInternal(
   }
 }
 
+bool RTCStatsCollector::PendingGatheringCovers(
+    const RequestInfo& request) const {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  if (!selected_stats_types_) {
+    return true;
+  }
+  if (request.filter_mode() != RequestInfo::FilterMode::kStatsTypes) {
+    return false;
+  }
+  for (const std::string& type : request.stats_types()) {
+    if (!selected_stats_types_->count(type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void RTCStatsCollector::ClearCachedStatsReport() {
   RTC_DCHECK_RUN_ON(signaling_thread_);
   cached_report_ = nullptr;
@@ -1246,8 +1349,11 @@ void RTCStatsCollector::ClearCachedStatsReport() {
 void RTCStatsCollector::WaitForPendingRequest() {
   RTC_DCHECK_RUN_ON(signaling_thread_);
   // If a request is pending, blocks until the `network_report_event_` is
-  // signaled and then delivers the result. Otherwise this is a NO-OP.
-  MergeNetworkReport_s();
+  // signaled and then delivers the result. Otherwise this is a NO-OP. Requests
+  // deferred by a selected gathering start another one when it completes.
+  do {
+    MergeNetworkReport_s();
+  } while (num_pending_partial_reports_ > 0);
 }
 
 void RTCStatsCollector::ProducePartialResultsOnSignalingThread(
@@ -1290,26 +1396,31 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
   // `network_report_event_` is reset before this method is invoked.
   network_report_ = RTCStatsReport::Create(timestamp);
 
-  ProduceDataChannelStats_n(timestamp, network_report_.get());
+  if (selected_stats_types_) {
+    ProduceSelectedResults_n(timestamp, std::move(sctp_transport_name),
+                             network_report_.get());
+  } else {
+    ProduceDataChannelStats_n(timestamp, network_report_.get());
 
-  std::set<std::string> transport_names;
-  if (sctp_transport_name) {
-    transport_names.emplace(std::move(*sctp_transport_name));
-  }
+    std::set<std::string> transport_names;
+    if (sctp_transport_name) {
+      transport_names.emplace(std::move(*sctp_transport_name));
+    }
 
-  for (const auto& info : transceiver_stats_infos_) {
-    if (info.transport_name)
-      transport_names.insert(*info.transport_name);
-  }
+    for (const auto& info : transceiver_stats_infos_) {
+      if (info.transport_name)
+        transport_names.insert(*info.transport_name);
+    }
 
-  std::map<std::string, cricket::TransportStats> transport_stats_by_name =
-      pc_->GetTransportStatsByNames(transport_names);
-  std::map<std::string, CertificateStatsPair> transport_cert_stats =
-      PrepareTransportCertificateStats_n(transport_stats_by_name);
+    std::map<std::string, cricket::TransportStats> transport_stats_by_name =
+        pc_->GetTransportStatsByNames(transport_names);
+    std::map<std::string, CertificateStatsPair> transport_cert_stats =
+        PrepareTransportCertificateStats_n(transport_stats_by_name);
 
-  ProducePartialResultsOnNetworkThreadImpl(timestamp, transport_stats_by_name,
-                                           transport_cert_stats,
-                                           network_report_.get());
+    ProducePartialResultsOnNetworkThreadImpl(
+        timestamp, transport_stats_by_name, transport_cert_stats,
+        network_report_.get());
+  }
 
   // Signal that it is now safe to touch `network_report_` on the signaling
   // thread, and post a task to merge it into the final results.
@@ -1361,20 +1472,33 @@ void RTCStatsCollector::MergeNetworkReport_s() {
   // asynchronously, so `num_pending_partial_reports_` must now be 0 and we are
   // ready to deliver the result.
   RTC_DCHECK_EQ(num_pending_partial_reports_, 0);
-  cache_timestamp_us_ = partial_report_timestamp_us_;
-  cached_report_ = partial_report_;
+  rtc::scoped_refptr<const RTCStatsReport> report = partial_report_;
+  // A selected report is incomplete, so it must not be served to later full
+  // requests.
+  if (!selected_stats_types_) {
+    cache_timestamp_us_ = partial_report_timestamp_us_;
+    cached_report_ = report;
+  }
   partial_report_ = nullptr;
   transceiver_stats_infos_.clear();
   // Trace WebRTC Stats when getStats is called on Javascript.
   // This allows access to WebRTC stats from trace logs. To enable them,
   // select the "webrtc_stats" category when recording traces.
   TRACE_EVENT_INSTANT1("webrtc_stats", "webrtc_stats", TRACE_EVENT_SCOPE_GLOBAL,
-                       "report", cached_report_->ToJson());
+                       "report", report->ToJson());
 
   // Deliver report and clear `requests_`.
   std::vector<RequestInfo> requests;
   requests.swap(requests_);
-  DeliverCachedReport(cached_report_, std::move(requests));
+  DeliverCachedReport(report, std::move(requests));
+
+  // Restart the requests that the completed gathering did not cover. The
+  // first starts a new gathering, which the others join if they can.
+  std::vector<RequestInfo> deferred_requests;
+  deferred_requests.swap(deferred_requests_);
+  for (RequestInfo& request : deferred_requests) {
+    GetStatsReportInternal(std::move(request));
+  }
 }
 
 void RTCStatsCollector::DeliverCachedReport(
@@ -1387,6 +1511,10 @@ void RTCStatsCollector::DeliverCachedReport(
   for (const RequestInfo& request : requests) {
     if (request.filter_mode() == RequestInfo::FilterMode::kAll) {
       request.callback()->OnStatsDelivered(cached_report);
+    } else if (request.filter_mode() ==
+               RequestInfo::FilterMode::kStatsTypes) {
+      request.callback()->OnStatsDelivered(
+          CreateReportFilteredByType(cached_report, request.stats_types()));
     } else {
       bool filter_by_sender_selector;
       rtc::scoped_refptr<RtpSenderInternal> sender_selector;
@@ -2052,152 +2180,173 @@ RTCStatsCollector::PrepareTransportCertificateStats_n(
   return transport_cert_stats;
 }
 
-void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
-  RTC_DCHECK_RUN_ON(signaling_thread_);
-
-  transceiver_stats_infos_.clear();
-  // These are used to invoke GetStats for all the media channels together in
-  // one worker thread hop.
-  std::map<cricket::VoiceMediaSendChannelInterface*,
-           cricket::VoiceMediaSendInfo>
-      voice_send_stats;
-  std::map<cricket::VideoMediaSendChannelInterface*,
-           cricket::VideoMediaSendInfo>
-      video_send_stats;
-  std::map<cricket::VoiceMediaReceiveChannelInterface*,
-           cricket::VoiceMediaReceiveInfo>
-      voice_receive_stats;
-  std::map<cricket::VideoMediaReceiveChannelInterface*,
-           cricket::VideoMediaReceiveInfo>
-      video_receive_stats;
-
-  auto transceivers = pc_->GetTransceiversInternal();
-
-  // TODO(tommi): See if we can avoid synchronously blocking the signaling
-  // thread while we do this (or avoid the BlockingCall at all).
-  network_thread_->BlockingCall([&] {
-    rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
+void RTCStatsCollector::PrepareTransceiverStatsInfos_n(
+    const std::vector<
+        rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>&
+        transceivers,
+    bool include_senders,
+    bool include_receivers,
+    MediaChannelStats* media_channel_stats) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
-    for (const auto& transceiver_proxy : transceivers) {
-      RtpTransceiver* transceiver = transceiver_proxy->internal();
-      cricket::MediaType media_type = transceiver->media_type();
+  for (const auto& transceiver_proxy : transceivers) {
+    RtpTransceiver* transceiver = transceiver_proxy->internal();
+    cricket::MediaType media_type = transceiver->media_type();
 
-      // Prepare stats entry. The TrackMediaInfoMap will be filled in after the
-      // stats have been fetched on the worker thread.
-      transceiver_stats_infos_.emplace_back();
-      RtpTransceiverStatsInfo& stats = transceiver_stats_infos_.back();
-      stats.transceiver = transceiver;
-      stats.media_type = media_type;
+    // Prepare stats entry. The TrackMediaInfoMap will be filled in after the
+    // stats have been fetched on the worker thread.
+    transceiver_stats_infos_.emplace_back();
+    RtpTransceiverStatsInfo& stats = transceiver_stats_infos_.back();
+    stats.transceiver = transceiver;
+    stats.media_type = media_type;
 
-      cricket::ChannelInterface* channel = transceiver->channel();
-      if (!channel) {
-        // The remaining fields require a BaseChannel.
-        continue;
-      }
+    cricket::ChannelInterface* channel = transceiver->channel();
+    if (!channel) {
+      // The remaining fields require a BaseChannel.
+      continue;
+    }
 
-      stats.mid = channel->mid();
-      stats.transport_name = std::string(channel->transport_name());
+    stats.mid = channel->mid();
+    stats.transport_name = std::string(channel->transport_name());
 
-      if (media_type == cricket::MEDIA_TYPE_AUDIO) {
+    if (media_type == cricket::MEDIA_TYPE_AUDIO) {
+      if (include_senders) {
         auto voice_send_channel = channel->voice_media_send_channel();
-        RTC_DCHECK(voice_send_stats.find(voice_send_channel) ==
-                   voice_send_stats.end());
-        voice_send_stats.insert(
+        RTC_DCHECK(media_channel_stats->voice_send.find(voice_send_channel) ==
+                   media_channel_stats->voice_send.end());
+        media_channel_stats->voice_send.insert(
             std::make_pair(voice_send_channel, cricket::VoiceMediaSendInfo()));
-
+      }
+      if (include_receivers) {
         auto voice_receive_channel = channel->voice_media_receive_channel();
-        RTC_DCHECK(voice_receive_stats.find(voice_receive_channel) ==
-                   voice_receive_stats.end());
-        voice_receive_stats.insert(std::make_pair(
+        RTC_DCHECK(
+            media_channel_stats->voice_receive.find(voice_receive_channel) ==
+            media_channel_stats->voice_receive.end());
+        media_channel_stats->voice_receive.insert(std::make_pair(
             voice_receive_channel, cricket::VoiceMediaReceiveInfo()));
-      } else if (media_type == cricket::MEDIA_TYPE_VIDEO) {
+      }
+    } else if (media_type == cricket::MEDIA_TYPE_VIDEO) {
+      if (include_senders) {
         auto video_send_channel = channel->video_media_send_channel();
-        RTC_DCHECK(video_send_stats.find(video_send_channel) ==
-                   video_send_stats.end());
-        video_send_stats.insert(
+        RTC_DCHECK(media_channel_stats->video_send.find(video_send_channel) ==
+                   media_channel_stats->video_send.end());
+        media_channel_stats->video_send.insert(
             std::make_pair(video_send_channel, cricket::VideoMediaSendInfo()));
+      }
+      if (include_receivers) {
         auto video_receive_channel = channel->video_media_receive_channel();
-        RTC_DCHECK(video_receive_stats.find(video_receive_channel) ==
-                   video_receive_stats.end());
-        video_receive_stats.insert(std::make_pair(
+        RTC_DCHECK(
+            media_channel_stats->video_receive.find(video_receive_channel) ==
+            media_channel_stats->video_receive.end());
+        media_channel_stats->video_receive.insert(std::make_pair(
             video_receive_channel, cricket::VideoMediaReceiveInfo()));
-      } else {
-        RTC_DCHECK_NOTREACHED();
       }
+    } else {
+      RTC_DCHECK_NOTREACHED();
     }
-  });
+  }
+}
 
-  // We jump to the worker thread and call GetStats() on each media channel as
-  // well as GetCallStats(). At the same time we construct the
-  // TrackMediaInfoMaps, which also needs info from the worker thread. This
-  // minimizes the number of thread jumps.
-  worker_thread_->BlockingCall([&] {
-    rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
+bool RTCStatsCollector::GetMediaChannelStats_w(
+    MediaChannelStats* media_channel_stats) {
+  RTC_DCHECK_RUN_ON(worker_thread_);
+  rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
-    for (auto& pair : voice_send_stats) {
-      if (!pair.first->GetStats(&pair.second)) {
-        RTC_LOG(LS_WARNING) << "Failed to get voice send stats.";
-      }
+  for (auto& pair : media_channel_stats->voice_send) {
+    if (!pair.first->GetStats(&pair.second)) {
+      RTC_LOG(LS_WARNING) << "Failed to get voice send stats.";
     }
-    for (auto& pair : voice_receive_stats) {
-      if (!pair.first->GetStats(&pair.second,
-                                /*get_and_clear_legacy_stats=*/false)) {
-        RTC_LOG(LS_WARNING) << "Failed to get voice receive stats.";
-      }
+  }
+  for (auto& pair : media_channel_stats->voice_receive) {
+    if (!pair.first->GetStats(&pair.second,
+                              /*get_and_clear_legacy_stats=*/false)) {
+      RTC_LOG(LS_WARNING) << "Failed to get voice receive stats.";
     }
-    for (auto& pair : video_send_stats) {
-      if (!pair.first->GetStats(&pair.second)) {
-        RTC_LOG(LS_WARNING) << "Failed to get video send stats.";
-      }
+  }
+  for (auto& pair : media_channel_stats->video_send) {
+    if (!pair.first->GetStats(&pair.second)) {
+      RTC_LOG(LS_WARNING) << "Failed to get video send stats.";
     }
-    for (auto& pair : video_receive_stats) {
-      if (!pair.first->GetStats(&pair.second)) {
-        RTC_LOG(LS_WARNING) << "Failed to get video receive stats.";
-      }
+  }
+  for (auto& pair : media_channel_stats->video_receive) {
+    if (!pair.first->GetStats(&pair.second)) {
+      RTC_LOG(LS_WARNING) << "Failed to get video receive stats.";
     }
+  }
 
-    // Create the TrackMediaInfoMap for each transceiver stats object
-    // and keep track of whether we have at least one audio receiver.
-    bool has_audio_receiver = false;
-    for (auto& stats : transceiver_stats_infos_) {
-      auto transceiver = stats.transceiver;
-      std::optional<cricket::VoiceMediaInfo> voice_media_info;
-      std::optional<cricket::VideoMediaInfo> video_media_info;
-      auto channel = transceiver->channel();
-      if (channel) {
-        cricket::MediaType media_type = transceiver->media_type();
-        if (media_type == cricket::MEDIA_TYPE_AUDIO) {
-          auto voice_send_channel = channel->voice_media_send_channel();
-          auto voice_receive_channel = channel->voice_media_receive_channel();
-          voice_media_info = cricket::VoiceMediaInfo(
-              std::move(voice_send_stats[voice_send_channel]),
-              std::move(voice_receive_stats[voice_receive_channel]));
-        } else if (media_type == cricket::MEDIA_TYPE_VIDEO) {
-          auto video_send_channel = channel->video_media_send_channel();
-          auto video_receive_channel = channel->video_media_receive_channel();
-          video_media_info = cricket::VideoMediaInfo(
-              std::move(video_send_stats[video_send_channel]),
-              std::move(video_receive_stats[video_receive_channel]));
-        }
-      }
-      std::vector<rtc::scoped_refptr<RtpSenderInternal>> senders;
-      for (const auto& sender : transceiver->senders()) {
-        senders.push_back(
-            rtc::scoped_refptr<RtpSenderInternal>(sender->internal()));
-      }
-      std::vector<rtc::scoped_refptr<RtpReceiverInternal>> receivers;
-      for (const auto& receiver : transceiver->receivers()) {
-        receivers.push_back(
-            rtc::scoped_refptr<RtpReceiverInternal>(receiver->internal()));
-      }
-      stats.track_media_info_map.Initialize(std::move(voice_media_info),
-                                            std::move(video_media_info),
-                                            senders, receivers);
-      if (transceiver->media_type() == cricket::MEDIA_TYPE_AUDIO) {
-        has_audio_receiver |= !receivers.empty();
+  // Create the TrackMediaInfoMap for each transceiver stats object
+  // and keep track of whether we have at least one audio receiver.
+  bool has_audio_receiver = false;
+  for (auto& stats : transceiver_stats_infos_) {
+    auto transceiver = stats.transceiver;
+    std::optional<cricket::VoiceMediaInfo> voice_media_info;
+    std::optional<cricket::VideoMediaInfo> video_media_info;
+    auto channel = transceiver->channel();
+    if (channel) {
+      cricket::MediaType media_type = transceiver->media_type();
+      if (media_type == cricket::MEDIA_TYPE_AUDIO) {
+        auto voice_send_channel = channel->voice_media_send_channel();
+        auto voice_receive_channel = channel->voice_media_receive_channel();
+        voice_media_info = cricket::VoiceMediaInfo(
+            std::move(media_channel_stats->voice_send[voice_send_channel]),
+            std::move(
+                media_channel_stats->voice_receive[voice_receive_channel]));
+      } else if (media_type == cricket::MEDIA_TYPE_VIDEO) {
+        auto video_send_channel = channel->video_media_send_channel();
+        auto video_receive_channel = channel->video_media_receive_channel();
+        video_media_info = cricket::VideoMediaInfo(
+            std::move(media_channel_stats->video_send[video_send_channel]),
+            std::move(
+                media_channel_stats->video_receive[video_receive_channel]));
       }
     }
+    std::vector<rtc::scoped_refptr<RtpSenderInternal>> senders;
+    for (const auto& sender : transceiver->senders()) {
+      senders.push_back(
+          rtc::scoped_refptr<RtpSenderInternal>(sender->internal()));
+    }
+    std::vector<rtc::scoped_refptr<RtpReceiverInternal>> receivers;
+    for (const auto& receiver : transceiver->receivers()) {
+      receivers.push_back(
+          rtc::scoped_refptr<RtpReceiverInternal>(receiver->internal()));
+    }
+    stats.track_media_info_map.Initialize(std::move(voice_media_info),
+                                          std::move(video_media_info),
+                                          senders, receivers);
+    if (transceiver->media_type() == cricket::MEDIA_TYPE_AUDIO) {
+      has_audio_receiver |= !receivers.empty();
+    }
+  }
+  return has_audio_receiver;
+}
+
+void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
 
+  transceiver_stats_infos_.clear();
+  // These are used to invoke GetStats for all the media channels together in
+  // one worker thread hop.
+  MediaChannelStats media_channel_stats;
+
+  auto transceivers = pc_->GetTransceiversInternal();
+
+  // TODO(tommi): See if we can avoid synchronously blocking the signaling
+  // thread while we do this (or avoid the BlockingCall at all).
+  network_thread_->BlockingCall([&] {
+    PrepareTransceiverStatsInfos_n(transceivers, /*include_senders=*/true,
+                                   /*include_receivers=*/true,
+                                   &media_channel_stats);
+  });
+
+  // We jump to the worker thread and call GetStats() on each media channel as
+  // well as GetCallStats(). At the same time we construct the
+  // TrackMediaInfoMaps, which also needs info from the worker thread. This
+  // minimizes the number of thread jumps.
+  worker_thread_->BlockingCall([&] {
+    bool has_audio_receiver = GetMediaChannelStats_w(&media_channel_stats);
+
+    rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
     call_stats_ = pc_->GetCallStats();
     audio_device_stats_ =
         has_audio_receiver ? pc_->GetAudioDeviceStats() : std::nullopt;
@@ -2208,6 +2357,186 @@ void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
   }
 }
 
+void RTCStatsCollector::StartSelectedStatsGathering_s(Timestamp timestamp) {
+  RTC_DCHECK_RUN_ON(signaling_thread_);
+  RTC_DCHECK(selected_stats_types_);
+  RTC_DCHECK_EQ(num_pending_partial_reports_, 1);
+
+  // Nothing is produced on the signaling thread, the network thread's partial
+  // report is the whole result.
+  partial_report_ = RTCStatsReport::Create(timestamp);
+  transceiver_stats_infos_.clear();
+  network_report_event_.Reset();
+  rtc::scoped_refptr<RTCStatsCollector> collector(this);
+  if (worker_thread_ == signaling_thread_) {
+    // A task posted to the worker thread could not run while
+    // WaitForPendingRequest() blocks the signaling thread on
+    // `network_report_event_`, so prepare the stats synchronously like a full
+    // gathering does. Only the report is produced asynchronously.
+    auto transceivers = pc_->GetTransceiversInternal();
+    MediaChannelStats media_channel_stats;
+    bool needs_worker_stats = false;
+    network_thread_->BlockingCall([&] {
+      needs_worker_stats = PrepareSelectedTransceiverStatsInfos_n(
+          transceivers, &media_channel_stats);
+    });
+    if (needs_worker_stats) {
+      GetSelectedMediaChannelAndCallStats_w(&media_channel_stats);
+    }
+    network_thread_->PostTask(
+        [collector, sctp_transport_name = pc_->sctp_transport_name(),
+         timestamp]() mutable {
+          collector->ProducePartialResultsOnNetworkThread(
+              timestamp, std::move(sctp_transport_name));
+        });
+    return;
+  }
+  network_thread_->PostTask(
+      [collector, transceivers = pc_->GetTransceiversInternal(),
+       sctp_transport_name = pc_->sctp_transport_name(), timestamp]() mutable {
+        collector->PrepareSelectedStats_n(timestamp, std::move(transceivers),
+                                          std::move(sctp_transport_name));
+      });
+}
+
+bool RTCStatsCollector::PrepareSelectedTransceiverStatsInfos_n(
+    const std::vector<
+        rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>&
+        transceivers,
+    MediaChannelStats* media_channel_stats) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  const std::set<std::string>& stats_types = *selected_stats_types_;
+  const bool include_senders = SelectsSendRtpStats(stats_types);
+  const bool include_receivers = SelectsReceiveRtpStats(stats_types);
+
+  // Transceivers are also needed for the transport names of transport,
+  // certificate and ICE stats.
+  PrepareTransceiverStatsInfos_n(transceivers, include_senders,
+                                 include_receivers, media_channel_stats);
+  return include_senders || include_receivers || SelectsIceStats(stats_types);
+}
+
+void RTCStatsCollector::GetSelectedMediaChannelAndCallStats_w(
+    MediaChannelStats* media_channel_stats) {
+  RTC_DCHECK_RUN_ON(worker_thread_);
+  const std::set<std::string>& stats_types = *selected_stats_types_;
+
+  if (SelectsSendRtpStats(stats_types) || SelectsReceiveRtpStats(stats_types)) {
+    GetMediaChannelStats_w(media_channel_stats);
+  }
+  rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
+  // Candidate pairs take their bandwidth estimates from the call. Audio
+  // playout is never selected this way, so inbound audio has no playout ID.
+  call_stats_ =
+      SelectsIceStats(stats_types) ? pc_->GetCallStats() : Call::Stats();
+  audio_device_stats_ = std::nullopt;
+}
+
+void RTCStatsCollector::PrepareSelectedStats_n(
+    Timestamp timestamp,
+    std::vector<
+        rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>
+        transceivers,
+    std::optional<std::string> sctp_transport_name) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  MediaChannelStats media_channel_stats;
+  if (!PrepareSelectedTransceiverStatsInfos_n(transceivers,
+                                              &media_channel_stats)) {
+    ProducePartialResultsOnNetworkThread(timestamp,
+                                         std::move(sctp_transport_name));
+    return;
+  }
+  rtc::scoped_refptr<RTCStatsCollector> collector(this);
+  worker_thread_->PostTask(
+      [collector, timestamp,
+       sctp_transport_name = std::move(sctp_transport_name),
+       media_channel_stats = std::move(media_channel_stats)]() mutable {
+        collector->PrepareSelectedStats_w(timestamp,
+                                          std::move(sctp_transport_name),
+                                          std::move(media_channel_stats));
+      });
+}
+
+void RTCStatsCollector::PrepareSelectedStats_w(
+    Timestamp timestamp,
+    std::optional<std::string> sctp_transport_name,
+    MediaChannelStats media_channel_stats) {
+  RTC_DCHECK_RUN_ON(worker_thread_);
+  GetSelectedMediaChannelAndCallStats_w(&media_channel_stats);
+
+  rtc::scoped_refptr<RTCStatsCollector> collector(this);
+  network_thread_->PostTask(
+      [collector, timestamp,
+       sctp_transport_name = std::move(sctp_transport_name)]() mutable {
+        collector->ProducePartialResultsOnNetworkThread(
+            timestamp, std::move(sctp_transport_name));
+      });
+}
+
+void RTCStatsCollector::ProduceSelectedResults_n(
+    Timestamp timestamp,
+    std::optional<std::string> sctp_transport_name,
+    RTCStatsReport* partial_report) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
+
+  const std::set<std::string>& stats_types = *selected_stats_types_;
+  if (stats_types.count(RTCDataChannelStats::kType)) {
+    ProduceDataChannelStats_n(timestamp, partial_report);
+  }
+
+  const bool include_ice = SelectsIceStats(stats_types);
+  const bool include_transport = stats_types.count(RTCTransportStats::kType);
+  const bool include_certificate =
+      stats_types.count(RTCCertificateStats::kType);
+  if (include_ice || include_transport || include_certificate) {
+    std::set<std::string> transport_names;
+    if (sctp_transport_name) {
+      transport_names.emplace(std::move(*sctp_transport_name));
+    }
+    for (const auto& info : transceiver_stats_infos_) {
+      if (info.transport_name)
+        transport_names.insert(*info.transport_name);
+    }
+
+    std::map<std::string, cricket::TransportStats> transport_stats_by_name =
+        pc_->GetTransportStatsByNames(transport_names);
+    // Certificate stats are the expensive part of transport stats.
+    std::map<std::string, CertificateStatsPair> transport_cert_stats;
+    if (include_transport || include_certificate) {
+      transport_cert_stats =
+          PrepareTransportCertificateStats_n(transport_stats_by_name);
+    }
+    if (include_certificate) {
+      ProduceCertificateStats_n(timestamp, transport_cert_stats,
+                                partial_report);
+    }
+    if (include_ice) {
+      ProduceIceCandidateAndPairStats_n(timestamp, transport_stats_by_name,
+                                        call_stats_, partial_report);
+    }
+    if (include_transport) {
+      ProduceTransportStats_n(timestamp, transport_stats_by_name,
+                              transport_cert_stats, partial_report);
+    }
+  }
+  if (SelectsSendRtpStats(stats_types) || SelectsReceiveRtpStats(stats_types)) {
+    ProduceRTPStreamStats_n(timestamp, transceiver_stats_infos_,
+                            partial_report);
+  }
+
+  // The producers also add the stats that their results reference, such as
+  // codecs and candidates, which were not necessarily selected.
+  std::vector<std::string> unselected_ids;
+  for (const RTCStats& stats : *partial_report) {
+    if (!stats_types.count(stats.type()))
+      unselected_ids.push_back(stats.id());
+  }
+  for (const std::string& id : unselected_ids) {
+    partial_report->Take(id);
+  }
+}
+
 void RTCStatsCollector::OnSctpDataChannelStateChanged(
     int channel_id,
     DataChannelInterface::DataState state) {
@@ -17,6 +17,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -79,6 +80,18 @@ class RTCStatsCollector : public RefCountInterface {
   // as: no RTP streams are received by selector). The result is empty.
   void GetStatsReport(rtc::scoped_refptr<RtpReceiverInternal> selector,
                       rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+  // Gets a report with only the stats whose type() is in `stats_types`, e.g.
+  // RTCInboundRtpStreamStats::kType and RTCIceCandidatePairStats::kType. Stats
+  // of other types are not produced and the signaling thread does not block
+  // on the network or worker thread, which makes this suitable for polling a
+  // few metrics at a high rate. Stats referenced by ID, such as the transport
+  // of an inbound-rtp, are only included if their type is selected too.
+  // Types produced on the signaling thread (media-source, peer-connection and
+  // media-playout) are taken from a full gathering instead. Selected reports
+  // are not cached, but a fresh cached full report is used if there is one.
+  void GetSelectedStatsReport(
+      std::set<std::string> stats_types,
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
   // Clears the cache's reference to the most recent stats report. Subsequently
   // calling `GetStatsReport` guarantees fresh stats. This method must be called
   // any time the PeerConnection visibly changes as a result of an API call as
@@ -122,7 +135,12 @@ class RTCStatsCollector : public RefCountInterface {
  private:
   class RequestInfo {
    public:
-    enum class FilterMode { kAll, kSenderSelector, kReceiverSelector };
+    enum class FilterMode {
+      kAll,
+      kSenderSelector,
+      kReceiverSelector,
+      kStatsTypes
+    };
 
     // Constructs with FilterMode::kAll.
     explicit RequestInfo(
@@ -135,6 +153,9 @@ class RTCStatsCollector : public RefCountInterface {
     // applied even if `selector` is null, resulting in an empty report.
     RequestInfo(rtc::scoped_refptr<RtpReceiverInternal> selector,
                 rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+    // Constructs with FilterMode::kStatsTypes.
+    RequestInfo(std::set<std::string> stats_types,
+                rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
 
     FilterMode filter_mode() const { return filter_mode_; }
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback() const {
@@ -148,6 +169,10 @@ class RTCStatsCollector : public RefCountInterface {
       RTC_DCHECK(filter_mode_ == FilterMode::kReceiverSelector);
       return receiver_selector_;
     }
+    const std::set<std::string>& stats_types() const {
+      RTC_DCHECK(filter_mode_ == FilterMode::kStatsTypes);
+      return stats_types_;
+    }
 
    private:
     RequestInfo(FilterMode filter_mode,
@@ -159,9 +184,12 @@ class RTCStatsCollector : public RefCountInterface {
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback_;
     rtc::scoped_refptr<RtpSenderInternal> sender_selector_;
     rtc::scoped_refptr<RtpReceiverInternal> receiver_selector_;
+    std::set<std::string> stats_types_;
   };
 
   void GetStatsReportInternal(RequestInfo request);
+  // Whether the gathering in progress produces everything `request` needs.
+  bool PendingGatheringCovers(const RequestInfo& request) const;
 
   // Structure for tracking stats about each RtpTransceiver managed by the
   // PeerConnection. This can either by a Plan B style or Unified Plan style
@@ -236,9 +264,66 @@ class RTCStatsCollector : public RefCountInterface {
   PrepareTransportCertificateStats_n(
       const std::map<std::string, cricket::TransportStats>&
           transport_stats_by_name);
+  // Stats of the media channels, gathered so that all channels are queried in
+  // one worker thread hop.
+  struct MediaChannelStats {
+    std::map<cricket::VoiceMediaSendChannelInterface*,
+             cricket::VoiceMediaSendInfo>
+        voice_send;
+    std::map<cricket::VideoMediaSendChannelInterface*,
+             cricket::VideoMediaSendInfo>
+        video_send;
+    std::map<cricket::VoiceMediaReceiveChannelInterface*,
+             cricket::VoiceMediaReceiveInfo>
+        voice_receive;
+    std::map<cricket::VideoMediaReceiveChannelInterface*,
+             cricket::VideoMediaReceiveInfo>
+        video_receive;
+  };
+  // Fills in `transceiver_stats_infos_` for `transceivers`, and adds the send
+  // and/or receive channels of each to `media_channel_stats`.
+  void PrepareTransceiverStatsInfos_n(
+      const std::vector<
+          rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>&
+          transceivers,
+      bool include_senders,
+      bool include_receivers,
+      MediaChannelStats* media_channel_stats);
+  // Gets the stats of the channels in `media_channel_stats` and creates the
+  // TrackMediaInfoMap of each transceiver. Returns true if there is at least
+  // one audio receiver.
+  bool GetMediaChannelStats_w(MediaChannelStats* media_channel_stats);
   // The results are stored in `transceiver_stats_infos_` and `call_stats_`.
   void PrepareTransceiverStatsInfosAndCallStats_s_w_n();
 
+  // Gathering for GetSelectedStatsReport(). Rather than blocking the signaling
+  // thread, each step posts the next one: transceiver infos on the network
+  // thread, media channel stats on the worker thread, and the report on the
+  // network thread again. If the worker thread is the signaling thread the
+  // first two steps are done synchronously.
+  void StartSelectedStatsGathering_s(Timestamp timestamp);
+  // Returns true if the selected stats need the worker thread step.
+  bool PrepareSelectedTransceiverStatsInfos_n(
+      const std::vector<
+          rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>&
+          transceivers,
+      MediaChannelStats* media_channel_stats);
+  void GetSelectedMediaChannelAndCallStats_w(
+      MediaChannelStats* media_channel_stats);
+  void PrepareSelectedStats_n(
+      Timestamp timestamp,
+      std::vector<
+          rtc::scoped_refptr<RtpTransceiverProxyWithInternal<RtpTransceiver>>>
+          transceivers,
+      std::optional<std::string> sctp_transport_name);
+  void PrepareSelectedStats_w(Timestamp timestamp,
+                              std::optional<std::string> sctp_transport_name,
+                              MediaChannelStats media_channel_stats);
+  void ProduceSelectedResults_n(
+      Timestamp timestamp,
+      std::optional<std::string> sctp_transport_name,
+      RTCStatsReport* partial_report);
+
   // Stats gathering on a particular thread.
   void ProducePartialResultsOnSignalingThread(Timestamp timestamp);
   void ProducePartialResultsOnNetworkThread(
@@ -268,6 +353,14 @@ class RTCStatsCollector : public RefCountInterface {
   // all partial reports are merged this is the result of a request.
   rtc::scoped_refptr<RTCStatsReport> partial_report_;
   std::vector<RequestInfo> requests_;
+  // Requests that arrived while a selected gathering that does not cover them
+  // was in progress. They are restarted when it completes.
+  std::vector<RequestInfo> deferred_requests_;
+  // The types produced by the gathering in progress if it is a selected one,
+  // or null for a full gathering. Set on the signaling thread before the
+  // gathering starts and read on the other threads in the same sequence as
+  // `transceiver_stats_infos_`.
+  std::optional<std::set<std::string>> selected_stats_types_;
   // Holds the result of ProducePartialResultsOnNetworkThread(). It is merged
   // into `partial_report_` on the signaling thread and then nulled by
   // MergeNetworkReport_s(). Thread-safety is ensured by using
@@ -18,6 +18,7 @@
 #include <memory>
 #include <optional>
 #include <ostream>
+#include <set>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -75,6 +76,7 @@
 #include "rtc_base/string_encode.h"
 #include "rtc_base/strings/json.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -460,6 +462,13 @@ class RTCStatsCollectorWrapper {
     return WaitForReport(callback);
   }
 
+  rtc::scoped_refptr<const RTCStatsReport> GetSelectedStatsReport(
+      std::set<std::string> stats_types) {
+    rtc::scoped_refptr<RTCStatsObtainer> callback = RTCStatsObtainer::Create();
+    stats_collector_->GetSelectedStatsReport(std::move(stats_types), callback);
+    return WaitForReport(callback);
+  }
+
   rtc::scoped_refptr<const RTCStatsReport> GetFreshStatsReport() {
     stats_collector_->ClearCachedStatsReport();
     return GetStatsReport();
@@ -3681,6 +3690,71 @@ TEST_F(RTCStatsCollectorTest, GetStatsWithNullReceiverSelector) {
   EXPECT_EQ(empty_report->size(), 0u);
 }
 
+TEST_F(RTCStatsCollectorTest, GetSelectedStatsProducesOnlySelectedTypes) {
+  ExampleStatsGraph graph = SetupExampleStatsGraphForSelectorTests();
+  stats_->stats_collector()->ClearCachedStatsReport();
+  rtc::scoped_refptr<const RTCStatsReport> report =
+      stats_->GetSelectedStatsReport({RTCInboundRtpStreamStats::kType});
+  ASSERT_TRUE(report);
+  EXPECT_EQ(report->size(), 1u);
+  ASSERT_TRUE(report->Get(graph.inbound_rtp_id));
+  // References are kept even though the referenced stats are not selected.
+  const auto& inbound_rtp =
+      report->Get(graph.inbound_rtp_id)->cast_to<RTCInboundRtpStreamStats>();
+  EXPECT_EQ(*inbound_rtp.codec_id, graph.recv_codec_id);
+  EXPECT_EQ(*inbound_rtp.transport_id, graph.transport_id);
+  EXPECT_FALSE(report->Get(graph.recv_codec_id));
+  EXPECT_FALSE(report->Get(graph.transport_id));
+
+  // The selected report must not be served from the cache to full requests.
+  rtc::scoped_refptr<const RTCStatsReport> full_report =
+      stats_->GetStatsReport();
+  EXPECT_EQ(full_report->size(), graph.full_report->size());
+}
+
+TEST_F(RTCStatsCollectorTest, GetSelectedStatsFiltersFreshCachedReport) {
+  ExampleStatsGraph graph = SetupExampleStatsGraphForSelectorTests();
+  // The report cached by the graph setup is still fresh.
+  rtc::scoped_refptr<const RTCStatsReport> report =
+      stats_->GetSelectedStatsReport(
+          {RTCOutboundRtpStreamStats::kType, RTCCodecStats::kType});
+  ASSERT_TRUE(report);
+  EXPECT_EQ(report->timestamp(), graph.full_report->timestamp());
+  EXPECT_EQ(report->size(), 3u);
+  EXPECT_TRUE(report->Get(graph.outbound_rtp_id));
+  EXPECT_TRUE(report->Get(graph.send_codec_id));
+  EXPECT_TRUE(report->Get(graph.recv_codec_id));
+}
+
+TEST_F(RTCStatsCollectorTest, GetSelectedStatsWithSignalingThreadType) {
+  ExampleStatsGraph graph = SetupExampleStatsGraphForSelectorTests();
+  stats_->stats_collector()->ClearCachedStatsReport();
+  rtc::scoped_refptr<const RTCStatsReport> report =
+      stats_->GetSelectedStatsReport(
+          {RTCPeerConnectionStats::kType, RTCTransportStats::kType});
+  ASSERT_TRUE(report);
+  EXPECT_EQ(report->size(), 2u);
+  EXPECT_TRUE(report->Get(graph.peer_connection_id));
+  EXPECT_TRUE(report->Get(graph.transport_id));
+}
+
+TEST_F(RTCStatsCollectorTest, GetSelectedStatsDefersUncoveredRequests) {
+  ExampleStatsGraph graph = SetupExampleStatsGraphForSelectorTests();
+  stats_->stats_collector()->ClearCachedStatsReport();
+  rtc::scoped_refptr<RTCStatsObtainer> selected_callback =
+      RTCStatsObtainer::Create();
+  rtc::scoped_refptr<RTCStatsObtainer> full_callback =
+      RTCStatsObtainer::Create();
+  stats_->stats_collector()->GetSelectedStatsReport(
+      {RTCInboundRtpStreamStats::kType}, selected_callback);
+  stats_->stats_collector()->GetStatsReport(full_callback);
+  EXPECT_TRUE_WAIT(full_callback->report() != nullptr,
+                   kGetStatsReportTimeoutMs);
+  ASSERT_TRUE(selected_callback->report());
+  EXPECT_EQ(selected_callback->report()->size(), 1u);
+  EXPECT_EQ(full_callback->report()->size(), graph.full_report->size());
+}
+
 // Before SetLocalDescription() senders don't have an SSRC.
 // To simulate this case we create a mock sender with SSRC=0.
 TEST_F(RTCStatsCollectorTest, RtpIsMissingWhileSsrcIsZero) {
@@ -3865,6 +3939,27 @@ class FakeRTCStatsCollector : public RTCStatsCollector,
   int produced_on_network_thread_ = 0;
 };
 
+// The worker thread is the signaling thread, which WaitForPendingRequest()
+// blocks, as PeerConnection::Close() does.
+TEST(RTCStatsCollectorTestWithSharedWorkerThread,
+     WaitForPendingSelectedStatsRequest) {
+  rtc::AutoThread main_thread;
+  std::unique_ptr<rtc::Thread> network_thread = rtc::Thread::Create();
+  network_thread->Start();
+  auto pc =
+      rtc::make_ref_counted<FakePeerConnectionForStats>(network_thread.get());
+  rtc::scoped_refptr<RTCStatsCollector> stats_collector =
+      RTCStatsCollector::Create(pc.get(), CreateEnvironment(),
+                                50 * rtc::kNumMicrosecsPerMillisec);
+  rtc::scoped_refptr<RTCStatsObtainer> callback = RTCStatsObtainer::Create();
+  stats_collector->GetSelectedStatsReport(
+      {RTCInboundRtpStreamStats::kType, RTCIceCandidatePairStats::kType},
+      callback);
+  stats_collector->WaitForPendingRequest();
+  ASSERT_TRUE(callback->report());
+  EXPECT_EQ(callback->report()->size(), 0u);
+}
+
 TEST(RTCStatsCollectorTestWithFakeCollector, ThreadUsageAndResultsMerging) {
   rtc::AutoThread main_thread_;
   auto pc = rtc::make_ref_counted<FakePeerConnectionForStats>();
@@ -212,14 +212,17 @@ class VideoChannelForTesting : public cricket::VideoChannel {
 // under which to test the stats collectors.
 class FakePeerConnectionForStats : public FakePeerConnectionBase {
  public:
-  // TODO(steveanton): Add support for specifying separate threads to test
-  // multi-threading correctness.
+  // TODO(steveanton): Add support for specifying separate worker and signaling
+  // threads to test multi-threading correctness.
   FakePeerConnectionForStats()
-      : network_thread_(rtc::Thread::Current()),
+      : FakePeerConnectionForStats(rtc::Thread::Current()) {}
+  // The worker and signaling threads are the current thread.
+  explicit FakePeerConnectionForStats(rtc::Thread* network_thread)
+      : network_thread_(network_thread),
         worker_thread_(rtc::Thread::Current()),
         signaling_thread_(rtc::Thread::Current()),
         // TODO(hta): remove separate thread variables and use context.
-        dependencies_(MakeDependencies()),
+        dependencies_(MakeDependencies(network_thread)),
         context_(
             ConnectionContext::Create(CreateEnvironment(), &dependencies_)),
         local_streams_(StreamCollection::Create()),
@@ -232,9 +235,10 @@ class FakePeerConnectionForStats : public FakePeerConnectionBase {
     }
   }
 
-  static PeerConnectionFactoryDependencies MakeDependencies() {
+  static PeerConnectionFactoryDependencies MakeDependencies(
+      rtc::Thread* network_thread) {
     PeerConnectionFactoryDependencies dependencies;
-    dependencies.network_thread = rtc::Thread::Current();
+    dependencies.network_thread = network_thread;
     dependencies.worker_thread = rtc::Thread::Current();
     dependencies.signaling_thread = rtc::Thread::Current();
     EnableFakeMedia(dependencies);
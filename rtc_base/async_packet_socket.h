@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "absl/functional/any_invocable.h"
+#include "api/array_view.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/callback_list.h"
 #include "rtc_base/checks.h"
@@ -133,6 +134,14 @@ class RTC_EXPORT AsyncPacketSocket : public sigslot::has_slots<> {
       absl::AnyInvocable<void(AsyncPacketSocket*, const rtc::ReceivedPacket&)>
           received_packet_callback);
   void DeregisterReceivedPacketCallback();
+  // Like RegisterReceivedPacketCallback(), but called once for all packets
+  // that were read together. Sockets without batched reads deliver one packet
+  // at a time. Replaces the per-packet callback while registered.
+  void RegisterReceivedPacketBatchCallback(
+      absl::AnyInvocable<void(AsyncPacketSocket*,
+                              rtc::ArrayView<const rtc::ReceivedPacket>)>
+          received_packet_batch_callback);
+  void DeregisterReceivedPacketBatchCallback();
 
   // Emitted each time a packet is sent.
   sigslot::signal2<AsyncPacketSocket*, const SentPacket&> SignalSentPacket;
@@ -164,6 +173,8 @@ class RTC_EXPORT AsyncPacketSocket : public sigslot::has_slots<> {
   }
 
   void NotifyPacketReceived(const rtc::ReceivedPacket& packet);
+  // `packets` were read together.
+  void NotifyPacketsReceived(rtc::ArrayView<const rtc::ReceivedPacket> packets);
 
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker network_checker_{
       webrtc::SequenceChecker::kDetached};
@@ -173,6 +184,9 @@ class RTC_EXPORT AsyncPacketSocket : public sigslot::has_slots<> {
       RTC_GUARDED_BY(&network_checker_);
   absl::AnyInvocable<void(AsyncPacketSocket*, const rtc::ReceivedPacket&)>
       received_packet_callback_ RTC_GUARDED_BY(&network_checker_);
+  absl::AnyInvocable<void(AsyncPacketSocket*,
+                          rtc::ArrayView<const rtc::ReceivedPacket>)>
+      received_packet_batch_callback_ RTC_GUARDED_BY(&network_checker_);
 };
 
 // Listen socket, producing an AsyncPacketSocket when a peer connects.
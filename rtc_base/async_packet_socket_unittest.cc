@@ -10,6 +10,10 @@
 
 #include "rtc_base/async_packet_socket.h"
 
+#include <cstdint>
+#include <vector>
+
+#include "api/array_view.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "test/gmock.h"
@@ -19,6 +23,7 @@ namespace rtc {
 namespace {
 
 using ::testing::MockFunction;
+using ::testing::SizeIs;
 
 class MockAsyncPacketSocket : public rtc::AsyncPacketSocket {
  public:
@@ -49,6 +54,7 @@ class MockAsyncPacketSocket : public rtc::AsyncPacketSocket {
   MOCK_METHOD(void, SetError, (int error), (override));
 
   using AsyncPacketSocket::NotifyPacketReceived;
+  using AsyncPacketSocket::NotifyPacketsReceived;
 };
 
 TEST(AsyncPacketSocket, RegisteredCallbackReceivePacketsFromNotify) {
@@ -61,5 +67,34 @@ TEST(AsyncPacketSocket, RegisteredCallbackReceivePacketsFromNotify) {
   mock_socket.NotifyPacketReceived(ReceivedPacket({}, SocketAddress()));
 }
 
+TEST(AsyncPacketSocket, PerPacketCallbackReceivesEachPacketOfBatch) {
+  MockAsyncPacketSocket mock_socket;
+  MockFunction<void(AsyncPacketSocket*, const rtc::ReceivedPacket&)>
+      received_packet;
+
+  EXPECT_CALL(received_packet, Call).Times(3);
+  mock_socket.RegisterReceivedPacketCallback(received_packet.AsStdFunction());
+  std::vector<ReceivedPacket> packets(3, ReceivedPacket({}, SocketAddress()));
+  mock_socket.NotifyPacketsReceived(packets);
+}
+
+TEST(AsyncPacketSocket, BatchCallbackReceivesBatchInOneCall) {
+  MockAsyncPacketSocket mock_socket;
+  MockFunction<void(AsyncPacketSocket*, const rtc::ReceivedPacket&)>
+      received_packet;
+  MockFunction<void(AsyncPacketSocket*, ArrayView<const rtc::ReceivedPacket>)>
+      received_packets;
+
+  EXPECT_CALL(received_packet, Call).Times(0);
+  EXPECT_CALL(received_packets, Call(&mock_socket, SizeIs(3)));
+  EXPECT_CALL(received_packets, Call(&mock_socket, SizeIs(1)));
+  mock_socket.RegisterReceivedPacketCallback(received_packet.AsStdFunction());
+  mock_socket.RegisterReceivedPacketBatchCallback(
+      received_packets.AsStdFunction());
+  std::vector<ReceivedPacket> packets(3, ReceivedPacket({}, SocketAddress()));
+  mock_socket.NotifyPacketsReceived(packets);
+  mock_socket.NotifyPacketReceived(ReceivedPacket({}, SocketAddress()));
+}
+
 }  // namespace
 }  // namespace rtc
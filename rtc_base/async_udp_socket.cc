@@ -10,11 +10,17 @@
 
 #include "rtc_base/async_udp_socket.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <utility>
 
+#include "api/array_view.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/async_packet_socket.h"
@@ -28,6 +34,19 @@
 #include "rtc_base/time_utils.h"
 
 namespace rtc {
+namespace {
+
+// Most packets held for one SendToBatch() call.
+constexpr size_t kMaxBatchSize = 64;
+// Packets of a batch whose last packet does not come through this socket,
+// e.g. because it was dropped or routed elsewhere, are sent after this long.
+constexpr webrtc::TimeDelta kMaxBatchDelay = webrtc::TimeDelta::Millis(1);
+
+// Most datagrams read for one read event.
+constexpr size_t kMaxReceiveBatchSize = 16;
+constexpr size_t kMaxDatagramSize = 64 * 1024;
+
+}  // namespace
 
 AsyncUDPSocket* AsyncUDPSocket::Create(Socket* socket,
                                        const SocketAddress& bind_address) {
@@ -54,6 +73,16 @@ AsyncUDPSocket::AsyncUDPSocket(Socket* socket) : socket_(socket) {
   socket_->SignalWriteEvent.connect(this, &AsyncUDPSocket::OnWriteEvent);
 }
 
+AsyncUDPSocket::~AsyncUDPSocket() {
+  if (!batch_.empty()) {
+    RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+    // Listeners may be going away along with this socket, so the held packets
+    // are sent without signaling them.
+    SignalSentPacket.disconnect_all();
+    SendBatch();
+  }
+}
+
 SocketAddress AsyncUDPSocket::GetLocalAddress() const {
   return socket_->GetLocalAddress();
 }
@@ -65,6 +94,10 @@ SocketAddress AsyncUDPSocket::GetRemoteAddress() const {
 int AsyncUDPSocket::Send(const void* pv,
                          size_t cb,
                          const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  if (!batch_.empty()) {
+    SendBatch();
+  }
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, &sent_packet.info);
@@ -77,24 +110,107 @@ int AsyncUDPSocket::SendTo(const void* pv,
                            size_t cb,
                            const SocketAddress& addr,
                            const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  if (options.batchable) {
+    AddToBatch(pv, cb, addr, options);
+    if (batch_error_ != 0) {
+      // Either the batch completed by this packet or an earlier one, sent
+      // after its SendTo() returned, failed.
+      socket_->SetError(std::exchange(batch_error_, 0));
+      return -1;
+    }
+    return static_cast<int>(cb);
+  }
+  if (!batch_.empty()) {
+    // Keep the send order.
+    SendBatch();
+  }
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, &sent_packet.info);
-  if (has_set_ect1_options_ != options.ecn_1) {
+  SetEct1(options.ecn_1);
+  int ret = socket_->SendTo(pv, cb, addr);
+  SignalSentPacket(this, sent_packet);
+  return ret;
+}
+
+void AsyncUDPSocket::AddToBatch(const void* pv,
+                                size_t cb,
+                                const SocketAddress& addr,
+                                const rtc::PacketOptions& options) {
+  if (!batch_.empty() && batch_ecn_1_ != options.ecn_1) {
+    // ECN is set on the socket, not per datagram.
+    SendBatch();
+  }
+  if (batch_.empty()) {
+    batch_ecn_1_ = options.ecn_1;
+    if (webrtc::TaskQueueBase* current = webrtc::TaskQueueBase::Current()) {
+      current->PostDelayedHighPrecisionTask(
+          webrtc::SafeTask(batch_safety_.flag(),
+                           [this, batch = num_batches_sent_] {
+                             RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+                             if (num_batches_sent_ == batch) {
+                               SendBatch();
+                             }
+                           }),
+          kMaxBatchDelay);
+    }
+  }
+  rtc::SentPacket sent_packet(options.packet_id, /*send_time_ms=*/-1,
+                              options.info_signaled_after_sent);
+  CopySocketInformationToPacketInfo(cb, *this, &sent_packet.info);
+  batch_.push_back({.offset = batch_payloads_.size(),
+                    .size = cb,
+                    .address = addr,
+                    .sent_packet = sent_packet});
+  batch_payloads_.AppendData(static_cast<const uint8_t*>(pv), cb);
+  if (options.last_packet_in_batch || batch_.size() >= kMaxBatchSize) {
+    SendBatch();
+  }
+}
+
+void AsyncUDPSocket::SendBatch() {
+  SetEct1(batch_ecn_1_);
+  batch_datagrams_.clear();
+  for (const BatchedPacket& packet : batch_) {
+    batch_datagrams_.push_back({.data = batch_payloads_.data() + packet.offset,
+                                .size = packet.size,
+                                .address = &packet.address});
+  }
+  const int64_t send_time_ms = rtc::TimeMillis();
+  int sent = socket_->SendToBatch(batch_datagrams_);
+  if (sent < static_cast<int>(batch_.size())) {
+    batch_error_ = socket_->GetError();
+    RTC_LOG(LS_VERBOSE) << "AsyncUDPSocket sent " << std::max(sent, 0)
+                        << " of " << batch_.size()
+                        << " batched packets, error " << batch_error_;
+  }
+  // Like unbatched packets, failed sends are signaled too.
+  for (BatchedPacket& packet : batch_) {
+    packet.sent_packet.send_time_ms = send_time_ms;
+    SignalSentPacket(this, packet.sent_packet);
+  }
+  batch_.clear();
+  batch_payloads_.Clear();
+  ++num_batches_sent_;
+}
+
+void AsyncUDPSocket::SetEct1(bool ecn_1) {
+  if (has_set_ect1_options_ != ecn_1) {
     // It is unclear what is most efficient, setting options on every sent
     // packet or when changed. Potentially, can separate send sockets be used?
     // This is the easier implementation.
-    if (socket_->SetOption(Socket::Option::OPT_SEND_ECN,
-                           options.ecn_1 ? 1 : 0) == 0) {
-      has_set_ect1_options_ = options.ecn_1;
+    if (socket_->SetOption(Socket::Option::OPT_SEND_ECN, ecn_1 ? 1 : 0) == 0) {
+      has_set_ect1_options_ = ecn_1;
     }
   }
-  int ret = socket_->SendTo(pv, cb, addr);
-  SignalSentPacket(this, sent_packet);
-  return ret;
 }
 
 int AsyncUDPSocket::Close() {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  if (!batch_.empty()) {
+    SendBatch();
+  }
   return socket_->Close();
 }
 
@@ -122,9 +238,18 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
   RTC_DCHECK_RUN_ON(&sequence_checker_);
 
-  Socket::ReceiveBuffer receive_buffer(buffer_);
-  int len = socket_->RecvFrom(receive_buffer);
-  if (len < 0) {
+  if (receive_buffers_.empty()) {
+    // Start out reading one datagram at a time, and only grow the batch once
+    // datagrams queue up, so that the many sockets that see little traffic
+    // don't each hold a full batch of maximum size buffers.
+    GrowReceiveBuffers(1);
+  }
+  receive_batch_.clear();
+  for (Buffer& buffer : receive_buffers_) {
+    receive_batch_.emplace_back(buffer);
+  }
+  int count = socket_->RecvFromBatch(receive_batch_);
+  if (count < 0) {
     // An error here typically means we got an ICMP error in response to our
     // send datagram, indicating the remote address was unreachable.
     // When doing ICE, this kind of thing will often happen.
@@ -134,25 +259,49 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
                      << "] receive failed with error " << socket_->GetError();
     return;
   }
-  if (len == 0) {
-    // Spurios wakeup.
-    return;
-  }
 
-  if (!receive_buffer.arrival_time) {
-    // Timestamp from socket is not available.
-    receive_buffer.arrival_time = webrtc::Timestamp::Micros(rtc::TimeMicros());
-  } else {
-    if (!socket_time_offset_) {
-      // Estimate timestamp offset from first packet arrival time.
-      socket_time_offset_ = webrtc::Timestamp::Micros(rtc::TimeMicros()) -
-                            *receive_buffer.arrival_time;
+  std::optional<webrtc::Timestamp> now;
+  received_packets_.clear();
+  for (Socket::ReceiveBuffer& receive_buffer :
+       ArrayView<Socket::ReceiveBuffer>(receive_batch_).subview(0, count)) {
+    if (receive_buffer.payload.empty()) {
+      // Spurious wakeup, or a datagram that did not fit.
+      continue;
+    }
+    if (!now) {
+      now = webrtc::Timestamp::Micros(rtc::TimeMicros());
+    }
+    if (!receive_buffer.arrival_time) {
+      // Timestamp from socket is not available.
+      receive_buffer.arrival_time = *now;
+    } else {
+      if (!socket_time_offset_) {
+        // Estimate timestamp offset from first packet arrival time.
+        socket_time_offset_ = *now - *receive_buffer.arrival_time;
+      }
+      *receive_buffer.arrival_time += *socket_time_offset_;
     }
-    *receive_buffer.arrival_time += *socket_time_offset_;
+    received_packets_.emplace_back(
+        receive_buffer.payload, receive_buffer.source_address,
+        receive_buffer.arrival_time, receive_buffer.ecn);
+  }
+  NotifyPacketsReceived(received_packets_);
+
+  if (static_cast<size_t>(count) == receive_buffers_.size() &&
+      receive_buffers_.size() < kMaxReceiveBatchSize) {
+    // Every buffer was filled, so more datagrams may have been waiting.
+    GrowReceiveBuffers(
+        std::min(2 * receive_buffers_.size(), kMaxReceiveBatchSize));
+  }
+}
+
+void AsyncUDPSocket::GrowReceiveBuffers(size_t size) {
+  receive_buffers_.resize(size);
+  for (Buffer& buffer : receive_buffers_) {
+    // Any datagram of a read can be as large as UDP allows, since one that
+    // does not fit is lost.
+    buffer.EnsureCapacity(kMaxDatagramSize);
   }
-  NotifyPacketReceived(
-      ReceivedPacket(receive_buffer.payload, receive_buffer.source_address,
-                     receive_buffer.arrival_time, receive_buffer.ecn));
 }
 
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
@@ -12,14 +12,19 @@
 #define RTC_BASE_ASYNC_UDP_SOCKET_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/buffer.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/network/sent_packet.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
@@ -30,6 +35,19 @@ namespace rtc {
 
 // Provides the ability to receive packets asynchronously.  Sends are not
 // buffered since it is acceptable to drop packets under high load.
+//
+// Datagrams queued on the socket are read several at once (with recvmmsg()
+// where available) and delivered with one NotifyPacketsReceived(). The number
+// read at once starts at one and grows, up to a limit, while reads keep
+// finding more datagrams queued.
+//
+// Packets sent with PacketOptions::batchable are the exception: they are
+// copied and held until the packet marked last_packet_in_batch, then sent
+// with one Socket::SendToBatch() call. Their SentPacket is signaled when they
+// are actually handed to the socket. As their SendTo() returns before they
+// are sent, a failure to send a batch is returned by the next batchable
+// SendTo(), with GetError() set to the error of the failed batch. Packets
+// still held when the socket is closed or destroyed are sent first.
 class AsyncUDPSocket : public AsyncPacketSocket {
  public:
   // Binds `socket` and creates AsyncUDPSocket for it. Takes ownership
@@ -42,7 +60,7 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   static AsyncUDPSocket* Create(SocketFactory* factory,
                                 const SocketAddress& bind_address);
   explicit AsyncUDPSocket(Socket* socket);
-  ~AsyncUDPSocket() = default;
+  ~AsyncUDPSocket() override;
 
   SocketAddress GetLocalAddress() const override;
   SocketAddress GetRemoteAddress() const override;
@@ -66,13 +84,49 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   void OnReadEvent(Socket* socket);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
+  // Makes `receive_buffers_` hold `size` buffers.
+  void GrowReceiveBuffers(size_t size) RTC_RUN_ON(sequence_checker_);
+
+  struct BatchedPacket {
+    size_t offset;
+    size_t size;
+    SocketAddress address;
+    SentPacket sent_packet;
+  };
+  void AddToBatch(const void* pv,
+                  size_t cb,
+                  const SocketAddress& addr,
+                  const rtc::PacketOptions& options)
+      RTC_RUN_ON(send_sequence_checker_);
+  // Sends the packets held in `batch_`. On failure the socket error is kept
+  // in `batch_error_`.
+  void SendBatch() RTC_RUN_ON(send_sequence_checker_);
+  void SetEct1(bool ecn_1);
 
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
   std::unique_ptr<Socket> socket_;
   bool has_set_ect1_options_ = false;
-  rtc::Buffer buffer_ RTC_GUARDED_BY(sequence_checker_);
+  // One per datagram that can be read in one read event. Grows, up to a
+  // limit, while read events find more datagrams than buffers.
+  std::vector<rtc::Buffer> receive_buffers_ RTC_GUARDED_BY(sequence_checker_);
+  std::vector<Socket::ReceiveBuffer> receive_batch_
+      RTC_GUARDED_BY(sequence_checker_);
+  std::vector<ReceivedPacket> received_packets_
+      RTC_GUARDED_BY(sequence_checker_);
   std::optional<webrtc::TimeDelta> socket_time_offset_
       RTC_GUARDED_BY(sequence_checker_);
+  RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker send_sequence_checker_{
+      webrtc::SequenceChecker::kDetached};
+  std::vector<BatchedPacket> batch_ RTC_GUARDED_BY(send_sequence_checker_);
+  // Payloads of `batch_`, back to back.
+  rtc::Buffer batch_payloads_ RTC_GUARDED_BY(send_sequence_checker_);
+  bool batch_ecn_1_ RTC_GUARDED_BY(send_sequence_checker_) = false;
+  uint64_t num_batches_sent_ RTC_GUARDED_BY(send_sequence_checker_) = 0;
+  // Error of a batch that failed since the last batchable SendTo(), or 0.
+  int batch_error_ RTC_GUARDED_BY(send_sequence_checker_) = 0;
+  std::vector<Socket::Datagram> batch_datagrams_
+      RTC_GUARDED_BY(send_sequence_checker_);
+  webrtc::ScopedTaskSafety batch_safety_;
 };
 
 }  // namespace rtc
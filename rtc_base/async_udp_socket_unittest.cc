@@ -12,18 +12,45 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/memory/memory.h"
+#include "api/array_view.h"
+#include "api/units/time_delta.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/network/sent_packet.h"
+#include "rtc_base/physical_socket_server.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/virtual_socket_server.h"
+#include "test/gmock.h"
 #include "test/gtest.h"
 
 namespace rtc {
 
+using ::testing::Contains;
+using ::testing::Each;
+using ::testing::ElementsAre;
+using ::testing::Gt;
+using ::testing::IsEmpty;
+using ::testing::Le;
+using ::testing::Not;
+using ::testing::SizeIs;
+
 static const SocketAddress kAddr("22.22.22.22", 0);
 
+class SentPacketListener : public sigslot::has_slots<> {
+ public:
+  void OnSentPacket(AsyncPacketSocket* /* socket */,
+                    const SentPacket& sent_packet) {
+    sent_packet_ids.push_back(sent_packet.packet_id);
+  }
+
+  std::vector<int64_t> sent_packet_ids;
+};
+
 TEST(AsyncUDPSocketTest, SetSocketOptionIfEctChange) {
   VirtualSocketServer socket_server;
   Socket* socket = socket_server.CreateSocket(kAddr.family(), SOCK_DGRAM);
@@ -52,4 +79,263 @@ TEST(AsyncUDPSocketTest, SetSocketOptionIfEctChange) {
   EXPECT_EQ(ect, 0);
 }
 
+TEST(AsyncUDPSocketTest, HoldsBatchablePacketsUntilLastPacketInBatch) {
+  VirtualSocketServer socket_server;
+  Socket* socket = socket_server.CreateSocket(kAddr.family(), SOCK_DGRAM);
+  std::unique_ptr<AsyncUDPSocket> udp_socket =
+      absl::WrapUnique(AsyncUDPSocket::Create(socket, kAddr));
+  SentPacketListener listener;
+  udp_socket->SignalSentPacket.connect(&listener,
+                                       &SentPacketListener::OnSentPacket);
+
+  uint8_t buffer[] = "hello";
+  rtc::PacketOptions packet_options;
+  packet_options.batchable = true;
+  packet_options.packet_id = 1;
+  EXPECT_EQ(udp_socket->SendTo(buffer, 5, kAddr, packet_options), 5);
+  packet_options.packet_id = 2;
+  EXPECT_EQ(udp_socket->SendTo(buffer, 5, kAddr, packet_options), 5);
+  EXPECT_THAT(listener.sent_packet_ids, IsEmpty());
+
+  packet_options.packet_id = 3;
+  packet_options.last_packet_in_batch = true;
+  EXPECT_EQ(udp_socket->SendTo(buffer, 5, kAddr, packet_options), 5);
+  EXPECT_THAT(listener.sent_packet_ids, ElementsAre(1, 2, 3));
+}
+
+TEST(AsyncUDPSocketTest, SendsHeldPacketsBeforeUnbatchedPacket) {
+  VirtualSocketServer socket_server;
+  Socket* socket = socket_server.CreateSocket(kAddr.family(), SOCK_DGRAM);
+  std::unique_ptr<AsyncUDPSocket> udp_socket =
+      absl::WrapUnique(AsyncUDPSocket::Create(socket, kAddr));
+  SentPacketListener listener;
+  udp_socket->SignalSentPacket.connect(&listener,
+                                       &SentPacketListener::OnSentPacket);
+
+  uint8_t buffer[] = "hello";
+  rtc::PacketOptions packet_options;
+  packet_options.batchable = true;
+  packet_options.packet_id = 1;
+  udp_socket->SendTo(buffer, 5, kAddr, packet_options);
+  packet_options.batchable = false;
+  packet_options.packet_id = 2;
+  udp_socket->SendTo(buffer, 5, kAddr, packet_options);
+  EXPECT_THAT(listener.sent_packet_ids, ElementsAre(1, 2));
+}
+
+TEST(AsyncUDPSocketTest, SendsHeldPacketsBeforeChangingEct) {
+  VirtualSocketServer socket_server;
+  Socket* socket = socket_server.CreateSocket(kAddr.family(), SOCK_DGRAM);
+  std::unique_ptr<AsyncUDPSocket> udp_socket =
+      absl::WrapUnique(AsyncUDPSocket::Create(socket, kAddr));
+  SentPacketListener listener;
+  udp_socket->SignalSentPacket.connect(&listener,
+                                       &SentPacketListener::OnSentPacket);
+
+  uint8_t buffer[] = "hello";
+  rtc::PacketOptions packet_options;
+  packet_options.batchable = true;
+  packet_options.packet_id = 1;
+  udp_socket->SendTo(buffer, 5, kAddr, packet_options);
+  packet_options.ecn_1 = true;
+  packet_options.packet_id = 2;
+  udp_socket->SendTo(buffer, 5, kAddr, packet_options);
+  EXPECT_THAT(listener.sent_packet_ids, ElementsAre(1));
+  int ect = 0;
+  socket->GetOption(Socket::OPT_SEND_ECN, &ect);
+  EXPECT_EQ(ect, 0);
+
+  packet_options.last_packet_in_batch = true;
+  packet_options.packet_id = 3;
+  udp_socket->SendTo(buffer, 5, kAddr, packet_options);
+  EXPECT_THAT(listener.sent_packet_ids, ElementsAre(1, 2, 3));
+  socket->GetOption(Socket::OPT_SEND_ECN, &ect);
+  EXPECT_EQ(ect, 1);
+}
+
+TEST(AsyncUDPSocketTest, SendsHeldPacketsOnClose) {
+  VirtualSocketServer socket_server;
+  Socket* socket = socket_server.CreateSocket(kAddr.family(), SOCK_DGRAM);
+  std::unique_ptr<AsyncUDPSocket> udp_socket =
+      absl::WrapUnique(AsyncUDPSocket::Create(socket, kAddr));
+  SentPacketListener listener;
+  udp_socket->SignalSentPacket.connect(&listener,
+                                       &SentPacketListener::OnSentPacket);
+
+  uint8_t buffer[] = "hello";
+  rtc::PacketOptions packet_options;
+  packet_options.batchable = true;
+  packet_options.packet_id = 1;
+  udp_socket->SendTo(buffer, 5, kAddr, packet_options);
+  packet_options.packet_id = 2;
+  udp_socket->SendTo(buffer, 5, kAddr, packet_options);
+  EXPECT_THAT(listener.sent_packet_ids, IsEmpty());
+
+  udp_socket->Close();
+  EXPECT_THAT(listener.sent_packet_ids, ElementsAre(1, 2));
+}
+
+TEST(AsyncUDPSocketTest, SendsHeldPacketsOnDestruction) {
+  PhysicalSocketServer socket_server;
+  const SocketAddress kLoopback("127.0.0.1", 0);
+  std::unique_ptr<Socket> receiver(
+      socket_server.CreateSocket(kLoopback.family(), SOCK_DGRAM));
+  ASSERT_EQ(receiver->Bind(kLoopback), 0);
+  std::unique_ptr<AsyncUDPSocket> udp_socket =
+      absl::WrapUnique(AsyncUDPSocket::Create(&socket_server, kLoopback));
+  ASSERT_TRUE(udp_socket);
+
+  uint8_t buffer[] = "hello";
+  rtc::PacketOptions packet_options;
+  packet_options.batchable = true;
+  udp_socket->SendTo(buffer, 5, receiver->GetLocalAddress(), packet_options);
+  udp_socket->SendTo(buffer, 5, receiver->GetLocalAddress(), packet_options);
+  udp_socket = nullptr;
+
+  uint8_t received[16];
+  SocketAddress source;
+  int64_t timestamp;
+  EXPECT_EQ(receiver->RecvFrom(received, sizeof(received), &source, &timestamp),
+            5);
+  EXPECT_EQ(receiver->RecvFrom(received, sizeof(received), &source, &timestamp),
+            5);
+}
+
+TEST(AsyncUDPSocketTest, ReturnsErrorOfFailedBatch) {
+  VirtualSocketServer socket_server;
+  Socket* socket = socket_server.CreateSocket(kAddr.family(), SOCK_DGRAM);
+  std::unique_ptr<AsyncUDPSocket> udp_socket =
+      absl::WrapUnique(AsyncUDPSocket::Create(socket, kAddr));
+
+  uint8_t buffer[] = "hello";
+  rtc::PacketOptions packet_options;
+  packet_options.batchable = true;
+  EXPECT_EQ(udp_socket->SendTo(buffer, 5, kAddr, packet_options), 5);
+  socket_server.SetSendingBlocked(true);
+  packet_options.last_packet_in_batch = true;
+  EXPECT_EQ(udp_socket->SendTo(buffer, 5, kAddr, packet_options), -1);
+  EXPECT_EQ(udp_socket->GetError(), EWOULDBLOCK);
+
+  // A batch sent before an ECN change fails after its packets were accepted,
+  // so the next batchable packet reports it.
+  packet_options.last_packet_in_batch = false;
+  EXPECT_EQ(udp_socket->SendTo(buffer, 5, kAddr, packet_options), 5);
+  packet_options.ecn_1 = true;
+  EXPECT_EQ(udp_socket->SendTo(buffer, 5, kAddr, packet_options), -1);
+  EXPECT_EQ(udp_socket->GetError(), EWOULDBLOCK);
+
+  socket_server.SetSendingBlocked(false);
+  packet_options.last_packet_in_batch = true;
+  EXPECT_EQ(udp_socket->SendTo(buffer, 5, kAddr, packet_options), 5);
+}
+
+TEST(AsyncUDPSocketTest, DeliversQueuedDatagramsTogether) {
+  PhysicalSocketServer socket_server;
+  const SocketAddress kLoopback("127.0.0.1", 0);
+  std::unique_ptr<AsyncUDPSocket> receiver =
+      absl::WrapUnique(AsyncUDPSocket::Create(&socket_server, kLoopback));
+  std::unique_ptr<Socket> sender(
+      socket_server.CreateSocket(kLoopback.family(), SOCK_DGRAM));
+  ASSERT_TRUE(receiver);
+  ASSERT_EQ(sender->Bind(kLoopback), 0);
+
+  std::vector<std::vector<uint8_t>> received;
+  receiver->RegisterReceivedPacketBatchCallback(
+      [&](AsyncPacketSocket* /* socket */,
+          ArrayView<const ReceivedPacket> packets) {
+        for (const ReceivedPacket& packet : packets) {
+          EXPECT_EQ(packet.source_address(), sender->GetLocalAddress());
+          EXPECT_TRUE(packet.arrival_time().has_value());
+          received.emplace_back(packet.payload().begin(),
+                                packet.payload().end());
+        }
+      });
+  for (uint8_t i = 0; i < 5; ++i) {
+    std::vector<uint8_t> payload(100 + i, i);
+    sender->SendTo(payload.data(), payload.size(),
+                   receiver->GetLocalAddress());
+  }
+  for (int i = 0; i < 10 && received.size() < 5; ++i) {
+    socket_server.Wait(webrtc::TimeDelta::Millis(10), /*process_io=*/true);
+  }
+
+  ASSERT_THAT(received, SizeIs(5));
+  for (uint8_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(received[i], std::vector<uint8_t>(100 + i, i));
+  }
+}
+
+TEST(AsyncUDPSocketTest, DeliversLargeDatagramsAfterTheFirst) {
+  PhysicalSocketServer socket_server;
+  const SocketAddress kLoopback("127.0.0.1", 0);
+  std::unique_ptr<AsyncUDPSocket> receiver =
+      absl::WrapUnique(AsyncUDPSocket::Create(&socket_server, kLoopback));
+  std::unique_ptr<Socket> sender(
+      socket_server.CreateSocket(kLoopback.family(), SOCK_DGRAM));
+  ASSERT_TRUE(receiver);
+  ASSERT_EQ(sender->Bind(kLoopback), 0);
+
+  std::vector<std::vector<uint8_t>> received;
+  receiver->RegisterReceivedPacketBatchCallback(
+      [&](AsyncPacketSocket* /* socket */,
+          ArrayView<const ReceivedPacket> packets) {
+        for (const ReceivedPacket& packet : packets) {
+          received.emplace_back(packet.payload().begin(),
+                                packet.payload().end());
+        }
+      });
+  const size_t kSizes[] = {100, 9000, 30000};
+  for (uint8_t i = 0; i < 3; ++i) {
+    std::vector<uint8_t> payload(kSizes[i], i);
+    ASSERT_EQ(sender->SendTo(payload.data(), payload.size(),
+                             receiver->GetLocalAddress()),
+              static_cast<int>(payload.size()));
+  }
+  for (int i = 0; i < 10 && received.size() < 3; ++i) {
+    socket_server.Wait(webrtc::TimeDelta::Millis(10), /*process_io=*/true);
+  }
+
+  ASSERT_THAT(received, SizeIs(3));
+  for (uint8_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(received[i], std::vector<uint8_t>(kSizes[i], i));
+  }
+}
+
+TEST(AsyncUDPSocketTest, ReadsMoreDatagramsAtOnceWhileTheyQueueUp) {
+  PhysicalSocketServer socket_server;
+  const SocketAddress kLoopback("127.0.0.1", 0);
+  std::unique_ptr<AsyncUDPSocket> receiver =
+      absl::WrapUnique(AsyncUDPSocket::Create(&socket_server, kLoopback));
+  std::unique_ptr<Socket> sender(
+      socket_server.CreateSocket(kLoopback.family(), SOCK_DGRAM));
+  ASSERT_TRUE(receiver);
+  ASSERT_EQ(sender->Bind(kLoopback), 0);
+
+  std::vector<size_t> batch_sizes;
+  size_t num_received = 0;
+  receiver->RegisterReceivedPacketBatchCallback(
+      [&](AsyncPacketSocket* /* socket */,
+          ArrayView<const ReceivedPacket> packets) {
+        batch_sizes.push_back(packets.size());
+        num_received += packets.size();
+      });
+  constexpr size_t kNumDatagrams = 40;
+  for (size_t i = 0; i < kNumDatagrams; ++i) {
+    uint8_t payload[100] = {};
+    sender->SendTo(payload, sizeof(payload), receiver->GetLocalAddress());
+  }
+  for (int i = 0; i < 50 && num_received < kNumDatagrams; ++i) {
+    socket_server.Wait(webrtc::TimeDelta::Millis(10), /*process_io=*/true);
+  }
+
+  EXPECT_EQ(num_received, kNumDatagrams);
+  ASSERT_THAT(batch_sizes, Not(IsEmpty()));
+  // The first read is a single datagram, later ones read more at once.
+  EXPECT_EQ(batch_sizes.front(), 1u);
+#if defined(WEBRTC_LINUX)
+  EXPECT_THAT(batch_sizes, Contains(Gt(1u)));
+#endif
+  EXPECT_THAT(batch_sizes, Each(Le(16u)));
+}
+
 }  // namespace rtc
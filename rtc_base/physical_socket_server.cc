@@ -9,6 +9,8 @@
  */
 #include "rtc_base/physical_socket_server.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -44,6 +46,7 @@
 
 #include <errno.h>
 
+#include "api/array_view.h"
 #include "rtc_base/async_dns_resolver.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
@@ -57,6 +60,7 @@
 
 #if defined(WEBRTC_LINUX)
 #include <linux/sockios.h>
+#include <netinet/udp.h>
 #endif
 
 #if defined(WEBRTC_WIN)
@@ -109,6 +113,16 @@ typedef char* SockOptArg;
 #endif  // !defined(EPOLLRDHUP)
 #endif  // defined(WEBRTC_LINUX)
 
+#if defined(WEBRTC_LINUX)
+// UDP generic segmentation offload, Linux 4.18 and later.
+#if !defined(SOL_UDP)
+#define SOL_UDP 17
+#endif
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+#endif  // defined(WEBRTC_LINUX)
+
 namespace {
 
 // RFC-3168, Section 5. ECN is the two least significant bits.
@@ -135,6 +149,36 @@ rtc::EcnMarking EcnFromDs(uint8_t ds) {
   return rtc::EcnMarking::kNotEct;
 }
 
+// TODO(bugs.webrtc.org/15368): What size is needed? IPV6_TCLASS is supposed
+// to be an int. Why is a larger size needed?
+constexpr size_t kReceiveControlSize =
+    CMSG_SPACE(sizeof(struct timeval) + 5 * sizeof(int));
+
+// Reads the receive timestamp and the ECN marking, for those of `timestamp`
+// and `ecn` that are not null, from the control messages of `msg`.
+void ReadControlMessages(msghdr& msg,
+                         int64_t* timestamp,
+                         rtc::EcnMarking* ecn) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (ecn) {
+      if ((cmsg->cmsg_type == IPV6_TCLASS &&
+           cmsg->cmsg_level == IPPROTO_IPV6) ||
+          (cmsg->cmsg_type == IP_TOS && cmsg->cmsg_level == IPPROTO_IP)) {
+        *ecn = EcnFromDs(CMSG_DATA(cmsg)[0]);
+      }
+    }
+    if (cmsg->cmsg_level != SOL_SOCKET)
+      continue;
+    if (timestamp && cmsg->cmsg_type == SCM_TIMESTAMP) {
+      timeval ts;
+      std::memcpy(static_cast<void*>(&ts), CMSG_DATA(cmsg), sizeof(ts));
+      *timestamp = rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts.tv_sec) +
+                   static_cast<int64_t>(ts.tv_usec);
+    }
+  }
+}
+
 #endif
 
 class ScopedSetTrue {
@@ -437,6 +481,144 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+#if defined(WEBRTC_LINUX)
+namespace {
+
+// Kernel limits: UDP_MAX_SEGMENTS and UIO_MAXIOV, and the largest UDP payload.
+constexpr size_t kMaxSegmentsPerSend = 64;
+constexpr size_t kMaxDatagramsPerSendmmsg = 64;
+constexpr size_t kMaxDatagramsPerRecvmmsg = 64;
+constexpr size_t kMaxSegmentedSendSize = 65507;
+
+#if !defined(WEBRTC_ANDROID)
+// Suppress SIGPIPE, see PhysicalSocket::Send().
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+// Returns how many of the leading `datagrams` can be sent as one segmented
+// buffer: all to the same address and of the same size, except for the last
+// one which may be shorter.
+size_t SegmentableCount(ArrayView<const Socket::Datagram> datagrams) {
+  const Socket::Datagram& first = datagrams[0];
+  if (first.size == 0) {
+    return 1;
+  }
+  size_t total_size = first.size;
+  size_t count = 1;
+  while (count < datagrams.size() && count < kMaxSegmentsPerSend) {
+    const Socket::Datagram& next = datagrams[count];
+    if (next.size == 0 || next.size > first.size ||
+        total_size + next.size > kMaxSegmentedSendSize ||
+        *next.address != *first.address) {
+      break;
+    }
+    total_size += next.size;
+    ++count;
+    if (next.size < first.size) {
+      break;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+int PhysicalSocket::SendToBatch(ArrayView<const Datagram> datagrams) {
+  if (!udp_) {
+    return Socket::SendToBatch(datagrams);
+  }
+  size_t sent = 0;
+  while (sent < datagrams.size()) {
+    ArrayView<const Datagram> remaining = datagrams.subview(sent);
+    size_t segmentable = SegmentableCount(remaining);
+    int result;
+    if (segmentable > 1 && SupportsUdpSegmentation()) {
+      result = DoSendSegmented(remaining.subview(0, segmentable));
+      if (result < 0 && (GetError() == EIO || GetError() == EINVAL)) {
+        // The device cannot segment (e.g. no checksum offload); stop trying.
+        RTC_LOG(LS_INFO) << "UDP segmentation failed with error "
+                         << GetError() << ", falling back to sendmmsg.";
+        udp_segmentation_ = false;
+        continue;
+      }
+    } else {
+      result = DoSendMmsg(remaining);
+    }
+    if (result <= 0) {
+      break;
+    }
+    sent += result;
+  }
+  if (sent < datagrams.size() && IsBlockingError(GetError())) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent == 0 && !datagrams.empty() ? -1 : static_cast<int>(sent);
+}
+
+bool PhysicalSocket::SupportsUdpSegmentation() {
+  if (!udp_segmentation_.has_value()) {
+    int segment_size = 0;
+    socklen_t length = sizeof(segment_size);
+    udp_segmentation_ =
+        ::getsockopt(s_, SOL_UDP, UDP_SEGMENT, &segment_size, &length) == 0;
+  }
+  return *udp_segmentation_;
+}
+
+int PhysicalSocket::DoSendSegmented(ArrayView<const Datagram> datagrams) {
+  RTC_DCHECK_LE(datagrams.size(), kMaxSegmentsPerSend);
+  sockaddr_storage saddr;
+  size_t addr_len = datagrams[0].address->ToSockAddrStorage(&saddr);
+  std::array<iovec, kMaxSegmentsPerSend> iov;
+  for (size_t i = 0; i < datagrams.size(); ++i) {
+    iov[i].iov_base = const_cast<void*>(datagrams[i].data);
+    iov[i].iov_len = datagrams[i].size;
+  }
+  char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+  msghdr msg = {};
+  msg.msg_name = &saddr;
+  msg.msg_namelen = static_cast<socklen_t>(addr_len);
+  msg.msg_iov = iov.data();
+  msg.msg_iovlen = datagrams.size();
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  const uint16_t segment_size = static_cast<uint16_t>(datagrams[0].size);
+  std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+  int sent = ::sendmsg(s_, &msg, kSendFlags);
+  UpdateLastError();
+  MaybeRemapSendError();
+  return sent < 0 ? sent : static_cast<int>(datagrams.size());
+}
+
+int PhysicalSocket::DoSendMmsg(ArrayView<const Datagram> datagrams) {
+  const size_t count = std::min(datagrams.size(), kMaxDatagramsPerSendmmsg);
+  std::array<mmsghdr, kMaxDatagramsPerSendmmsg> messages = {};
+  std::array<iovec, kMaxDatagramsPerSendmmsg> iov;
+  std::array<sockaddr_storage, kMaxDatagramsPerSendmmsg> addresses;
+  for (size_t i = 0; i < count; ++i) {
+    iov[i].iov_base = const_cast<void*>(datagrams[i].data);
+    iov[i].iov_len = datagrams[i].size;
+    msghdr& msg = messages[i].msg_hdr;
+    msg.msg_name = &addresses[i];
+    msg.msg_namelen = static_cast<socklen_t>(
+        datagrams[i].address->ToSockAddrStorage(&addresses[i]));
+    msg.msg_iov = &iov[i];
+    msg.msg_iovlen = 1;
+  }
+  int sent = ::sendmmsg(s_, messages.data(), count, kSendFlags);
+  UpdateLastError();
+  MaybeRemapSendError();
+  return sent;
+}
+#endif  // defined(WEBRTC_LINUX)
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received = DoReadFromSocket(buffer, length, /*out_addr*/ nullptr,
                                   timestamp, /*ecn=*/nullptr);
@@ -506,6 +688,59 @@ int PhysicalSocket::RecvFrom(ReceiveBuffer& buffer) {
   return received;
 }
 
+#if defined(WEBRTC_LINUX)
+int PhysicalSocket::RecvFromBatch(ArrayView<ReceiveBuffer> buffers) {
+  if (!udp_ || buffers.size() <= 1) {
+    return Socket::RecvFromBatch(buffers);
+  }
+  const size_t count = std::min(buffers.size(), kMaxDatagramsPerRecvmmsg);
+  std::array<mmsghdr, kMaxDatagramsPerRecvmmsg> messages = {};
+  std::array<iovec, kMaxDatagramsPerRecvmmsg> iov;
+  std::array<sockaddr_storage, kMaxDatagramsPerRecvmmsg> addresses;
+  std::array<std::array<char, kReceiveControlSize>, kMaxDatagramsPerRecvmmsg>
+      control;
+  for (size_t i = 0; i < count; ++i) {
+    Buffer& payload = buffers[i].payload;
+    RTC_DCHECK_GT(payload.capacity(), 0);
+    iov[i].iov_base = payload.data();
+    iov[i].iov_len = payload.capacity();
+    msghdr& msg = messages[i].msg_hdr;
+    msg.msg_name = &addresses[i];
+    msg.msg_namelen = sizeof(addresses[i]);
+    msg.msg_iov = &iov[i];
+    msg.msg_iovlen = 1;
+    msg.msg_control = control[i].data();
+    msg.msg_controllen = control[i].size();
+  }
+  int received = ::recvmmsg(s_, messages.data(), count, 0, nullptr);
+  UpdateLastError();
+  int error = GetError();
+  bool success = (received >= 0) || IsBlockingError(error);
+  EnableEvents(DE_READ);
+  if (!success) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+  for (int i = 0; i < received; ++i) {
+    ReceiveBuffer& buffer = buffers[i];
+    msghdr& msg = messages[i].msg_hdr;
+    if (msg.msg_flags & MSG_TRUNC) {
+      RTC_LOG(LS_WARNING) << "Dropping a datagram larger than "
+                          << buffer.payload.capacity() << " bytes.";
+      buffer.payload.SetSize(0);
+      continue;
+    }
+    buffer.payload.SetSize(messages[i].msg_len);
+    SocketAddressFromSockAddrStorage(addresses[i], &buffer.source_address);
+    int64_t timestamp = -1;
+    ReadControlMessages(msg, &timestamp, ecn_ ? &buffer.ecn : nullptr);
+    if (timestamp != -1) {
+      buffer.arrival_time = webrtc::Timestamp::Micros(timestamp);
+    }
+  }
+  return received;
+}
+#endif  // defined(WEBRTC_LINUX)
+
 int PhysicalSocket::DoReadFromSocket(void* buffer,
                                      size_t length,
                                      SocketAddress* out_addr,
@@ -524,9 +759,7 @@ int PhysicalSocket::DoReadFromSocket(void* buffer,
     msg.msg_name = addr;
     msg.msg_namelen = addr_len;
   }
-    // TODO(bugs.webrtc.org/15368): What size is needed? IPV6_TCLASS is supposed
-    // to be an int. Why is a larger size needed?
-    char control[CMSG_SPACE(sizeof(struct timeval) + 5 * sizeof(int))] = {};
+    char control[kReceiveControlSize] = {};
     if (timestamp || ecn) {
       *timestamp = -1;
       msg.msg_control = &control;
@@ -538,25 +771,7 @@ int PhysicalSocket::DoReadFromSocket(void* buffer,
       return received;
     }
     if (timestamp || ecn) {
-      struct cmsghdr* cmsg;
-      for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
-        if (ecn) {
-          if ((cmsg->cmsg_type == IPV6_TCLASS &&
-               cmsg->cmsg_level == IPPROTO_IPV6) ||
-              (cmsg->cmsg_type == IP_TOS && cmsg->cmsg_level == IPPROTO_IP)) {
-            *ecn = EcnFromDs(CMSG_DATA(cmsg)[0]);
-          }
-        }
-        if (cmsg->cmsg_level != SOL_SOCKET)
-          continue;
-        if (timestamp && cmsg->cmsg_type == SCM_TIMESTAMP) {
-          timeval ts;
-          std::memcpy(static_cast<void*>(&ts), CMSG_DATA(cmsg), sizeof(ts));
-          *timestamp =
-              rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts.tv_sec) +
-              static_cast<int64_t>(ts.tv_usec);
-        }
-      }
+      ReadControlMessages(msg, timestamp, ecn);
     }
     if (out_addr) {
       SocketAddressFromSockAddrStorage(addr_storage, out_addr);
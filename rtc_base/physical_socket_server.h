@@ -37,6 +37,7 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -183,6 +184,11 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+#if defined(WEBRTC_LINUX)
+  // Uses UDP GSO for runs of equally sized datagrams to the same address and
+  // sendmmsg() for the rest.
+  int SendToBatch(ArrayView<const Datagram> datagrams) override;
+#endif
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   // TODO(webrtc:15368): Deprecate and remove.
@@ -191,6 +197,10 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                SocketAddress* out_addr,
                int64_t* timestamp) override;
   int RecvFrom(ReceiveBuffer& buffer) override;
+#if defined(WEBRTC_LINUX)
+  // Uses recvmmsg().
+  int RecvFromBatch(ArrayView<ReceiveBuffer> buffers) override;
+#endif
 
   int Listen(int backlog) override;
   Socket* Accept(SocketAddress* out_addr) override;
@@ -224,6 +234,16 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                        int64_t* timestamp,
                        EcnMarking* ecn);
 
+#if defined(WEBRTC_LINUX)
+  // Sends `datagrams`, all but the last of the same size and all to the same
+  // address, as one UDP_SEGMENT buffer. Returns the number of datagrams sent.
+  int DoSendSegmented(ArrayView<const Datagram> datagrams);
+  // Sends as many of `datagrams` as fit in one sendmmsg() call. Returns the
+  // number of datagrams sent.
+  int DoSendMmsg(ArrayView<const Datagram> datagrams);
+  bool SupportsUdpSegmentation();
+#endif
+
   void OnResolveResult(const webrtc::AsyncDnsResolverResult& resolver);
 
   void UpdateLastError();
@@ -246,6 +266,10 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   std::unique_ptr<webrtc::AsyncDnsResolverInterface> resolver_;
   uint8_t dscp_ = 0;  // 6bit.
   uint8_t ecn_ = 0;   // 2bits.
+#if defined(WEBRTC_LINUX)
+  // Whether the kernel can segment UDP sends, probed on the first batch.
+  std::optional<bool> udp_segmentation_;
+#endif
 
 #if !defined(NDEBUG)
   std::string dbg_addr_;
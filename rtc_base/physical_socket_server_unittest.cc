@@ -13,8 +13,11 @@
 #include <signal.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
+#include "rtc_base/buffer.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/logging.h"
@@ -532,4 +535,88 @@ TEST_F(PhysicalSocketTest, UdpSocketRecvTimestampUseRtcEpochIPv6) {
   SocketTest::TestUdpSocketRecvTimestampUseRtcEpochIPv6();
 }
 
+TEST_F(PhysicalSocketTest, SendToBatchDeliversDatagramsInOrder) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver_a(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> receiver_b(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver_a->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, receiver_b->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  const SocketAddress address_a = receiver_a->GetLocalAddress();
+  const SocketAddress address_b = receiver_b->GetLocalAddress();
+
+  // A run of equally sized datagrams ending with a shorter one, which can be
+  // sent segmented, followed by datagrams of varying size and destination.
+  const struct {
+    size_t size;
+    const SocketAddress* address;
+  } kDatagrams[] = {{1200, &address_a}, {1200, &address_a}, {1200, &address_a},
+                    {1200, &address_a}, {300, &address_a},  {1000, &address_b},
+                    {17, &address_a},   {1000, &address_b}, {900, &address_a}};
+  std::vector<Buffer> payloads;
+  std::vector<Socket::Datagram> datagrams;
+  for (const auto& datagram : kDatagrams) {
+    payloads.emplace_back(datagram.size);
+    std::fill(payloads.back().begin(), payloads.back().end(),
+              static_cast<uint8_t>(payloads.size()));
+  }
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    datagrams.push_back({.data = payloads[i].data(),
+                         .size = payloads[i].size(),
+                         .address = kDatagrams[i].address});
+  }
+  EXPECT_EQ(static_cast<int>(datagrams.size()), sender->SendToBatch(datagrams));
+
+  Buffer received;
+  for (Socket* receiver : {receiver_a.get(), receiver_b.get()}) {
+    const SocketAddress& address = receiver->GetLocalAddress();
+    for (size_t i = 0; i < datagrams.size(); ++i) {
+      if (*datagrams[i].address != address) {
+        continue;
+      }
+      Socket::ReceiveBuffer receive_buffer(received);
+      ASSERT_EQ(static_cast<int>(datagrams[i].size),
+                receiver->RecvFrom(receive_buffer))
+          << "datagram " << i;
+      EXPECT_EQ(received, payloads[i]) << "datagram " << i;
+      EXPECT_EQ(receive_buffer.source_address, sender->GetLocalAddress());
+    }
+  }
+}
+
+#if defined(WEBRTC_LINUX)
+TEST_F(PhysicalSocketTest, RecvFromBatchReceivesQueuedDatagrams) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  // Datagrams of different sizes, none of them the first, are received whole.
+  const size_t kSizes[] = {100, 3000, 200};
+  for (size_t i = 0; i < 3; ++i) {
+    std::vector<uint8_t> payload(kSizes[i], static_cast<uint8_t>(i));
+    ASSERT_EQ(static_cast<int>(payload.size()),
+              sender->SendTo(payload.data(), payload.size(),
+                             receiver->GetLocalAddress()));
+  }
+
+  std::vector<Buffer> payloads(4);
+  std::vector<Socket::ReceiveBuffer> buffers;
+  for (Buffer& payload : payloads) {
+    payload.EnsureCapacity(4096);
+    buffers.emplace_back(payload);
+  }
+  ASSERT_EQ(3, receiver->RecvFromBatch(buffers));
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(std::vector<uint8_t>(payloads[i].begin(), payloads[i].end()),
+              std::vector<uint8_t>(kSizes[i], static_cast<uint8_t>(i)))
+        << "datagram " << i;
+    EXPECT_EQ(buffers[i].source_address, sender->GetLocalAddress());
+    EXPECT_TRUE(buffers[i].arrival_time.has_value());
+  }
+}
+#endif
+
 }  // namespace rtc
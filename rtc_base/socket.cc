@@ -10,8 +10,10 @@
 
 #include "rtc_base/socket.h"
 
+#include <cstddef>
 #include <cstdint>
 
+#include "api/array_view.h"
 #include "rtc_base/buffer.h"
 
 namespace rtc {
@@ -30,4 +32,23 @@ int Socket::RecvFrom(ReceiveBuffer& buffer) {
   return len;
 }
 
+int Socket::RecvFromBatch(ArrayView<ReceiveBuffer> buffers) {
+  if (buffers.empty()) {
+    return 0;
+  }
+  int len = RecvFrom(buffers[0]);
+  return len < 0 ? len : 1;
+}
+
+int Socket::SendToBatch(ArrayView<const Datagram> datagrams) {
+  size_t sent = 0;
+  for (const Datagram& datagram : datagrams) {
+    if (SendTo(datagram.data, datagram.size, *datagram.address) < 0) {
+      break;
+    }
+    ++sent;
+  }
+  return sent == 0 && !datagrams.empty() ? -1 : static_cast<int>(sent);
+}
+
 }  // namespace rtc
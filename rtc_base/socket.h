@@ -23,6 +23,7 @@
 #define SOCKET_EACCES EACCES
 #endif
 
+#include "api/array_view.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
@@ -93,6 +94,12 @@ class RTC_EXPORT Socket {
     EcnMarking ecn = EcnMarking::kNotEct;
     Buffer& payload;
   };
+  // One datagram of SendToBatch().
+  struct Datagram {
+    const void* data = nullptr;
+    size_t size = 0;
+    const SocketAddress* address = nullptr;
+  };
   virtual ~Socket() {}
 
   Socket(const Socket&) = delete;
@@ -110,6 +117,12 @@ class RTC_EXPORT Socket {
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // Sends `datagrams` in order with as few system calls as the socket
+  // supports. Returns the number of datagrams sent, which is less than
+  // `datagrams.size()` if one of them could not be sent, or -1 if none were;
+  // GetError() then tells why. The default implementation calls SendTo() for
+  // each datagram.
+  virtual int SendToBatch(ArrayView<const Datagram> datagrams);
   // `timestamp` is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   // TODO(webrtc:15368): Deprecate and remove.
@@ -124,6 +137,13 @@ class RTC_EXPORT Socket {
   // Default implementation calls RecvFrom(void* ...) with 64Kbyte buffer.
   // Returns number of bytes received or a negative value on error.
   virtual int RecvFrom(ReceiveBuffer& buffer);
+  // Receives datagrams that are already queued, one into each of `buffers`,
+  // up to the capacity of its payload. Returns the number of datagrams
+  // received or a negative value on error. A datagram that did not fit is
+  // dropped and its payload left empty, so every buffer should have room for
+  // the largest datagram accepted. The default implementation receives one
+  // datagram with RecvFrom(ReceiveBuffer&).
+  virtual int RecvFromBatch(ArrayView<ReceiveBuffer> buffers);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/network_controller_replay/control_update_writer.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "api/transport/network_types.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+ControlUpdateWriter::ControlUpdateWriter(FILE* output) : output_(output) {
+  RTC_DCHECK(output_);
+  fprintf(output_,
+          "time_ms,target_rate_bps,stable_target_rate_bps,pacing_rate_bps,"
+          "padding_rate_bps,congestion_window_bytes,probe_cluster_id,"
+          "probe_rate_bps,probe_duration_ms\n");
+}
+
+void ControlUpdateWriter::OnUpdate(const NetworkControlUpdate& update,
+                                   Timestamp at_time) {
+  if (update.target_rate || update.pacer_config || update.congestion_window) {
+    fprintf(output_, "%" PRId64, at_time.ms());
+    if (update.target_rate) {
+      fprintf(output_, ",%" PRId64 ",%" PRId64,
+              update.target_rate->target_rate.bps(),
+              update.target_rate->stable_target_rate.bps());
+    } else {
+      fprintf(output_, ",,");
+    }
+    if (update.pacer_config) {
+      fprintf(output_, ",%" PRId64 ",%" PRId64,
+              update.pacer_config->data_rate().bps(),
+              update.pacer_config->pad_rate().bps());
+    } else {
+      fprintf(output_, ",,");
+    }
+    // An infinite window means that there is no congestion window.
+    if (update.congestion_window && update.congestion_window->IsFinite()) {
+      fprintf(output_, ",%" PRId64, update.congestion_window->bytes());
+    } else {
+      fprintf(output_, ",");
+    }
+    fprintf(output_, ",,,\n");
+    ++rows_written_;
+  }
+  for (const ProbeClusterConfig& probe : update.probe_cluster_configs) {
+    fprintf(output_, "%" PRId64 ",,,,,,%d,%" PRId64 ",%" PRId64 "\n",
+            at_time.ms(), probe.id, probe.target_data_rate.bps(),
+            probe.target_duration.ms());
+    ++rows_written_;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_NETWORK_CONTROLLER_REPLAY_CONTROL_UPDATE_WRITER_H_
+#define RTC_TOOLS_NETWORK_CONTROLLER_REPLAY_CONTROL_UPDATE_WRITER_H_
+
+#include <stdio.h>
+
+#include <cstddef>
+
+#include "api/transport/network_types.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+
+// Writes the decisions of a network controller to `output` as comma separated
+// columns, so that runs of different controllers over the same log can be
+// compared with standard tools. Each update with a target rate, pacer config
+// or congestion window gives one row, and each probe cluster it requests one
+// more. Fields an update does not set are left empty.
+class ControlUpdateWriter {
+ public:
+  // `output` is not owned and must outlive the writer.
+  explicit ControlUpdateWriter(FILE* output);
+
+  ControlUpdateWriter(const ControlUpdateWriter&) = delete;
+  ControlUpdateWriter& operator=(const ControlUpdateWriter&) = delete;
+
+  void OnUpdate(const NetworkControlUpdate& update, Timestamp at_time);
+
+  size_t rows_written() const { return rows_written_; }
+
+ private:
+  FILE* const output_;
+  size_t rows_written_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_NETWORK_CONTROLLER_REPLAY_CONTROL_UPDATE_WRITER_H_
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/network_controller_replay/control_update_writer.h"
+
+#include <stdio.h>
+
+#include <string>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::string ReadAll(FILE* file) {
+  std::string contents;
+  rewind(file);
+  char buffer[256];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents.append(buffer, read);
+  }
+  return contents;
+}
+
+TEST(ControlUpdateWriterTest, WritesOneRowPerUpdateAndProbe) {
+  FILE* file = tmpfile();
+  ASSERT_NE(file, nullptr);
+  ControlUpdateWriter writer(file);
+
+  NetworkControlUpdate rates;
+  rates.target_rate = TargetTransferRate();
+  rates.target_rate->target_rate = DataRate::BitsPerSec(300'000);
+  rates.target_rate->stable_target_rate = DataRate::BitsPerSec(250'000);
+  rates.pacer_config = PacerConfig();
+  rates.pacer_config->time_window = TimeDelta::Seconds(1);
+  rates.pacer_config->data_window = DataSize::Bytes(100'000);
+  rates.pacer_config->pad_window = DataSize::Bytes(1'000);
+  writer.OnUpdate(rates, Timestamp::Millis(1000));
+
+  NetworkControlUpdate probes;
+  probes.congestion_window = DataSize::Bytes(20'000);
+  ProbeClusterConfig probe;
+  probe.id = 3;
+  probe.target_data_rate = DataRate::BitsPerSec(900'000);
+  probe.target_duration = TimeDelta::Millis(15);
+  probes.probe_cluster_configs.push_back(probe);
+  writer.OnUpdate(probes, Timestamp::Millis(1025));
+
+  // Updates without decisions are not written.
+  writer.OnUpdate(NetworkControlUpdate(), Timestamp::Millis(1050));
+
+  EXPECT_EQ(writer.rows_written(), 3u);
+  EXPECT_EQ(ReadAll(file),
+            "time_ms,target_rate_bps,stable_target_rate_bps,pacing_rate_bps,"
+            "padding_rate_bps,congestion_window_bytes,probe_cluster_id,"
+            "probe_rate_bps,probe_duration_ms\n"
+            "1000,300000,250000,800000,8000,,,,\n"
+            "1025,,,,,20000,,,\n"
+            "1025,,,,,,3,900000,15\n");
+  fclose(file);
+}
+
+}  // namespace
+}  // namespace webrtc
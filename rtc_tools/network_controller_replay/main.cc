@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/strings/string_view.h"
+#include "api/transport/goog_cc_factory.h"
+#include "api/transport/network_control.h"
+#include "api/transport/network_types.h"
+#include "api/units/timestamp.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_tools/network_controller_replay/control_update_writer.h"
+#include "rtc_tools/rtc_event_log_visualizer/log_simulation.h"
+#include "system_wrappers/include/field_trial.h"
+
+ABSL_FLAG(std::string,
+          controller,
+          "goog_cc",
+          "Network controller to replay the logs through. One of: goog_cc, bbr.");
+ABSL_FLAG(std::string,
+          output_dir,
+          "",
+          "Directory to write the results to. By default each result is "
+          "written next to its log.");
+ABSL_FLAG(std::string,
+          force_fieldtrials,
+          "",
+          "Field trials control experimental feature code which can be forced. "
+          "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enabled/"
+          " will assign the group Enabled to field trial WebRTC-FooFeature.");
+ABSL_FLAG(bool,
+          parse_unconfigured_header_extensions,
+          true,
+          "Attempt to parse unconfigured header extensions using the default "
+          "WebRTC mapping. This can give very misleading results if the "
+          "application negotiates a different mapping.");
+
+namespace webrtc {
+namespace {
+
+std::unique_ptr<NetworkControllerFactoryInterface> CreateFactory(
+    absl::string_view controller) {
+  if (controller == "goog_cc") {
+    return std::make_unique<GoogCcNetworkControllerFactory>();
+  }
+  if (controller == "bbr") {
+    return std::make_unique<BbrNetworkControllerFactory>();
+  }
+  return nullptr;
+}
+
+std::string OutputFileName(absl::string_view log_file,
+                           absl::string_view output_dir,
+                           absl::string_view controller) {
+  std::string name(log_file);
+  if (!output_dir.empty()) {
+    size_t separator = log_file.find_last_of('/');
+    name = std::string(output_dir) + "/" +
+           std::string(separator == absl::string_view::npos
+                           ? log_file
+                           : log_file.substr(separator + 1));
+  }
+  return name + "." + std::string(controller) + ".csv";
+}
+
+// Replays `log_file` through a network controller created by `controller` and
+// writes its decisions to `output_file`.
+bool Replay(const std::string& log_file,
+            const std::string& output_file,
+            absl::string_view controller,
+            ParsedRtcEventLog::UnconfiguredHeaderExtensions header_extensions) {
+  const int64_t start_ms = rtc::TimeMillis();
+  ParsedRtcEventLog parsed_log(header_extensions,
+                               /*allow_incomplete_logs=*/true);
+  auto status = parsed_log.ParseFile(log_file);
+  if (!status.ok()) {
+    RTC_LOG(LS_ERROR) << "Failed to parse " << log_file << ": "
+                      << status.message();
+    return false;
+  }
+
+  FILE* output = fopen(output_file.c_str(), "w");
+  if (output == nullptr) {
+    RTC_LOG(LS_ERROR) << "Failed to open " << output_file;
+    return false;
+  }
+  ControlUpdateWriter writer(output);
+  LogBasedNetworkControllerSimulation simulation(
+      CreateFactory(controller),
+      [&](const NetworkControlUpdate& update, Timestamp at_time) {
+        writer.OnUpdate(update, at_time);
+      });
+  simulation.ProcessEventsInLog(parsed_log);
+  fclose(output);
+
+  const Timestamp first_time = parsed_log.first_timestamp();
+  const Timestamp last_time = parsed_log.last_timestamp();
+  printf("%s: %zu rows, %.1f s of log in %.1f s\n", output_file.c_str(),
+         writer.rows_written(),
+         first_time.IsFinite() && last_time.IsFinite()
+             ? (last_time - first_time).seconds<double>()
+             : 0.0,
+         (rtc::TimeMillis() - start_ms) / 1000.0);
+  return true;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+// Replays the send side of RTC event logs through a network controller, faster
+// than real time, to compare controllers or controller changes over many logs.
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "A tool for replaying WebRTC event logs through a network controller.\n"
+      "The sent packets, transport feedback and receiver reports of each log\n"
+      "are fed to the controller, and its target rate, pacing rate,\n"
+      "congestion window and probe decisions are written as a CSV file named\n"
+      "<log>.<controller>.csv.\n"
+      "\n"
+      "Example usage:\n"
+      "./network_controller_replay <log1> <log2> ...\n"
+      "./network_controller_replay --output_dir=out "
+      "--force_fieldtrials=WebRTC-Bwe-Foo/Enabled/ <log1> <log2> ...\n"
+      "Logs are replayed one at a time; run several instances, e.g. with\n"
+      "xargs -P, to replay many logs in parallel.\n");
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+
+  // Print RTC_LOG warnings and errors even in release builds.
+  if (rtc::LogMessage::GetLogToDebug() > rtc::LS_WARNING) {
+    rtc::LogMessage::LogToDebug(rtc::LS_WARNING);
+  }
+  rtc::LogMessage::SetLogToStderr(true);
+
+  // InitFieldTrialsFromString stores the char*, so the char array must outlive
+  // the application.
+  const std::string field_trials = absl::GetFlag(FLAGS_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(field_trials.c_str());
+
+  const std::string controller = absl::GetFlag(FLAGS_controller);
+  if (args.size() < 2 || !webrtc::CreateFactory(controller)) {
+    // Print usage information.
+    absl::string_view usage = absl::ProgramUsageMessage();
+    fwrite(usage.data(), usage.size(), 1, stderr);
+    return 1;
+  }
+
+  webrtc::ParsedRtcEventLog::UnconfiguredHeaderExtensions header_extensions =
+      webrtc::ParsedRtcEventLog::UnconfiguredHeaderExtensions::kDontParse;
+  if (absl::GetFlag(FLAGS_parse_unconfigured_header_extensions)) {
+    header_extensions = webrtc::ParsedRtcEventLog::
+        UnconfiguredHeaderExtensions::kAttemptWebrtcDefaultConfig;
+  }
+
+  const std::string output_dir = absl::GetFlag(FLAGS_output_dir);
+  int failures = 0;
+  for (size_t i = 1; i < args.size(); ++i) {
+    const std::string log_file = args[i];
+    if (!webrtc::Replay(
+            log_file,
+            webrtc::OutputFileName(log_file, output_dir, controller),
+            controller, header_extensions)) {
+      ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "api/environment/environment_factory.h"
@@ -82,7 +83,13 @@ void LogBasedNetworkControllerSimulation::OnProbeCreated(
 void LogBasedNetworkControllerSimulation::OnPacketSent(
     const LoggedPacketInfo& packet) {
   ProcessUntil(packet.log_packet_time);
-  if (packet.has_transport_seq_no) {
+  std::optional<uint16_t> transport_seq_no;
+  if (use_congestion_control_feedback_) {
+    transport_seq_no = next_transport_seq_no_++;
+  } else if (packet.has_transport_seq_no) {
+    transport_seq_no = packet.transport_seq_no;
+  }
+  if (transport_seq_no) {
     PacedPacketInfo probe_info;
     if (!pending_probes_.empty() &&
         packet.media_type == LoggedMediaType::kVideo) {
@@ -100,9 +107,11 @@ void LogBasedNetworkControllerSimulation::OnPacketSent(
     }
 
     RtpPacketToSend send_packet(/*extensions=*/nullptr);
-    send_packet.set_transport_sequence_number(packet.transport_seq_no);
+    send_packet.set_transport_sequence_number(*transport_seq_no);
     send_packet.SetSsrc(packet.ssrc);
-    send_packet.SetSequenceNumber(packet.transport_seq_no);
+    send_packet.SetSequenceNumber(use_congestion_control_feedback_
+                                      ? packet.stream_seq_no
+                                      : *transport_seq_no);
     send_packet.SetPayloadSize(packet.size - send_packet.headers_size());
     RTC_DCHECK_EQ(send_packet.size(), packet.size);
     transport_feedback_.AddPacket(send_packet, probe_info, packet.overhead,
@@ -112,8 +121,8 @@ void LogBasedNetworkControllerSimulation::OnPacketSent(
   sent_packet.send_time_ms = packet.log_packet_time.ms();
   sent_packet.info.included_in_allocation = true;
   sent_packet.info.packet_size_bytes = packet.size + packet.overhead;
-  if (packet.has_transport_seq_no) {
-    sent_packet.packet_id = packet.transport_seq_no;
+  if (transport_seq_no) {
+    sent_packet.packet_id = *transport_seq_no;
     sent_packet.info.included_in_feedback = true;
   }
   auto msg = transport_feedback_.ProcessSentPacket(sent_packet);
@@ -131,6 +140,15 @@ void LogBasedNetworkControllerSimulation::OnFeedback(
     HandleStateUpdate(controller_->OnTransportPacketsFeedback(*msg));
 }
 
+void LogBasedNetworkControllerSimulation::OnCongestionControlFeedback(
+    const LoggedRtcpCongestionControlFeedback& feedback) {
+  ProcessUntil(feedback.log_time());
+  auto msg = transport_feedback_.ProcessCongestionControlFeedback(
+      feedback.congestion_feedback, feedback.log_time());
+  if (msg)
+    HandleStateUpdate(controller_->OnTransportPacketsFeedback(*msg));
+}
+
 void LogBasedNetworkControllerSimulation::OnReceiverReport(
     const LoggedRtcpPacketReceiverReport& report) {
   if (report.rr.report_blocks().empty())
@@ -196,6 +214,9 @@ void LogBasedNetworkControllerSimulation::OnIceConfig(
 void LogBasedNetworkControllerSimulation::ProcessEventsInLog(
     const ParsedRtcEventLog& parsed_log_) {
   auto packet_infos = parsed_log_.GetOutgoingPacketInfos();
+  use_congestion_control_feedback_ =
+      !parsed_log_.congestion_feedback(PacketDirection::kIncomingPacket)
+           .empty();
   RtcEventProcessor processor;
   processor.AddEvents(
       parsed_log_.bwe_probe_cluster_created_events(),
@@ -212,6 +233,12 @@ void LogBasedNetworkControllerSimulation::ProcessEventsInLog(
         OnFeedback(feedback);
       },
       PacketDirection::kIncomingPacket);
+  processor.AddEvents(
+      parsed_log_.congestion_feedback(PacketDirection::kIncomingPacket),
+      [this](const LoggedRtcpCongestionControlFeedback& feedback) {
+        OnCongestionControlFeedback(feedback);
+      },
+      PacketDirection::kIncomingPacket);
   processor.AddEvents(
       parsed_log_.receiver_reports(PacketDirection::kIncomingPacket),
       [this](const LoggedRtcpPacketReceiverReport& report) {
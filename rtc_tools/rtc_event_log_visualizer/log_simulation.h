@@ -51,6 +51,8 @@ class LogBasedNetworkControllerSimulation {
   void OnProbeCreated(const LoggedBweProbeClusterCreatedEvent& probe_cluster);
   void OnPacketSent(const LoggedPacketInfo& packet);
   void OnFeedback(const LoggedRtcpPacketTransportFeedback& feedback);
+  void OnCongestionControlFeedback(
+      const LoggedRtcpCongestionControlFeedback& feedback);
   void OnReceiverReport(const LoggedRtcpPacketReceiverReport& report);
   void OnIceConfig(const LoggedIceCandidatePairConfig& candidate);
   RtcEventLogNull null_event_log_;
@@ -63,6 +65,11 @@ class LogBasedNetworkControllerSimulation {
   Timestamp current_time_ = Timestamp::MinusInfinity();
   Timestamp last_process_ = Timestamp::MinusInfinity();
   TransportFeedbackAdapter transport_feedback_;
+  // With RFC 8888 congestion control feedback, packets are matched by SSRC and
+  // RTP sequence number and need not carry a transport sequence number, so one
+  // is assigned to every sent packet.
+  bool use_congestion_control_feedback_ = false;
+  uint16_t next_transport_seq_no_ = 0;
   std::deque<ProbingStatus> pending_probes_;
   std::map<uint32_t, rtcp::ReportBlock> last_report_blocks_;
   Timestamp last_report_block_time_ = Timestamp::MinusInfinity();
@@ -10,18 +10,33 @@
 
 #include "rtc_tools/video_file_reader.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "absl/strings/match.h"
 #include "api/make_ref_counted.h"
+#include "api/ref_count.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/video_frame_buffer.h"
+#include "common_video/include/video_frame_buffer_pool.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/string_to_number.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 namespace test {
@@ -32,6 +47,77 @@ bool ReadBytes(uint8_t* dst, size_t n, FILE* file) {
   return fread(reinterpret_cast<char*>(dst), /* size= */ 1, n, file) == n;
 }
 
+struct Y4mHeader {
+  int width;
+  int height;
+  float fps;
+};
+
+// Parses the stream header parameters that follow "YUV4MPEG2 ".
+std::optional<Y4mHeader> ParseY4mHeader(const std::string& header_line) {
+  std::optional<int> width;
+  std::optional<int> height;
+  std::optional<float> fps;
+
+  std::vector<std::string> fields;
+  rtc::tokenize(header_line, ' ', &fields);
+  for (const std::string& field : fields) {
+    const char prefix = field.front();
+    const std::string suffix = field.substr(1);
+    switch (prefix) {
+      case 'W':
+        width = rtc::StringToNumber<int>(suffix);
+        break;
+      case 'H':
+        height = rtc::StringToNumber<int>(suffix);
+        break;
+      case 'C':
+        if (suffix != "420" && suffix != "420mpeg2") {
+          RTC_LOG(LS_ERROR)
+              << "Does not support any other color space than I420 or "
+                 "420mpeg2, but was: "
+              << suffix;
+          return std::nullopt;
+        }
+        break;
+      case 'F': {
+        std::vector<std::string> fraction;
+        rtc::tokenize(suffix, ':', &fraction);
+        if (fraction.size() == 2) {
+          const std::optional<int> numerator =
+              rtc::StringToNumber<int>(fraction[0]);
+          const std::optional<int> denominator =
+              rtc::StringToNumber<int>(fraction[1]);
+          if (numerator && denominator && *denominator != 0)
+            fps = *numerator / static_cast<float>(*denominator);
+          break;
+        }
+      }
+    }
+  }
+  if (!width || !height) {
+    RTC_LOG(LS_ERROR) << "Could not find width and height in file header";
+    return std::nullopt;
+  }
+  if (!fps) {
+    RTC_LOG(LS_ERROR) << "Could not find fps in file header";
+    return std::nullopt;
+  }
+  RTC_LOG(LS_INFO) << "Video has resolution: " << *width << "x" << *height
+                   << " " << *fps << " fps";
+  if (*width % 2 != 0 || *height % 2 != 0) {
+    RTC_LOG(LS_ERROR)
+        << "Only supports even width/height so that chroma size is a "
+           "whole number.";
+    return std::nullopt;
+  }
+  return Y4mHeader{*width, *height, *fps};
+}
+
+// Upper bound on the frames of a VideoFile that can be in use at once before
+// GetFrame() falls back to allocating a buffer per frame.
+constexpr size_t kMaxPooledFrames = 8;
+
 // Common base class for .yuv and .y4m files.
 class VideoFile : public Video {
  public:
@@ -42,7 +128,8 @@ class VideoFile : public Video {
       : width_(width),
         height_(height),
         frame_positions_(frame_positions),
-        file_(file) {}
+        file_(file),
+        buffer_pool_(/*zero_initialize=*/false, kMaxPooledFrames) {}
 
   ~VideoFile() override { fclose(file_); }
 
@@ -54,8 +141,17 @@ class VideoFile : public Video {
       size_t frame_index) const override {
     RTC_CHECK_LT(frame_index, frame_positions_.size());
 
+    // Callers may share the video between threads, and both the file position
+    // and `buffer_pool_` must only be used by one of them at a time.
+    MutexLock lock(&mutex_);
     fsetpos(file_, &frame_positions_[frame_index]);
-    rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+    // Frames are read into pooled buffers, which are reused once the caller
+    // releases a frame. A caller holding on to many frames gets new buffers.
+    rtc::scoped_refptr<I420Buffer> buffer =
+        buffer_pool_.CreateI420Buffer(width_, height_);
+    if (!buffer) {
+      buffer = I420Buffer::Create(width_, height_);
+    }
 
     if (!ReadBytes(buffer->MutableDataY(), width_ * height_, file_) ||
         !ReadBytes(buffer->MutableDataU(),
@@ -73,9 +169,238 @@ class VideoFile : public Video {
   const int width_;
   const int height_;
   const std::vector<fpos_t> frame_positions_;
-  FILE* const file_;
+  mutable Mutex mutex_;
+  FILE* const file_ RTC_PT_GUARDED_BY(mutex_);
+  mutable VideoFrameBufferPool buffer_pool_ RTC_GUARDED_BY(mutex_);
+};
+
+// Read-only view of a whole file. On POSIX the file is memory mapped and
+// prefaulted, elsewhere it is read into memory once.
+class MappedFile : public RefCountInterface {
+ public:
+  static rtc::scoped_refptr<MappedFile> Open(const std::string& file_name) {
+#if defined(WEBRTC_POSIX)
+    const int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      RTC_LOG(LS_ERROR) << "Could not open input file for reading: "
+                        << file_name;
+      return nullptr;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+      RTC_LOG(LS_ERROR) << "Could not get size of " << file_name;
+      close(fd);
+      return nullptr;
+    }
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+    // Fault in every page now rather than on first playback.
+    flags |= MAP_POPULATE;
+#endif
+    void* data = mmap(nullptr, size, PROT_READ, flags, fd, 0);
+    // The mapping holds its own reference to the file.
+    close(fd);
+    if (data == MAP_FAILED) {
+      RTC_LOG(LS_ERROR) << "Could not map " << file_name;
+      return nullptr;
+    }
+    madvise(data, size, MADV_WILLNEED);
+    return rtc::make_ref_counted<MappedFile>(static_cast<const uint8_t*>(data),
+                                             size);
+#else
+    FILE* file = fopen(file_name.c_str(), "rb");
+    if (file == nullptr) {
+      RTC_LOG(LS_ERROR) << "Could not open input file for reading: "
+                        << file_name;
+      return nullptr;
+    }
+    std::vector<uint8_t> contents;
+    uint8_t chunk[64 * 1024];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+      contents.insert(contents.end(), chunk, chunk + read);
+    }
+    fclose(file);
+    if (contents.empty()) {
+      RTC_LOG(LS_ERROR) << "Could not read " << file_name;
+      return nullptr;
+    }
+    return rtc::make_ref_counted<MappedFile>(std::move(contents));
+#endif
+  }
+
+#if defined(WEBRTC_POSIX)
+  MappedFile(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+  ~MappedFile() override {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+#else
+  explicit MappedFile(std::vector<uint8_t> contents)
+      : contents_(std::move(contents)),
+        data_(contents_.data()),
+        size_(contents_.size()) {}
+#endif
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+#if !defined(WEBRTC_POSIX)
+  const std::vector<uint8_t> contents_;
+#endif
+  const uint8_t* const data_;
+  const size_t size_;
+};
+
+// I420 frame pointing straight into a MappedFile, which it keeps alive.
+class MappedI420Buffer : public I420BufferInterface {
+ public:
+  MappedI420Buffer(rtc::scoped_refptr<const MappedFile> file,
+                   size_t offset,
+                   int width,
+                   int height)
+      : file_(std::move(file)),
+        width_(width),
+        height_(height),
+        data_y_(file_->data() + offset),
+        data_u_(data_y_ + width * height),
+        data_v_(data_u_ + ChromaWidth() * ChromaHeight()) {}
+
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+  const uint8_t* DataY() const override { return data_y_; }
+  const uint8_t* DataU() const override { return data_u_; }
+  const uint8_t* DataV() const override { return data_v_; }
+  int StrideY() const override { return width_; }
+  int StrideU() const override { return ChromaWidth(); }
+  int StrideV() const override { return ChromaWidth(); }
+
+ private:
+  const rtc::scoped_refptr<const MappedFile> file_;
+  const int width_;
+  const int height_;
+  const uint8_t* const data_y_;
+  const uint8_t* const data_u_;
+  const uint8_t* const data_v_;
+};
+
+// Video whose frames are all created up front on top of a MappedFile, so
+// GetFrame() only bumps a reference count: no I/O and no allocation.
+class MappedVideoFile : public Video {
+ public:
+  MappedVideoFile(int width,
+                  int height,
+                  std::vector<rtc::scoped_refptr<I420BufferInterface>> frames)
+      : width_(width), height_(height), frames_(std::move(frames)) {}
+
+  size_t number_of_frames() const override { return frames_.size(); }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+
+  rtc::scoped_refptr<I420BufferInterface> GetFrame(
+      size_t frame_index) const override {
+    RTC_CHECK_LT(frame_index, frames_.size());
+    return frames_[frame_index];
+  }
+
+ private:
+  const int width_;
+  const int height_;
+  const std::vector<rtc::scoped_refptr<I420BufferInterface>> frames_;
 };
 
+rtc::scoped_refptr<Video> CreateMappedVideoFile(
+    rtc::scoped_refptr<const MappedFile> file,
+    const std::vector<size_t>& frame_offsets,
+    int width,
+    int height) {
+  if (frame_offsets.empty()) {
+    RTC_LOG(LS_ERROR) << "Could not find any frames in the file";
+    return nullptr;
+  }
+  RTC_LOG(LS_INFO) << "Video has " << frame_offsets.size()
+                   << " frames, mapped " << file->size() << " bytes";
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> frames;
+  frames.reserve(frame_offsets.size());
+  for (size_t offset : frame_offsets) {
+    frames.push_back(
+        rtc::make_ref_counted<MappedI420Buffer>(file, offset, width, height));
+  }
+  return rtc::make_ref_counted<MappedVideoFile>(width, height,
+                                                std::move(frames));
+}
+
+rtc::scoped_refptr<Video> OpenMappedY4mFile(const std::string& file_name) {
+  rtc::scoped_refptr<const MappedFile> file = MappedFile::Open(file_name);
+  if (!file) {
+    return nullptr;
+  }
+  const char* const begin = reinterpret_cast<const char*>(file->data());
+  const char* const end = begin + file->size();
+
+  static constexpr char kFileHeader[] = "YUV4MPEG2 ";
+  const size_t file_header_size = sizeof(kFileHeader) - 1;
+  if (file->size() < file_header_size ||
+      memcmp(begin, kFileHeader, file_header_size) != 0) {
+    RTC_LOG(LS_ERROR) << "File " << file_name
+                      << " does not start with YUV4MPEG2 header";
+    return nullptr;
+  }
+  const char* const header_end =
+      std::find(begin + file_header_size, end, '\n');
+  if (header_end == end) {
+    RTC_LOG(LS_ERROR) << "Could not read header line";
+    return nullptr;
+  }
+  const std::optional<Y4mHeader> header =
+      ParseY4mHeader(std::string(begin + file_header_size, header_end));
+  if (!header) {
+    return nullptr;
+  }
+
+  static constexpr char kFrameHeader[] = "FRAME\n";
+  const size_t frame_header_size = sizeof(kFrameHeader) - 1;
+  const size_t i420_frame_size = 3 * header->width * header->height / 2;
+  std::vector<size_t> frame_offsets;
+  const char* position = header_end + 1;
+  while (position != end) {
+    if (static_cast<size_t>(end - position) <
+            frame_header_size + i420_frame_size ||
+        memcmp(position, kFrameHeader, frame_header_size) != 0) {
+      RTC_LOG(LS_ERROR) << "Did not find FRAME header, ignoring rest of file";
+      break;
+    }
+    position += frame_header_size;
+    frame_offsets.push_back(position - begin);
+    position += i420_frame_size;
+  }
+  return CreateMappedVideoFile(std::move(file), frame_offsets, header->width,
+                               header->height);
+}
+
+rtc::scoped_refptr<Video> OpenMappedYuvFile(const std::string& file_name,
+                                            int width,
+                                            int height) {
+  if (width % 2 != 0 || height % 2 != 0) {
+    RTC_LOG(LS_ERROR)
+        << "Only supports even width/height so that chroma size is a "
+           "whole number.";
+    return nullptr;
+  }
+  rtc::scoped_refptr<const MappedFile> file = MappedFile::Open(file_name);
+  if (!file) {
+    return nullptr;
+  }
+  const size_t i420_frame_size = 3 * width * height / 2;
+  std::vector<size_t> frame_offsets;
+  for (size_t offset = 0; offset + i420_frame_size <= file->size();
+       offset += i420_frame_size) {
+    frame_offsets.push_back(offset);
+  }
+  return CreateMappedVideoFile(std::move(file), frame_offsets, width, height);
+}
+
 }  // namespace
 
 Video::Iterator::Iterator(const rtc::scoped_refptr<const Video>& video,
@@ -144,64 +469,12 @@ rtc::scoped_refptr<Video> OpenY4mFile(const std::string& file_name) {
     header_line.push_back(static_cast<char>(c));
   }
 
-  std::optional<int> width;
-  std::optional<int> height;
-  std::optional<float> fps;
-
-  std::vector<std::string> fields;
-  rtc::tokenize(header_line, ' ', &fields);
-  for (const std::string& field : fields) {
-    const char prefix = field.front();
-    const std::string suffix = field.substr(1);
-    switch (prefix) {
-      case 'W':
-        width = rtc::StringToNumber<int>(suffix);
-        break;
-      case 'H':
-        height = rtc::StringToNumber<int>(suffix);
-        break;
-      case 'C':
-        if (suffix != "420" && suffix != "420mpeg2") {
-          RTC_LOG(LS_ERROR)
-              << "Does not support any other color space than I420 or "
-                 "420mpeg2, but was: "
-              << suffix;
-          return nullptr;
-        }
-        break;
-      case 'F': {
-        std::vector<std::string> fraction;
-        rtc::tokenize(suffix, ':', &fraction);
-        if (fraction.size() == 2) {
-          const std::optional<int> numerator =
-              rtc::StringToNumber<int>(fraction[0]);
-          const std::optional<int> denominator =
-              rtc::StringToNumber<int>(fraction[1]);
-          if (numerator && denominator && *denominator != 0)
-            fps = *numerator / static_cast<float>(*denominator);
-          break;
-        }
-      }
-    }
-  }
-  if (!width || !height) {
-    RTC_LOG(LS_ERROR) << "Could not find width and height in file header";
-    return nullptr;
-  }
-  if (!fps) {
-    RTC_LOG(LS_ERROR) << "Could not find fps in file header";
-    return nullptr;
-  }
-  RTC_LOG(LS_INFO) << "Video has resolution: " << *width << "x" << *height
-                   << " " << *fps << " fps";
-  if (*width % 2 != 0 || *height % 2 != 0) {
-    RTC_LOG(LS_ERROR)
-        << "Only supports even width/height so that chroma size is a "
-           "whole number.";
+  const std::optional<Y4mHeader> header = ParseY4mHeader(header_line);
+  if (!header) {
     return nullptr;
   }
 
-  const int i420_frame_size = 3 * *width * *height / 2;
+  const int i420_frame_size = 3 * header->width * header->height / 2;
   std::vector<fpos_t> frame_positions;
   while (true) {
     std::array<char, 6> read_buffer;
@@ -225,8 +498,8 @@ rtc::scoped_refptr<Video> OpenY4mFile(const std::string& file_name) {
   }
   RTC_LOG(LS_INFO) << "Video has " << frame_positions.size() << " frames";
 
-  return rtc::make_ref_counted<VideoFile>(*width, *height, frame_positions,
-                                          file);
+  return rtc::make_ref_counted<VideoFile>(header->width, header->height,
+                                          frame_positions, file);
 }
 
 rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
@@ -284,5 +557,19 @@ rtc::scoped_refptr<Video> OpenYuvOrY4mFile(const std::string& file_name,
   return nullptr;
 }
 
+rtc::scoped_refptr<Video> OpenMappedYuvOrY4mFile(const std::string& file_name,
+                                                 int width,
+                                                 int height) {
+  if (absl::EndsWith(file_name, ".yuv"))
+    return OpenMappedYuvFile(file_name, width, height);
+  if (absl::EndsWith(file_name, ".y4m"))
+    return OpenMappedY4mFile(file_name);
+
+  RTC_LOG(LS_ERROR) << "Video file does not end in either .yuv or .y4m: "
+                    << file_name;
+
+  return nullptr;
+}
+
 }  // namespace test
 }  // namespace webrtc
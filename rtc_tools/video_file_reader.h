@@ -76,6 +76,15 @@ rtc::scoped_refptr<Video> OpenYuvOrY4mFile(const std::string& file_name,
                                            int width,
                                            int height);
 
+// Same as OpenYuvOrY4mFile(), but maps the whole file into memory up front
+// and returns frames that point straight into the mapping. After opening,
+// GetFrame() does no I/O, copying or allocation, which keeps file reads out
+// of the timing of whatever consumes the frames. The mapping is released once
+// the Video and every frame obtained from it are gone.
+rtc::scoped_refptr<Video> OpenMappedYuvOrY4mFile(const std::string& file_name,
+                                                 int width,
+                                                 int height);
+
 }  // namespace test
 }  // namespace webrtc
 
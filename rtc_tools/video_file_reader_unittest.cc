@@ -11,20 +11,39 @@
 #include "rtc_tools/video_file_reader.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include <string>
+#include <vector>
 
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
 
 namespace webrtc {
 namespace test {
+namespace {
+
+void ExpectSameFrames(const Video& expected, const Video& actual) {
+  ASSERT_EQ(expected.width(), actual.width());
+  ASSERT_EQ(expected.height(), actual.height());
+  ASSERT_EQ(expected.number_of_frames(), actual.number_of_frames());
+  const int y_size = expected.width() * expected.height();
+  const int chroma_size = y_size / 4;
+  for (size_t i = 0; i < expected.number_of_frames(); ++i) {
+    rtc::scoped_refptr<I420BufferInterface> a = expected.GetFrame(i);
+    rtc::scoped_refptr<I420BufferInterface> b = actual.GetFrame(i);
+    EXPECT_EQ(0, memcmp(a->DataY(), b->DataY(), y_size));
+    EXPECT_EQ(0, memcmp(a->DataU(), b->DataU(), chroma_size));
+    EXPECT_EQ(0, memcmp(a->DataV(), b->DataV(), chroma_size));
+  }
+}
+
+}  // namespace
 
 class Y4mFileReaderTest : public ::testing::Test {
  public:
   void SetUp() override {
-    const std::string filename =
-        TempFilename(webrtc::test::OutputPath(), "test_video_file.y4m");
+    filename = TempFilename(webrtc::test::OutputPath(), "test_video_file.y4m");
 
     // Create simple test video of size 6x4.
     FILE* file = fopen(filename.c_str(), "wb");
@@ -49,6 +68,7 @@ class Y4mFileReaderTest : public ::testing::Test {
     ASSERT_TRUE(video);
   }
 
+  std::string filename;
   rtc::scoped_refptr<webrtc::test::Video> video;
 };
 
@@ -73,11 +93,47 @@ TEST_F(Y4mFileReaderTest, TestPixelContent) {
   }
 }
 
+TEST_F(Y4mFileReaderTest, MappedFileHasSameContent) {
+  rtc::scoped_refptr<Video> mapped = OpenMappedYuvOrY4mFile(filename, 0, 0);
+  ASSERT_TRUE(mapped);
+  ExpectSameFrames(*video, *mapped);
+}
+
+TEST_F(Y4mFileReaderTest, MappedFileReturnsFramesWithoutCopying) {
+  rtc::scoped_refptr<Video> mapped = OpenMappedYuvOrY4mFile(filename, 0, 0);
+  ASSERT_TRUE(mapped);
+  EXPECT_EQ(mapped->GetFrame(1).get(), mapped->GetFrame(1).get());
+}
+
+TEST_F(Y4mFileReaderTest, MappedFrameOutlivesVideo) {
+  rtc::scoped_refptr<I420BufferInterface> frame =
+      OpenMappedYuvOrY4mFile(filename, 0, 0)->GetFrame(1);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(6 * 4 * 3 / 2, frame->DataY()[0]);
+}
+
+TEST_F(Y4mFileReaderTest, ReusesBufferOfReleasedFrame) {
+  const uint8_t* const released_data = video->GetFrame(0)->DataY();
+  rtc::scoped_refptr<I420BufferInterface> frame = video->GetFrame(1);
+  EXPECT_EQ(released_data, frame->DataY());
+  EXPECT_EQ(6 * 4 * 3 / 2, frame->DataY()[0]);
+}
+
+TEST_F(Y4mFileReaderTest, FramesInUseKeepTheirContent) {
+  // More frames than the reader pools, so that some are newly allocated.
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> frames;
+  for (size_t i = 0; i < 20; ++i) {
+    frames.push_back(video->GetFrame(i % 2));
+  }
+  for (size_t i = 0; i < frames.size(); ++i) {
+    EXPECT_EQ(static_cast<int>(i % 2) * 6 * 4 * 3 / 2, frames[i]->DataY()[0]);
+  }
+}
+
 class YuvFileReaderTest : public ::testing::Test {
  public:
   void SetUp() override {
-    const std::string filename =
-        TempFilename(webrtc::test::OutputPath(), "test_video_file.yuv");
+    filename = TempFilename(webrtc::test::OutputPath(), "test_video_file.yuv");
 
     // Create simple test video of size 6x4.
     FILE* file = fopen(filename.c_str(), "wb");
@@ -99,6 +155,7 @@ class YuvFileReaderTest : public ::testing::Test {
     ASSERT_TRUE(video);
   }
 
+  std::string filename;
   rtc::scoped_refptr<webrtc::test::Video> video;
 };
 
@@ -123,5 +180,11 @@ TEST_F(YuvFileReaderTest, TestPixelContent) {
   }
 }
 
+TEST_F(YuvFileReaderTest, MappedFileHasSameContent) {
+  rtc::scoped_refptr<Video> mapped = OpenMappedYuvOrY4mFile(filename, 6, 4);
+  ASSERT_TRUE(mapped);
+  ExpectSameFrames(*video, *mapped);
+}
+
 }  // namespace test
 }  // namespace webrtc
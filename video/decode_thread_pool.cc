@@ -0,0 +1,250 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/functional/function_ref.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/numerics/divide_round.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+class DecodeThreadPool::Queue final : public TaskQueueBase {
+ public:
+  explicit Queue(DecodeThreadPool* pool) : pool_(pool) {}
+  ~Queue() override = default;
+
+  void Delete() override {
+    RTC_DCHECK(!IsCurrent());
+    pool_->DeleteQueue(this);
+  }
+
+  // Runs `f` with this queue set as the current task queue.
+  void RunAsCurrent(absl::FunctionRef<void()> f) {
+    CurrentTaskQueueSetter set_current(this);
+    f();
+  }
+
+ protected:
+  void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                    const PostTaskTraits& traits,
+                    const Location& location) override {
+    pool_->PostTask(this, std::move(task), Timestamp::MinusInfinity());
+  }
+  void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                           TimeDelta delay,
+                           const PostDelayedTaskTraits& traits,
+                           const Location& location) override {
+    pool_->PostDelayedTask(this, std::move(task), delay);
+  }
+
+ private:
+  friend class DecodeThreadPool;
+
+  DecodeThreadPool* const pool_;
+
+  // Members below are guarded by the pool's mutex.
+  std::queue<std::pair<ReadyKey, Task>> pending_;
+  // If a pool thread is running a task of this queue. A running queue is not
+  // in `ready_queues_`.
+  bool running_ = false;
+  bool deleted_ = false;
+  // Signaled when the running task of a deleted queue has completed.
+  rtc::Event idle_;
+};
+
+DecodeThreadPool::DecodeThreadPool(int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  threads_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.push_back(rtc::PlatformThread::SpawnJoinable(
+        [this] { ProcessTasks(); }, "DecodeThreadPool",
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kHigh)));
+  }
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+  {
+    MutexLock lock(&mutex_);
+    RTC_DCHECK_EQ(num_queues_, 0);
+    quit_ = true;
+  }
+  wake_up_.Set();
+  // Joins the threads.
+  threads_.clear();
+}
+
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+DecodeThreadPool::CreateTaskQueue() {
+  {
+    MutexLock lock(&mutex_);
+    ++num_queues_;
+  }
+  return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(new Queue(this));
+}
+
+void DecodeThreadPool::PostDecodeTask(TaskQueueBase* task_queue,
+                                      absl::AnyInvocable<void() &&> task,
+                                      Timestamp render_time) {
+  Queue* queue = static_cast<Queue*>(task_queue);
+  RTC_DCHECK_EQ(queue->pool_, this);
+  PostTask(queue, std::move(task), render_time);
+}
+
+void DecodeThreadPool::PostTask(Queue* queue, Task task, Timestamp deadline) {
+  {
+    MutexLock lock(&mutex_);
+    if (queue->deleted_) {
+      // Dropped, `task` is destroyed outside the lock.
+      return;
+    }
+    PushTask(queue, std::move(task), deadline);
+  }
+  wake_up_.Set();
+}
+
+void DecodeThreadPool::PostDelayedTask(Queue* queue,
+                                       Task task,
+                                       TimeDelta delay) {
+  const int64_t fire_at_us = rtc::TimeMicros() + delay.us();
+  {
+    MutexLock lock(&mutex_);
+    if (queue->deleted_) {
+      return;
+    }
+    delayed_tasks_.emplace(DelayedKey{fire_at_us, ++next_order_},
+                           std::make_pair(queue, std::move(task)));
+  }
+  wake_up_.Set();
+}
+
+void DecodeThreadPool::DeleteQueue(Queue* queue) {
+  std::queue<std::pair<ReadyKey, Task>> pending;
+  std::vector<Task> delayed;
+  bool running;
+  {
+    MutexLock lock(&mutex_);
+    queue->deleted_ = true;
+    running = queue->running_;
+    if (!running && !queue->pending_.empty()) {
+      ready_queues_.erase(queue->pending_.front().first);
+    }
+    pending.swap(queue->pending_);
+    for (auto it = delayed_tasks_.begin(); it != delayed_tasks_.end();) {
+      if (it->second.first == queue) {
+        delayed.push_back(std::move(it->second.second));
+        it = delayed_tasks_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    --num_queues_;
+  }
+  if (running) {
+    queue->idle_.Wait(rtc::Event::kForever);
+  }
+  // Destroy the tasks that did not run with the queue set as current, as a
+  // TaskQueueBase implementation would.
+  queue->RunAsCurrent([&] {
+    pending = {};
+    delayed.clear();
+  });
+  delete queue;
+}
+
+void DecodeThreadPool::PushTask(Queue* queue, Task task, Timestamp deadline) {
+  const ReadyKey key = {.deadline = deadline, .order = ++next_order_};
+  queue->pending_.emplace(key, std::move(task));
+  if (!queue->running_ && queue->pending_.size() == 1) {
+    ready_queues_.emplace(key, queue);
+  }
+}
+
+TimeDelta DecodeThreadPool::PromoteDelayedTasks() {
+  if (delayed_tasks_.empty()) {
+    return rtc::Event::kForever;
+  }
+  const int64_t now_us = rtc::TimeMicros();
+  while (!delayed_tasks_.empty()) {
+    auto it = delayed_tasks_.begin();
+    if (it->first.fire_at_us > now_us) {
+      return TimeDelta::Millis(
+          DivideRoundUp(it->first.fire_at_us - now_us, 1'000));
+    }
+    PushTask(it->second.first, std::move(it->second.second),
+             Timestamp::MinusInfinity());
+    delayed_tasks_.erase(it);
+  }
+  return rtc::Event::kForever;
+}
+
+void DecodeThreadPool::ProcessTasks() {
+  while (true) {
+    Queue* queue = nullptr;
+    Task task;
+    TimeDelta sleep_time = rtc::Event::kForever;
+    bool more_work = false;
+    {
+      MutexLock lock(&mutex_);
+      if (quit_) {
+        break;
+      }
+      sleep_time = PromoteDelayedTasks();
+      if (!ready_queues_.empty()) {
+        auto it = ready_queues_.begin();
+        queue = it->second;
+        ready_queues_.erase(it);
+        task = std::move(queue->pending_.front().second);
+        queue->pending_.pop();
+        queue->running_ = true;
+        more_work = !ready_queues_.empty() || !delayed_tasks_.empty();
+      }
+    }
+
+    if (queue == nullptr) {
+      wake_up_.Wait(sleep_time, sleep_time);
+      continue;
+    }
+    if (more_work) {
+      wake_up_.Set();
+    }
+
+    queue->RunAsCurrent([&] {
+      std::move(task)();
+      // Destroy the task while the queue is current.
+      task = nullptr;
+    });
+
+    MutexLock lock(&mutex_);
+    queue->running_ = false;
+    if (queue->deleted_) {
+      queue->idle_.Set();
+    } else if (!queue->pending_.empty()) {
+      ready_queues_.emplace(queue->pending_.front().first, queue);
+    }
+  }
+  // Wake up the next thread to quit.
+  wake_up_.Set();
+}
+
+}  // namespace webrtc
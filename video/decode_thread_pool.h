@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_DECODE_THREAD_POOL_H_
+#define VIDEO_DECODE_THREAD_POOL_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// DecodeThreadPool runs the decode queues of many video receive streams on a
+// fixed number of threads, typically one per core, instead of one thread per
+// stream. A receiver with a large number of incoming streams then neither
+// oversubscribes the CPU nor relies on the OS to pick which stream to decode
+// next.
+//
+// Each queue created by the pool is a TaskQueueBase that runs its tasks in
+// order, on one pool thread at a time. Whenever a thread is free it takes the
+// queue whose next task has the earliest deadline, so when the pool is
+// overloaded CPU goes to the frames closest to their render time. Decode tasks
+// are posted with PostDecodeTask() and the render time of their frame; tasks
+// posted through the TaskQueueBase interface have no deadline and run ahead of
+// all decode tasks.
+//
+// The pool must outlive all of its queues.
+class DecodeThreadPool {
+ public:
+  explicit DecodeThreadPool(int num_threads);
+  DecodeThreadPool(const DecodeThreadPool&) = delete;
+  DecodeThreadPool& operator=(const DecodeThreadPool&) = delete;
+  ~DecodeThreadPool();
+
+  int num_threads() const { return static_cast<int>(threads_.size()); }
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue();
+
+  // Posts `task` to `task_queue`, which must have been created by this pool.
+  // `render_time` is the render time of the frame that `task` decodes.
+  void PostDecodeTask(TaskQueueBase* task_queue,
+                      absl::AnyInvocable<void() &&> task,
+                      Timestamp render_time);
+
+ private:
+  class Queue;
+  using Order = uint64_t;
+  using Task = absl::AnyInvocable<void() &&>;
+
+  struct ReadyKey {
+    Timestamp deadline;
+    Order order;
+
+    bool operator<(const ReadyKey& o) const {
+      return std::tie(deadline, order) < std::tie(o.deadline, o.order);
+    }
+  };
+
+  struct DelayedKey {
+    int64_t fire_at_us;
+    Order order;
+
+    bool operator<(const DelayedKey& o) const {
+      return std::tie(fire_at_us, order) < std::tie(o.fire_at_us, o.order);
+    }
+  };
+
+  void PostTask(Queue* queue, Task task, Timestamp deadline);
+  void PostDelayedTask(Queue* queue, Task task, TimeDelta delay);
+  void DeleteQueue(Queue* queue);
+
+  void PushTask(Queue* queue, Task task, Timestamp deadline)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Moves the delayed tasks that are due to their queues. Returns the time
+  // until the next delayed task is due.
+  TimeDelta PromoteDelayedTasks() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void ProcessTasks();
+
+  // Signaled when a task or a delayed task is posted, or on shutdown. Threads
+  // that take a queue while more work is pending signal it again, so that
+  // idle threads wake up one after another.
+  rtc::Event wake_up_;
+
+  Mutex mutex_;
+  bool quit_ RTC_GUARDED_BY(mutex_) = false;
+  Order next_order_ RTC_GUARDED_BY(mutex_) = 0;
+  int num_queues_ RTC_GUARDED_BY(mutex_) = 0;
+  // Queues that have pending tasks and are not running, by the deadline of
+  // their next task.
+  std::map<ReadyKey, Queue*> ready_queues_ RTC_GUARDED_BY(mutex_);
+  std::map<DelayedKey, std::pair<Queue*, Task>> delayed_tasks_
+      RTC_GUARDED_BY(mutex_);
+
+  // Placed last so that the threads don't see uninitialized members.
+  std::vector<rtc::PlatformThread> threads_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_DECODE_THREAD_POOL_H_
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/field_trials_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/task_queue/task_queue_test.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/event.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr TimeDelta kTimeout = TimeDelta::Seconds(5);
+
+class DecodeThreadPoolTaskQueueFactory : public TaskQueueFactory {
+ public:
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return pool_.CreateTaskQueue();
+  }
+
+ private:
+  mutable DecodeThreadPool pool_{/*num_threads=*/2};
+};
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueFactory(
+    const FieldTrialsView*) {
+  return std::make_unique<DecodeThreadPoolTaskQueueFactory>();
+}
+
+INSTANTIATE_TEST_SUITE_P(DecodeThreadPool,
+                         TaskQueueTest,
+                         ::testing::Values(CreateTaskQueueFactory));
+
+TEST(DecodeThreadPoolTest, RunsFramesClosestToRenderTimeFirst) {
+  DecodeThreadPool pool(/*num_threads=*/1);
+  auto blocked_queue = pool.CreateTaskQueue();
+  auto queue1 = pool.CreateTaskQueue();
+  auto queue2 = pool.CreateTaskQueue();
+  auto queue3 = pool.CreateTaskQueue();
+  auto queue4 = pool.CreateTaskQueue();
+
+  // Keep the only thread busy while the tasks are posted.
+  rtc::Event blocked;
+  blocked_queue->PostTask([&] { blocked.Wait(rtc::Event::kForever); });
+
+  std::vector<int> order;
+  rtc::Event done;
+  auto run = [&](int id) {
+    return [&, id] {
+      order.push_back(id);
+      if (order.size() == 5) {
+        done.Set();
+      }
+    };
+  };
+  pool.PostDecodeTask(queue1.get(), run(1), Timestamp::Millis(30));
+  pool.PostDecodeTask(queue2.get(), run(2), Timestamp::Millis(10));
+  pool.PostDecodeTask(queue3.get(), run(3), Timestamp::Millis(20));
+  // Tasks of one queue run in the order they were posted.
+  pool.PostDecodeTask(queue3.get(), run(4), Timestamp::Millis(5));
+  // Tasks without a render time run first.
+  queue4->PostTask(run(0));
+  blocked.Set();
+
+  ASSERT_TRUE(done.Wait(kTimeout));
+  EXPECT_THAT(order, ElementsAre(0, 2, 3, 4, 1));
+}
+
+TEST(DecodeThreadPoolTest, RunsQueuesInParallel) {
+  DecodeThreadPool pool(/*num_threads=*/2);
+  auto queue1 = pool.CreateTaskQueue();
+  auto queue2 = pool.CreateTaskQueue();
+
+  // Each task waits for the other one, so both must run at the same time.
+  rtc::Event started1;
+  rtc::Event started2;
+  rtc::Event done1;
+  rtc::Event done2;
+  pool.PostDecodeTask(
+      queue1.get(),
+      [&] {
+        started1.Set();
+        if (started2.Wait(kTimeout)) {
+          done1.Set();
+        }
+      },
+      Timestamp::Millis(10));
+  pool.PostDecodeTask(
+      queue2.get(),
+      [&] {
+        started2.Set();
+        if (started1.Wait(kTimeout)) {
+          done2.Set();
+        }
+      },
+      Timestamp::Millis(20));
+
+  EXPECT_TRUE(done1.Wait(kTimeout));
+  EXPECT_TRUE(done2.Wait(kTimeout));
+}
+
+TEST(DecodeThreadPoolTest, DeletingQueueWaitsForRunningTask) {
+  DecodeThreadPool pool(/*num_threads=*/1);
+  auto queue = pool.CreateTaskQueue();
+
+  rtc::Event started;
+  bool task_ran = false;
+  bool pending_task_ran = false;
+  queue->PostTask([&] {
+    started.Set();
+    // Give the test thread time to start deleting the queue.
+    rtc::Event().Wait(TimeDelta::Millis(50));
+    task_ran = true;
+  });
+  queue->PostTask([&] { pending_task_ran = true; });
+  ASSERT_TRUE(started.Wait(kTimeout));
+  queue = nullptr;
+
+  EXPECT_TRUE(task_ran);
+  EXPECT_FALSE(pending_task_ran);
+}
+
+}  // namespace
+}  // namespace webrtc
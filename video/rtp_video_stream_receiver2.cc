@@ -359,9 +359,13 @@ void RtpVideoStreamReceiver2::AddReceiveCodec(
     packet_buffer_.ForceSpsPpsIdrIsH264Keyframe();
     sps_pps_idr_is_h264_keyframe_ = true;
   }
-  payload_type_map_.emplace(
-      payload_type, raw_payload ? std::make_unique<VideoRtpDepacketizerRaw>()
-                                : CreateVideoRtpDepacketizer(video_codec));
+  std::unique_ptr<VideoRtpDepacketizer> depacketizer =
+      raw_payload ? std::make_unique<VideoRtpDepacketizerRaw>()
+                  : CreateVideoRtpDepacketizer(video_codec);
+  if (depacketizer) {
+    depacketizer->SetFrameBufferPool(&frame_buffer_pool_);
+  }
+  payload_type_map_.emplace(payload_type, std::move(depacketizer));
   pt_codec_params_.emplace(payload_type, codec_params);
 }
 
@@ -527,8 +531,8 @@ bool RtpVideoStreamReceiver2::OnReceivedPayloadData(
   int64_t unwrapped_rtp_seq_num =
       rtp_seq_num_unwrapper_.Unwrap(rtp_packet.SequenceNumber());
 
-  auto packet = std::make_unique<video_coding::PacketBuffer::Packet>(
-      rtp_packet, unwrapped_rtp_seq_num, video);
+  std::unique_ptr<video_coding::PacketBuffer::Packet> packet =
+      packet_buffer_.CreatePacket(rtp_packet, unwrapped_rtp_seq_num, video);
 
   RtpPacketInfo& packet_info =
       packet_infos_
@@ -848,6 +852,7 @@ void RtpVideoStreamReceiver2::OnInsertedPacket(
     }
   }
   RTC_DCHECK(frame_boundary);
+  packet_buffer_.ReturnPackets(std::move(result.packets));
   if (result.buffer_cleared) {
     last_received_rtp_system_time_.reset();
     last_received_keyframe_rtp_system_time_.reset();
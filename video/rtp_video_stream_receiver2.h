@@ -28,6 +28,7 @@
 #include "call/syncable.h"
 #include "call/video_receive_stream.h"
 #include "common_video/frame_instrumentation_data.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 #include "modules/rtp_rtcp/include/recovered_packet_receiver.h"
 #include "modules/rtp_rtcp/include/remote_ntp_time_estimator.h"
@@ -408,6 +409,9 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
   video_coding::H264SpsPpsTracker tracker_
       RTC_GUARDED_BY(packet_sequence_checker_);
 
+  // Recycles the buffers of assembled frames once they have been decoded.
+  EncodedImageBufferPool frame_buffer_pool_
+      RTC_GUARDED_BY(packet_sequence_checker_);
   // Maps payload id to the depacketizer.
   std::map<uint8_t, std::unique_ptr<VideoRtpDepacketizer>> payload_type_map_
       RTC_GUARDED_BY(packet_sequence_checker_);
@@ -189,13 +189,15 @@ VideoReceiveStream2::VideoReceiveStream2(
     CallStats* call_stats,
     std::unique_ptr<VCMTiming> timing,
     NackPeriodicProcessor* nack_periodic_processor,
-    DecodeSynchronizer* decode_sync)
+    DecodeSynchronizer* decode_sync,
+    DecodeThreadPool* decode_thread_pool)
     : env_(env),
       packet_sequence_checker_(SequenceChecker::kDetached),
       decode_sequence_checker_(SequenceChecker::kDetached),
       transport_adapter_(config.rtcp_send_transport),
       config_(std::move(config)),
       num_cpu_cores_(num_cpu_cores),
+      decode_thread_pool_(decode_thread_pool),
       call_(call),
       call_stats_(call_stats),
       source_tracker_(&env_.clock()),
@@ -223,9 +225,11 @@ VideoReceiveStream2::VideoReceiveStream2(
       max_wait_for_frame_(DetermineMaxWaitForFrame(
           TimeDelta::Millis(config_.rtp.nack.rtp_history_ms),
           false)),
-      decode_queue_(env_.task_queue_factory().CreateTaskQueue(
-          "DecodingQueue",
-          TaskQueueFactory::Priority::HIGH)) {
+      decode_queue_(decode_thread_pool
+                        ? decode_thread_pool->CreateTaskQueue()
+                        : env_.task_queue_factory().CreateTaskQueue(
+                              "DecodingQueue",
+                              TaskQueueFactory::Priority::HIGH)) {
   RTC_LOG(LS_INFO) << "VideoReceiveStream2: " << config_.ToString();
 
   RTC_DCHECK(call_->worker_thread());
@@ -784,9 +788,10 @@ void VideoReceiveStream2::OnEncodedFrame(std::unique_ptr<EncodedFrame> frame) {
   }
   stats_proxy_.OnPreDecode(frame->CodecSpecific()->codecType, qp);
 
-  decode_queue_->PostTask([this, now, keyframe_request_is_due,
-                           received_frame_is_keyframe, frame = std::move(frame),
-                           keyframe_required = keyframe_required_]() mutable {
+  const Timestamp render_time = frame->RenderTimestamp().value_or(now);
+  auto decode_task = [this, now, keyframe_request_is_due,
+                      received_frame_is_keyframe, frame = std::move(frame),
+                      keyframe_required = keyframe_required_]() mutable {
     RTC_DCHECK_RUN_ON(&decode_sequence_checker_);
     if (decoder_stopped_)
       return;
@@ -813,7 +818,14 @@ void VideoReceiveStream2::OnEncodedFrame(std::unique_ptr<EncodedFrame> frame) {
                                             keyframe_request_is_due);
                    buffer_->StartNextDecode(keyframe_required_);
                  }));
-  });
+  };
+  if (decode_thread_pool_ != nullptr) {
+    // Frames closest to their render time are decoded first.
+    decode_thread_pool_->PostDecodeTask(decode_queue_.get(),
+                                        std::move(decode_task), render_time);
+  } else {
+    decode_queue_->PostTask(std::move(decode_task));
+  }
 }
 
 void VideoReceiveStream2::OnDecodableFrameTimeout(TimeDelta wait) {
@@ -36,6 +36,7 @@
 #include "modules/video_coding/video_receiver2.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/thread_annotations.h"
+#include "video/decode_thread_pool.h"
 #include "video/receive_statistics_proxy.h"
 #include "video/rtp_streams_synchronizer2.h"
 #include "video/rtp_video_stream_receiver2.h"
@@ -105,7 +106,8 @@ class VideoReceiveStream2
                       CallStats* call_stats,
                       std::unique_ptr<VCMTiming> timing,
                       NackPeriodicProcessor* nack_periodic_processor,
-                      DecodeSynchronizer* decode_sync);
+                      DecodeSynchronizer* decode_sync,
+                      DecodeThreadPool* decode_thread_pool);
   // Destruction happens on the worker thread. Prior to destruction the caller
   // must ensure that a registration with the transport has been cleared. See
   // `RegisterWithTransport` for details.
@@ -264,6 +266,9 @@ class VideoReceiveStream2
   TransportAdapter transport_adapter_;
   const VideoReceiveStreamInterface::Config config_;
   const int num_cpu_cores_;
+  // If set, frames are decoded on a queue of this pool instead of a task
+  // queue of their own.
+  DecodeThreadPool* const decode_thread_pool_;
   Call* const call_;
 
   CallStats* const call_stats_;
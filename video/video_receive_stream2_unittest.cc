@@ -252,7 +252,8 @@ class VideoReceiveStream2Test : public ::testing::TestWithParam<bool> {
             env_, &fake_call_, kDefaultNumCpuCores, &packet_router_,
             config_.Copy(), &call_stats_, absl::WrapUnique(timing_),
             &nack_periodic_processor_,
-            UseMetronome() ? &decode_sync_ : nullptr);
+            UseMetronome() ? &decode_sync_ : nullptr,
+            /*decode_thread_pool=*/nullptr);
     video_receive_stream_->RegisterWithTransport(
         &rtp_stream_receiver_controller_);
     if (state)
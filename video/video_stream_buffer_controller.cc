@@ -263,7 +263,7 @@ void VideoStreamBufferController::OnFrameReady(
   UpdateTimingFrameInfo();
 
   std::unique_ptr<EncodedFrame> frame =
-      CombineAndDeleteFrames(std::move(frames));
+      CombineAndDeleteFrames(std::move(frames), superframe_buffer_pool_);
 
   timing_->SetLastDecodeScheduledTimestamp(now);
 
@@ -17,6 +17,7 @@
 #include "api/task_queue/task_queue_base.h"
 #include "api/video/encoded_frame.h"
 #include "api/video/frame_buffer.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "modules/video_coding/timing/inter_frame_delay_variation_calculator.h"
 #include "modules/video_coding/timing/jitter_estimator.h"
@@ -130,6 +131,12 @@ class VideoStreamBufferController {
   bool decoder_ready_for_new_frame_ RTC_GUARDED_BY(&worker_sequence_checker_) =
       false;
 
+  // Buffers for frames combined from several spatial layers. Few superframes
+  // are in flight at a time since frames are not queued in front of the
+  // decoder.
+  EncodedImageBufferPool superframe_buffer_pool_
+      RTC_GUARDED_BY(&worker_sequence_checker_){/*max_number_of_buffers=*/8};
+
   // Maximum number of frames in the decode queue to allow pacing. If the
   // queue grows beyond the max limit, pacing will be disabled and frames will
   // be pushed to the decoder as soon as possible. This only has an effect